@@ -221,6 +221,8 @@ MFX_LIB_SHARED_FILES_2 := $(addprefix shared/src/, \
     mfx_vpp_vaapi.cpp \
     libmfx_allocator.cpp \
     libmfx_allocator_vaapi.cpp \
+    mfx_cpu_topology.cpp \
+    mfx_surface_pool.cpp \
     libmfx_core.cpp \
     libmfx_core_hw.cpp \
     libmfx_core_factory.cpp \
@@ -1734,6 +1734,23 @@ mfxStatus VideoDECODEH264::SetSkipMode(mfxSkipMode mode)
     if (!m_isInit)
         return MFX_ERR_NOT_INITIALIZED;
 
+    bool const keyFramesOnly = m_pH264VideoDecoder->IsKeyFramesOnly();
+
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    if (mode == MFX_SKIPMODE_KEY_FRAMES_ONLY)
+    {
+        // the views of MVC streams are not dropped together with the base one
+        if (IsMVCProfile(m_vPar.mfx.CodecProfile))
+            return MFX_ERR_UNSUPPORTED;
+
+        if (keyFramesOnly)
+            return MFX_WRN_VALUE_NOT_CHANGED;
+
+        m_pH264VideoDecoder->SetKeyFramesOnly(true);
+        return MFX_ERR_NONE;
+    }
+#endif
+
     int32_t test_num = 0;
     m_pH264VideoDecoder->ChangeVideoDecodingSpeed(test_num);
 
@@ -1742,6 +1759,7 @@ mfxStatus VideoDECODEH264::SetSkipMode(mfxSkipMode mode)
     {
         case MFX_SKIPMODE_NOSKIP:
             num = -10;
+            m_pH264VideoDecoder->SetKeyFramesOnly(false);
             break;
 
         case MFX_SKIPMODE_MORE:
@@ -1762,7 +1780,7 @@ mfxStatus VideoDECODEH264::SetSkipMode(mfxSkipMode mode)
     m_pH264VideoDecoder->ChangeVideoDecodingSpeed(num);
 
     return
-        test_num == num ? MFX_WRN_VALUE_NOT_CHANGED : MFX_ERR_NONE;
+        test_num == num && keyFramesOnly == m_pH264VideoDecoder->IsKeyFramesOnly() ? MFX_WRN_VALUE_NOT_CHANGED : MFX_ERR_NONE;
 }
 
 bool VideoDECODEH264::IsSameVideoParam(mfxVideoParam * newPar, mfxVideoParam * oldPar, eMFXHWType type)
@@ -1501,6 +1501,18 @@ mfxStatus VideoDECODEH265::SetSkipMode(mfxSkipMode mode)
 
     MFX_CHECK(m_isInit, MFX_ERR_NOT_INITIALIZED);
 
+    bool const keyFramesOnly = m_pH265VideoDecoder->IsKeyFramesOnly();
+
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    if (mode == MFX_SKIPMODE_KEY_FRAMES_ONLY)
+    {
+        MFX_CHECK(!keyFramesOnly, MFX_WRN_VALUE_NOT_CHANGED);
+
+        m_pH265VideoDecoder->SetKeyFramesOnly(true);
+        return MFX_ERR_NONE;
+    }
+#endif
+
     int32_t test_num = 0;
     m_pH265VideoDecoder->ChangeVideoDecodingSpeed(test_num);
 
@@ -1510,6 +1522,7 @@ mfxStatus VideoDECODEH265::SetSkipMode(mfxSkipMode mode)
     {
     case MFX_SKIPMODE_NOSKIP:
         num = -10;
+        m_pH265VideoDecoder->SetKeyFramesOnly(false);
         break;
     case MFX_SKIPMODE_MORE:
         num = 1;
@@ -1524,7 +1537,7 @@ mfxStatus VideoDECODEH265::SetSkipMode(mfxSkipMode mode)
 
     m_pH265VideoDecoder->ChangeVideoDecodingSpeed(num);
 
-    MFX_CHECK(test_num != num, MFX_WRN_VALUE_NOT_CHANGED);
+    MFX_CHECK(test_num != num || keyFramesOnly != m_pH265VideoDecoder->IsKeyFramesOnly(), MFX_WRN_VALUE_NOT_CHANGED);
     return MFX_ERR_NONE;
 }
 
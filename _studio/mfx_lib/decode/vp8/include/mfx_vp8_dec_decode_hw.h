@@ -192,15 +192,19 @@ public:
     virtual mfxStatus GetPayload(mfxU64 *pTimeStamp, mfxPayload *pPayload);
     virtual mfxStatus SetSkipMode(mfxSkipMode mode);
 
+protected:
+
+    // Frame parsing, it needs no device and is also run by the CPU benchmarks
+    mfxStatus ConstructFrame(mfxBitstream *, mfxBitstream *, VP8DecodeCommon::IVF_FRAME&);
+    mfxStatus DecodeFrameHeader(mfxBitstream *p_bistream);
+
 private:
 
     mfxFrameSurface1 * GetOriginalSurface(mfxFrameSurface1 *);
     mfxStatus GetOutputSurface(mfxFrameSurface1 **, mfxFrameSurface1 *, UMC::FrameMemID);
 
-    mfxStatus ConstructFrame(mfxBitstream *, mfxBitstream *, VP8DecodeCommon::IVF_FRAME&);
     mfxStatus PreDecodeFrame(mfxBitstream *, mfxFrameSurface1 *);
 
-    mfxStatus DecodeFrameHeader(mfxBitstream *p_bistream);
     void UpdateSegmentation(MFX_VP8_BoolDecoder &);
     void UpdateLoopFilterDeltas(MFX_VP8_BoolDecoder &);
     void DecodeInitDequantization(MFX_VP8_BoolDecoder &);
@@ -243,7 +247,7 @@ private:
     mfxF64                  m_in_framerate;
     mfxU16                  m_frameOrder;
 
-    mfxBitstream            m_bs;
+    mfxBitstream            m_bs;       // the frame being decoded, refers to the input bitstream
     VP8Defs::vp8_FrameInfo  m_frame_info;
     unsigned                m_CodedCoeffTokenPartition;
     bool                    m_firstFrame;
@@ -334,11 +334,7 @@ mfxStatus VideoDECODEVP8_HW::Close()
     m_p_video_accelerator = 0;
     memset(&m_stat, 0, sizeof(m_stat));
 
-    if (m_bs.Data)
-    {
-        delete[] m_bs.Data;
-        m_bs.DataLength = 0;
-    }
+    UMC_SET_ZERO(m_bs);
 
     gold_indx = 0;
     altref_indx = 0;
@@ -503,20 +499,12 @@ mfxStatus VideoDECODEVP8_HW::ConstructFrame(mfxBitstream *p_in, mfxBitstream *p_
         return MFX_ERR_MORE_DATA;
     }
 
-    mfxU8 *p_bs_start = p_in->Data + p_in->DataOffset;
-
-    if (p_out->Data)
-    {
-        delete[] p_out->Data;
-        p_out->DataLength = 0;
-    }
-
-    p_out->Data = new uint8_t[p_in->DataLength];
-
-    std::copy(p_bs_start, p_bs_start + p_in->DataLength, p_out->Data);
-
+    // The frame is parsed and its data is copied to the driver buffer before
+    // DecodeFrameAsync returns, so refer to it in place instead of copying
+    p_out->Data = p_in->Data + p_in->DataOffset;
     p_out->DataLength = p_in->DataLength;
     p_out->DataOffset = 0;
+    p_out->MaxLength = p_in->DataLength;
 
     frame.frame_size = p_in->DataLength;
 
@@ -23,6 +23,7 @@
 #include <vector>
 #include <list>
 #include <memory>
+#include <atomic>
 #include <algorithm> /* for std::find_if on Linux/Android */
 #include <mfx_brc_common.h>
 
@@ -986,6 +987,7 @@ namespace MfxHwH264Encode
             , m_cmHistSys(0)
             , m_isENCPAK(false)
             , m_startTime(0)
+            , m_stageTime(0)
 #ifdef MFX_ENABLE_MFE
             , m_beginTime(0)
             , m_endTime(0)
@@ -1237,6 +1239,7 @@ namespace MfxHwH264Encode
         std::vector<SliceStructInfo> m_SliceInfo;
 
         mfxU32 m_startTime;
+        vm_tick m_stageTime; // when task entered its current DdiTaskQueue
 #ifdef MFX_ENABLE_MFE
         vm_tick m_beginTime;//where we start counting
         vm_tick m_endTime;//where we get bitstream
@@ -1274,6 +1277,43 @@ namespace MfxHwH264Encode
     typedef std::list<DdiTask>::iterator DdiTaskIter;
     typedef std::list<DdiTask>::const_iterator DdiTaskCiter;
 
+    // Tasks of one AsyncRoutine stage.
+    // All tasks are allocated once in Init and then only move between stages
+    // by relinking list nodes, so a transition is O(1) and never allocates.
+    // Transitions made through Take/TakeAll are accounted in per-stage counters.
+    // Some stages move tasks without m_listMutex, so the counters are atomic
+    // and GetStat doesn't touch the list.
+    class DdiTaskQueue : public std::list<DdiTask>
+    {
+    public:
+        DdiTaskQueue()
+            : m_numEntered(0)
+            , m_occupancy(0)
+            , m_maxOccupancy(0)
+            , m_totalDwellTime(0)
+        {}
+
+        // move task from src to the end of this queue
+        void Take(DdiTaskQueue & src, DdiTaskIter task);
+
+        // move all tasks from src to the end of this queue
+        void TakeAll(DdiTaskQueue & src);
+
+        void ResetStat();
+
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        mfxTaskStageStat GetStat() const;
+#endif
+
+    private:
+        void OnEntered(mfxU32 numTasks);
+
+        std::atomic<mfxU32> m_numEntered;
+        std::atomic<mfxU32> m_occupancy;
+        std::atomic<mfxU32> m_maxOccupancy;
+        std::atomic<mfxU64> m_totalDwellTime;
+    };
+
 
     template <size_t N>
     class Regression
@@ -2049,6 +2089,12 @@ namespace MfxHwH264Encode
 
         void BrcPreEnc(DdiTask const & task);
 
+        void ResetTaskStageStat();
+
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        void GetTaskStageStat(mfxExtAvcTaskStageStat & stat);
+#endif
+
         static mfxStatus AsyncRoutineHelper(
             void * state,
             void * param,
@@ -2101,16 +2147,16 @@ namespace MfxHwH264Encode
 
         SliceDivider        m_sliceDivider;
 
-        std::list<DdiTask>  m_free;
-        std::list<DdiTask>  m_incoming;
-        std::list<DdiTask>  m_ScDetectionStarted;
-        std::list<DdiTask>  m_ScDetectionFinished;
-        std::list<DdiTask>  m_reordering;
-        std::list<DdiTask>  m_lookaheadStarted;
-        std::list<DdiTask>  m_lookaheadFinished;
-        std::list<DdiTask>  m_histRun;
-        std::list<DdiTask>  m_histWait;
-        std::list<DdiTask>  m_encoding;
+        DdiTaskQueue        m_free;
+        DdiTaskQueue        m_incoming;
+        DdiTaskQueue        m_ScDetectionStarted;
+        DdiTaskQueue        m_ScDetectionFinished;
+        DdiTaskQueue        m_reordering;
+        DdiTaskQueue        m_lookaheadStarted;
+        DdiTaskQueue        m_lookaheadFinished;
+        DdiTaskQueue        m_histRun;
+        DdiTaskQueue        m_histWait;
+        DdiTaskQueue        m_encoding;
         std::list<mfxU64>   m_timeStamps;
         UMC::Mutex          m_listMutex;
         DdiTask             m_lastTask;
@@ -2412,6 +2458,14 @@ namespace MfxHwH264Encode
         mfxU8 const * sbegin,
         mfxU8 const * send);
 
+    // same as CheckedMFX_INTERNAL_CPY, but source is read with streaming loads
+    // used for payloads taken directly from locked coded buffer
+    mfxU8 * CheckedFastCopyVid2Sys(
+        mfxU8 *       dbegin,
+        mfxU8 *       dend,
+        mfxU8 const * sbegin,
+        mfxU8 const * send);
+
     mfxU8 * CheckedMemset(
         mfxU8 * dbegin,
         mfxU8 * dend,
@@ -2507,6 +2561,49 @@ namespace MfxHwH264Encode
         DdiTask&              task,
         bool&                 bRecoding);
 
+    // hands slices to application (mfxExtAvcSliceOutput) as soon as they are written to mfxBitstream,
+    // non-slice units are attached to the following slice, trailing ones to the last slice
+    class SliceDelivery
+    {
+    public:
+        typedef mfxStatus (MFX_CDECL *SliceReadyFunc)(mfxHDL pthis, mfxBitstream *bs, mfxU32 offset, mfxU32 size, mfxU16 sliceId, mfxU16 lastSliceInFrame);
+
+        SliceDelivery(
+            mfxHDL         pthis,
+            SliceReadyFunc sliceReady,
+            mfxU16 &       numDelivered,
+            mfxBitstream & bs,
+            mfxU8 *        begin);
+
+        // next slice unit is going to be written, previous slice is complete
+        void SliceBegin();
+
+        // slice unit is written up to dend
+        void SliceEnd(mfxU8 * dend);
+
+        // field is written up to dend, delivers the last slice
+        void Finish(mfxU8 * dend, bool lastField);
+
+    private:
+        void Deliver(mfxU8 * end, mfxU16 lastSliceInFrame);
+
+        mfxHDL         m_pthis;
+        SliceReadyFunc m_sliceReady;
+        mfxU16 &       m_numDelivered;
+        mfxBitstream & m_bs;
+        mfxU8 *        m_start;
+        mfxU8 *        m_sliceEnd;
+        bool           m_stopped;
+    };
+
+    // copies units from locked coded buffer with streaming loads delivering slices one by one
+    mfxU8 * CopyBitstreamBySlices(
+        mfxU8 *               sbegin,
+        mfxU8 *               send,
+        mfxU8 *               dbegin,
+        mfxU8 *               dend,
+        SliceDelivery &       slices);
+
     mfxU8 * PatchBitstream(
         MfxVideoParam const & video,
         DdiTask const &       task,
@@ -2514,14 +2611,17 @@ namespace MfxHwH264Encode
         mfxU8 *               sbegin, // contents of source buffer may be modified
         mfxU8 *               send,
         mfxU8 *               dbegin,
-        mfxU8 *               dend);
+        mfxU8 *               dend,
+        bool                  srcIsCodedBuffer = false, // source is locked coded buffer, stream slice data out of it
+        SliceDelivery *       slices = 0);
     mfxU8 * InsertSVCNAL(
         DdiTask const &       task,
         mfxU32                fieldId,
         mfxU8 *               sbegin, // contents of source buffer may be modified
         mfxU8 *               send,
         mfxU8 *               dbegin,
-        mfxU8 *               dend);
+        mfxU8 *               dend,
+        SliceDelivery *       slices = 0);
 
     mfxU8 * AddEmulationPreventionAndCopy(
         mfxU8 *               sbegin,
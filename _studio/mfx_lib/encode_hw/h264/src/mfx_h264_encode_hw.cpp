@@ -1162,6 +1162,7 @@ mfxStatus ImplementationAvc::Init(mfxVideoParam * par)
         m_histWait.clear();
         m_encoding.clear();
         m_timeStamps.clear();
+        ResetTaskStageStat();
     }
     m_fieldCounter   = 0;
     m_1stFieldStatus = MFX_ERR_NONE;
@@ -1502,13 +1503,13 @@ mfxStatus ImplementationAvc::Reset(mfxVideoParam *par)
             }
         }
 
-        m_free.splice(m_free.end(), m_incoming);
-        m_free.splice(m_free.end(), m_reordering);
-        m_free.splice(m_free.end(), m_lookaheadStarted);
-        m_free.splice(m_free.end(), m_lookaheadFinished);
-        m_free.splice(m_free.end(), m_histRun);
-        m_free.splice(m_free.end(), m_histWait);
-        m_free.splice(m_free.end(), m_encoding);
+        m_free.TakeAll(m_incoming);
+        m_free.TakeAll(m_reordering);
+        m_free.TakeAll(m_lookaheadStarted);
+        m_free.TakeAll(m_lookaheadFinished);
+        m_free.TakeAll(m_histRun);
+        m_free.TakeAll(m_histWait);
+        m_free.TakeAll(m_encoding);
         m_timeStamps.clear();
 
         for (DdiTaskIter i = m_free.begin(); i != m_free.end(); ++i)
@@ -1517,6 +1518,7 @@ mfxStatus ImplementationAvc::Reset(mfxVideoParam *par)
                 m_core->DecreaseReference(&i->m_yuv->Data);
             *i = DdiTask();
         }
+        ResetTaskStageStat();
 
         Zero(m_stat);
         m_lastTask = DdiTask();
@@ -1604,6 +1606,15 @@ mfxStatus ImplementationAvc::GetVideoParam(mfxVideoParam *par)
 
     for (mfxU32 i = 0; i < par->NumExtParam; i++)
     {
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        if (par->ExtParam[i]->BufferId == MFX_EXTBUFF_AVC_TASK_STAGE_STAT)
+        {
+            MFX_CHECK(par->ExtParam[i]->BufferSz >= sizeof(mfxExtAvcTaskStageStat), MFX_ERR_UNSUPPORTED);
+            GetTaskStageStat(*(mfxExtAvcTaskStageStat *)par->ExtParam[i]);
+            continue;
+        }
+#endif
+
         if (buffers_offsets.find(par->ExtParam[i]->BufferId) == buffers_offsets.end())
             buffers_offsets[par->ExtParam[i]->BufferId] = 0;
         else
@@ -1682,6 +1693,37 @@ mfxStatus ImplementationAvc::GetEncodeStat(mfxEncodeStat *stat)
     return MFX_ERR_NONE;
 }
 
+void ImplementationAvc::ResetTaskStageStat()
+{
+    m_free.ResetStat();
+    m_incoming.ResetStat();
+    m_ScDetectionStarted.ResetStat();
+    m_ScDetectionFinished.ResetStat();
+    m_reordering.ResetStat();
+    m_lookaheadStarted.ResetStat();
+    m_lookaheadFinished.ResetStat();
+    m_histRun.ResetStat();
+    m_histWait.ResetStat();
+    m_encoding.ResetStat();
+}
+
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+void ImplementationAvc::GetTaskStageStat(mfxExtAvcTaskStageStat & stat)
+{
+    stat.TimerFrequency = vm_time_get_frequency();
+    stat.Stage[MFX_AVC_TASK_STAGE_FREE]         = m_free.GetStat();
+    stat.Stage[MFX_AVC_TASK_STAGE_INCOMING]     = m_incoming.GetStat();
+    stat.Stage[MFX_AVC_TASK_STAGE_SCD_STARTED]  = m_ScDetectionStarted.GetStat();
+    stat.Stage[MFX_AVC_TASK_STAGE_SCD_FINISHED] = m_ScDetectionFinished.GetStat();
+    stat.Stage[MFX_AVC_TASK_STAGE_REORDERING]   = m_reordering.GetStat();
+    stat.Stage[MFX_AVC_TASK_STAGE_LA_STARTED]   = m_lookaheadStarted.GetStat();
+    stat.Stage[MFX_AVC_TASK_STAGE_LA_FINISHED]  = m_lookaheadFinished.GetStat();
+    stat.Stage[MFX_AVC_TASK_STAGE_HIST_RUN]     = m_histRun.GetStat();
+    stat.Stage[MFX_AVC_TASK_STAGE_HIST_WAIT]    = m_histWait.GetStat();
+    stat.Stage[MFX_AVC_TASK_STAGE_ENCODING]     = m_encoding.GetStat();
+}
+#endif
+
 struct CompareByMidRec
 {
     mfxMemId m_mid;
@@ -1707,7 +1749,7 @@ void ImplementationAvc::OnNewFrame()
     m_stagesToGo &= ~AsyncRoutineEmulator::STG_BIT_ACCEPT_FRAME;
 
     UMC::AutomaticUMCMutex guard(m_listMutex);
-    m_reordering.splice(m_reordering.end(), m_incoming, m_incoming.begin());
+    m_reordering.Take(m_incoming, m_incoming.begin());
 }
 
 void ImplementationAvc::SubmitScd()
@@ -1715,7 +1757,7 @@ void ImplementationAvc::SubmitScd()
     m_stagesToGo &= ~AsyncRoutineEmulator::STG_BIT_ACCEPT_FRAME;
 
     UMC::AutomaticUMCMutex guard(m_listMutex);
-    m_ScDetectionStarted.splice(m_ScDetectionStarted.end(), m_incoming, m_incoming.begin());
+    m_ScDetectionStarted.Take(m_incoming, m_incoming.begin());
 }
 
 void ImplementationAvc::OnScdQueried()
@@ -1723,7 +1765,7 @@ void ImplementationAvc::OnScdQueried()
     m_stagesToGo &= ~AsyncRoutineEmulator::STG_BIT_START_SCD;
 
     UMC::AutomaticUMCMutex guard(m_listMutex);
-    m_ScDetectionFinished.splice(m_ScDetectionFinished.end(), m_ScDetectionStarted, m_ScDetectionStarted.begin());
+    m_ScDetectionFinished.Take(m_ScDetectionStarted, m_ScDetectionStarted.begin());
 }
 
 void ImplementationAvc::OnScdFinished()
@@ -1731,7 +1773,7 @@ void ImplementationAvc::OnScdFinished()
     m_stagesToGo &= ~AsyncRoutineEmulator::STG_BIT_WAIT_SCD;
 
     UMC::AutomaticUMCMutex guard(m_listMutex);
-    m_reordering.splice(m_reordering.end(), m_ScDetectionFinished, m_ScDetectionFinished.begin());
+    m_reordering.Take(m_ScDetectionFinished, m_ScDetectionFinished.begin());
 }
 
 
@@ -1741,7 +1783,7 @@ void ImplementationAvc::OnLookaheadSubmitted(DdiTaskIter task)
 
     if (m_inputFrameType == MFX_IOPATTERN_IN_SYSTEM_MEMORY)
         m_core->DecreaseReference(&task->m_yuv->Data);
-    m_lookaheadStarted.splice(m_lookaheadStarted.end(), m_reordering, task);
+    m_lookaheadStarted.Take(m_reordering, task);
 }
 
 
@@ -1796,14 +1838,14 @@ void ImplementationAvc::OnLookaheadQueried()
         }
     }
 
-    m_histRun.splice(m_histRun.end(), m_lookaheadStarted, m_lookaheadStarted.begin());
+    m_histRun.Take(m_lookaheadStarted, m_lookaheadStarted.begin());
 }
 
 void ImplementationAvc::OnHistogramSubmitted()
 {
     m_stagesToGo &= ~AsyncRoutineEmulator::STG_BIT_START_HIST;
 
-    m_histWait.splice(m_histWait.end(), m_histRun, m_histRun.begin());
+    m_histWait.Take(m_histRun, m_histRun.begin());
 }
 
 void ImplementationAvc::OnHistogramQueried()
@@ -1841,7 +1883,7 @@ void ImplementationAvc::OnHistogramQueried()
         task.m_event = 0;
     }
 
-    m_lookaheadFinished.splice(m_lookaheadFinished.end(), m_histWait, m_histWait.begin());
+    m_lookaheadFinished.Take(m_histWait, m_histWait.begin());
 }
 
 
@@ -1852,7 +1894,7 @@ void ImplementationAvc::OnEncodingSubmitted(DdiTaskIter task)
 
     MFX_TRACE_D(task->m_startTime);
 
-    m_encoding.splice(m_encoding.end(), m_lookaheadFinished, task);
+    m_encoding.Take(m_lookaheadFinished, task);
 }
 
 
@@ -1906,7 +1948,9 @@ void ImplementationAvc::OnEncodingQueried(DdiTaskIter task)
 
 
     mfxU32 numBits = 8 * (task->m_bsDataLength[0] + task->m_bsDataLength[1]);
+    vm_tick stageTime = task->m_stageTime;
     *task = DdiTask();
+    task->m_stageTime = stageTime;
 
     UMC::AutomaticUMCMutex guard(m_listMutex);
 
@@ -1916,7 +1960,7 @@ void ImplementationAvc::OnEncodingQueried(DdiTaskIter task)
 #if defined (MFX_ENABLE_MFE)
     m_lastTask.m_endTime = vm_time_get_tick();
 #endif
-    m_free.splice(m_free.end(), m_encoding, task);
+    m_free.Take(m_encoding, task);
 }
 
 
@@ -3420,7 +3464,7 @@ mfxStatus ImplementationAvc::EncodeFrameCheckNormalWay(
 
         m_free.front().m_beginTime = vm_time_get_tick();
 #endif
-        m_incoming.splice(m_incoming.end(), m_free, m_free.begin());
+        m_incoming.Take(m_free, m_free.begin());
     }
 
 
@@ -3508,6 +3552,11 @@ mfxStatus ImplementationAvc::UpdateBitstream(
         || m_video.Protected != 0)
         doPatch = needIntermediateBitstreamBuffer = false;
 
+    // VA-API coded buffer is mapped to system memory and may be modified while locked,
+    // so instead of copying it to m_tmpBsBuf and then patching into task.m_bs,
+    // headers are patched straight from locked buffer into task.m_bs in single pass
+    bool patchFromCodedBuffer = needIntermediateBitstreamBuffer && m_core->GetVAType() == MFX_HW_VAAPI;
+
     // Lock d3d surface with compressed picture.
     MFX_LTRACE_S(MFX_TRACE_LEVEL_INTERNAL, task.m_FrameName);
 
@@ -3535,7 +3584,7 @@ mfxStatus ImplementationAvc::UpdateBitstream(
 
     if (m_video.Protected == 0 || task.m_notProtected)
     {
-        if (needIntermediateBitstreamBuffer)
+        if (needIntermediateBitstreamBuffer && !patchFromCodedBuffer)
         {
             bsData      = &m_tmpBsBuf[0];
             bsSizeAvail = mfxU32(m_tmpBsBuf.size());
@@ -3544,9 +3593,24 @@ mfxStatus ImplementationAvc::UpdateBitstream(
 
     mfxU32 initialDataLength = *dataLength;
 
-    assert(bsSizeToCopy <= bsSizeAvail);
+    // slices are handed to application while they are copied/patched into task.m_bs
+    std::unique_ptr<SliceDelivery> slices;
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    mfxExtAvcSliceOutput * sliceOut = (mfxExtAvcSliceOutput*)GetExtBuffer(task.m_bs->ExtParam, task.m_bs->NumExtParam, MFX_EXTBUFF_AVC_SLICE_OUTPUT);
+    if (sliceOut && sliceOut->SliceReady && (m_video.Protected == 0 || task.m_notProtected))
+    {
+        if (task.m_fieldCounter == 0)
+            sliceOut->NumSlicesDelivered = 0;
+
+        slices.reset(new SliceDelivery(sliceOut->pthis, sliceOut->SliceReady, sliceOut->NumSlicesDelivered,
+            *task.m_bs, task.m_bs->Data + task.m_bs->DataOffset + initialDataLength));
+    }
+#endif
+
+    // patched size isn't known until patching, PatchBitstream checks task.m_bs boundaries itself
+    assert(patchFromCodedBuffer || bsSizeToCopy <= bsSizeAvail);
 
-    if (bsSizeToCopy > bsSizeAvail)
+    if (!patchFromCodedBuffer && bsSizeToCopy > bsSizeAvail)
     {
         bsSizeToCopy = bsSizeAvail;
         bsSizeActual = bsSizeAvail;
@@ -3568,11 +3632,16 @@ mfxStatus ImplementationAvc::UpdateBitstream(
     }
 
     // Copy compressed picture from d3d surface to buffer in system memory
-    if (bsSizeToCopy)
+    if (bsSizeToCopy && !patchFromCodedBuffer)
     {
-        FastCopyBufferVid2Sys(bsData, bitstream.Y, bsSizeToCopy);
+        if (slices && !doPatch)
+            CopyBitstreamBySlices(bitstream.Y, bitstream.Y + bsSizeToCopy, bsData, bsData + bsSizeAvail, *slices);
+        else
+            FastCopyBufferVid2Sys(bsData, bitstream.Y, bsSizeToCopy);
     }
 
+    // coded buffer stays locked until it is patched
+    if (!patchFromCodedBuffer)
     {
         MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "Surface unlock (bitstream)");
         MFX_LTRACE_S(MFX_TRACE_LEVEL_INTERNAL, task.m_FrameName);
@@ -3591,6 +3660,7 @@ mfxStatus ImplementationAvc::UpdateBitstream(
 
     if (doPatch)
     {
+        mfxU8 * sbegin = patchFromCodedBuffer ? bitstream.Y : bsData;
         mfxU8 * dbegin = bsData;
         mfxU8 * dend   = bsData + bsSizeActual;
 
@@ -3602,10 +3672,18 @@ mfxStatus ImplementationAvc::UpdateBitstream(
 
         mfxU8 * endOfPatchedBitstream =
             IsOn(m_video.mfx.LowPower)?
-            InsertSVCNAL(task, fid, bsData, bsData + bsSizeActual, dbegin, dend)://insert SVC NAL for temporal scalability
-            PatchBitstream(m_video, task, fid, bsData, bsData + bsSizeActual, dbegin, dend);
+            InsertSVCNAL(task, fid, sbegin, sbegin + bsSizeActual, dbegin, dend, slices.get())://insert SVC NAL for temporal scalability
+            PatchBitstream(m_video, task, fid, sbegin, sbegin + bsSizeActual, dbegin, dend, patchFromCodedBuffer, slices.get());
 
         *dataLength += (mfxU32)(endOfPatchedBitstream - dbegin);
+
+        if (patchFromCodedBuffer)
+        {
+            MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "Surface unlock (bitstream)");
+            MFX_LTRACE_S(MFX_TRACE_LEVEL_INTERNAL, task.m_FrameName);
+            mfxStatus sts = lock.Unlock();
+            MFX_CHECK_STS(sts);
+        }
     }
     else
     {
@@ -3639,6 +3717,9 @@ mfxStatus ImplementationAvc::UpdateBitstream(
     if (task.m_fieldPicFlag)
         task.m_bs->FrameType = mfxU16(task.m_bs->FrameType | ((task.m_type[!task.GetFirstField()]& ~MFX_FRAMETYPE_KEYPIC) << 8));
 
+    if (slices)
+        slices->Finish(task.m_bs->Data + task.m_bs->DataOffset + *dataLength, !task.m_fieldPicFlag || task.m_fieldCounter == 1);
+
     mfxExtCodingOption const &extOpt = GetExtBufferRef(m_video);
 
     if (task.m_bs->NumExtParam > 0)
@@ -682,6 +682,77 @@ void FrameTypeGenerator::Next()
     m_frameOrder = (m_frameOrder + 1) % m_idrDist;
 }
 
+/////////////////////////////////////////////////////////////////////////////////
+// DdiTaskQueue
+
+void DdiTaskQueue::OnEntered(mfxU32 numTasks)
+{
+    m_numEntered += numTasks;
+
+    mfxU32 occupancy = (m_occupancy += numTasks);
+    mfxU32 maxOccupancy = m_maxOccupancy;
+    while (occupancy > maxOccupancy && !m_maxOccupancy.compare_exchange_weak(maxOccupancy, occupancy))
+        ;
+}
+
+void DdiTaskQueue::Take(DdiTaskQueue & src, DdiTaskIter task)
+{
+    vm_tick now = vm_time_get_tick();
+
+    src.m_totalDwellTime += now - task->m_stageTime;
+    task->m_stageTime = now;
+
+    splice(end(), src, task);
+
+    src.m_occupancy--;
+    OnEntered(1);
+}
+
+void DdiTaskQueue::TakeAll(DdiTaskQueue & src)
+{
+    if (src.empty())
+        return;
+
+    vm_tick now = vm_time_get_tick();
+    mfxU32 numTasks = mfxU32(src.size());
+
+    for (DdiTaskIter i = src.begin(); i != src.end(); ++i)
+    {
+        src.m_totalDwellTime += now - i->m_stageTime;
+        i->m_stageTime = now;
+    }
+
+    splice(end(), src);
+
+    src.m_occupancy -= numTasks;
+    OnEntered(numTasks);
+}
+
+void DdiTaskQueue::ResetStat()
+{
+    vm_tick now = vm_time_get_tick();
+
+    for (DdiTaskIter i = begin(); i != end(); ++i)
+        i->m_stageTime = now;
+
+    m_numEntered     = 0;
+    m_occupancy      = mfxU32(size());
+    m_maxOccupancy   = mfxU32(size());
+    m_totalDwellTime = 0;
+}
+
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+mfxTaskStageStat DdiTaskQueue::GetStat() const
+{
+    mfxTaskStageStat stat = {};
+    stat.NumEntered     = m_numEntered;
+    stat.Occupancy      = m_occupancy;
+    stat.MaxOccupancy   = m_maxOccupancy;
+    stat.TotalDwellTime = m_totalDwellTime;
+    return stat;
+}
+#endif
+
 
 NalUnit MfxHwH264Encode::GetNalUnit(mfxU8 * begin, mfxU8 * end)
 {
@@ -3546,6 +3617,23 @@ mfxU8 * MfxHwH264Encode::CheckedMFX_INTERNAL_CPY(
 }
 
 
+mfxU8 * MfxHwH264Encode::CheckedFastCopyVid2Sys(
+    mfxU8 *       dbegin,
+    mfxU8 *       dend,
+    mfxU8 const * sbegin,
+    mfxU8 const * send)
+{
+    if (dend - dbegin < send - sbegin)
+    {
+        assert(0);
+        throw EndOfBuffer();
+    }
+
+    copyVideoToSys(sbegin, dbegin, (int)(send - sbegin));
+    return dbegin + (send - sbegin);
+}
+
+
 mfxU8 * MfxHwH264Encode::CheckedMemset(
     mfxU8 * dbegin,
     mfxU8 * dend,
@@ -4276,6 +4364,90 @@ mfxStatus MfxHwH264Encode::UpdateSliceInfo(
    }
    return (task.m_SliceInfo.size()!= num)? MFX_ERR_UNDEFINED_BEHAVIOR : MFX_ERR_NONE;
 }
+MfxHwH264Encode::SliceDelivery::SliceDelivery(
+    mfxHDL         pthis,
+    SliceReadyFunc sliceReady,
+    mfxU16 &       numDelivered,
+    mfxBitstream & bs,
+    mfxU8 *        begin)
+    : m_pthis(pthis)
+    , m_sliceReady(sliceReady)
+    , m_numDelivered(numDelivered)
+    , m_bs(bs)
+    , m_start(begin)
+    , m_sliceEnd(0)
+    , m_stopped(false)
+{
+}
+
+void MfxHwH264Encode::SliceDelivery::SliceBegin()
+{
+    if (m_sliceEnd)
+    {
+        Deliver(m_sliceEnd, 0);
+        m_start    = m_sliceEnd;
+        m_sliceEnd = 0;
+    }
+}
+
+void MfxHwH264Encode::SliceDelivery::SliceEnd(mfxU8 * dend)
+{
+    m_sliceEnd = dend;
+}
+
+void MfxHwH264Encode::SliceDelivery::Finish(mfxU8 * dend, bool lastField)
+{
+    if (m_sliceEnd)
+    {
+        Deliver(dend, mfxU16(lastField));
+        m_sliceEnd = 0;
+    }
+}
+
+void MfxHwH264Encode::SliceDelivery::Deliver(mfxU8 * end, mfxU16 lastSliceInFrame)
+{
+    if (m_stopped)
+        return;
+
+    MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "SliceReady");
+
+    // application error stops delivery of the rest of the frame,
+    // only slices accepted by application are counted
+    mfxStatus sts = m_sliceReady(m_pthis, &m_bs,
+        mfxU32(m_start - m_bs.Data), mfxU32(end - m_start), m_numDelivered, lastSliceInFrame);
+    if (sts != MFX_ERR_NONE)
+        m_stopped = true;
+    else
+        m_numDelivered++;
+}
+
+mfxU8 * MfxHwH264Encode::CopyBitstreamBySlices(
+    mfxU8 *         sbegin,
+    mfxU8 *         send,
+    mfxU8 *         dbegin,
+    mfxU8 *         dend,
+    SliceDelivery & slices)
+{
+    // bytes outside of units are copied as well, so the result is the same as a single copy
+    mfxU8 * copied = sbegin;
+
+    for (NaluIterator nalu(sbegin, send); nalu != NaluIterator(); ++nalu)
+    {
+        bool slice = nalu->type == NALU_NON_IDR || nalu->type == NALU_IDR || nalu->type == NALU_CODED_SLICE_EXT;
+
+        if (slice)
+            slices.SliceBegin();
+
+        dbegin = CheckedFastCopyVid2Sys(dbegin, dend, copied, nalu->end);
+        copied = nalu->end;
+
+        if (slice)
+            slices.SliceEnd(dbegin);
+    }
+
+    return CheckedFastCopyVid2Sys(dbegin, dend, copied, send);
+}
+
 mfxU8 * MfxHwH264Encode::PatchBitstream(
     MfxVideoParam const & video,
     DdiTask const &       task,
@@ -4283,7 +4455,9 @@ mfxU8 * MfxHwH264Encode::PatchBitstream(
     mfxU8 *               sbegin, // contents of source buffer may be modified
     mfxU8 *               send,
     mfxU8 *               dbegin,
-    mfxU8 *               dend)
+    mfxU8 *               dend,
+    bool                  srcIsCodedBuffer,
+    SliceDelivery *       slices)
 {
     mfxExtSpsHeader const & extSps = GetExtBufferRef(video);
     mfxExtPpsHeader const & extPps = GetExtBufferRef(video);
@@ -4369,6 +4543,9 @@ mfxU8 * MfxHwH264Encode::PatchBitstream(
         }
         else if (nalu->type == 1 || nalu->type == 5)
         {
+            if (slices)
+                slices->SliceBegin();
+
             if (task.m_nalRefIdc[fieldId] > 1)
             {
                 nalu->begin[nalu->numZero + 1] &= ~0x30;
@@ -4386,12 +4563,20 @@ mfxU8 * MfxHwH264Encode::PatchBitstream(
                 dbegin = CheckedMFX_INTERNAL_CPY(dbegin, dend, nalu->begin, nalu->begin + nalu->numZero + 2);
                 dbegin = RePackSlice(dbegin, dend, nalu->begin + nalu->numZero + 2, nalu->end, video, task, fieldId);
             }
+            else if (copy && srcIsCodedBuffer)
+            {
+                // slice data is not changed, move it with streaming copy
+                dbegin = CheckedFastCopyVid2Sys(dbegin, dend, nalu->begin, nalu->end);
+            }
             else
             {
                 dbegin = copy
                     ? CheckedMFX_INTERNAL_CPY(dbegin, dend, nalu->begin, nalu->end)
                     : nalu->end;
             }
+
+            if (slices)
+                slices->SliceEnd(dbegin);
         }
         else
         {
@@ -4410,7 +4595,8 @@ mfxU8 * MfxHwH264Encode::InsertSVCNAL(
     mfxU8 *               sbegin, // contents of source buffer may be modified
     mfxU8 *               send,
     mfxU8 *               dbegin,
-    mfxU8 *               dend)
+    mfxU8 *               dend,
+    SliceDelivery *       slices)
 {
 
     bool copy = (sbegin != dbegin);
@@ -4419,11 +4605,16 @@ mfxU8 * MfxHwH264Encode::InsertSVCNAL(
     {
         if (nalu->type == 1 || nalu->type == 5)
         {
+            if (slices)
+                slices->SliceBegin();
 
             dbegin = PackPrefixNalUnitSvc(dbegin, dend, true, task, fieldId);
             dbegin = copy
                     ? CheckedMFX_INTERNAL_CPY(dbegin, dend, nalu->begin, nalu->end)
                     : nalu->end;
+
+            if (slices)
+                slices->SliceEnd(dbegin);
         }
         else
         {
@@ -26,6 +26,7 @@
 #include <mfx_scheduler_core_thread.h>
 #include <mfx_scheduler_core_handle.h>
 #include <mfx_scheduler_core_task.h>
+#include <mfx_scheduler_core_pool.h>
 
 #include <mfx_task.h>
 
@@ -210,12 +211,20 @@ public:
     //MFX_SCHEDULER_TASK is only one consumer
     void ResolveDependencyTable(MFX_SCHEDULER_TASK *pTask);
 
+    // Queue the done notification of the task, if it has any.
+    // Notifications are called by CallDoneCallbacks.
+    void QueueDoneCallback(MFX_SCHEDULER_TASK *pTask, mfxStatus res);
+
     // Notification to the scheduler that task got resolved dependencies
     void OnDependencyResolved(MFX_SCHEDULER_TASK *pTask);
 
     // WA for SINGLE THREAD MODE
     virtual
     mfxStatus GetTimeout(mfxU32 & maxTimeToRun);
+
+    // Execute one ready task on the calling thread of the shared pool.
+    // Returns the task's priority or -1 if there is no ready task.
+    int RunSharedTask(mfxU64 &timeSpent);
 protected:
     // Destructor is protected to avoid deletion the object by occasion.
     virtual
@@ -295,6 +304,9 @@ protected:
                            const mfxU32 threadNum);
     // Reset 'waiting' state for tasks with given owner
     void ResetWaitingTasks(const void *pOwner);
+    // Call queued done notifications. The guard must be locked,
+    // it is released while the notifications are running.
+    void CallDoneCallbacks(void);
     // Managing HW event counter functions
     inline
     void IncrementHWEventCounter(void);
@@ -384,6 +396,11 @@ protected:
     // Threads contexts
     MFX_SCHEDULER_THREAD_CONTEXT *m_pThreadCtx;
 
+    // process-wide pool executing the tasks instead of own threads
+    mfxSchedulerPool *m_pSharedPool;
+    // a thread of the pool executes a dedicated task
+    bool m_bDedicatedThreadBusy;
+
 
 
     // Event to wait free task objects
@@ -414,6 +431,16 @@ protected:
     // Number of tasks for non-dedicated threads
     mfxU32 m_RegularThreadsToWakeUp;
 
+    struct MFX_DONE_CALLBACK
+    {
+        mfxTaskDoneCallback pCallback;
+        void *pState;
+        void *pParam;
+        mfxStatus res;
+    };
+    // Done notifications of finished tasks waiting for leaving the guard
+    std::vector<MFX_DONE_CALLBACK> m_doneCallbacks;
+
     // these members are used only from the main thread,
     // so synchronization is not necessary to access them.
 
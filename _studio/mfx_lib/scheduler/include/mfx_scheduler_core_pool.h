@@ -0,0 +1,113 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MFX_SCHEDULER_CORE_POOL_H
+#define __MFX_SCHEDULER_CORE_POOL_H
+
+#include <mfx_interface_scheduler.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <list>
+#include <vector>
+
+// forward declaration of the served class
+class mfxSchedulerCore;
+
+// Process-wide pool of working threads shared by the schedulers initialized
+// with MFX_SCHEDULER_SHARED_POOL. Schedulers keep their own task queues,
+// the pool only lends threads to them. Sessions are served in order of
+// the CPU time they consumed, weighted by the priority of executed tasks,
+// so a busy session can't starve the others.
+class mfxSchedulerPool
+{
+public:
+    // Get the pool, the first call spawns the threads using given parameters.
+    // Returns MFX_ERR_INCOMPATIBLE_VIDEO_PARAM if the running pool was
+    // spawned with other number, scheduling or placement of threads.
+    static
+    mfxStatus Acquire(const MFX_SCHEDULER_PARAM2 &param, mfxSchedulerPool **ppPool);
+    // Release the pool, the last call stops the threads
+    void Release(void);
+
+    mfxU32 GetNumThreads(void) const { return (mfxU32) m_threads.size(); }
+
+    // Start serving the scheduler
+    void Register(mfxSchedulerCore *pScheduler);
+    // Stop serving the scheduler, returns when no thread executes its tasks
+    void Unregister(mfxSchedulerCore *pScheduler);
+
+    // Wake up sleeping threads, (mfxU32) -1 wakes up all of them
+    void WakeUpThreads(mfxU32 numThreads);
+
+protected:
+    struct Entry
+    {
+        mfxSchedulerCore *pScheduler;
+        // weighted CPU time consumed by the scheduler's tasks
+        mfxU64 pass;
+        // number of threads referring the entry
+        mfxU32 numUsers;
+        bool bRemoved;
+    };
+
+    mfxSchedulerPool(void);
+    ~mfxSchedulerPool(void);
+
+    mfxStatus Start(const MFX_SCHEDULER_PARAM2 &param);
+    void Stop(void);
+
+    // check the threads requested by a joining session against the running ones
+    bool IsCompatible(const MFX_SCHEDULER_PARAM2 &param) const;
+
+    void ThreadProc(mfxU32 threadNum);
+
+    // instance guard
+    static std::mutex m_instanceGuard;
+    static mfxSchedulerPool *m_pInstance;
+    mfxU32 m_refCounter;
+
+    std::mutex m_guard;
+    // signals new tasks and leaving of the entry users
+    std::condition_variable m_taskAdded;
+    std::condition_variable m_entryReleased;
+
+    std::vector<std::thread> m_threads;
+    // parameters of the threads given by the session spawned them
+    mfxExtThreadsParam m_threadsParam;
+    mfxU16 m_affinityPolicy;
+    mfxI32 m_affinityNode;
+
+    std::list<Entry> m_entries;
+    // pass of the most recently served entry
+    mfxU64 m_virtualTime;
+    // incremented on every wake up request to avoid missing a wake up
+    // between scanning the schedulers and falling asleep
+    mfxU64 m_wakeUpCounter;
+    mfxU32 m_numWaiting;
+    bool m_bQuit;
+
+private:
+    mfxSchedulerPool(const mfxSchedulerPool &);
+    mfxSchedulerPool & operator = (const mfxSchedulerPool &);
+};
+
+#endif // __MFX_SCHEDULER_CORE_POOL_H
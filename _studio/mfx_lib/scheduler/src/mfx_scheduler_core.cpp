@@ -23,6 +23,8 @@
 #include <mfx_scheduler_core_task.h>
 #include <mfx_scheduler_core_handle.h>
 #include <mfx_trace.h>
+#include <mfx_cpu_topology.h>
+#include <mfx_ext_buffers.h>
 
 #include <vm_time.h>
 #include <vm_sys_info.h>
@@ -47,6 +49,8 @@ mfxSchedulerCore::mfxSchedulerCore(void)
     m_bQuit = false;
 
     m_pThreadCtx = NULL;
+    m_pSharedPool = NULL;
+    m_bDedicatedThreadBusy = false;
     m_vmtick_msec_frequency = vm_time_get_frequency()/1000;
     vm_event_set_invalid(&m_hwTaskDone);
 
@@ -99,6 +103,15 @@ bool mfxSchedulerCore::SetScheduling(std::thread& handle)
 
 void mfxSchedulerCore::SetThreadsAffinityToSockets(void)
 {
+    if (MFX_THREADS_AFFINITY_NONE == m_param.affinityPolicy || !m_pThreadCtx)
+        return;
+
+    // placement is a hint, threads keep running on any CPU on failure
+    for (mfxU32 i = 0; i < m_param.numberOfThreads; i += 1)
+    {
+        mfx::SetThreadAffinity(m_pThreadCtx[i].threadHandle,
+            mfx::GetThreadCpus(m_param.affinityPolicy, m_param.affinityNode, i));
+    }
 }
 
 void mfxSchedulerCore::Close(void)
@@ -129,16 +142,29 @@ void mfxSchedulerCore::Close(void)
         delete[] m_pThreadCtx;
     }
 
+    // leave the shared pool
+    if (m_pSharedPool)
+    {
+        // returns when no thread of the pool executes our tasks
+        m_pSharedPool->Unregister(this);
+        m_pSharedPool->Release();
+    }
+
     // run over the task lists and abort the existing tasks
     ForEachTask(
-        [](MFX_SCHEDULER_TASK* task)
+        [this](MFX_SCHEDULER_TASK* task)
         {
             if (MFX_TASK_WORKING == task->curStatus)
             {
                 task->CompleteTask(MFX_ERR_ABORTED);
+                QueueDoneCallback(task, MFX_ERR_ABORTED);
             }
         }
     );
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+        CallDoneCallbacks();
+    }
 
     // delete task objects
     for (auto & it : m_ppTaskLookUpTable)
@@ -156,6 +182,8 @@ void mfxSchedulerCore::Close(void)
     // reset variables
     m_bQuit = false;
     m_pThreadCtx = NULL;
+    m_pSharedPool = NULL;
+    m_bDedicatedThreadBusy = false;
     // reset task variables
     memset(m_pTasks, 0, sizeof(m_pTasks));
     memset(m_numAssignedTasks, 0, sizeof(m_numAssignedTasks));
@@ -179,6 +207,13 @@ void mfxSchedulerCore::WakeUpThreads(mfxU32 num_dedicated_threads, mfxU32 num_re
     if (m_param.flags == MFX_SINGLE_THREAD)
         return;
 
+    if (m_pSharedPool) {
+        m_pSharedPool->WakeUpThreads(
+            (num_dedicated_threads == (mfxU32)-1 || num_regular_threads == (mfxU32)-1)
+            ? (mfxU32)-1 : num_dedicated_threads + num_regular_threads);
+        return;
+    }
+
     MFX_SCHEDULER_THREAD_CONTEXT* thctx;
 
     if (num_dedicated_threads) {
@@ -525,6 +560,7 @@ void mfxSchedulerCore::RegisterTaskDependencies(MFX_SCHEDULER_TASK  *pTask)
         m_pFreeTasks->curStatus = taskRes;
         m_pFreeTasks->opRes = taskRes;
         m_pFreeTasks->done.notify_all();
+        QueueDoneCallback(m_pFreeTasks, taskRes);
     }
 
 } // void mfxSchedulerCore::RegisterTaskDependencies(MFX_SCHEDULER_TASK  *pTask)
@@ -103,6 +103,22 @@ mfxStatus mfxSchedulerCore::Initialize2(const MFX_SCHEDULER_PARAM2 *pParam)
                 return MFX_ERR_UNKNOWN;
             }
 
+            if (MFX_SCHEDULER_SHARED_POOL == m_param.flags)
+            {
+                // the first session spawns the pool, others join it
+                mfxStatus mfxRes = mfxSchedulerPool::Acquire(m_param, &m_pSharedPool);
+                if (MFX_ERR_NONE != mfxRes)
+                {
+                    return mfxRes;
+                }
+
+                // tasks are split between threads of the pool
+                m_param.numberOfThreads = m_pSharedPool->GetNumThreads();
+                m_pSharedPool->Register(this);
+
+                return MFX_ERR_NONE;
+            }
+
             // allocate thread contexts
             m_pThreadCtx = new MFX_SCHEDULER_THREAD_CONTEXT[m_param.numberOfThreads];
 
@@ -654,6 +670,9 @@ mfxStatus mfxSchedulerCore::AddTask(const MFX_TASK &task, mfxSyncPoint *pSyncPoi
             WakeUpThreads(num_hw_threads, num_sw_threads);
         }
 
+        // the task might be aborted right away by a failed dependency
+        CallDoneCallbacks();
+
         // leave the protected section
     }
 
@@ -0,0 +1,345 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <mfx_scheduler_core_pool.h>
+#include <mfx_scheduler_core.h>
+
+#include <mfx_trace.h>
+#include <mfx_cpu_topology.h>
+#include <mfx_ext_buffers.h>
+#include <vm_sys_info.h>
+
+#include <algorithm>
+#include <functional>
+#include <stdio.h>
+
+// declare the static section of the file
+namespace
+{
+
+// share of the pool given to a session running tasks of the given priority
+const
+mfxU64 SessionWeight[MFX_PRIORITY_NUMBER] =
+{
+    // MFX_PRIORITY_LOW
+    1,
+    // MFX_PRIORITY_NORMAL
+    2,
+    // MFX_PRIORITY_HIGH
+    4
+};
+
+} // namespace
+
+std::mutex mfxSchedulerPool::m_instanceGuard;
+mfxSchedulerPool *mfxSchedulerPool::m_pInstance = nullptr;
+
+mfxStatus mfxSchedulerPool::Acquire(const MFX_SCHEDULER_PARAM2 &param, mfxSchedulerPool **ppPool)
+{
+    std::lock_guard<std::mutex> guard(m_instanceGuard);
+
+    if (nullptr == m_pInstance)
+    {
+        mfxSchedulerPool *pPool = nullptr;
+
+        try
+        {
+            pPool = new mfxSchedulerPool;
+        }
+        catch (...)
+        {
+            return MFX_ERR_MEMORY_ALLOC;
+        }
+
+        mfxStatus mfxRes = pPool->Start(param);
+        if (MFX_ERR_NONE != mfxRes)
+        {
+            delete pPool;
+            return mfxRes;
+        }
+
+        m_pInstance = pPool;
+    }
+    else if (false == m_pInstance->IsCompatible(param))
+    {
+        // the session would silently run on threads it didn't ask for
+        return MFX_ERR_INCOMPATIBLE_VIDEO_PARAM;
+    }
+
+    m_pInstance->m_refCounter += 1;
+    *ppPool = m_pInstance;
+
+    return MFX_ERR_NONE;
+
+} // mfxStatus mfxSchedulerPool::Acquire(const MFX_SCHEDULER_PARAM2 &param, mfxSchedulerPool **ppPool)
+
+void mfxSchedulerPool::Release(void)
+{
+    std::lock_guard<std::mutex> guard(m_instanceGuard);
+
+    m_refCounter -= 1;
+    if (0 == m_refCounter)
+    {
+        m_pInstance = nullptr;
+        delete this;
+    }
+
+} // void mfxSchedulerPool::Release(void)
+
+mfxSchedulerPool::mfxSchedulerPool(void)
+    : m_refCounter(0)
+    , m_threadsParam()
+    , m_affinityPolicy(MFX_THREADS_AFFINITY_NONE)
+    , m_affinityNode(0)
+    , m_virtualTime(0)
+    , m_wakeUpCounter(0)
+    , m_numWaiting(0)
+    , m_bQuit(false)
+{
+} // mfxSchedulerPool::mfxSchedulerPool(void)
+
+mfxSchedulerPool::~mfxSchedulerPool(void)
+{
+    Stop();
+
+} // mfxSchedulerPool::~mfxSchedulerPool(void)
+
+mfxStatus mfxSchedulerPool::Start(const MFX_SCHEDULER_PARAM2 &param)
+{
+    mfxU32 numThreads = param.numberOfThreads;
+
+    if (!numThreads)
+    {
+        numThreads = vm_sys_info_get_cpu_num();
+    }
+    // we need at least 2 threads to avoid dead locks
+    numThreads = std::max<mfxU32>(numThreads, 2);
+
+    m_threadsParam = param.params;
+    m_affinityPolicy = param.affinityPolicy;
+    m_affinityNode = param.affinityNode;
+
+    try
+    {
+        for (mfxU32 i = 0; i < numThreads; i += 1)
+        {
+            m_threads.emplace_back(std::bind(&mfxSchedulerPool::ThreadProc, this, i));
+
+#if !defined(_WIN32) && !defined(_WIN64)
+            if (param.params.SchedulingType || param.params.Priority)
+            {
+                struct sched_param schedParam{};
+
+                schedParam.sched_priority = param.params.Priority;
+                if (pthread_setschedparam(m_threads.back().native_handle(), param.params.SchedulingType, &schedParam))
+                {
+                    return MFX_ERR_UNSUPPORTED;
+                }
+            }
+#endif
+
+            // placement is a hint, threads keep running on any CPU on failure
+            if (MFX_THREADS_AFFINITY_NONE != param.affinityPolicy)
+            {
+                mfx::SetThreadAffinity(m_threads.back(),
+                    mfx::GetThreadCpus(param.affinityPolicy, param.affinityNode, i));
+            }
+        }
+    }
+    catch (...)
+    {
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    return MFX_ERR_NONE;
+
+} // mfxStatus mfxSchedulerPool::Start(const MFX_SCHEDULER_PARAM2 &param)
+
+bool mfxSchedulerPool::IsCompatible(const MFX_SCHEDULER_PARAM2 &param) const
+{
+    // sessions not asking for the number of threads get the pool's one
+    if (param.params.NumThread && param.params.NumThread != m_threads.size())
+    {
+        return false;
+    }
+
+    if (param.params.SchedulingType != m_threadsParam.SchedulingType ||
+        param.params.Priority != m_threadsParam.Priority)
+    {
+        return false;
+    }
+
+    if (param.affinityPolicy != m_affinityPolicy)
+    {
+        return false;
+    }
+
+    return MFX_THREADS_AFFINITY_NONE == m_affinityPolicy ||
+        param.affinityNode == m_affinityNode;
+
+} // bool mfxSchedulerPool::IsCompatible(const MFX_SCHEDULER_PARAM2 &param) const
+
+void mfxSchedulerPool::Stop(void)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        m_bQuit = true;
+        m_taskAdded.notify_all();
+    }
+
+    for (auto & thread : m_threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+    m_threads.clear();
+
+} // void mfxSchedulerPool::Stop(void)
+
+void mfxSchedulerPool::Register(mfxSchedulerCore *pScheduler)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    // a new session starts with the current virtual time,
+    // otherwise it would monopolize the pool until catching up others
+    m_entries.push_back(Entry{pScheduler, m_virtualTime, 0, false});
+
+} // void mfxSchedulerPool::Register(mfxSchedulerCore *pScheduler)
+
+void mfxSchedulerPool::Unregister(mfxSchedulerCore *pScheduler)
+{
+    std::unique_lock<std::mutex> guard(m_guard);
+
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+        [pScheduler](const Entry & entry) { return entry.pScheduler == pScheduler; });
+    if (m_entries.end() == it)
+    {
+        return;
+    }
+
+    // threads don't pick removed entries, wait for those already inside
+    it->bRemoved = true;
+    m_entryReleased.wait(guard, [&it] { return 0 == it->numUsers; });
+
+    m_entries.erase(it);
+
+} // void mfxSchedulerPool::Unregister(mfxSchedulerCore *pScheduler)
+
+void mfxSchedulerPool::WakeUpThreads(mfxU32 numThreads)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    m_wakeUpCounter += 1;
+
+    if (numThreads >= m_numWaiting)
+    {
+        m_taskAdded.notify_all();
+    }
+    else
+    {
+        for (mfxU32 i = 0; i < numThreads; i += 1)
+        {
+            m_taskAdded.notify_one();
+        }
+    }
+
+} // void mfxSchedulerPool::WakeUpThreads(mfxU32 numThreads)
+
+void mfxSchedulerPool::ThreadProc(mfxU32 threadNum)
+{
+    std::unique_lock<std::mutex> guard(m_guard);
+    std::vector<Entry *> entries;
+
+    {
+        char thread_name[30] = {};
+        snprintf(thread_name, sizeof(thread_name)-1, "ThreadName=MSDKPool#%d", threadNum);
+        MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_SCHED, thread_name);
+    }
+
+    // main working cycle for threads
+    while (false == m_bQuit)
+    {
+        const mfxU64 wakeUpCounter = m_wakeUpCounter;
+        bool bExecuted = false;
+
+        // visit the sessions starting from the least served one.
+        // entries are referenced until the end of the round,
+        // so they can't leave the list while the lock is released.
+        entries.clear();
+        for (auto & entry : m_entries)
+        {
+            if (!entry.bRemoved)
+            {
+                entry.numUsers += 1;
+                entries.push_back(&entry);
+            }
+        }
+        std::stable_sort(entries.begin(), entries.end(),
+            [](const Entry *a, const Entry *b) { return a->pass < b->pass; });
+
+        for (Entry *pEntry : entries)
+        {
+            mfxU64 timeSpent = 0;
+            int priority;
+
+            if (pEntry->bRemoved)
+            {
+                continue;
+            }
+
+            guard.unlock();
+            priority = pEntry->pScheduler->RunSharedTask(timeSpent);
+            guard.lock();
+
+            if (0 <= priority)
+            {
+                // charge the session for the time spent
+                m_virtualTime = std::max(m_virtualTime, pEntry->pass);
+                pEntry->pass = std::max(pEntry->pass, m_virtualTime) +
+                    (timeSpent + 1) * SessionWeight[MFX_PRIORITY_HIGH] / SessionWeight[std::min<int>(priority, MFX_PRIORITY_HIGH)];
+
+                bExecuted = true;
+                break;
+            }
+        }
+
+        for (Entry *pEntry : entries)
+        {
+            pEntry->numUsers -= 1;
+            if (pEntry->bRemoved && 0 == pEntry->numUsers)
+            {
+                m_entryReleased.notify_all();
+            }
+        }
+
+        if (false == bExecuted)
+        {
+            // there is no any task.
+            // sleep until new tasks are added to any of the schedulers.
+            m_numWaiting += 1;
+            m_taskAdded.wait(guard, [this, wakeUpCounter] {
+                return m_bQuit || (wakeUpCounter != m_wakeUpCounter);
+            });
+            m_numWaiting -= 1;
+        }
+    }
+
+} // void mfxSchedulerPool::ThreadProc(mfxU32 threadNum)
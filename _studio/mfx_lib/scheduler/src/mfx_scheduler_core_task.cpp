@@ -70,6 +70,7 @@ void MFX_SCHEDULER_TASK::OnDependencyResolved(mfxStatus result)
         // need to update dependency table for all tasks dependent from failed 
         m_pSchedulerCore->ResolveDependencyTable(this);
         done.notify_all();
+        m_pSchedulerCore->QueueDoneCallback(this, result);
 
         // release the current task resources
         ReleaseResources();
@@ -532,6 +532,7 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
             pTask->opRes = pTask->curStatus;
 
             pTask->done.notify_all();
+            QueueDoneCallback(pTask, pTask->curStatus);
 
             // update dependencies produced from the dependency table
             //for (i = 0; i < MFX_TASK_NUM_DEPENDENCIES; i += 1)
@@ -562,6 +563,7 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
             pTask->opRes = MFX_ERR_NONE;
 
             pTask->done.notify_all();
+            QueueDoneCallback(pTask, MFX_ERR_NONE);
 
             // remove dependencies produced from the dependency table
             for (i = 0; i < MFX_TASK_NUM_DEPENDENCIES; i += 1)
@@ -596,6 +598,9 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
         m_freeTasks.Signal(1);
     }
 
+    // notify the application about finished tasks
+    CallDoneCallbacks();
+
     // send tracing event
     if (nTraceTaskId)
     {
@@ -604,6 +609,47 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
 
 }
 
+void mfxSchedulerCore::QueueDoneCallback(MFX_SCHEDULER_TASK *pTask, mfxStatus res)
+{
+    MFX_TASK &task = pTask->param.task;
+
+    if (task.pDoneCallback)
+    {
+        m_doneCallbacks.push_back({task.pDoneCallback, task.pDoneState, task.pDoneParam, res});
+
+        // the job is notified once, even if its status changes later
+        task.pDoneCallback = nullptr;
+    }
+
+} // void mfxSchedulerCore::QueueDoneCallback(MFX_SCHEDULER_TASK *pTask, mfxStatus res)
+
+void mfxSchedulerCore::CallDoneCallbacks(void)
+{
+    std::vector<MFX_DONE_CALLBACK> callbacks;
+
+    // notifications may finish or add other tasks
+    while (!m_doneCallbacks.empty())
+    {
+        callbacks.swap(m_doneCallbacks);
+
+        m_guard.unlock();
+        for (const MFX_DONE_CALLBACK & callback : callbacks)
+        {
+            try
+            {
+                callback.pCallback(callback.pState, callback.pParam, callback.res);
+            }
+            catch (...)
+            {
+            }
+        }
+        m_guard.lock();
+
+        callbacks.clear();
+    }
+
+} // void mfxSchedulerCore::CallDoneCallbacks(void)
+
 // update dependencies produced from the dependency table
 void mfxSchedulerCore::ResolveDependencyTable(MFX_SCHEDULER_TASK *pTask)
 {
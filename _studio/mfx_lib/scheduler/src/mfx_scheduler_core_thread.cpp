@@ -112,6 +112,48 @@ void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
     }
 }
 
+int mfxSchedulerCore::RunSharedTask(mfxU64 &timeSpent)
+{
+    std::unique_lock<std::mutex> guard(m_guard);
+    MFX_CALL_INFO call = {};
+    mfxTaskHandle previousTaskHandle = {};
+
+    // a thread of the pool acts as the dedicated thread #0 of the scheduler
+    // while there is no other thread executing a dedicated task
+    const mfxU32 threadNum = (m_bDedicatedThreadBusy) ? (1) : (0);
+
+    if (MFX_ERR_NONE != GetTask(call, previousTaskHandle, threadNum))
+    {
+        return -1;
+    }
+
+    const bool bDedicated = (0 == threadNum) && (MFX_TASK_DEDICATED & call.pTask->threadingPolicy);
+    const int priority = call.pTask->priority;
+
+    m_bDedicatedThreadBusy |= bDedicated;
+
+    guard.unlock();
+    {
+        // perform asynchronous operation
+        call_pRoutine(call);
+    }
+    guard.lock();
+
+    // mark the task completed,
+    // set the sync point into the high state if any.
+    MarkTaskCompleted(&call, threadNum);
+
+    if (bDedicated)
+    {
+        m_bDedicatedThreadBusy = false;
+    }
+
+    timeSpent = call.timeSpend;
+
+    return priority;
+
+} // int mfxSchedulerCore::RunSharedTask(mfxU64 &timeSpent)
+
 void mfxSchedulerCore::WakeupThreadProc()
 {
     {
@@ -56,6 +56,10 @@ mfxStatus PackMfxFrameRate(mfxU32 nom, mfxU32 denom, mfxU32& packed); // fit u32
 mfxExtBuffer* GetExtendedBuffer(mfxExtBuffer** extBuf, mfxU32 numExtBuf, mfxU32 id);
 mfxExtBuffer* GetExtendedBufferInternal(mfxExtBuffer** extBuf, mfxU32 numExtBuf, mfxU32 id);
 
+struct MFX_TASK;
+// Make the task call mfxExtSurfaceCompletion attached to the output surface, if any
+void SetSurfaceCompletion(MFX_TASK &task, mfxFrameSurface1 *surface);
+
 class ExtendedBuffer
 {
 public:
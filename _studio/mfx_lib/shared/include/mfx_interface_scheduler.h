@@ -41,7 +41,9 @@ enum mfxSchedulerFlags
 {
     // default behaviour policy
     MFX_SCHEDULER_DEFAULT = 0,
-    MFX_SINGLE_THREAD = 1
+    MFX_SINGLE_THREAD = 1,
+    // run tasks on the process-wide pool of threads shared between sessions
+    MFX_SCHEDULER_SHARED_POOL = 2
 };
 
 enum mfxSchedulerMessage
@@ -127,6 +129,10 @@ struct MFX_SCHEDULER_PARAM2: public MFX_SCHEDULER_PARAM
 {
     // user-adjustable extended parameters
     mfxExtThreadsParam params;
+    // placement of threads, MFX_THREADS_AFFINITY_*
+    mfxU16 affinityPolicy;
+    // NUMA node for the node policies
+    mfxI32 affinityNode;
 };
 
 class MFXIScheduler2 : public MFXIScheduler
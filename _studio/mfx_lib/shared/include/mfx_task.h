@@ -81,6 +81,7 @@ typedef mfxStatus (*mfxTaskRoutine) (void *pState, void *pParam, mfxU32 threadNu
 typedef mfxStatus (*mfxTaskCompleteProc) (void *pState, void *pParam, mfxStatus taskRes);
 typedef mfxStatus (*mfxGetSubTaskProc) (void *pState, void *pParam, void **ppSubTask);
 typedef mfxStatus (*mfxCompleteSubTaskProc) (void *pState, void *pParam, void *pSubTask, mfxStatus taskRes);
+typedef void (*mfxTaskDoneCallback) (void *pState, void *pParam, mfxStatus taskRes);
 
 typedef
 struct MFX_ENTRY_POINT
@@ -134,6 +135,13 @@ struct MFX_TASK
 
     unsigned int nTaskId;
     unsigned int nParentId;
+
+    // optional notification called once the job of the task is finished
+    // or aborted. It is called outside of the scheduler's protected section,
+    // so it may add new tasks, but it delays other tasks while running.
+    mfxTaskDoneCallback pDoneCallback;
+    void *pDoneState;
+    void *pDoneParam;
 };
 
 #endif // __MFX_TASK_H
@@ -528,6 +528,8 @@ mfxStatus MFXVideoDECODE_DecodeFrameAsync(mfxSession session, mfxBitstream *bs,
             // fill dependencies
             task.pSrc[0] = *surface_out;
             task.pDst[0] = *surface_out;
+            // notify the application when the output surface is ready
+            SetSurfaceCompletion(task, *surface_out);
             // this is wa to remove external task dependency for HEVC SW decode plugin.
             // need only because SW HEVC decode is pseudo
 #if !defined(MFX_ONEVPL)
@@ -565,6 +567,16 @@ mfxStatus MFXVideoDECODE_DecodeFrameAsync(mfxSession session, mfxBitstream *bs,
         if (MFX_ERR_NONE == mfxRes || (mfxRes == MFX_WRN_VIDEO_PARAM_CHANGED && *surface_out != NULL))
         {
             *syncp = syncPoint;
+
+#if defined(MFX_ONEVPL)
+            // surfaces of the internal pool are returned with a reference
+            // owned by the application and can be synchronized on their own
+            if (mfxSurfacePool::GetPooledSurface(*surface_out))
+            {
+                mfxSurfacePool::SetSyncPoint(*surface_out, syncPoint);
+                (*surface_out)->FrameInterface->AddRef(*surface_out);
+            }
+#endif
         }
     }
     // handle error(s)
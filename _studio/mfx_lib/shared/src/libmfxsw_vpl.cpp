@@ -26,6 +26,9 @@
 
 #include <mfx_session.h>
 #include <mfx_trace.h>
+#include <mfx_ext_buffers.h>
+#include <mfx_surface_pool.h>
+#include <libmfx_core_interface.h>
 
 #include <map>
 #include <functional>
@@ -541,19 +544,80 @@ mfxStatus MFXReleaseImplDescription(mfxHDL hdl)
     return MFX_ERR_NONE;
 }
 
+static mfxStatus GetSurfaceFromPool(mfxSession session, mfxU16 component, const mfxFrameInfo &info, mfxFrameSurface1 **surface)
+{
+    mfxSurfacePoolSet *pPools = QueryCoreInterface<mfxSurfacePoolSet>(session->m_pCORE.get(), MFXICORE_SURFACE_POOLS_GUID);
+    MFX_CHECK(pPools, MFX_ERR_UNSUPPORTED);
+
+    // surfaces are placed on the node the session threads run on
+    mfxI32 *pNumaNode = QueryCoreInterface<mfxI32>(session->m_pCORE.get(), MFXICORE_NUMA_NODE_GUID);
+
+    return pPools->GetSurface(session, component, pNumaNode ? *pNumaNode : -1, info, surface);
+}
+
+// Internal pools hold system memory surfaces only, video memory surfaces
+// still come from the allocator set by the application
 mfxStatus MFXMemory_GetSurfaceForVPP(mfxSession session, mfxFrameSurface1** surface)
 {
-    return MFX_ERR_NOT_IMPLEMENTED;
+    MFX_CHECK(session, MFX_ERR_INVALID_HANDLE);
+    MFX_CHECK(session->m_pVPP.get(), MFX_ERR_NOT_INITIALIZED);
+    MFX_CHECK_NULL_PTR1(surface);
+
+    try
+    {
+        mfxVideoParam par = {};
+        mfxStatus mfxRes = session->m_pVPP->GetVideoParam(&par);
+        MFX_CHECK_STS(mfxRes);
+        MFX_CHECK(par.IOPattern & MFX_IOPATTERN_IN_SYSTEM_MEMORY, MFX_ERR_UNSUPPORTED);
+
+        return GetSurfaceFromPool(session, MFX_MEMTYPE_FROM_VPPIN, par.vpp.In, surface);
+    }
+    catch (...)
+    {
+        return MFX_ERR_UNKNOWN;
+    }
 }
 
 mfxStatus MFXMemory_GetSurfaceForEncode(mfxSession session, mfxFrameSurface1** surface)
 {
-    return MFX_ERR_NOT_IMPLEMENTED;
+    MFX_CHECK(session, MFX_ERR_INVALID_HANDLE);
+    MFX_CHECK(session->m_pENCODE.get(), MFX_ERR_NOT_INITIALIZED);
+    MFX_CHECK_NULL_PTR1(surface);
+
+    try
+    {
+        mfxVideoParam par = {};
+        mfxStatus mfxRes = session->m_pENCODE->GetVideoParam(&par);
+        MFX_CHECK_STS(mfxRes);
+        MFX_CHECK(par.IOPattern & MFX_IOPATTERN_IN_SYSTEM_MEMORY, MFX_ERR_UNSUPPORTED);
+
+        return GetSurfaceFromPool(session, MFX_MEMTYPE_FROM_ENCODE, par.mfx.FrameInfo, surface);
+    }
+    catch (...)
+    {
+        return MFX_ERR_UNKNOWN;
+    }
 }
 
 mfxStatus MFXMemory_GetSurfaceForDecode(mfxSession session, mfxFrameSurface1** surface)
 {
-    return MFX_ERR_NOT_IMPLEMENTED;
+    MFX_CHECK(session, MFX_ERR_INVALID_HANDLE);
+    MFX_CHECK(session->m_pDECODE.get(), MFX_ERR_NOT_INITIALIZED);
+    MFX_CHECK_NULL_PTR1(surface);
+
+    try
+    {
+        mfxVideoParam par = {};
+        mfxStatus mfxRes = session->m_pDECODE->GetVideoParam(&par);
+        MFX_CHECK_STS(mfxRes);
+        MFX_CHECK(par.IOPattern & MFX_IOPATTERN_OUT_SYSTEM_MEMORY, MFX_ERR_UNSUPPORTED);
+
+        return GetSurfaceFromPool(session, MFX_MEMTYPE_FROM_DECODE, par.mfx.FrameInfo, surface);
+    }
+    catch (...)
+    {
+        return MFX_ERR_UNKNOWN;
+    }
 }
 
 mfxStatus MFXInitExInternal(mfxInitParam par, mfxSession* session);
@@ -565,7 +629,25 @@ mfxStatus MFXInitialize(mfxInitializationParam parVPL, mfxSession *session)
     par.Version.Major = MFX_VERSION_MAJOR;
     par.Version.Minor = MFX_VERSION_MINOR;
     par.ExternalThreads = 0;
-   
+
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    // pass through the buffers understood by the session, others are ignored
+    mfxExtBuffer *extParam[2] = {};
+    for (mfxU16 i = 0; parVPL.ExtParam && i < parVPL.NumExtParam; i++)
+    {
+        if (parVPL.ExtParam[i] && par.NumExtParam < 2 &&
+            (parVPL.ExtParam[i]->BufferId == MFX_EXTBUFF_SHARED_THREAD_POOL ||
+             parVPL.ExtParam[i]->BufferId == MFX_EXTBUFF_THREADS_AFFINITY))
+        {
+            extParam[par.NumExtParam++] = parVPL.ExtParam[i];
+        }
+    }
+    if (par.NumExtParam)
+    {
+        par.ExtParam = extParam;
+    }
+#endif
+
     return MFXInitExInternal(par, session);
 }
 
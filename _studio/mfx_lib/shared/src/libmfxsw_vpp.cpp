@@ -23,11 +23,13 @@
 #include <mfx_session.h>
 #include <mfx_tools.h>
 #include <mfx_common.h>
+#include <mfx_common_int.h>
 #if !defined(MFX_ONEVPL)
 #include <mfx_user_plugin.h>
 #endif
 // sheduling and threading stuff
 #include <mfx_task.h>
+#include <mfx_surface_pool.h>
 
 #ifdef MFX_ENABLE_VPP
 // VPP include files here
@@ -346,6 +348,8 @@ mfxStatus MFXVideoVPP_RunFrameVPPAsync(mfxSession session, mfxFrameSurface1 *in,
 
                 if (MFX_ERR_MORE_DATA_SUBMIT_TASK == static_cast<int>(mfxRes))
                     task.pDst[0] = NULL;
+                // notify the application when the output surface is ready
+                SetSurfaceCompletion(task, (mfxFrameSurface1 *) task.pDst[0]);
 
 #ifdef MFX_TRACE_ENABLE
                 task.nParentId = MFX_AUTO_TRACE_GETID();
@@ -369,6 +373,8 @@ mfxStatus MFXVideoVPP_RunFrameVPPAsync(mfxSession session, mfxFrameSurface1 *in,
                 task.pDst[0] = out;
                 if (MFX_ERR_MORE_DATA_SUBMIT_TASK == static_cast<int>(mfxRes))
                     task.pDst[0] = NULL;
+                // notify the application when the output surface is ready
+                SetSurfaceCompletion(task, (mfxFrameSurface1 *) task.pDst[0]);
 
 
 #ifdef MFX_TRACE_ENABLE
@@ -414,6 +420,8 @@ mfxStatus MFXVideoVPP_RunFrameVPPAsync(mfxSession session, mfxFrameSurface1 *in,
                     task.pDst[0] = NULL;
                     task.pDst[1] = NULL;
                 }
+                // notify the application when the output surface is ready
+                SetSurfaceCompletion(task, (mfxFrameSurface1 *) task.pDst[0]);
 
 #ifdef MFX_TRACE_ENABLE
                 task.nParentId = MFX_AUTO_TRACE_GETID();
@@ -432,6 +440,14 @@ mfxStatus MFXVideoVPP_RunFrameVPPAsync(mfxSession session, mfxFrameSurface1 *in,
 
         // return pointer to synchronization point
         *syncp = syncPoint;
+
+#if defined(MFX_ONEVPL)
+        // pooled output surfaces can be synchronized on their own
+        if (syncPoint)
+        {
+            mfxSurfacePool::SetSyncPoint(out, syncPoint);
+        }
+#endif
 #ifdef MFX_ENABLE_USER_VPP
       }
 #endif
@@ -47,6 +47,14 @@ void MFXMediaDataAdapter::Load(mfxBitstream *pBitstream)
     }
     else
     {
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        // the last NAL unit is complete, it isn't held back till the next data
+        if (!(pBitstream->DataFlag & MFX_BITSTREAM_COMPLETE_FRAME) && (pBitstream->DataFlag & MFX_BITSTREAM_COMPLETE_SLICES))
+        {
+            SetFlags(UMC::MediaData::FLAG_VIDEO_DATA_COMPLETE_SLICES | UMC::MediaData::FLAG_VIDEO_DATA_NOT_FULL_FRAME);
+        }
+        else
+#endif
         if (!(pBitstream->DataFlag & MFX_BITSTREAM_COMPLETE_FRAME))
         {
             SetFlags(UMC::MediaData::FLAG_VIDEO_DATA_NOT_FULL_UNIT | UMC::MediaData::FLAG_VIDEO_DATA_NOT_FULL_FRAME);
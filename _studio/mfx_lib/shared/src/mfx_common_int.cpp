@@ -25,6 +25,7 @@
 #include "mfxfei.h"
 #endif
 #include "mfx_utils.h"
+#include "mfx_task.h"
 
 #include <stdexcept>
 #include <string>
@@ -55,6 +56,35 @@ mfxExtBuffer* GetExtendedBufferInternal(mfxExtBuffer** extBuf, mfxU32 numExtBuf,
     return result;
 }
 
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+static void MFXSurfaceCompletionRoutine(void *pState, void *pParam, mfxStatus taskRes)
+{
+    mfxExtSurfaceCompletion *pCompletion = (mfxExtSurfaceCompletion *) pState;
+
+    pCompletion->OnComplete(pCompletion->pthis, (mfxFrameSurface1 *) pParam, taskRes);
+}
+
+void SetSurfaceCompletion(MFX_TASK &task, mfxFrameSurface1 *surface)
+{
+    if (!surface)
+        return;
+
+    mfxExtSurfaceCompletion *pCompletion = (mfxExtSurfaceCompletion *)
+        GetExtendedBuffer(surface->Data.ExtParam, surface->Data.NumExtParam, MFX_EXTBUFF_SURFACE_COMPLETION);
+
+    if (pCompletion && pCompletion->OnComplete)
+    {
+        task.pDoneCallback = &MFXSurfaceCompletionRoutine;
+        task.pDoneState = pCompletion;
+        task.pDoneParam = surface;
+    }
+}
+#else
+void SetSurfaceCompletion(MFX_TASK &, mfxFrameSurface1 *)
+{
+}
+#endif
+
 mfxStatus CheckFrameInfoCommon(mfxFrameInfo  *info, mfxU32 /* codecId */)
 {
     if (!info)
@@ -27,6 +27,7 @@
 
 #include <libmfx_core_factory.h>
 #include <libmfx_core.h>
+#include <mfx_cpu_topology.h>
 
 #if defined(MFX_VA_LINUX)
 #include <libmfx_core_vaapi.h>
@@ -861,17 +862,46 @@ mfxStatus _mfxSession_1_10::InitEx(mfxInitParam& par)
             return MFX_ERR_INCOMPATIBLE_VIDEO_PARAM;
     }
 
-    // only mfxExtThreadsParam is allowed
+    // only mfxExtThreadsParam, mfxExtSharedThreadPool and mfxExtThreadsAffinity are allowed
+    mfxExtThreadsParam *pThreadsParam = nullptr;
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    mfxExtSharedThreadPool *pSharedPool = nullptr;
+    mfxExtThreadsAffinity *pAffinity = nullptr;
+#endif
     if (par.NumExtParam)
     {
-        if ((par.NumExtParam > 1) || !par.ExtParam)
+        if ((par.NumExtParam > 3) || !par.ExtParam)
         {
             return MFX_ERR_UNSUPPORTED;
         }
-        if ((par.ExtParam[0]->BufferId != MFX_EXTBUFF_THREADS_PARAM) ||
-            (par.ExtParam[0]->BufferSz != sizeof(mfxExtThreadsParam)))
+        for (mfxU16 i = 0; i < par.NumExtParam; i++)
         {
-            return MFX_ERR_UNSUPPORTED;
+            if (!par.ExtParam[i])
+            {
+                return MFX_ERR_UNSUPPORTED;
+            }
+            if ((par.ExtParam[i]->BufferId == MFX_EXTBUFF_THREADS_PARAM) &&
+                (par.ExtParam[i]->BufferSz == sizeof(mfxExtThreadsParam)) && !pThreadsParam)
+            {
+                pThreadsParam = (mfxExtThreadsParam*)par.ExtParam[i];
+            }
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+            else if ((par.ExtParam[i]->BufferId == MFX_EXTBUFF_SHARED_THREAD_POOL) &&
+                     (par.ExtParam[i]->BufferSz == sizeof(mfxExtSharedThreadPool)) && !pSharedPool)
+            {
+                pSharedPool = (mfxExtSharedThreadPool*)par.ExtParam[i];
+            }
+            else if ((par.ExtParam[i]->BufferId == MFX_EXTBUFF_THREADS_AFFINITY) &&
+                     (par.ExtParam[i]->BufferSz == sizeof(mfxExtThreadsAffinity)) && !pAffinity &&
+                     (((mfxExtThreadsAffinity*)par.ExtParam[i])->Policy <= MFX_THREADS_AFFINITY_DEVICE_NODE))
+            {
+                pAffinity = (mfxExtThreadsAffinity*)par.ExtParam[i];
+            }
+#endif
+            else
+            {
+                return MFX_ERR_UNSUPPORTED;
+            }
         }
     }
 
@@ -930,9 +960,30 @@ mfxStatus _mfxSession_1_10::InitEx(mfxInitParam& par)
         schedParam.flags = MFX_SCHEDULER_DEFAULT;
         schedParam.numberOfThreads = maxNumThreads;
         schedParam.pCore = m_pCORE.get();
-        if (par.NumExtParam) {
-            schedParam.params = *((mfxExtThreadsParam*)par.ExtParam[0]);
+        if (pThreadsParam) {
+            schedParam.params = *pThreadsParam;
         }
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        if (pSharedPool) {
+            schedParam.flags = MFX_SCHEDULER_SHARED_POOL;
+            if (pSharedPool->NumThread) {
+                schedParam.params.NumThread = pSharedPool->NumThread;
+            }
+        }
+        if (pAffinity) {
+            schedParam.affinityPolicy = pAffinity->Policy;
+            schedParam.affinityNode = (MFX_THREADS_AFFINITY_DEVICE_NODE == pAffinity->Policy)
+                ? mfx::GetRenderNodeNumaNode(m_adapterNum)
+                : pAffinity->Node;
+
+            // let system memory frames live next to the threads processing them
+            mfxI32 *pNumaNode = QueryCoreInterface<mfxI32>(m_pCORE.get(), MFXICORE_NUMA_NODE_GUID);
+            if (pNumaNode) {
+                *pNumaNode = mfx::GetPolicyNumaNode(schedParam.affinityPolicy, schedParam.affinityNode,
+                    schedParam.params.NumThread ? schedParam.params.NumThread : maxNumThreads);
+            }
+        }
+#endif
         mfxRes = pScheduler2->Initialize2(&schedParam);
 
         m_pScheduler->Release();
@@ -61,6 +61,8 @@ public:
     mfxWideBufferAllocator(void);
     ~mfxWideBufferAllocator(void);
     mfxBufferAllocator bufferAllocator;
+    // NUMA node buffers are first touched on, -1 - node of the calling thread
+    mfxI32 numaNode;
 };
 
 class mfxBaseWideFrameAllocator
@@ -27,6 +27,9 @@
 
 #include <va/va.h>
 
+#include <condition_variable>
+#include <mutex>
+
 #include "mfxvideo++int.h"
 #include "libmfx_allocator.h"
 
@@ -36,6 +39,18 @@ struct vaapiMemIdInt
     VASurfaceID* m_surface;
     VAImage      m_image;
     unsigned int m_fourcc;
+
+    // m_image is derived from the surface and kept between locks
+    bool         m_bDerived;
+    // CPU mapping of m_image kept after read-only locks, nullptr if unmapped
+    mfxU8*       m_pMapped;
+    mfxU32       m_locks;
+    // the mapping is dropped by the last unlock
+    bool         m_bUnmap;
+    // the derived image is dropped by the last unlock
+    bool         m_bFlush;
+    // a lock or an unlock maps or unmaps m_image outside the allocator guard
+    bool         m_bBusy;
 };
 
 // Internal Allocators 
@@ -50,6 +65,10 @@ namespace mfxDefaultAllocatorVAAPI
 
     mfxStatus SetFrameData(const VAImage &va_image, mfxU32 mfx_fourcc, mfxU8* p_buffer, mfxFrameData* ptr);
 
+    // Drops the CPU mapping and the derived image of the surface once it isn't locked.
+    // Called when the device gets the surface, the next lock sees what the device wrote.
+    mfxStatus FlushFrameHW(mfxHDL pthis, mfxMemId mid);
+
     class mfxWideHWFrameAllocator : public  mfxBaseWideFrameAllocator
     {
     public:
@@ -62,6 +81,11 @@ namespace mfxDefaultAllocatorVAAPI
 
         std::vector<VASurfaceID>   m_allocatedSurfaces;
         std::vector<vaapiMemIdInt> m_allocatedMids;
+
+        // protects the mapping state of m_allocatedMids, VA calls are made without it
+        std::mutex                 m_mappingGuard;
+        // signalled when a mid stops being busy
+        std::condition_variable    m_mappingDone;
     };
 
 } //  namespace mfxDefaultAllocatorVAAPI
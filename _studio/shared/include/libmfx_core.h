@@ -30,6 +30,7 @@
 #include "mfx_ext_buffers.h"
 #include "fast_copy.h"
 #include "libmfx_core_interface.h"
+#include "mfx_surface_pool.h"
 
 #include <memory>
 
@@ -276,6 +277,11 @@ protected:
 
 
     mfxU16      m_deviceId;
+
+#if defined(MFX_ONEVPL)
+    // surfaces given to the application by MFXMemory_GetSurfaceFor*
+    mfxSurfacePoolSet m_surfacePools;
+#endif
 private:
     // Forbid the assignment operator
     CommonCORE & operator = (const CommonCORE &);
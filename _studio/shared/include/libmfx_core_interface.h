@@ -111,6 +111,16 @@ static const MFX_GUID MFXICORE_GT_CONFIG_GUID =
 static const MFX_GUID MFXIFEIEnabled_GUID =
 { 0x7df28d19, 0x889a, 0x45c1,{ 0xaa, 0x5, 0xa4, 0xf7, 0xef, 0xae, 0x95, 0x28 } };
 
+// returns pointer to mfxI32 NUMA node system memory allocated by the core is placed on
+// {3C1B6E52-8F0D-4B7A-9E21-6A5D0C47F318}
+static const MFX_GUID MFXICORE_NUMA_NODE_GUID =
+{ 0x3c1b6e52, 0x8f0d, 0x4b7a,{ 0x9e, 0x21, 0x6a, 0x5d, 0x0c, 0x47, 0xf3, 0x18 } };
+
+// returns pointer to mfxSurfacePoolSet serving MFXMemory_GetSurfaceFor* calls
+// {8A4F2D71-5C36-4E0B-B1D9-27E6F0A3C58D}
+static const MFX_GUID MFXICORE_SURFACE_POOLS_GUID =
+{ 0x8a4f2d71, 0x5c36, 0x4e0b,{ 0xb1, 0xd9, 0x27, 0xe6, 0xf0, 0xa3, 0xc5, 0x8d } };
+
 // Try to obtain required interface
 // Declare a template to query an interface
 template <class T> inline
@@ -0,0 +1,80 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MFX_CPU_TOPOLOGY_H__
+#define __MFX_CPU_TOPOLOGY_H__
+
+#include "mfxdefs.h"
+
+#include <thread>
+#include <vector>
+
+namespace mfx
+{
+    // CPUs available to the process grouped by NUMA node, discovered once
+    // from sysfs and sched_getaffinity. Hosts without NUMA report one node.
+    struct CpuTopology
+    {
+        struct Node
+        {
+            mfxI32            id;
+            std::vector<int>  cpus;
+        };
+
+        std::vector<Node> nodes; // ordered by node id, empty nodes are skipped
+
+        mfxU32 GetNumCpus() const;
+        // index in nodes of the node with given id, -1 if the node has no available CPUs
+        mfxI32 FindNode(mfxI32 id) const;
+    };
+
+    const CpuTopology & GetCpuTopology();
+
+    // NUMA node of the DRM render node /dev/dri/renderD<128 + adapterNum>, -1 if unknown
+    mfxI32 GetRenderNodeNumaNode(mfxU32 adapterNum);
+
+    // CPUs the thread threadNum should run on according to MFX_THREADS_AFFINITY_* policy,
+    // empty set means no restriction
+    std::vector<int> GetThreadCpus(mfxU16 policy, mfxI32 node, mfxU32 threadNum);
+
+    // NUMA node numThreads threads of the policy run on, -1 if they are not confined to one node
+    mfxI32 GetPolicyNumaNode(mfxU16 policy, mfxI32 node, mfxU32 numThreads);
+
+    bool SetThreadAffinity(std::thread & thread, const std::vector<int> & cpus);
+
+    // Binds the calling thread to CPUs of the node for the lifetime of the object,
+    // memory first touched in the scope is allocated on this node
+    class NumaNodeScope
+    {
+    public:
+        explicit NumaNodeScope(mfxI32 node);
+        ~NumaNodeScope();
+
+    private:
+        NumaNodeScope(const NumaNodeScope &);
+        NumaNodeScope & operator = (const NumaNodeScope &);
+
+        bool               m_bound;
+        std::vector<char>  m_savedMask;
+    };
+
+} // namespace mfx
+
+#endif // __MFX_CPU_TOPOLOGY_H__
@@ -99,6 +99,18 @@ typedef struct {
 
 } mfxExtCodingOptionDDI;
 
+#if (MFX_VERSION < MFX_VERSION_NEXT)
+// placement policies are used by the scheduler regardless of API version,
+// with MFX_VERSION_NEXT they come with mfxExtThreadsAffinity
+enum {
+    MFX_THREADS_AFFINITY_NONE        = 0,
+    MFX_THREADS_AFFINITY_COMPACT     = 1,
+    MFX_THREADS_AFFINITY_SPREAD      = 2,
+    MFX_THREADS_AFFINITY_NODE        = 3,
+    MFX_THREADS_AFFINITY_DEVICE_NODE = 4
+};
+#endif
+
 
 
 
@@ -29,6 +29,10 @@
 #include <vector>
 #include <condition_variable>
 #include <mfxstructures.h>
+#include "mfx_mfe_policy.h"
+
+// signature of vaMFSubmit, replaceable to run the adapter without a driver
+typedef VAStatus (*MFESubmitFunc)(VADisplay dpy, VAMFContextID mf_context, VAContextID * contexts, int num_contexts);
 
 class MFEVAAPIEncoder
 {
@@ -91,6 +95,10 @@ public:
     virtual void AddRef();
     virtual void Release();
 
+    // statistics of the batches submitted so far
+    MFEBatchPolicy::Statistics GetStatistics();
+    void SetSubmitFunction(MFESubmitFunc submit);
+
 private:
 
     mfxStatus   reconfigureRestorationCounts(VAContextID newCtx);
@@ -135,6 +143,9 @@ private:
     std::map<VAContextID, StreamsIter_t> m_streamsMap;
     //minimal timeout of all streams
     long long m_minTimeToWait;
+    // decides on size and deadline of the batch being collected
+    MFEBatchPolicy m_policy;
+    MFESubmitFunc m_submit;
     // currently up-to-to 3 frames worth combining
     static const mfxU32 MAX_FRAMES_TO_COMBINE = 3;
 };
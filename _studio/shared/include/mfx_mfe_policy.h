@@ -0,0 +1,109 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef _MFX_MFE_POLICY_
+#define _MFX_MFE_POLICY_
+
+#include <mfxdefs.h>
+#include <map>
+
+// Decides when frames collected by the multi-frame encoder are submitted.
+// A batch is closed either when all streams expected to bring a frame
+// before the deadline did it, or when the deadline comes. The deadline is
+// the tightest latency budget of the collected frames minus the observed
+// cost of the submission, streams are expected by their observed frame
+// intervals. The policy knows nothing about VA, all times are in microseconds
+// and passed by the caller.
+class MFEBatchPolicy
+{
+public:
+    // sizes of batches above are counted in the last bucket
+    static const mfxU32 MAX_BATCH_HISTOGRAM = 16;
+
+    struct Statistics
+    {
+        mfxU64 numBatches;
+        mfxU64 numFrames;
+        // batches closed on collecting the expected number of frames
+        mfxU64 numFullBatches;
+        // batches closed on the deadline with less frames than expected
+        mfxU64 numDeadlineBatches;
+        // batches the driver refused or the caller failed to form
+        mfxU64 numFailedBatches;
+        // time from the first frame of a batch till its submission
+        mfxU64 totalWaitTime;
+        mfxU64 maxWaitTime;
+        // time spent inside the submission call
+        mfxU64 totalSubmitTime;
+        mfxU64 maxSubmitTime;
+        // number of batches of each size
+        mfxU64 batchSizes[MAX_BATCH_HISTOGRAM];
+    };
+
+    MFEBatchPolicy();
+
+    // latencyBudget is the frame interval the stream declared on joining
+    void AddStream(mfxU32 id, long long latencyBudget);
+    void RemoveStream(mfxU32 id);
+
+    // A frame of the stream came, timeToWait is the time the frame may wait
+    // for others. Skipped frames are not collected, but update the stream timing.
+    void OnFrame(mfxU32 id, long long now, long long timeToWait, bool skipped);
+
+    // Current batch is submitted or dropped, all collected frames leave it.
+    // submitTime is the time spent in the submission call.
+    void OnSubmit(mfxU32 numFrames, long long now, long long submitTime, bool failed);
+
+    // number of frames worth waiting for in the current batch
+    mfxU32 GetBatchSize() const { return m_batchSize; }
+    // time the current batch has to be submitted at
+    long long GetDeadline() const { return m_deadline; }
+    // expected duration of the submission call
+    long long GetSubmitCost() const { return m_submitCost; }
+
+    Statistics GetStatistics() const { return m_stats; }
+    void ResetStatistics();
+
+protected:
+    struct Stream
+    {
+        long long latencyBudget;
+        // time of the last frame, negative until the first one
+        long long lastArrival;
+        // smoothed interval between frames
+        long long interval;
+        bool      inBatch;
+    };
+
+    void UpdateBatchSize();
+
+    std::map<mfxU32, Stream> m_streams;
+
+    mfxU32    m_numCollected;
+    mfxU32    m_batchSize;
+    long long m_batchStart;
+    long long m_deadline;
+    long long m_submitCost;
+
+    Statistics m_stats;
+};
+
+#endif // _MFX_MFE_POLICY_
@@ -0,0 +1,156 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MFX_SURFACE_POOL_H__
+#define __MFX_SURFACE_POOL_H__
+
+#include "mfxvideo.h"
+
+#if defined(MFX_ONEVPL)
+
+#include "libmfx_allocator.h"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+
+class mfxSurfacePool;
+
+// Surface handed out by mfxSurfacePool. The application sees the surface
+// and its interface only, the rest is bookkeeping of the pool.
+struct mfxPooledSurface
+{
+    mfxPooledSurface(mfxSurfacePool *pool, mfxU16 type);
+
+    mfxFrameSurface1         surface;
+    mfxFrameSurfaceInterface frameInterface;
+    mfxSurfacePool          *pPool;
+
+    mfxWideSWFrameAllocator  allocator;
+    mfxFrameAllocResponse    response;
+
+    // goes to zero under the pool guard only, see mfxSurfacePool::ReleaseLast
+    std::atomic<mfxU32>      refCounter;
+
+    // fields below are protected by the pool guard
+    mfxU32                   generation;
+    mfxU32                   numReaders;
+    bool                     bWriter;
+    // sync point of the last operation writing to the surface
+    mfxSyncPoint             syncp;
+    // time the application released the surface, ms
+    mfxU64                   idleSince;
+};
+
+// System memory surfaces of one component type allocated on demand and
+// recycled after the application and the component stopped using them.
+// Surfaces idle for a while are freed, so the pool follows the actual
+// working set instead of the peak one.
+class mfxSurfacePool
+{
+public:
+    // type is MFX_MEMTYPE_FROM_* flag of the component
+    mfxSurfacePool(mfxSession session, mfxU16 type, mfxI32 numaNode);
+
+    // the pool lives until the owner and all allocated surfaces release it
+    void AddRef(void);
+    void Release(void);
+
+    // Called by the owner on closing of the session, surfaces being used
+    // by the application are freed on their last release
+    void Detach(void);
+
+    // Get a free surface with reference counter set to 1,
+    // grows the pool if all surfaces are in use
+    mfxStatus GetSurface(const mfxFrameInfo &info, mfxFrameSurface1 **ppSurface);
+
+    // returns the bookkeeping of the surface or NULL if the surface doesn't belong to any pool
+    static
+    mfxPooledSurface *GetPooledSurface(mfxFrameSurface1 *surface);
+
+    // Remember the operation producing the surface, (*Synchronize) waits for it
+    static
+    void SetSyncPoint(mfxFrameSurface1 *surface, mfxSyncPoint syncp);
+
+protected:
+    ~mfxSurfacePool(void);
+
+    mfxStatus Allocate(const mfxFrameInfo &info, mfxPooledSurface **ppItem);
+    // Free the surface, returns the number of pool references to drop
+    mfxU32 Free(std::list<mfxPooledSurface *>::iterator it);
+    // Free surfaces which nobody used for longer than maxIdleTime,
+    // returns the number of pool references to drop
+    mfxU32 Trim(mfxU64 maxIdleTime);
+    // Drop the reference which may be the last one, the surface becomes
+    // idle or is freed if it is not reused any more
+    mfxStatus ReleaseLast(mfxPooledSurface *pItem);
+    mfxStatus Synchronize(mfxPooledSurface *pItem, mfxU32 wait);
+
+    // mfxFrameSurfaceInterface implementation
+    static mfxStatus MFX_CDECL SurfaceAddRef(mfxFrameSurface1 *surface);
+    static mfxStatus MFX_CDECL SurfaceRelease(mfxFrameSurface1 *surface);
+    static mfxStatus MFX_CDECL SurfaceGetRefCounter(mfxFrameSurface1 *surface, mfxU32 *counter);
+    static mfxStatus MFX_CDECL SurfaceMap(mfxFrameSurface1 *surface, mfxU32 flags);
+    static mfxStatus MFX_CDECL SurfaceUnmap(mfxFrameSurface1 *surface);
+    static mfxStatus MFX_CDECL SurfaceGetNativeHandle(mfxFrameSurface1 *surface, mfxHDL *resource, mfxResourceType *resource_type);
+    static mfxStatus MFX_CDECL SurfaceGetDeviceHandle(mfxFrameSurface1 *surface, mfxHDL *device_handle, mfxHandleType *device_type);
+    static mfxStatus MFX_CDECL SurfaceSynchronize(mfxFrameSurface1 *surface, mfxU32 wait);
+
+    std::atomic<mfxU32> m_refCounter;
+
+    std::mutex m_guard;
+    mfxSession m_session;
+    const mfxU16 m_type;
+    const mfxI32 m_numaNode;
+
+    std::list<mfxPooledSurface *> m_surfaces;
+    // parameters of the surfaces being allocated,
+    // surfaces of older generations are freed on their release
+    mfxFrameInfo m_info;
+    mfxU32 m_generation;
+
+private:
+    mfxSurfacePool(const mfxSurfacePool &);
+    mfxSurfacePool & operator = (const mfxSurfacePool &);
+};
+
+// Surface pools of the session components, owned by the core
+class mfxSurfacePoolSet
+{
+public:
+    mfxSurfacePoolSet(void);
+    ~mfxSurfacePoolSet(void);
+
+    // component is MFX_MEMTYPE_FROM_DECODE, MFX_MEMTYPE_FROM_VPPIN or MFX_MEMTYPE_FROM_ENCODE
+    mfxStatus GetSurface(mfxSession session, mfxU16 component, mfxI32 numaNode,
+                         const mfxFrameInfo &info, mfxFrameSurface1 **ppSurface);
+
+protected:
+    std::mutex m_guard;
+    mfxSurfacePool *m_pPools[3];
+
+private:
+    mfxSurfacePoolSet(const mfxSurfacePoolSet &);
+    mfxSurfacePoolSet & operator = (const mfxSurfacePoolSet &);
+};
+
+#endif // defined(MFX_ONEVPL)
+
+#endif // __MFX_SURFACE_POOL_H__
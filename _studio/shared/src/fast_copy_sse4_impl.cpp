@@ -29,12 +29,13 @@ void copyVideoToSys_SSE4(const mfxU8* src, mfxU8* dst, int width)
 {
     static const int item_size = 4*sizeof(__m128i);
 
-    int align16 = (0x10 - (reinterpret_cast<size_t>(src) & 0xf)) & 0xf;
+    // a row shorter than the way to the aligned address is copied whole by the prologue
+    int align16 = std::min((0x10 - (int)(reinterpret_cast<size_t>(src) & 0xf)) & 0xf, width);
     for (int i = 0; i < align16; i++)
         *dst++ = *src++;
 
     int w = width - align16;
-    if (w < 0)
+    if (w <= 0)
         return;
 
     int width4 = w & (-item_size);
@@ -24,6 +24,7 @@
 
 #include "mfx_utils.h"
 #include "mfx_common.h"
+#include "mfx_cpu_topology.h"
 
 #define ALIGN32(X) (((mfxU32)((X)+31)) & (~ (mfxU32)31))
 #define ID_BUFFER MFX_MAKEFOURCC('B','U','F','F')
@@ -46,7 +47,11 @@ mfxStatus mfxDefaultAllocator::AllocBuffer(mfxHDL pthis, mfxU32 nbytes, mfxU16 t
     if (!buffer_ptr)
         return MFX_ERR_MEMORY_ALLOC;
 
-    memset(buffer_ptr, 0, header_size + nbytes);
+    {
+        // pages are placed on the node of the thread touching them first
+        mfx::NumaNodeScope numaScope(((mfxWideBufferAllocator*)pthis)->numaNode);
+        memset(buffer_ptr, 0, header_size + nbytes);
+    }
 
     BufferStruct *bs=(BufferStruct *)buffer_ptr;
     bs->allocator = pthis;
@@ -512,6 +517,7 @@ mfxWideBufferAllocator::mfxWideBufferAllocator()
     bufferAllocator.Free = &mfxDefaultAllocator::FreeBuffer;
 
     bufferAllocator.pthis = 0;
+    numaNode = -1;
 }
 
 mfxWideBufferAllocator::~mfxWideBufferAllocator()
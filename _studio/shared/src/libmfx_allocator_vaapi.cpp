@@ -242,6 +242,80 @@ static inline bool isFourCCSupported(unsigned int va_fourcc)
     }
 }
 
+// Unmaps the image derived from the surface, with bDestroy the image is destroyed too
+static mfxStatus ReleaseImage(VADisplay* va_disp, vaapiMemIdInt *vaapi_mid, bool bDestroy)
+{
+    VAStatus va_res = VA_STATUS_SUCCESS;
+
+    /* Explicit check on invalid buffer id before unMap
+       Underlying vaapi-bypass return error for invalid buffer id*/
+    if (vaapi_mid->m_pMapped && vaapi_mid->m_image.buf != 0)
+    {
+        MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_EXTCALL, "vaUnmapBuffer");
+        va_res = vaUnmapBuffer(va_disp, vaapi_mid->m_image.buf);
+    }
+    vaapi_mid->m_pMapped = nullptr;
+    vaapi_mid->m_bUnmap  = false;
+    MFX_CHECK(va_res == VA_STATUS_SUCCESS, MFX_ERR_DEVICE_FAILED);
+
+    if (bDestroy && vaapi_mid->m_bDerived)
+    {
+        va_res = vaDestroyImage(va_disp, vaapi_mid->m_image.image_id);
+        vaapi_mid->m_bDerived = false;
+        vaapi_mid->m_bFlush   = false;
+        MFX_CHECK(va_res == VA_STATUS_SUCCESS, MFX_ERR_DEVICE_FAILED);
+    }
+
+    return MFX_ERR_NONE;
+}
+
+// Takes the mapping, and with bDestroy the derived image, off the mid while the allocator guard is held.
+// The returned copy is passed to ReleaseImage after the guard is unlocked.
+static vaapiMemIdInt DetachImage(vaapiMemIdInt *vaapi_mid, bool bDestroy)
+{
+    vaapiMemIdInt detached = *vaapi_mid;
+    detached.m_bDerived = bDestroy && vaapi_mid->m_bDerived;
+
+    vaapi_mid->m_pMapped = nullptr;
+    vaapi_mid->m_bUnmap  = false;
+    if (bDestroy)
+    {
+        vaapi_mid->m_bDerived = false;
+        vaapi_mid->m_bFlush   = false;
+    }
+
+    return detached;
+}
+
+// Unmaps the image of an unlocked mid, or destroys it if flushed. The guard is held on entry and exit,
+// the VA calls are made without it while the mid is busy.
+static mfxStatus ReleaseUnlocked(mfxDefaultAllocatorVAAPI::mfxWideHWFrameAllocator *self, vaapiMemIdInt *vaapi_mid,
+                                 std::unique_lock<std::mutex> &guard)
+{
+    // lock holders and a release in progress keep the image, the last of them releases it
+    while (!vaapi_mid->m_locks && !vaapi_mid->m_bBusy)
+    {
+        bool bDestroy = vaapi_mid->m_bFlush && vaapi_mid->m_bDerived;
+        bool bUnmap   = vaapi_mid->m_pMapped && (vaapi_mid->m_bUnmap || bDestroy);
+        if (!bUnmap && !bDestroy)
+            break;
+
+        vaapiMemIdInt detached = DetachImage(vaapi_mid, bDestroy);
+        vaapi_mid->m_bBusy = true;
+        guard.unlock();
+
+        mfxStatus mfx_res = ReleaseImage(self->m_pVADisplay, &detached, bDestroy);
+
+        // a flush arrived meanwhile is handled by the next iteration
+        guard.lock();
+        vaapi_mid->m_bBusy = false;
+        self->m_mappingDone.notify_all();
+        MFX_CHECK_STS(mfx_res);
+    }
+
+    return MFX_ERR_NONE;
+}
+
 static mfxStatus ReallocImpl(VADisplay* va_disp, vaapiMemIdInt *vaapi_mid, mfxFrameSurface1 *surf)
 {
     MFX_CHECK_NULL_PTR3(va_disp, vaapi_mid, surf);
@@ -254,6 +328,10 @@ static mfxStatus ReallocImpl(VADisplay* va_disp, vaapiMemIdInt *vaapi_mid, mfxFr
 
     MFX_CHECK(isFourCCSupported(va_fourcc), MFX_ERR_UNSUPPORTED);
 
+    MFX_CHECK(!vaapi_mid->m_locks && !vaapi_mid->m_bBusy, MFX_ERR_LOCK_MEMORY);
+    mfxStatus mfx_res = ReleaseImage(va_disp, vaapi_mid, true);
+    MFX_CHECK_STS(mfx_res);
+
     VAStatus va_res = VA_STATUS_SUCCESS;
     if (MFX_FOURCC_P8 == vaapi_mid->m_fourcc)
     {
@@ -298,6 +376,7 @@ mfxStatus mfxDefaultAllocatorVAAPI::ReallocFrameHW(mfxHDL pthis, mfxFrameSurface
 
     MFX_CHECK(it != std::end(self->m_frameHandles), MFX_ERR_MEMORY_ALLOC);
 
+    std::lock_guard<std::mutex> guard(self->m_mappingGuard);
     return ReallocImpl(self->m_pVADisplay, reinterpret_cast<vaapiMemIdInt *>(*it), surf);
 }
 
@@ -453,6 +532,15 @@ mfxStatus mfxDefaultAllocatorVAAPI::FreeFramesHW(
         // Make sure that we are asked to clean memory which was allocated by current allocator
         MFX_CHECK(self->m_allocatedSurfaces.data() == vaapi_mids->m_surface, MFX_ERR_UNDEFINED_BEHAVIOR);
 
+        {
+            std::lock_guard<std::mutex> guard(self->m_mappingGuard);
+            for (vaapiMemIdInt& mid : self->m_allocatedMids)
+            {
+                mfxStatus sts = ReleaseImage(self->m_pVADisplay, &mid, true);
+                std::ignore = MFX_STS_TRACE(sts);
+            }
+        }
+
         if (ConvertVP8FourccToMfxFourcc(vaapi_mids->m_fourcc) == MFX_FOURCC_P8)
         {
             for (VABufferID& coded_buf : self->m_allocatedSurfaces)
@@ -767,23 +855,71 @@ mfxDefaultAllocatorVAAPI::LockFrameHW(
     }
     else
     {
-        va_res = vaDeriveImage(self->m_pVADisplay, *(vaapi_mids->m_surface), &(vaapi_mids->m_image));
-        MFX_CHECK(va_res == VA_STATUS_SUCCESS, MFX_ERR_DEVICE_FAILED);
+        std::unique_lock<std::mutex> guard(self->m_mappingGuard);
+
+        // another lock maps the image or an unlock unmaps it, the VA calls on an image aren't overlapped
+        self->m_mappingDone.wait(guard, [vaapi_mids] { return !vaapi_mids->m_bBusy; });
+
+        // counted before the VA calls, a flush meanwhile leaves the image to the last unlock
+        ++vaapi_mids->m_locks;
+
+        // data written by CPU reaches the surface on unmap
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        if (!(ptr->LockFlag & MFX_FRAMELOCK_READ_ONLY))
+#endif
+            vaapi_mids->m_bUnmap = true;
 
-        mfxU8* p_buffer = nullptr;
+        VAImage image    = vaapi_mids->m_image;
+        mfxU8*  p_buffer = vaapi_mids->m_pMapped;
+        bool    bDerived = vaapi_mids->m_bDerived;
+
+        if (p_buffer)
         {
-            MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_EXTCALL, "vaMapBuffer");
-            va_res = vaMapBuffer(self->m_pVADisplay, vaapi_mids->m_image.buf, (void **) &p_buffer);
-            MFX_CHECK(va_res == VA_STATUS_SUCCESS, MFX_ERR_DEVICE_FAILED);
-        }
+            guard.unlock();
 
-        mfxStatus mfx_res = SetFrameData(vaapi_mids->m_image, mfx_fourcc, p_buffer, ptr);
-        if (mfx_res != MFX_ERR_NONE)
+            // vaMapBuffer waits for the device, a mapping kept from a previous lock doesn't
+            MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_EXTCALL, "vaSyncSurface");
+            va_res = vaSyncSurface(self->m_pVADisplay, *(vaapi_mids->m_surface));
+        }
+        else
         {
-            vaUnmapBuffer(self->m_pVADisplay, vaapi_mids->m_image.buf);
-            vaDestroyImage(self->m_pVADisplay, vaapi_mids->m_image.image_id);
+            // The image derived by the first lock is kept until the device gets the surface,
+            // its mapping is kept after read-only locks too
+            vaapi_mids->m_bBusy = true;
+            guard.unlock();
 
+            if (!bDerived)
+                va_res = vaDeriveImage(self->m_pVADisplay, *(vaapi_mids->m_surface), &image);
+
+            if (va_res == VA_STATUS_SUCCESS)
+            {
+                {
+                    MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_EXTCALL, "vaMapBuffer");
+                    va_res = vaMapBuffer(self->m_pVADisplay, image.buf, (void **) &p_buffer);
+                }
+                if (va_res != VA_STATUS_SUCCESS && !bDerived)
+                    vaDestroyImage(self->m_pVADisplay, image.image_id);
+            }
+
+            guard.lock();
+            if (va_res == VA_STATUS_SUCCESS)
+            {
+                vaapi_mids->m_image    = image;
+                vaapi_mids->m_bDerived = true;
+                vaapi_mids->m_pMapped  = p_buffer;
+            }
+            vaapi_mids->m_bBusy = false;
+            self->m_mappingDone.notify_all();
+            guard.unlock();
         }
+
+        mfxStatus mfx_res = (va_res == VA_STATUS_SUCCESS) ? MFX_ERR_NONE : MFX_ERR_DEVICE_FAILED;
+        if (mfx_res == MFX_ERR_NONE)
+            mfx_res = SetFrameData(image, mfx_fourcc, p_buffer, ptr);
+
+        // drops the lock counted above
+        if (mfx_res != MFX_ERR_NONE)
+            std::ignore = MFX_STS_TRACE(UnlockFrameHW(pthis, mid));
         MFX_CHECK_STS(mfx_res);
     }
 
@@ -814,16 +950,13 @@ mfxStatus mfxDefaultAllocatorVAAPI::UnlockFrameHW(
     }
     else  // Image processing
     {
-	/* Explicit check on invalid buffer id before unMap 
-	   Underlying vaapi-bypass return error for invalid buffer id*/
-	if(vaapi_mids->m_image.buf != 0)
-        {
-            MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_EXTCALL, "vaUnmapBuffer");
-            va_res = vaUnmapBuffer(self->m_pVADisplay, vaapi_mids->m_image.buf);
-            MFX_CHECK(va_res == VA_STATUS_SUCCESS, MFX_ERR_DEVICE_FAILED);
-        }
-        va_res = vaDestroyImage(self->m_pVADisplay, vaapi_mids->m_image.image_id);
-        MFX_CHECK(va_res == VA_STATUS_SUCCESS, MFX_ERR_DEVICE_FAILED);
+        std::unique_lock<std::mutex> guard(self->m_mappingGuard);
+
+        if (vaapi_mids->m_locks)
+            --vaapi_mids->m_locks;
+
+        mfxStatus mfx_res = ReleaseUnlocked(self, vaapi_mids, guard);
+        MFX_CHECK_STS(mfx_res);
 
         if (ptr)
         {
@@ -838,6 +971,27 @@ mfxStatus mfxDefaultAllocatorVAAPI::UnlockFrameHW(
     return MFX_ERR_NONE;
 }
 
+mfxStatus mfxDefaultAllocatorVAAPI::FlushFrameHW(
+    mfxHDL         pthis,
+    mfxMemId       mid)
+{
+    MFX_CHECK(pthis, MFX_ERR_INVALID_HANDLE);
+    MFX_CHECK(mid,   MFX_ERR_INVALID_HANDLE);
+
+    auto vaapi_mids = reinterpret_cast<vaapiMemIdInt*>(mid);
+    auto self       = reinterpret_cast<mfxWideHWFrameAllocator*>(pthis);
+
+    std::unique_lock<std::mutex> guard(self->m_mappingGuard);
+
+    // a lock in progress may be deriving the image yet
+    if (!vaapi_mids->m_bDerived && !vaapi_mids->m_locks)
+        return MFX_ERR_NONE;
+
+    vaapi_mids->m_bFlush = true;
+
+    return ReleaseUnlocked(self, vaapi_mids, guard);
+}
+
 mfxStatus
 mfxDefaultAllocatorVAAPI::GetHDLHW(
     mfxHDL    pthis,
@@ -850,6 +1004,10 @@ mfxDefaultAllocatorVAAPI::GetHDLHW(
     auto vaapi_mids = reinterpret_cast<vaapiMemIdInt*>(mid);
     MFX_CHECK(vaapi_mids->m_surface, MFX_ERR_INVALID_HANDLE);
 
+    // the device is going to access the surface, CPU mappings kept by locks are stale after it
+    mfxStatus mfx_res = FlushFrameHW(pthis, mid);
+    MFX_CHECK_STS(mfx_res);
+
     *handle = vaapi_mids->m_surface; //VASurfaceID* <-> mfxHDL
     return MFX_ERR_NONE;
 }
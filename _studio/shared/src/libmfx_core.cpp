@@ -1046,6 +1046,11 @@ mfxStatus CommonCORE::DoFastCopyWrapper(mfxFrameSurface1 *pDst, mfxU16 dstMemTyp
     memset(&srcTempSurface, 0, sizeof(mfxFrameSurface1));
     memset(&dstTempSurface, 0, sizeof(mfxFrameSurface1));
 
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    // the source is only read, the allocator may keep its mapping
+    srcTempSurface.Data.LockFlag = MFX_FRAMELOCK_READ_ONLY;
+#endif
+
     // save original mem ids
     srcMemId = pSrc->Data.MemId;
     dstMemId = pDst->Data.MemId;
@@ -1581,8 +1586,16 @@ mfxStatus CommonCORE::DoFastCopyExtended(mfxFrameSurface1 *pDst, mfxFrameSurface
 
     if (NULL != pSrc->Data.MemId)
     {
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        // the source is only read, the flag is taken by the lock and restored for the caller
+        mfxU16 lockFlag = pSrc->Data.LockFlag;
+        pSrc->Data.LockFlag = MFX_FRAMELOCK_READ_ONLY;
+#endif
         // lock external frame
         sts = LockExternalFrame(pSrc->Data.MemId, &pSrc->Data);
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        pSrc->Data.LockFlag = lockFlag;
+#endif
         MFX_CHECK_STS(sts);
         isSrcLocked = true;
         copyFlag = COPY_VIDEO_TO_SYS;
@@ -1849,6 +1862,18 @@ void* CommonCORE::QueryCoreInterface(const MFX_GUID &guid)
         return &m_API_1_19;
     }
 
+    if (MFXICORE_NUMA_NODE_GUID == guid)
+    {
+        return &m_bufferAllocator.numaNode;
+    }
+
+#if defined(MFX_ONEVPL)
+    if (MFXICORE_SURFACE_POOLS_GUID == guid)
+    {
+        return &m_surfacePools;
+    }
+#endif
+
     return NULL;
 }
 
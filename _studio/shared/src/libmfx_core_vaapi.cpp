@@ -984,6 +984,11 @@ VAAPIVideoCORE::DoFastCopyWrapper(
     memset(&srcTempSurface, 0, sizeof(mfxFrameSurface1));
     memset(&dstTempSurface, 0, sizeof(mfxFrameSurface1));
 
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    // the source is only read, the allocator may keep its mapping
+    srcTempSurface.Data.LockFlag = MFX_FRAMELOCK_READ_ONLY;
+#endif
+
     // save original mem ids
     srcMemId = pSrc->Data.MemId;
     dstMemId = pDst->Data.MemId;
@@ -1567,6 +1572,16 @@ void* VAAPIVideoCORE::QueryCoreInterface(const MFX_GUID &guid)
     {
         return &m_bHEVCFEIEnabled;
     }
+    else if (MFXICORE_NUMA_NODE_GUID == guid)
+    {
+        return &m_bufferAllocator.numaNode;
+    }
+#if defined(MFX_ONEVPL)
+    else if (MFXICORE_SURFACE_POOLS_GUID == guid)
+    {
+        return &m_surfacePools;
+    }
+#endif
     else
     {
         return NULL;
@@ -0,0 +1,326 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_cpu_topology.h"
+#include "mfxstructures.h"
+#include "mfx_ext_buffers.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace mfx
+{
+
+#if !defined(_WIN32) && !defined(_WIN64)
+
+namespace
+{
+    // parses cpulist format of sysfs, i.e. "0-3,8,10-11"
+    bool ReadCpuList(const char *path, std::vector<int> & cpus)
+    {
+        FILE *file = fopen(path, "r");
+        if (!file)
+            return false;
+
+        char buf[4096] = {};
+        bool ok = (NULL != fgets(buf, sizeof(buf), file));
+        fclose(file);
+
+        for (char *p = buf; ok && *p && *p != '\n'; )
+        {
+            char *end = NULL;
+            long first = strtol(p, &end, 10);
+            long last = first;
+
+            if (end == p)
+                return false;
+            if (*end == '-')
+            {
+                p = end + 1;
+                last = strtol(p, &end, 10);
+                if (end == p || last < first)
+                    return false;
+            }
+            for (long cpu = first; cpu <= last; ++cpu)
+                cpus.push_back((int)cpu);
+
+            p = (*end == ',') ? end + 1 : end;
+        }
+
+        return ok;
+    }
+
+    mfxI32 ReadInt(const char *path, mfxI32 defaultValue)
+    {
+        FILE *file = fopen(path, "r");
+        if (!file)
+            return defaultValue;
+
+        int value = defaultValue;
+        if (1 != fscanf(file, "%d", &value))
+            value = defaultValue;
+        fclose(file);
+
+        return value;
+    }
+
+    CpuTopology DiscoverTopology()
+    {
+        CpuTopology topology;
+        cpu_set_t allowed;
+
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed))
+        {
+            return topology;
+        }
+
+        std::vector<mfxI32> ids;
+        if (DIR *dir = opendir("/sys/devices/system/node"))
+        {
+            while (struct dirent *entry = readdir(dir))
+            {
+                int id = 0;
+                char tail = 0;
+                if (1 == sscanf(entry->d_name, "node%d%c", &id, &tail))
+                    ids.push_back(id);
+            }
+            closedir(dir);
+        }
+        std::sort(ids.begin(), ids.end());
+
+        for (mfxI32 id : ids)
+        {
+            char path[64] = {};
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", id);
+
+            CpuTopology::Node node = { id, {} };
+            std::vector<int> cpus;
+            if (!ReadCpuList(path, cpus))
+                continue;
+
+            for (int cpu : cpus)
+            {
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+                    node.cpus.push_back(cpu);
+            }
+            if (!node.cpus.empty())
+                topology.nodes.push_back(node);
+        }
+
+        // no NUMA support in the kernel, all CPUs belong to the node 0
+        if (topology.nodes.empty())
+        {
+            CpuTopology::Node node = { 0, {} };
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &allowed))
+                    node.cpus.push_back(cpu);
+            }
+            if (!node.cpus.empty())
+                topology.nodes.push_back(node);
+        }
+
+        return topology;
+    }
+
+    bool FillCpuSet(const std::vector<int> & cpus, cpu_set_t & set)
+    {
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+        {
+            if (cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+        }
+        return CPU_COUNT(&set) != 0;
+    }
+} // namespace
+
+const CpuTopology & GetCpuTopology()
+{
+    static const CpuTopology topology = DiscoverTopology();
+    return topology;
+}
+
+mfxI32 GetRenderNodeNumaNode(mfxU32 adapterNum)
+{
+    char path[64] = {};
+    snprintf(path, sizeof(path), "/sys/class/drm/renderD%u/device/numa_node", 128 + adapterNum);
+
+    return ReadInt(path, -1);
+}
+
+bool SetThreadAffinity(std::thread & thread, const std::vector<int> & cpus)
+{
+    cpu_set_t set;
+
+    if (cpus.empty() || !thread.joinable())
+        return true;
+    if (!FillCpuSet(cpus, set))
+        return false;
+
+    return !pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+}
+
+NumaNodeScope::NumaNodeScope(mfxI32 node)
+    : m_bound(false)
+    , m_savedMask(sizeof(cpu_set_t))
+{
+    const CpuTopology & topology = GetCpuTopology();
+    mfxI32 idx = (node < 0) ? -1 : topology.FindNode(node);
+    cpu_set_t set;
+
+    // binding makes sense only if there is somewhere to move from
+    if (idx < 0 || topology.nodes.size() < 2)
+        return;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), (cpu_set_t *)m_savedMask.data()))
+        return;
+    if (!FillCpuSet(topology.nodes[idx].cpus, set))
+        return;
+
+    m_bound = !pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+NumaNodeScope::~NumaNodeScope()
+{
+    if (m_bound)
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), (cpu_set_t *)m_savedMask.data());
+}
+
+#else // !defined(_WIN32) && !defined(_WIN64)
+
+const CpuTopology & GetCpuTopology()
+{
+    static const CpuTopology topology;
+    return topology;
+}
+
+mfxI32 GetRenderNodeNumaNode(mfxU32)
+{
+    return -1;
+}
+
+bool SetThreadAffinity(std::thread &, const std::vector<int> &)
+{
+    return true;
+}
+
+NumaNodeScope::NumaNodeScope(mfxI32)
+    : m_bound(false)
+{
+}
+
+NumaNodeScope::~NumaNodeScope()
+{
+}
+
+#endif // !defined(_WIN32) && !defined(_WIN64)
+
+mfxU32 CpuTopology::GetNumCpus() const
+{
+    mfxU32 numCpus = 0;
+    for (const Node & node : nodes)
+        numCpus += (mfxU32)node.cpus.size();
+    return numCpus;
+}
+
+mfxI32 CpuTopology::FindNode(mfxI32 id) const
+{
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes[i].id == id)
+            return (mfxI32)i;
+    }
+    return -1;
+}
+
+std::vector<int> GetThreadCpus(mfxU16 policy, mfxI32 node, mfxU32 threadNum)
+{
+    const CpuTopology & topology = GetCpuTopology();
+    const mfxU32 numCpus = topology.GetNumCpus();
+
+    if (!numCpus)
+        return std::vector<int>();
+
+    switch (policy)
+    {
+    case MFX_THREADS_AFFINITY_COMPACT:
+    {
+        // fill CPUs of the first node, then the second one, etc.
+        mfxU32 idx = threadNum % numCpus;
+        for (const CpuTopology::Node & n : topology.nodes)
+        {
+            if (idx < n.cpus.size())
+                return std::vector<int>(1, n.cpus[idx]);
+            idx -= (mfxU32)n.cpus.size();
+        }
+        break;
+    }
+    case MFX_THREADS_AFFINITY_SPREAD:
+    {
+        // round robin over nodes, then over CPUs of the node
+        const mfxU32 numNodes = (mfxU32)topology.nodes.size();
+        const CpuTopology::Node & n = topology.nodes[threadNum % numNodes];
+        return std::vector<int>(1, n.cpus[(threadNum / numNodes) % n.cpus.size()]);
+    }
+    case MFX_THREADS_AFFINITY_NODE:
+    case MFX_THREADS_AFFINITY_DEVICE_NODE:
+    {
+        mfxI32 idx = (node < 0) ? -1 : topology.FindNode(node);
+        if (idx >= 0)
+            return topology.nodes[idx].cpus;
+        break;
+    }
+    default:
+        break;
+    }
+
+    return std::vector<int>();
+}
+
+mfxI32 GetPolicyNumaNode(mfxU16 policy, mfxI32 node, mfxU32 numThreads)
+{
+    const CpuTopology & topology = GetCpuTopology();
+
+    if (topology.nodes.empty())
+        return -1;
+
+    switch (policy)
+    {
+    case MFX_THREADS_AFFINITY_COMPACT:
+        // the first node is filled first
+        return (numThreads <= topology.nodes[0].cpus.size()) ? topology.nodes[0].id : -1;
+    case MFX_THREADS_AFFINITY_NODE:
+    case MFX_THREADS_AFFINITY_DEVICE_NODE:
+        return (topology.FindNode(node) >= 0) ? node : -1;
+    default:
+        return -1;
+    }
+}
+
+} // namespace mfx
@@ -28,9 +28,17 @@
 #include "vm_interlocked.h"
 #include <assert.h>
 #include <iterator>
+#include <chrono>
+#include <algorithm>
 
 #define CTX(dpy) (((VADisplayContextP)dpy)->pDriverContext)
 
+static inline long long GetTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 
 MFEVAAPIEncoder::MFEVAAPIEncoder() :
       m_refCounter(1)
@@ -40,6 +48,7 @@ MFEVAAPIEncoder::MFEVAAPIEncoder() :
     , m_maxFramesToCombine(0)
     , m_framesCollected(0)
     , m_minTimeToWait(0)
+    , m_submit(vaMFSubmit)
 {
     m_contexts.reserve(MAX_FRAMES_TO_COMBINE);
     m_streams.reserve(MAX_FRAMES_TO_COMBINE);
@@ -63,6 +72,18 @@ void MFEVAAPIEncoder::Release()
         delete this;
 }
 
+MFEBatchPolicy::Statistics MFEVAAPIEncoder::GetStatistics()
+{
+    std::lock_guard<std::mutex> guard(m_mfe_guard);
+    return m_policy.GetStatistics();
+}
+
+void MFEVAAPIEncoder::SetSubmitFunction(MFESubmitFunc submit)
+{
+    std::lock_guard<std::mutex> guard(m_mfe_guard);
+    m_submit = submit ? submit : vaMFSubmit;
+}
+
 mfxStatus MFEVAAPIEncoder::Create(mfxExtMultiFrameParam  const & par, VADisplay vaDisplay)
 {
     assert(vaDisplay);
@@ -90,6 +111,7 @@ mfxStatus MFEVAAPIEncoder::Create(mfxExtMultiFrameParam  const & par, VADisplay
 
     m_streams_pool.clear();
     m_toSubmit.clear();
+    m_policy = MFEBatchPolicy();
 
     VAStatus vaSts = vaCreateMFContext(m_vaDisplay, &m_mfe_context);
     if (VA_STATUS_SUCCESS == vaSts)
@@ -174,6 +196,7 @@ mfxStatus MFEVAAPIEncoder::Join(VAContextID ctx, long long timeout)
         m_streams_pool.push_back(m_stream_ids_t(ctx, MFX_ERR_NONE, timeout));
         iter = m_streams_pool.end();
         m_streamsMap.insert(std::pair<VAContextID, StreamsIter_t>(ctx,--iter));
+        m_policy.AddStream(ctx, timeout);
         // to deal with the situation when a number of sessions < requested
         if (m_framesToCombine < m_maxFramesToCombine)
             ++m_framesToCombine;
@@ -198,6 +221,9 @@ mfxStatus MFEVAAPIEncoder::Disjoin(VAContextID ctx)
     }
     m_streams_pool.erase(iter->second);
     m_streamsMap.erase(iter);
+    m_policy.RemoveStream(ctx);
+    // the batch may be waiting for the stream
+    m_mfe_wait.notify_all();
     if (m_framesToCombine > 0 && m_framesToCombine >= m_maxFramesToCombine)
         --m_framesToCombine;
     return (VA_STATUS_SUCCESS == vaSts)? MFX_ERR_NONE: MFX_ERR_DEVICE_FAILED;
@@ -281,6 +307,15 @@ mfxStatus MFEVAAPIEncoder::Submit(VAContextID context, long long timeToWait, boo
         cur_stream->reset();//cleanup stream state
     }
 
+    const long long now = GetTimeUs();
+    // the frame never waits past its own budget, the batch deadline is
+    // reset when the batch is submitted or dropped by another stream
+    const long long frameDeadline = now + std::max(timeToWait, 0LL);
+
+    m_policy.OnFrame(context, now, timeToWait, skipFrame);
+    // batch size and deadline might change, let waiting streams re-check
+    m_mfe_wait.notify_all();
+
     if (skipFrame)
     {
         //if frame is skipped - threat it as submitted without real submission
@@ -303,9 +338,21 @@ mfxStatus MFEVAAPIEncoder::Submit(VAContextID context, long long timeToWait, boo
     {
         return MFX_ERR_UNDEFINED_BEHAVIOR;
     }
-    m_mfe_wait.wait_for(guard, std::chrono::microseconds(timeToWait), [this, framesToSubmit, cur_stream] {
-        return (m_framesCollected >= framesToSubmit) || cur_stream->isFrameSubmitted();
-    });
+    //wait until either the frames expected by the policy are collected
+    //or the deadline of the batch comes. Both can move while other streams
+    //join the batch, so re-evaluate them on each wake up.
+    for (;;)
+    {
+        if (cur_stream->isFrameSubmitted() ||
+            m_framesCollected >= std::min(framesToSubmit, m_policy.GetBatchSize()))
+            break;
+
+        long long timeLeft = std::min(m_policy.GetDeadline(), frameDeadline) - GetTimeUs();
+        if (timeLeft <= 0)
+            break;
+
+        m_mfe_wait.wait_for(guard, std::chrono::microseconds(timeLeft));
+    }
 
     //for interlace we will return stream back to stream pool when first field submitted
     //to submit next one imediately after than, and don't count it as submitted
@@ -330,12 +377,17 @@ mfxStatus MFEVAAPIEncoder::Submit(VAContextID context, long long timeToWait, boo
             }
             // if cur_stream is not in m_streams (somehow)
             cur_stream->sts = MFX_ERR_UNDEFINED_BEHAVIOR;
+            m_policy.OnSubmit(0, GetTimeUs(), 0, true);
         }
         else
         {
-            VAStatus vaSts = vaMFSubmit(m_vaDisplay, m_mfe_context,
+            long long submitStart = GetTimeUs();
+            VAStatus vaSts = m_submit(m_vaDisplay, m_mfe_context,
                                          &m_contexts[0], m_contexts.size());
-            
+            long long submitEnd = GetTimeUs();
+            m_policy.OnSubmit((mfxU32)m_contexts.size(), submitEnd, submitEnd - submitStart,
+                VA_STATUS_SUCCESS != vaSts);
+
             mfxStatus tmp_res = VA_STATUS_SUCCESS == vaSts ? MFX_ERR_NONE : MFX_ERR_DEVICE_FAILED;
             for (std::vector<StreamsIter_t>::iterator it = m_streams.begin();
                  it != m_streams.end(); ++it)
@@ -0,0 +1,160 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "mfx_mfe_policy.h"
+
+#include <algorithm>
+#include <limits>
+#include <string.h>
+
+namespace
+{
+    const long long NO_DEADLINE = std::numeric_limits<long long>::max();
+
+    // exponential moving average with the weight 1/2^shift for the new sample
+    inline long long Smooth(long long average, long long sample, int shift)
+    {
+        return average + ((sample - average) >> shift);
+    }
+}
+
+MFEBatchPolicy::MFEBatchPolicy()
+    : m_numCollected(0)
+    , m_batchSize(0)
+    , m_batchStart(-1)
+    , m_deadline(NO_DEADLINE)
+    , m_submitCost(0)
+{
+    ResetStatistics();
+}
+
+void MFEBatchPolicy::ResetStatistics()
+{
+    memset(&m_stats, 0, sizeof(m_stats));
+}
+
+void MFEBatchPolicy::AddStream(mfxU32 id, long long latencyBudget)
+{
+    Stream stream = {};
+
+    stream.latencyBudget = latencyBudget;
+    stream.lastArrival = -1;
+    stream.interval = latencyBudget;
+    m_streams[id] = stream;
+
+    UpdateBatchSize();
+}
+
+void MFEBatchPolicy::RemoveStream(mfxU32 id)
+{
+    std::map<mfxU32, Stream>::iterator it = m_streams.find(id);
+    if (it == m_streams.end())
+        return;
+
+    if (it->second.inBatch)
+        --m_numCollected;
+    m_streams.erase(it);
+
+    UpdateBatchSize();
+}
+
+void MFEBatchPolicy::OnFrame(mfxU32 id, long long now, long long timeToWait, bool skipped)
+{
+    std::map<mfxU32, Stream>::iterator it = m_streams.find(id);
+    if (it == m_streams.end())
+        return;
+
+    Stream & stream = it->second;
+    if (stream.lastArrival >= 0 && now > stream.lastArrival)
+        stream.interval = Smooth(stream.interval, now - stream.lastArrival, 2);
+    stream.lastArrival = now;
+
+    if (skipped || stream.inBatch)
+        return;
+
+    stream.inBatch = true;
+    if (0 == m_numCollected++)
+        m_batchStart = now;
+
+    // leave room for the submission itself, but never wait past the budget
+    long long deadline = now + std::max(timeToWait - m_submitCost, 0LL);
+    m_deadline = std::min(m_deadline, deadline);
+
+    UpdateBatchSize();
+}
+
+void MFEBatchPolicy::OnSubmit(mfxU32 numFrames, long long now, long long submitTime, bool failed)
+{
+    if (failed)
+    {
+        ++m_stats.numFailedBatches;
+    }
+    else
+    {
+        const mfxU64 waitTime = (mfxU64)std::max(now - submitTime - m_batchStart, 0LL);
+
+        ++m_stats.numBatches;
+        m_stats.numFrames += numFrames;
+        if (numFrames >= m_batchSize)
+            ++m_stats.numFullBatches;
+        else
+            ++m_stats.numDeadlineBatches;
+        m_stats.totalWaitTime += waitTime;
+        m_stats.maxWaitTime = std::max(m_stats.maxWaitTime, waitTime);
+        m_stats.totalSubmitTime += (mfxU64)submitTime;
+        m_stats.maxSubmitTime = std::max(m_stats.maxSubmitTime, (mfxU64)submitTime);
+        ++m_stats.batchSizes[std::min(numFrames, MAX_BATCH_HISTOGRAM - 1)];
+
+        m_submitCost = m_stats.numBatches > 1 ? Smooth(m_submitCost, submitTime, 3) : submitTime;
+    }
+
+    for (std::map<mfxU32, Stream>::iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+        it->second.inBatch = false;
+
+    m_numCollected = 0;
+    m_batchStart = -1;
+    m_deadline = NO_DEADLINE;
+
+    UpdateBatchSize();
+}
+
+void MFEBatchPolicy::UpdateBatchSize()
+{
+    if (!m_numCollected)
+    {
+        // nothing collected yet, any stream may open the batch
+        m_batchSize = (mfxU32)m_streams.size();
+        return;
+    }
+
+    // count the streams which are going to bring a frame before the deadline,
+    // a stream without history is expected to be in time
+    m_batchSize = m_numCollected;
+    for (std::map<mfxU32, Stream>::const_iterator it = m_streams.begin(); it != m_streams.end(); ++it)
+    {
+        const Stream & stream = it->second;
+
+        if (stream.inBatch)
+            continue;
+        if (stream.lastArrival < 0 || stream.lastArrival + stream.interval <= m_deadline)
+            ++m_batchSize;
+    }
+}
@@ -0,0 +1,604 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_surface_pool.h"
+
+#if defined(MFX_ONEVPL)
+
+#include "mfx_utils.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    // surfaces released by the application longer ago are freed
+    const mfxU64 MAX_IDLE_TIME = 1000; // ms
+
+    mfxU64 GetTime(void)
+    {
+        return (mfxU64) std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // fields defining the size of the allocated memory
+    bool IsSameAllocation(const mfxFrameInfo &a, const mfxFrameInfo &b)
+    {
+        return a.FourCC == b.FourCC
+            && a.Width == b.Width
+            && a.Height == b.Height
+            && a.ChromaFormat == b.ChromaFormat
+            && a.BitDepthLuma == b.BitDepthLuma
+            && a.BitDepthChroma == b.BitDepthChroma
+            && a.Shift == b.Shift;
+    }
+
+    mfxU32 GetPoolIndex(mfxU16 component)
+    {
+        if (component & MFX_MEMTYPE_FROM_DECODE)
+            return 0;
+        if (component & MFX_MEMTYPE_FROM_VPPIN)
+            return 1;
+        if (component & MFX_MEMTYPE_FROM_ENCODE)
+            return 2;
+        return (mfxU32) -1;
+    }
+} // namespace
+
+mfxPooledSurface::mfxPooledSurface(mfxSurfacePool *pool, mfxU16 type)
+    : surface()
+    , frameInterface()
+    , pPool(pool)
+    , allocator(type)
+    , response()
+    , refCounter(0)
+    , generation(0)
+    , numReaders(0)
+    , bWriter(false)
+    , syncp(NULL)
+    , idleSince(0)
+{
+}
+
+mfxSurfacePool::mfxSurfacePool(mfxSession session, mfxU16 type, mfxI32 numaNode)
+    : m_refCounter(1)
+    , m_session(session)
+    , m_type(type)
+    , m_numaNode(numaNode)
+    , m_info()
+    , m_generation(0)
+{
+}
+
+mfxSurfacePool::~mfxSurfacePool(void)
+{
+}
+
+void mfxSurfacePool::AddRef(void)
+{
+    m_refCounter += 1;
+}
+
+void mfxSurfacePool::Release(void)
+{
+    if (0 == --m_refCounter)
+    {
+        delete this;
+    }
+}
+
+void mfxSurfacePool::Detach(void)
+{
+    mfxU32 numReleased = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        // the components are closed, only the application can hold surfaces
+        m_session = NULL;
+        for (auto it = m_surfaces.begin(); it != m_surfaces.end(); )
+        {
+            auto next = std::next(it);
+            if (0 == (*it)->refCounter)
+            {
+                numReleased += Free(it);
+            }
+            it = next;
+        }
+    }
+
+    // the owner's reference
+    numReleased += 1;
+    while (numReleased--)
+    {
+        Release();
+    }
+}
+
+mfxStatus mfxSurfacePool::GetSurface(const mfxFrameInfo &info, mfxFrameSurface1 **ppSurface)
+{
+    MFX_CHECK_NULL_PTR1(ppSurface);
+
+    mfxPooledSurface *pItem = NULL;
+    mfxU32 numReleased = 0;
+    mfxStatus sts = MFX_ERR_NONE;
+
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        MFX_CHECK(m_session, MFX_ERR_NOT_INITIALIZED);
+
+        // component was reset to a different resolution or format,
+        // surfaces of the old size are not reused
+        if (!IsSameAllocation(info, m_info))
+        {
+            m_info = info;
+            m_generation += 1;
+            numReleased += Trim(0);
+        }
+
+        // surfaces are free when both the application and the component
+        // (e.g. decoder keeping a reference frame) don't use them
+        for (mfxPooledSurface *pCandidate : m_surfaces)
+        {
+            if (0 == pCandidate->refCounter &&
+                0 == pCandidate->surface.Data.Locked &&
+                m_generation == pCandidate->generation)
+            {
+                pItem = pCandidate;
+                break;
+            }
+        }
+
+        if (!pItem)
+        {
+            sts = Allocate(info, &pItem);
+            if (MFX_ERR_MEMORY_ALLOC == sts)
+            {
+                // don't wait for idle surfaces to age out if the memory is low
+                numReleased += Trim(0);
+                sts = Allocate(info, &pItem);
+            }
+        }
+
+        if (pItem)
+        {
+            pItem->refCounter = 1;
+            pItem->numReaders = 0;
+            pItem->bWriter = false;
+            pItem->syncp = NULL;
+
+            // allocation is the same, crops and frame rate may differ
+            pItem->surface.Info = info;
+            pItem->surface.Data.TimeStamp = 0;
+            pItem->surface.Data.FrameOrder = 0;
+            pItem->surface.Data.DataFlag = 0;
+            pItem->surface.Data.Corrupted = 0;
+
+            numReleased += Trim(MAX_IDLE_TIME);
+        }
+    }
+
+    while (numReleased--)
+    {
+        Release();
+    }
+    MFX_CHECK_STS(sts);
+
+    *ppSurface = &pItem->surface;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus mfxSurfacePool::Allocate(const mfxFrameInfo &info, mfxPooledSurface **ppItem)
+{
+    mfxPooledSurface *pItem = NULL;
+    mfxFrameAllocRequest request = {};
+    mfxStatus sts;
+
+    try
+    {
+        pItem = new mfxPooledSurface(this, MFX_MEMTYPE_SYSTEM_MEMORY | MFX_MEMTYPE_INTERNAL_FRAME | m_type);
+        m_surfaces.push_back(pItem);
+    }
+    catch (...)
+    {
+        delete pItem;
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    mfxWideSWFrameAllocator &allocator = pItem->allocator;
+
+    // every surface has an allocator of its own, so idle surfaces can be freed one by one
+    allocator.frameAllocator.pthis = &allocator;
+    allocator.wbufferAllocator.bufferAllocator.pthis = &allocator.wbufferAllocator;
+    allocator.wbufferAllocator.numaNode = m_numaNode;
+
+    request.Info = info;
+    request.Type = allocator.type;
+    request.NumFrameMin = request.NumFrameSuggested = 1;
+
+    sts = (*allocator.frameAllocator.Alloc)(allocator.frameAllocator.pthis, &request, &pItem->response);
+    if (MFX_ERR_NONE == sts)
+    {
+        // system memory stays locked for the whole life of the surface,
+        // components of the library access it through these pointers
+        sts = (*allocator.frameAllocator.Lock)(allocator.frameAllocator.pthis, pItem->response.mids[0], &pItem->surface.Data);
+        if (MFX_ERR_NONE != sts)
+        {
+            (*allocator.frameAllocator.Free)(allocator.frameAllocator.pthis, &pItem->response);
+        }
+    }
+    if (MFX_ERR_NONE != sts)
+    {
+        m_surfaces.pop_back();
+        delete pItem;
+        return sts;
+    }
+
+    pItem->surface.Version.Version = MFX_FRAMESURFACE1_VERSION;
+    pItem->surface.Info = info;
+    pItem->surface.Data.MemType = allocator.type;
+    pItem->surface.FrameInterface = &pItem->frameInterface;
+
+    mfxFrameSurfaceInterface &frameInterface = pItem->frameInterface;
+    frameInterface.Context = pItem;
+    frameInterface.Version.Version = MFX_FRAMESURFACEINTERFACE_VERSION;
+    frameInterface.AddRef = &mfxSurfacePool::SurfaceAddRef;
+    frameInterface.Release = &mfxSurfacePool::SurfaceRelease;
+    frameInterface.GetRefCounter = &mfxSurfacePool::SurfaceGetRefCounter;
+    frameInterface.Map = &mfxSurfacePool::SurfaceMap;
+    frameInterface.Unmap = &mfxSurfacePool::SurfaceUnmap;
+    frameInterface.GetNativeHandle = &mfxSurfacePool::SurfaceGetNativeHandle;
+    frameInterface.GetDeviceHandle = &mfxSurfacePool::SurfaceGetDeviceHandle;
+    frameInterface.Synchronize = &mfxSurfacePool::SurfaceSynchronize;
+
+    pItem->generation = m_generation;
+
+    // every surface keeps the pool alive
+    AddRef();
+
+    *ppItem = pItem;
+
+    return MFX_ERR_NONE;
+}
+
+mfxU32 mfxSurfacePool::Free(std::list<mfxPooledSurface *>::iterator it)
+{
+    mfxPooledSurface *pItem = *it;
+    mfxWideSWFrameAllocator &allocator = pItem->allocator;
+
+    (*allocator.frameAllocator.Unlock)(allocator.frameAllocator.pthis, pItem->response.mids[0], &pItem->surface.Data);
+    (*allocator.frameAllocator.Free)(allocator.frameAllocator.pthis, &pItem->response);
+
+    m_surfaces.erase(it);
+    delete pItem;
+
+    return 1;
+}
+
+mfxU32 mfxSurfacePool::Trim(mfxU64 maxIdleTime)
+{
+    const mfxU64 now = GetTime();
+    mfxU32 numReleased = 0;
+
+    for (auto it = m_surfaces.begin(); it != m_surfaces.end(); )
+    {
+        auto next = std::next(it);
+        mfxPooledSurface *pItem = *it;
+
+        if (0 == pItem->refCounter &&
+            0 == pItem->surface.Data.Locked &&
+            (m_generation != pItem->generation || now - pItem->idleSince >= maxIdleTime))
+        {
+            numReleased += Free(it);
+        }
+        it = next;
+    }
+
+    return numReleased;
+}
+
+mfxStatus mfxSurfacePool::ReleaseLast(mfxPooledSurface *pItem)
+{
+    mfxU32 numReleased = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        // the counter drops to zero only here, so Trim and Detach
+        // can't free the surface while it is being released
+        mfxU32 refCounter = pItem->refCounter;
+        do
+        {
+            MFX_CHECK(refCounter, MFX_ERR_UNDEFINED_BEHAVIOR);
+        } while (!pItem->refCounter.compare_exchange_weak(refCounter, refCounter - 1));
+
+        // somebody else still holds the surface
+        if (1 != refCounter)
+        {
+            return MFX_ERR_NONE;
+        }
+
+        if (NULL == m_session || m_generation != pItem->generation)
+        {
+            auto it = std::find(m_surfaces.begin(), m_surfaces.end(), pItem);
+            if (m_surfaces.end() != it)
+            {
+                numReleased += Free(it);
+            }
+        }
+        else
+        {
+            pItem->numReaders = 0;
+            pItem->bWriter = false;
+            pItem->idleSince = GetTime();
+        }
+    }
+
+    while (numReleased--)
+    {
+        Release();
+    }
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus mfxSurfacePool::Synchronize(mfxPooledSurface *pItem, mfxU32 wait)
+{
+    mfxSyncPoint syncp;
+    mfxSession session;
+
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        syncp = pItem->syncp;
+        session = m_session;
+    }
+
+    // nothing writes to the surface or the session is closed
+    if (NULL == syncp || NULL == session)
+    {
+        return MFX_ERR_NONE;
+    }
+
+    mfxStatus sts = MFXVideoCORE_SyncOperation(session, syncp, wait);
+
+    // the scheduler forgets the operation after the first successful
+    // synchronization, it might be already done through MFXVideoCORE_SyncOperation
+    if (MFX_ERR_NULL_PTR == sts)
+    {
+        sts = MFX_ERR_NONE;
+    }
+
+    if (MFX_ERR_NONE == sts)
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        if (syncp == pItem->syncp)
+        {
+            pItem->syncp = NULL;
+        }
+    }
+
+    return sts;
+}
+
+mfxPooledSurface *mfxSurfacePool::GetPooledSurface(mfxFrameSurface1 *surface)
+{
+    if (NULL == surface ||
+        NULL == surface->FrameInterface ||
+        &mfxSurfacePool::SurfaceAddRef != surface->FrameInterface->AddRef)
+    {
+        return NULL;
+    }
+
+    return (mfxPooledSurface *) surface->FrameInterface->Context;
+}
+
+void mfxSurfacePool::SetSyncPoint(mfxFrameSurface1 *surface, mfxSyncPoint syncp)
+{
+    mfxPooledSurface *pItem = GetPooledSurface(surface);
+
+    if (pItem)
+    {
+        std::lock_guard<std::mutex> guard(pItem->pPool->m_guard);
+
+        pItem->syncp = syncp;
+    }
+}
+
+#define MFX_CHECK_POOLED_SURFACE(surface, pItem) \
+    MFX_CHECK_NULL_PTR1(surface); \
+    MFX_CHECK(surface->FrameInterface && surface->FrameInterface->Context, MFX_ERR_INVALID_HANDLE); \
+    mfxPooledSurface *pItem = (mfxPooledSurface *) surface->FrameInterface->Context;
+
+mfxStatus mfxSurfacePool::SurfaceAddRef(mfxFrameSurface1 *surface)
+{
+    MFX_CHECK_POOLED_SURFACE(surface, pItem);
+
+    pItem->refCounter += 1;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus mfxSurfacePool::SurfaceRelease(mfxFrameSurface1 *surface)
+{
+    MFX_CHECK_POOLED_SURFACE(surface, pItem);
+
+    // references other than the last one are dropped without the pool guard
+    mfxU32 refCounter = pItem->refCounter;
+    while (refCounter > 1)
+    {
+        if (pItem->refCounter.compare_exchange_weak(refCounter, refCounter - 1))
+        {
+            return MFX_ERR_NONE;
+        }
+    }
+
+    return pItem->pPool->ReleaseLast(pItem);
+}
+
+mfxStatus mfxSurfacePool::SurfaceGetRefCounter(mfxFrameSurface1 *surface, mfxU32 *counter)
+{
+    MFX_CHECK_POOLED_SURFACE(surface, pItem);
+    MFX_CHECK_NULL_PTR1(counter);
+
+    *counter = pItem->refCounter;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus mfxSurfacePool::SurfaceMap(mfxFrameSurface1 *surface, mfxU32 flags)
+{
+    MFX_CHECK_POOLED_SURFACE(surface, pItem);
+    MFX_CHECK(flags & MFX_MAP_READ_WRITE, MFX_ERR_UNSUPPORTED);
+    MFX_CHECK(!(flags & ~(mfxU32)(MFX_MAP_READ_WRITE | MFX_MAP_NOWAIT)), MFX_ERR_UNSUPPORTED);
+
+    mfxSurfacePool *pPool = pItem->pPool;
+    const bool bWrite = !!(flags & MFX_MAP_WRITE);
+
+    // writing is exclusive and checked right away
+    if (bWrite)
+    {
+        std::lock_guard<std::mutex> guard(pPool->m_guard);
+
+        MFX_CHECK(0 == surface->Data.Locked, MFX_ERR_LOCK_MEMORY);
+        MFX_CHECK(!pItem->bWriter && !pItem->numReaders, MFX_ERR_LOCK_MEMORY);
+    }
+
+    // wait for the component producing the surface
+    mfxStatus sts = pPool->Synchronize(pItem, (flags & MFX_MAP_NOWAIT) ? 0 : MFX_INFINITE);
+    MFX_CHECK(MFX_WRN_IN_EXECUTION != sts, MFX_ERR_RESOURCE_MAPPED);
+    MFX_CHECK_STS(sts);
+
+    std::lock_guard<std::mutex> guard(pPool->m_guard);
+
+    MFX_CHECK(!pItem->bWriter, MFX_ERR_LOCK_MEMORY);
+    if (bWrite)
+    {
+        MFX_CHECK(0 == surface->Data.Locked && !pItem->numReaders, MFX_ERR_LOCK_MEMORY);
+        pItem->bWriter = true;
+    }
+    else
+    {
+        pItem->numReaders += 1;
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        // components locking the surface while it's mapped for reading don't write it either
+        surface->Data.LockFlag |= MFX_FRAMELOCK_READ_ONLY;
+#endif
+    }
+
+    // pointers are never reset for system memory, see Allocate
+    return MFX_ERR_NONE;
+}
+
+mfxStatus mfxSurfacePool::SurfaceUnmap(mfxFrameSurface1 *surface)
+{
+    MFX_CHECK_POOLED_SURFACE(surface, pItem);
+
+    std::lock_guard<std::mutex> guard(pItem->pPool->m_guard);
+
+    if (pItem->bWriter)
+    {
+        pItem->bWriter = false;
+    }
+    else
+    {
+        MFX_CHECK(pItem->numReaders, MFX_ERR_UNSUPPORTED);
+        pItem->numReaders -= 1;
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        if (!pItem->numReaders)
+            surface->Data.LockFlag &= (mfxU16)~MFX_FRAMELOCK_READ_ONLY;
+#endif
+    }
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus mfxSurfacePool::SurfaceGetNativeHandle(mfxFrameSurface1 *surface, mfxHDL *resource, mfxResourceType *resource_type)
+{
+    MFX_CHECK_POOLED_SURFACE(surface, pItem);
+    MFX_CHECK_NULL_PTR2(resource, resource_type);
+    (void)pItem;
+
+    return MFX_ERR_UNSUPPORTED;
+}
+
+mfxStatus mfxSurfacePool::SurfaceGetDeviceHandle(mfxFrameSurface1 *surface, mfxHDL *device_handle, mfxHandleType *device_type)
+{
+    MFX_CHECK_POOLED_SURFACE(surface, pItem);
+    MFX_CHECK_NULL_PTR2(device_handle, device_type);
+    (void)pItem;
+
+    return MFX_ERR_UNSUPPORTED;
+}
+
+mfxStatus mfxSurfacePool::SurfaceSynchronize(mfxFrameSurface1 *surface, mfxU32 wait)
+{
+    MFX_CHECK_POOLED_SURFACE(surface, pItem);
+
+    return pItem->pPool->Synchronize(pItem, wait);
+}
+
+#undef MFX_CHECK_POOLED_SURFACE
+
+mfxSurfacePoolSet::mfxSurfacePoolSet(void)
+    : m_pPools()
+{
+}
+
+mfxSurfacePoolSet::~mfxSurfacePoolSet(void)
+{
+    for (mfxSurfacePool *pPool : m_pPools)
+    {
+        if (pPool)
+            pPool->Detach();
+    }
+}
+
+mfxStatus mfxSurfacePoolSet::GetSurface(mfxSession session, mfxU16 component, mfxI32 numaNode,
+                                        const mfxFrameInfo &info, mfxFrameSurface1 **ppSurface)
+{
+    const mfxU32 idx = GetPoolIndex(component);
+    MFX_CHECK(idx < sizeof(m_pPools) / sizeof(m_pPools[0]), MFX_ERR_UNSUPPORTED);
+
+    mfxSurfacePool *pPool;
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        if (NULL == m_pPools[idx])
+        {
+            try
+            {
+                m_pPools[idx] = new mfxSurfacePool(session, component, numaNode);
+            }
+            catch (...)
+            {
+                return MFX_ERR_MEMORY_ALLOC;
+            }
+        }
+        pPool = m_pPools[idx];
+    }
+
+    return pPool->GetSurface(info, ppSurface);
+}
+
+#endif // defined(MFX_ONEVPL)
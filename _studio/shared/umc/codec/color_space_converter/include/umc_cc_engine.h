@@ -0,0 +1,51 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __UMC_CC_ENGINE_H__
+#define __UMC_CC_ENGINE_H__
+
+#include "umc_structures.h"
+
+namespace UMC
+{
+
+// Row-parallel color space conversion between NV12, YUV420 (I420), YUY2, UYVY,
+// RGB32, P010 and Y410. Pairs without a direct kernel are converted through
+// NV12/P010 band by band, so no full-frame intermediate is allocated.
+namespace CC
+{
+    struct Image
+    {
+        ColorFormat format;
+        uint8_t *   planes[3]; // Y/UV for NV12 and P010, Y/U/V for YUV420, packed formats use [0]
+        size_t      pitches[3];
+    };
+
+    bool IsSupported(ColorFormat src, ColorFormat dst);
+
+    // width and height must be even, stripes are converted on UMC::ThreadPool and the calling thread,
+    // numThreads == 0 uses all threads of the pool, small pictures stay on the calling thread
+    Status Convert(Image const & src, Image const & dst, int32_t width, int32_t height, uint32_t numThreads = 0);
+
+} // namespace CC
+
+} // namespace UMC
+
+#endif /* __UMC_CC_ENGINE_H__ */
@@ -0,0 +1,74 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __UMC_CC_ENGINE_IMPL_H__
+#define __UMC_CC_ENGINE_IMPL_H__
+
+#include "umc_cc_engine.h"
+
+namespace UMC
+{
+namespace CC
+{
+    // Converts columns [x, width) of 'height' rows (even) starting at the first row of src and dst.
+    // x is even, AVX2 kernels process the bulk and pass the tail to the C kernel.
+    typedef void (*Kernel)(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height);
+
+#define UMC_CC_DECLARE_KERNEL(name) \
+    void name##_C   (Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height); \
+    void name##_AVX2(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height);
+
+    UMC_CC_DECLARE_KERNEL(I420ToNV12)
+    UMC_CC_DECLARE_KERNEL(NV12ToI420)
+    UMC_CC_DECLARE_KERNEL(YUY2ToNV12)
+    UMC_CC_DECLARE_KERNEL(NV12ToYUY2)
+    UMC_CC_DECLARE_KERNEL(UYVYToNV12)
+    UMC_CC_DECLARE_KERNEL(NV12ToUYVY)
+    UMC_CC_DECLARE_KERNEL(Swap422)
+    UMC_CC_DECLARE_KERNEL(RGB4ToNV12)
+    UMC_CC_DECLARE_KERNEL(NV12ToRGB4)
+    UMC_CC_DECLARE_KERNEL(P010ToNV12)
+    UMC_CC_DECLARE_KERNEL(NV12ToP010)
+    UMC_CC_DECLARE_KERNEL(Y410ToP010)
+    UMC_CC_DECLARE_KERNEL(P010ToY410)
+
+#undef UMC_CC_DECLARE_KERNEL
+
+    template <class T> inline
+    T * Row(Image const & img, int32_t plane, int32_t y)
+    {
+        return (T *)(img.planes[plane] + y * img.pitches[plane]);
+    }
+
+    template <class T> inline
+    T Clip(T val, T min, T max)
+    {
+        return val < min ? min : (val > max ? max : val);
+    }
+
+    // BT.601 limited range, 8 bit fixed point, C and AVX2 kernels produce identical results
+    inline uint8_t RGBToY(int32_t r, int32_t g, int32_t b) { return (uint8_t)((( 66 * r + 129 * g +  25 * b + 128) >> 8) +  16); }
+    inline uint8_t RGBToU(int32_t r, int32_t g, int32_t b) { return (uint8_t)(((-38 * r -  74 * g + 112 * b + 128) >> 8) + 128); }
+    inline uint8_t RGBToV(int32_t r, int32_t g, int32_t b) { return (uint8_t)(((112 * r -  94 * g -  18 * b + 128) >> 8) + 128); }
+
+} // namespace CC
+} // namespace UMC
+
+#endif /* __UMC_CC_ENGINE_IMPL_H__ */
@@ -0,0 +1,578 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "umc_cc_engine_impl.h"
+
+#include "umc_thread_pool.h"
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+namespace UMC
+{
+namespace CC
+{
+
+/////////////////////////////////////////////////////////////////////////
+// C kernels
+
+void I420ToNV12_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y++)
+        memcpy(Row<uint8_t>(dst, 0, y) + x, Row<uint8_t>(src, 0, y) + x, width - x);
+
+    for (int32_t y = 0; y < height / 2; y++)
+    {
+        uint8_t const * u  = Row<uint8_t>(src, 1, y);
+        uint8_t const * v  = Row<uint8_t>(src, 2, y);
+        uint8_t *       uv = Row<uint8_t>(dst, 1, y);
+
+        for (int32_t i = x / 2; i < width / 2; i++)
+        {
+            uv[2 * i + 0] = u[i];
+            uv[2 * i + 1] = v[i];
+        }
+    }
+}
+
+void NV12ToI420_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y++)
+        memcpy(Row<uint8_t>(dst, 0, y) + x, Row<uint8_t>(src, 0, y) + x, width - x);
+
+    for (int32_t y = 0; y < height / 2; y++)
+    {
+        uint8_t const * uv = Row<uint8_t>(src, 1, y);
+        uint8_t *       u  = Row<uint8_t>(dst, 1, y);
+        uint8_t *       v  = Row<uint8_t>(dst, 2, y);
+
+        for (int32_t i = x / 2; i < width / 2; i++)
+        {
+            u[i] = uv[2 * i + 0];
+            v[i] = uv[2 * i + 1];
+        }
+    }
+}
+
+// YUY2: Y0 U Y1 V, UYVY: U Y0 V Y1
+template <int32_t Y0, int32_t U, int32_t Y1, int32_t V>
+static void Packed422ToNV12(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y += 2)
+    {
+        uint8_t const * s0 = Row<uint8_t>(src, 0, y);
+        uint8_t const * s1 = Row<uint8_t>(src, 0, y + 1);
+        uint8_t *       d0 = Row<uint8_t>(dst, 0, y);
+        uint8_t *       d1 = Row<uint8_t>(dst, 0, y + 1);
+        uint8_t *       uv = Row<uint8_t>(dst, 1, y / 2);
+
+        for (int32_t i = x; i < width; i += 2)
+        {
+            d0[i + 0] = s0[2 * i + Y0];
+            d0[i + 1] = s0[2 * i + Y1];
+            d1[i + 0] = s1[2 * i + Y0];
+            d1[i + 1] = s1[2 * i + Y1];
+            uv[i + 0] = (uint8_t)((s0[2 * i + U] + s1[2 * i + U] + 1) >> 1);
+            uv[i + 1] = (uint8_t)((s0[2 * i + V] + s1[2 * i + V] + 1) >> 1);
+        }
+    }
+}
+
+template <int32_t Y0, int32_t U, int32_t Y1, int32_t V>
+static void NV12ToPacked422(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint8_t const * s  = Row<uint8_t>(src, 0, y);
+        uint8_t const * uv = Row<uint8_t>(src, 1, y / 2);
+        uint8_t *       d  = Row<uint8_t>(dst, 0, y);
+
+        for (int32_t i = x; i < width; i += 2)
+        {
+            d[2 * i + Y0] = s[i + 0];
+            d[2 * i + U]  = uv[i + 0];
+            d[2 * i + Y1] = s[i + 1];
+            d[2 * i + V]  = uv[i + 1];
+        }
+    }
+}
+
+void YUY2ToNV12_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    Packed422ToNV12<0, 1, 2, 3>(src, dst, x, width, height);
+}
+
+void NV12ToYUY2_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    NV12ToPacked422<0, 1, 2, 3>(src, dst, x, width, height);
+}
+
+void UYVYToNV12_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    Packed422ToNV12<1, 0, 3, 2>(src, dst, x, width, height);
+}
+
+void NV12ToUYVY_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    NV12ToPacked422<1, 0, 3, 2>(src, dst, x, width, height);
+}
+
+// YUY2 <-> UYVY
+void Swap422_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint8_t const * s = Row<uint8_t>(src, 0, y);
+        uint8_t *       d = Row<uint8_t>(dst, 0, y);
+
+        for (int32_t i = 2 * x; i < 2 * width; i += 2)
+        {
+            uint8_t tmp = s[i];
+            d[i]        = s[i + 1];
+            d[i + 1]    = tmp;
+        }
+    }
+}
+
+void RGB4ToNV12_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y += 2)
+    {
+        uint8_t const * s0 = Row<uint8_t>(src, 0, y);
+        uint8_t const * s1 = Row<uint8_t>(src, 0, y + 1);
+        uint8_t *       d0 = Row<uint8_t>(dst, 0, y);
+        uint8_t *       d1 = Row<uint8_t>(dst, 0, y + 1);
+        uint8_t *       uv = Row<uint8_t>(dst, 1, y / 2);
+
+        for (int32_t i = x; i < width; i += 2)
+        {
+            uint8_t const * p00 = s0 + 4 * i;
+            uint8_t const * p01 = s0 + 4 * i + 4;
+            uint8_t const * p10 = s1 + 4 * i;
+            uint8_t const * p11 = s1 + 4 * i + 4;
+
+            d0[i + 0] = RGBToY(p00[2], p00[1], p00[0]);
+            d0[i + 1] = RGBToY(p01[2], p01[1], p01[0]);
+            d1[i + 0] = RGBToY(p10[2], p10[1], p10[0]);
+            d1[i + 1] = RGBToY(p11[2], p11[1], p11[0]);
+
+            int32_t b = (p00[0] + p01[0] + p10[0] + p11[0] + 2) >> 2;
+            int32_t g = (p00[1] + p01[1] + p10[1] + p11[1] + 2) >> 2;
+            int32_t r = (p00[2] + p01[2] + p10[2] + p11[2] + 2) >> 2;
+
+            uv[i + 0] = RGBToU(r, g, b);
+            uv[i + 1] = RGBToV(r, g, b);
+        }
+    }
+}
+
+void NV12ToRGB4_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint8_t const * s  = Row<uint8_t>(src, 0, y);
+        uint8_t const * uv = Row<uint8_t>(src, 1, y / 2);
+        uint8_t *       d  = Row<uint8_t>(dst, 0, y);
+
+        for (int32_t i = x; i < width; i++)
+        {
+            int32_t c  = 298 * (s[i] - 16) + 128;
+            int32_t du = uv[i & ~1] - 128;
+            int32_t dv = uv[i | 1] - 128;
+
+            d[4 * i + 0] = (uint8_t)Clip((c + 516 * du) >> 8, 0, 255);
+            d[4 * i + 1] = (uint8_t)Clip((c - 100 * du - 208 * dv) >> 8, 0, 255);
+            d[4 * i + 2] = (uint8_t)Clip((c + 409 * dv) >> 8, 0, 255);
+            d[4 * i + 3] = 0xff;
+        }
+    }
+}
+
+// P010 keeps 10 bit samples in MSBs of 16 bit words, UV plane has 'width' samples per row
+void P010ToNV12_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint16_t const * s = Row<uint16_t>(src, 0, y);
+        uint8_t *        d = Row<uint8_t>(dst, 0, y);
+
+        for (int32_t i = x; i < width; i++)
+            d[i] = (uint8_t)std::min<int32_t>((s[i] + 0x80) >> 8, 255);
+    }
+
+    for (int32_t y = 0; y < height / 2; y++)
+    {
+        uint16_t const * s = Row<uint16_t>(src, 1, y);
+        uint8_t *        d = Row<uint8_t>(dst, 1, y);
+
+        for (int32_t i = x; i < width; i++)
+            d[i] = (uint8_t)std::min<int32_t>((s[i] + 0x80) >> 8, 255);
+    }
+}
+
+void NV12ToP010_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint8_t const * s = Row<uint8_t>(src, 0, y);
+        uint16_t *      d = Row<uint16_t>(dst, 0, y);
+
+        for (int32_t i = x; i < width; i++)
+            d[i] = (uint16_t)(s[i] << 8);
+    }
+
+    for (int32_t y = 0; y < height / 2; y++)
+    {
+        uint8_t const * s = Row<uint8_t>(src, 1, y);
+        uint16_t *      d = Row<uint16_t>(dst, 1, y);
+
+        for (int32_t i = x; i < width; i++)
+            d[i] = (uint16_t)(s[i] << 8);
+    }
+}
+
+// Y410: U [9:0], Y [19:10], V [29:20], A [31:30]
+void Y410ToP010_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y += 2)
+    {
+        uint32_t const * s0 = Row<uint32_t>(src, 0, y);
+        uint32_t const * s1 = Row<uint32_t>(src, 0, y + 1);
+        uint16_t *       d0 = Row<uint16_t>(dst, 0, y);
+        uint16_t *       d1 = Row<uint16_t>(dst, 0, y + 1);
+        uint16_t *       uv = Row<uint16_t>(dst, 1, y / 2);
+
+        for (int32_t i = x; i < width; i += 2)
+        {
+            d0[i + 0] = (uint16_t)(((s0[i + 0] >> 10) & 0x3ff) << 6);
+            d0[i + 1] = (uint16_t)(((s0[i + 1] >> 10) & 0x3ff) << 6);
+            d1[i + 0] = (uint16_t)(((s1[i + 0] >> 10) & 0x3ff) << 6);
+            d1[i + 1] = (uint16_t)(((s1[i + 1] >> 10) & 0x3ff) << 6);
+
+            uint32_t u = (s0[i] & 0x3ff) + (s0[i + 1] & 0x3ff) + (s1[i] & 0x3ff) + (s1[i + 1] & 0x3ff);
+            uint32_t v = ((s0[i] >> 20) & 0x3ff) + ((s0[i + 1] >> 20) & 0x3ff) + ((s1[i] >> 20) & 0x3ff) + ((s1[i + 1] >> 20) & 0x3ff);
+
+            uv[i + 0] = (uint16_t)(((u + 2) >> 2) << 6);
+            uv[i + 1] = (uint16_t)(((v + 2) >> 2) << 6);
+        }
+    }
+}
+
+void P010ToY410_C(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint16_t const * s  = Row<uint16_t>(src, 0, y);
+        uint16_t const * uv = Row<uint16_t>(src, 1, y / 2);
+        uint32_t *       d  = Row<uint32_t>(dst, 0, y);
+
+        for (int32_t i = x; i < width; i++)
+        {
+            uint32_t u = uv[i & ~1] >> 6;
+            uint32_t v = uv[i | 1] >> 6;
+            d[i] = u | ((uint32_t)(s[i] >> 6) << 10) | (v << 20) | (3u << 30);
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+// dispatching
+
+#ifdef MFX_HW_VSI_TARGET
+#define UMC_CC_KERNEL(name) (name ## _C)
+#else
+static bool IsAVX2Available()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2") != 0;
+    return avx2;
+}
+#define UMC_CC_KERNEL(name) (IsAVX2Available() ? (name ## _AVX2) : (name ## _C))
+#endif
+
+static Kernel GetKernel(ColorFormat src, ColorFormat dst)
+{
+    switch (src)
+    {
+    case YUV420:
+        if (dst == NV12)   return UMC_CC_KERNEL(I420ToNV12);
+        break;
+    case YUY2:
+        if (dst == NV12)   return UMC_CC_KERNEL(YUY2ToNV12);
+        if (dst == UYVY)   return UMC_CC_KERNEL(Swap422);
+        break;
+    case UYVY:
+        if (dst == NV12)   return UMC_CC_KERNEL(UYVYToNV12);
+        if (dst == YUY2)   return UMC_CC_KERNEL(Swap422);
+        break;
+    case RGB32:
+        if (dst == NV12)   return UMC_CC_KERNEL(RGB4ToNV12);
+        break;
+    case NV12:
+        if (dst == YUV420) return UMC_CC_KERNEL(NV12ToI420);
+        if (dst == YUY2)   return UMC_CC_KERNEL(NV12ToYUY2);
+        if (dst == UYVY)   return UMC_CC_KERNEL(NV12ToUYVY);
+        if (dst == RGB32)  return UMC_CC_KERNEL(NV12ToRGB4);
+        if (dst == P010)   return UMC_CC_KERNEL(NV12ToP010);
+        break;
+    case P010:
+        if (dst == NV12)   return UMC_CC_KERNEL(P010ToNV12);
+        if (dst == Y410)   return UMC_CC_KERNEL(P010ToY410);
+        break;
+    case Y410:
+        if (dst == P010)   return UMC_CC_KERNEL(Y410ToP010);
+        break;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+static bool IsEngineFormat(ColorFormat format)
+{
+    switch (format)
+    {
+    case NV12:
+    case YUV420:
+    case YUY2:
+    case UYVY:
+    case RGB32:
+    case P010:
+    case Y410:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool IsChroma420(ColorFormat format)
+{
+    return format == NV12 || format == YUV420 || format == P010;
+}
+
+static int32_t GetNumPlanes(ColorFormat format)
+{
+    return format == YUV420 ? 3 : (IsChroma420(format) ? 2 : 1);
+}
+
+// bytes per row of plane
+static size_t GetRowSize(ColorFormat format, int32_t plane, int32_t width)
+{
+    switch (format)
+    {
+    case NV12:   return width;
+    case YUV420: return plane ? width / 2 : width;
+    case YUY2:
+    case UYVY:   return 2 * width;
+    case P010:   return 2 * width;
+    default:     return 4 * width; // RGB32, Y410
+    }
+}
+
+static Image OffsetImage(Image const & img, int32_t y)
+{
+    Image res = img;
+
+    for (int32_t i = 0; i < GetNumPlanes(img.format); i++)
+    {
+        int32_t row = (i && IsChroma420(img.format)) ? y / 2 : y;
+        res.planes[i] = img.planes[i] + row * img.pitches[i];
+    }
+
+    return res;
+}
+
+static void Copy(Image const & src, Image const & dst, int32_t, int32_t width, int32_t height)
+{
+    for (int32_t i = 0; i < GetNumPlanes(src.format); i++)
+    {
+        int32_t rows = (i && IsChroma420(src.format)) ? height / 2 : height;
+        size_t  size = GetRowSize(src.format, i, width);
+
+        for (int32_t y = 0; y < rows; y++)
+            memcpy(Row<uint8_t>(dst, i, y), Row<uint8_t>(src, i, y), size);
+    }
+}
+
+// kernels which convert src to dst, several ones are chained through NV12/P010 intermediates
+struct Chain
+{
+    Kernel      kernels[3];
+    ColorFormat formats[4];
+    int32_t     length;
+};
+
+static bool BuildChain(ColorFormat src, ColorFormat dst, Chain & chain)
+{
+    static const ColorFormat pivots[] = { NV12, P010 };
+
+    chain.formats[0] = src;
+
+    if (src == dst)
+    {
+        chain.kernels[0] = &Copy;
+        chain.formats[1] = dst;
+        chain.length     = 1;
+        return true;
+    }
+
+    if ((chain.kernels[0] = GetKernel(src, dst)) != 0)
+    {
+        chain.formats[1] = dst;
+        chain.length     = 1;
+        return true;
+    }
+
+    for (ColorFormat p : pivots)
+    {
+        chain.kernels[0] = GetKernel(src, p);
+        chain.kernels[1] = GetKernel(p, dst);
+        if (chain.kernels[0] && chain.kernels[1])
+        {
+            chain.formats[1] = p;
+            chain.formats[2] = dst;
+            chain.length     = 2;
+            return true;
+        }
+    }
+
+    for (ColorFormat p0 : pivots)
+    {
+        for (ColorFormat p1 : pivots)
+        {
+            if (p0 == p1)
+                continue;
+
+            chain.kernels[0] = GetKernel(src, p0);
+            chain.kernels[1] = GetKernel(p0, p1);
+            chain.kernels[2] = GetKernel(p1, dst);
+            if (chain.kernels[0] && chain.kernels[1] && chain.kernels[2])
+            {
+                chain.formats[1] = p0;
+                chain.formats[2] = p1;
+                chain.formats[3] = dst;
+                chain.length     = 3;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// rows converted at once when intermediate formats are involved, band buffers stay in cache
+enum { BAND_HEIGHT = 16 };
+
+// single thread worker, converts rows [y0, y1)
+static void ConvertRows(Chain const & chain, Image const & src, Image const & dst, int32_t width, int32_t y0, int32_t y1)
+{
+    if (chain.length == 1)
+    {
+        chain.kernels[0](OffsetImage(src, y0), OffsetImage(dst, y0), 0, width, y1 - y0);
+        return;
+    }
+
+    // intermediate band images, NV12/P010 only
+    Image                tmp[2] = {};
+    std::vector<uint8_t> buf[2];
+
+    for (int32_t i = 0; i < chain.length - 1; i++)
+    {
+        ColorFormat format = chain.formats[i + 1];
+        size_t      pitch  = GetRowSize(format, 0, width);
+
+        buf[i].resize(pitch * BAND_HEIGHT * 3 / 2);
+
+        tmp[i].format     = format;
+        tmp[i].planes[0]  = buf[i].data();
+        tmp[i].planes[1]  = buf[i].data() + pitch * BAND_HEIGHT;
+        tmp[i].pitches[0] = tmp[i].pitches[1] = pitch;
+    }
+
+    for (int32_t y = y0; y < y1; y += BAND_HEIGHT)
+    {
+        int32_t rows = std::min<int32_t>(BAND_HEIGHT, y1 - y);
+
+        for (int32_t i = 0; i < chain.length; i++)
+        {
+            Image const & in  = i ? tmp[i - 1] : OffsetImage(src, y);
+            Image const & out = (i == chain.length - 1) ? OffsetImage(dst, y) : tmp[i];
+            chain.kernels[i](in, out, 0, width, rows);
+        }
+    }
+}
+
+bool IsSupported(ColorFormat src, ColorFormat dst)
+{
+    Chain chain;
+    return IsEngineFormat(src) && IsEngineFormat(dst) && BuildChain(src, dst, chain);
+}
+
+Status Convert(Image const & src, Image const & dst, int32_t width, int32_t height, uint32_t numThreads)
+{
+    if ((width | height) & 1 || width <= 0 || height <= 0)
+        return UMC_ERR_INVALID_PARAMS;
+
+    if (src.format != dst.format && !(IsEngineFormat(src.format) && IsEngineFormat(dst.format)))
+        return UMC_ERR_NOT_IMPLEMENTED;
+
+    Chain chain;
+    if (!BuildChain(src.format, dst.format, chain))
+        return UMC_ERR_NOT_IMPLEMENTED;
+
+    for (int32_t i = 0; i < GetNumPlanes(src.format); i++)
+        if (!src.planes[i])
+            return UMC_ERR_NULL_PTR;
+    for (int32_t i = 0; i < GetNumPlanes(dst.format); i++)
+        if (!dst.planes[i])
+            return UMC_ERR_NULL_PTR;
+
+    // threads get stripes of whole bands, small pictures aren't worth to be split
+    const int32_t minRowsPerThread = 4 * BAND_HEIGHT;
+    int32_t numBands = (height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+
+    ThreadPool & pool = ThreadPool::GetInstance();
+
+    if (!numThreads)
+        numThreads = pool.GetNumThreads();
+    numThreads = std::min<uint32_t>(numThreads, std::max(1, height / minRowsPerThread));
+
+    if (numThreads == 1)
+    {
+        ConvertRows(chain, src, dst, width, 0, height);
+        return UMC_OK;
+    }
+
+    // stripes go to the persistent pool, the calling thread converts some of them too
+    int32_t stripes = (int32_t)numThreads;
+    pool.ParallelFor(numThreads, [&](uint32_t i)
+    {
+        int32_t band0 = (int32_t)i * (numBands / stripes) + std::min<int32_t>(i, numBands % stripes);
+        int32_t band1 = band0 + numBands / stripes + ((int32_t)i < numBands % stripes ? 1 : 0);
+
+        ConvertRows(chain, src, dst, width, band0 * BAND_HEIGHT, std::min(height, band1 * BAND_HEIGHT));
+    });
+
+    return UMC_OK;
+}
+
+} // namespace CC
+} // namespace UMC
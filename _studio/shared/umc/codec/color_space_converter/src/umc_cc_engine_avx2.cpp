@@ -0,0 +1,460 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "umc_cc_engine_impl.h"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+#include <string.h>
+
+namespace UMC
+{
+namespace CC
+{
+
+#define LOAD128(p)     _mm_loadu_si128((const __m128i *)(p))
+#define LOAD256(p)     _mm256_loadu_si256((const __m256i *)(p))
+#define STORE128(p, v) _mm_storeu_si128((__m128i *)(p), (v))
+#define STORE256(p, v) _mm256_storeu_si256((__m256i *)(p), (v))
+
+// dword of two 16 bit words, for _mm256_madd_epi16
+#define PAIR16(lo, hi) _mm256_set1_epi32((int32_t)(((uint32_t)(uint16_t)(hi) << 16) | (uint16_t)(lo)))
+
+static inline void CopyRows(Image const & src, Image const & dst, int32_t x, int32_t width, int32_t height)
+{
+    for (int32_t y = 0; y < height; y++)
+        memcpy(Row<uint8_t>(dst, 0, y) + x, Row<uint8_t>(src, 0, y) + x, width - x);
+}
+
+void I420ToNV12_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    int32_t wBulk = x0 + ((width - x0) & ~31);
+
+    CopyRows(src, dst, x0, width, height);
+
+    for (int32_t y = 0; y < height / 2; y++)
+    {
+        uint8_t const * u  = Row<uint8_t>(src, 1, y);
+        uint8_t const * v  = Row<uint8_t>(src, 2, y);
+        uint8_t *       uv = Row<uint8_t>(dst, 1, y);
+
+        for (int32_t x = x0; x < wBulk; x += 32)
+        {
+            __m128i cb = LOAD128(u + x / 2);
+            __m128i cr = LOAD128(v + x / 2);
+            STORE128(uv + x,      _mm_unpacklo_epi8(cb, cr));
+            STORE128(uv + x + 16, _mm_unpackhi_epi8(cb, cr));
+        }
+    }
+
+    if (wBulk < width)
+        I420ToNV12_C(src, dst, wBulk, width, height);
+}
+
+void NV12ToI420_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    const __m256i split = _mm256_setr_epi8(
+        0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+        0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    int32_t wBulk = x0 + ((width - x0) & ~31);
+
+    CopyRows(src, dst, x0, width, height);
+
+    for (int32_t y = 0; y < height / 2; y++)
+    {
+        uint8_t const * uv = Row<uint8_t>(src, 1, y);
+        uint8_t *       u  = Row<uint8_t>(dst, 1, y);
+        uint8_t *       v  = Row<uint8_t>(dst, 2, y);
+
+        for (int32_t x = x0; x < wBulk; x += 32)
+        {
+            // U0..U7 V0..V7 | U8..U15 V8..V15 -> U0..U15 | V0..V15
+            __m256i c = _mm256_shuffle_epi8(LOAD256(uv + x), split);
+            c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(3, 1, 2, 0));
+            STORE128(u + x / 2, _mm256_castsi256_si128(c));
+            STORE128(v + x / 2, _mm256_extracti128_si256(c, 1));
+        }
+    }
+
+    if (wBulk < width)
+        NV12ToI420_C(src, dst, wBulk, width, height);
+}
+
+// 16 pixels of 4:2:2 row -> Y0..Y15 | C0..C15 where C is interleaved UV
+template <bool UYVY>
+static inline __m256i Split422(uint8_t const * p)
+{
+    const __m256i yfirst = UYVY ?
+        _mm256_setr_epi8(
+            1, 3, 5, 7, 9, 11, 13, 15, 0, 2, 4, 6, 8, 10, 12, 14,
+            1, 3, 5, 7, 9, 11, 13, 15, 0, 2, 4, 6, 8, 10, 12, 14) :
+        _mm256_setr_epi8(
+            0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+            0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+
+    __m256i v = _mm256_shuffle_epi8(LOAD256(p), yfirst);
+    return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+template <bool UYVY>
+static void Packed422ToNV12_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    int32_t wBulk = x0 + ((width - x0) & ~15);
+
+    for (int32_t y = 0; y < height; y += 2)
+    {
+        uint8_t const * s0 = Row<uint8_t>(src, 0, y);
+        uint8_t const * s1 = Row<uint8_t>(src, 0, y + 1);
+        uint8_t *       d0 = Row<uint8_t>(dst, 0, y);
+        uint8_t *       d1 = Row<uint8_t>(dst, 0, y + 1);
+        uint8_t *       uv = Row<uint8_t>(dst, 1, y / 2);
+
+        for (int32_t x = x0; x < wBulk; x += 16)
+        {
+            __m256i r0 = Split422<UYVY>(s0 + 2 * x);
+            __m256i r1 = Split422<UYVY>(s1 + 2 * x);
+
+            STORE128(d0 + x, _mm256_castsi256_si128(r0));
+            STORE128(d1 + x, _mm256_castsi256_si128(r1));
+            STORE128(uv + x, _mm_avg_epu8(_mm256_extracti128_si256(r0, 1), _mm256_extracti128_si256(r1, 1)));
+        }
+    }
+}
+
+template <bool UYVY>
+static void NV12ToPacked422_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    int32_t wBulk = x0 + ((width - x0) & ~15);
+
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint8_t const * s  = Row<uint8_t>(src, 0, y);
+        uint8_t const * uv = Row<uint8_t>(src, 1, y / 2);
+        uint8_t *       d  = Row<uint8_t>(dst, 0, y);
+
+        for (int32_t x = x0; x < wBulk; x += 16)
+        {
+            __m128i l = LOAD128(s + x);
+            __m128i c = LOAD128(uv + x);
+            __m128i lo = UYVY ? _mm_unpacklo_epi8(c, l) : _mm_unpacklo_epi8(l, c);
+            __m128i hi = UYVY ? _mm_unpackhi_epi8(c, l) : _mm_unpackhi_epi8(l, c);
+            STORE256(d + 2 * x, _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1));
+        }
+    }
+}
+
+void YUY2ToNV12_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    Packed422ToNV12_AVX2<false>(src, dst, x0, width, height);
+    int32_t wBulk = x0 + ((width - x0) & ~15);
+    if (wBulk < width)
+        YUY2ToNV12_C(src, dst, wBulk, width, height);
+}
+
+void NV12ToYUY2_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    NV12ToPacked422_AVX2<false>(src, dst, x0, width, height);
+    int32_t wBulk = x0 + ((width - x0) & ~15);
+    if (wBulk < width)
+        NV12ToYUY2_C(src, dst, wBulk, width, height);
+}
+
+void UYVYToNV12_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    Packed422ToNV12_AVX2<true>(src, dst, x0, width, height);
+    int32_t wBulk = x0 + ((width - x0) & ~15);
+    if (wBulk < width)
+        UYVYToNV12_C(src, dst, wBulk, width, height);
+}
+
+void NV12ToUYVY_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    NV12ToPacked422_AVX2<true>(src, dst, x0, width, height);
+    int32_t wBulk = x0 + ((width - x0) & ~15);
+    if (wBulk < width)
+        NV12ToUYVY_C(src, dst, wBulk, width, height);
+}
+
+void Swap422_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    const __m256i swap = _mm256_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    int32_t wBulk = x0 + ((width - x0) & ~15);
+
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint8_t const * s = Row<uint8_t>(src, 0, y);
+        uint8_t *       d = Row<uint8_t>(dst, 0, y);
+
+        for (int32_t x = x0; x < wBulk; x += 16)
+            STORE256(d + 2 * x, _mm256_shuffle_epi8(LOAD256(s + 2 * x), swap));
+    }
+
+    if (wBulk < width)
+        Swap422_C(src, dst, wBulk, width, height);
+}
+
+// 8 dwords -> 8 bytes, values must fit into 0..255
+static inline void StoreDwordsAsBytes(uint8_t * p, __m256i v)
+{
+    v = _mm256_packs_epi32(v, v);
+    v = _mm256_packus_epi16(v, v);
+    v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4));
+    _mm_storel_epi64((__m128i *)p, _mm256_castsi256_si128(v));
+}
+
+void RGB4ToNV12_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    const __m256i mask  = _mm256_set1_epi32(0x00ff00ff);
+    // [B, R] and [G, A] pairs of 16 bit words
+    const __m256i kyBR  = PAIR16( 25,  66);
+    const __m256i kyGA  = PAIR16(129,   0);
+    const __m256i kuBR  = PAIR16(112, -38);
+    const __m256i kuGA  = PAIR16(-74,   0);
+    const __m256i kvBR  = PAIR16(-18, 112);
+    const __m256i kvGA  = PAIR16(-94,   0);
+    const __m256i rnd   = _mm256_set1_epi32(128);
+    const __m256i ofsY  = _mm256_set1_epi32(16);
+    const __m256i ofsC  = _mm256_set1_epi32(128);
+    const __m256i rnd2  = _mm256_set1_epi16(2);
+    const __m256i even  = _mm256_set1_epi64x(0xffffffff);
+    int32_t wBulk = x0 + ((width - x0) & ~7);
+
+    for (int32_t y = 0; y < height; y += 2)
+    {
+        uint8_t const * s0 = Row<uint8_t>(src, 0, y);
+        uint8_t const * s1 = Row<uint8_t>(src, 0, y + 1);
+        uint8_t *       d0 = Row<uint8_t>(dst, 0, y);
+        uint8_t *       d1 = Row<uint8_t>(dst, 0, y + 1);
+        uint8_t *       uv = Row<uint8_t>(dst, 1, y / 2);
+
+        for (int32_t x = x0; x < wBulk; x += 8)
+        {
+            __m256i p0 = LOAD256(s0 + 4 * x);
+            __m256i p1 = LOAD256(s1 + 4 * x);
+
+            __m256i br0 = _mm256_and_si256(p0, mask);
+            __m256i ga0 = _mm256_and_si256(_mm256_srli_epi32(p0, 8), mask);
+            __m256i br1 = _mm256_and_si256(p1, mask);
+            __m256i ga1 = _mm256_and_si256(_mm256_srli_epi32(p1, 8), mask);
+
+            __m256i y0 = _mm256_add_epi32(_mm256_madd_epi16(br0, kyBR), _mm256_madd_epi16(ga0, kyGA));
+            __m256i y1 = _mm256_add_epi32(_mm256_madd_epi16(br1, kyBR), _mm256_madd_epi16(ga1, kyGA));
+            y0 = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(y0, rnd), 8), ofsY);
+            y1 = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(y1, rnd), 8), ofsY);
+            StoreDwordsAsBytes(d0 + x, y0);
+            StoreDwordsAsBytes(d1 + x, y1);
+
+            // 2x2 averages land in even dwords
+            __m256i br = _mm256_add_epi16(br0, br1);
+            __m256i ga = _mm256_add_epi16(ga0, ga1);
+            br = _mm256_add_epi16(br, _mm256_srli_epi64(br, 32));
+            ga = _mm256_add_epi16(ga, _mm256_srli_epi64(ga, 32));
+            br = _mm256_srli_epi16(_mm256_add_epi16(br, rnd2), 2);
+            ga = _mm256_and_si256(_mm256_srli_epi16(_mm256_add_epi16(ga, rnd2), 2), _mm256_set1_epi32(0xffff));
+
+            __m256i u = _mm256_add_epi32(_mm256_madd_epi16(br, kuBR), _mm256_madd_epi16(ga, kuGA));
+            __m256i v = _mm256_add_epi32(_mm256_madd_epi16(br, kvBR), _mm256_madd_epi16(ga, kvGA));
+            u = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(u, rnd), 8), ofsC);
+            v = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(v, rnd), 8), ofsC);
+
+            StoreDwordsAsBytes(uv + x, _mm256_or_si256(_mm256_and_si256(u, even), _mm256_slli_epi64(v, 32)));
+        }
+    }
+
+    if (wBulk < width)
+        RGB4ToNV12_C(src, dst, wBulk, width, height);
+}
+
+void NV12ToRGB4_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    const __m256i dup   = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i lo16  = _mm256_set1_epi32(0xffff);
+    const __m256i c16   = _mm256_set1_epi32(16);
+    const __m256i c128  = _mm256_set1_epi32(128);
+    const __m256i k298  = _mm256_set1_epi32(298);
+    const __m256i k516  = _mm256_set1_epi32(516);
+    const __m256i k100  = _mm256_set1_epi32(100);
+    const __m256i k208  = _mm256_set1_epi32(208);
+    const __m256i k409  = _mm256_set1_epi32(409);
+    const __m256i zero  = _mm256_setzero_si256();
+    const __m256i max   = _mm256_set1_epi32(255);
+    const __m256i alpha = _mm256_set1_epi32((int32_t)0xff000000);
+    int32_t wBulk = x0 + ((width - x0) & ~7);
+
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint8_t const * s  = Row<uint8_t>(src, 0, y);
+        uint8_t const * uv = Row<uint8_t>(src, 1, y / 2);
+        uint8_t *       d  = Row<uint8_t>(dst, 0, y);
+
+        for (int32_t x = x0; x < wBulk; x += 8)
+        {
+            __m256i l = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(s + x)));
+            __m256i c = _mm256_castsi128_si256(_mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(uv + x))));
+            c = _mm256_permutevar8x32_epi32(c, dup);
+
+            __m256i du = _mm256_sub_epi32(_mm256_and_si256(c, lo16), c128);
+            __m256i dv = _mm256_sub_epi32(_mm256_srli_epi32(c, 16), c128);
+            __m256i cy = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(l, c16), k298), c128);
+
+            __m256i b = _mm256_srai_epi32(_mm256_add_epi32(cy, _mm256_mullo_epi32(du, k516)), 8);
+            __m256i g = _mm256_srai_epi32(_mm256_sub_epi32(_mm256_sub_epi32(cy, _mm256_mullo_epi32(du, k100)), _mm256_mullo_epi32(dv, k208)), 8);
+            __m256i r = _mm256_srai_epi32(_mm256_add_epi32(cy, _mm256_mullo_epi32(dv, k409)), 8);
+
+            b = _mm256_min_epi32(_mm256_max_epi32(b, zero), max);
+            g = _mm256_min_epi32(_mm256_max_epi32(g, zero), max);
+            r = _mm256_min_epi32(_mm256_max_epi32(r, zero), max);
+
+            __m256i px = _mm256_or_si256(_mm256_or_si256(b, _mm256_slli_epi32(g, 8)), _mm256_or_si256(_mm256_slli_epi32(r, 16), alpha));
+            STORE256(d + 4 * x, px);
+        }
+    }
+
+    if (wBulk < width)
+        NV12ToRGB4_C(src, dst, wBulk, width, height);
+}
+
+static inline void P010RowToNV12(uint16_t const * s, uint8_t * d, int32_t x0, int32_t wBulk)
+{
+    const __m256i rnd = _mm256_set1_epi16(0x80);
+
+    for (int32_t x = x0; x < wBulk; x += 32)
+    {
+        __m256i a = _mm256_srli_epi16(_mm256_adds_epu16(LOAD256(s + x),      rnd), 8);
+        __m256i b = _mm256_srli_epi16(_mm256_adds_epu16(LOAD256(s + x + 16), rnd), 8);
+        STORE256(d + x, _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+}
+
+static inline void NV12RowToP010(uint8_t const * s, uint16_t * d, int32_t x0, int32_t wBulk)
+{
+    for (int32_t x = x0; x < wBulk; x += 16)
+        STORE256(d + x, _mm256_slli_epi16(_mm256_cvtepu8_epi16(LOAD128(s + x)), 8));
+}
+
+void P010ToNV12_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    int32_t wBulk = x0 + ((width - x0) & ~31);
+
+    for (int32_t y = 0; y < height; y++)
+        P010RowToNV12(Row<uint16_t>(src, 0, y), Row<uint8_t>(dst, 0, y), x0, wBulk);
+    for (int32_t y = 0; y < height / 2; y++)
+        P010RowToNV12(Row<uint16_t>(src, 1, y), Row<uint8_t>(dst, 1, y), x0, wBulk);
+
+    if (wBulk < width)
+        P010ToNV12_C(src, dst, wBulk, width, height);
+}
+
+void NV12ToP010_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    int32_t wBulk = x0 + ((width - x0) & ~15);
+
+    for (int32_t y = 0; y < height; y++)
+        NV12RowToP010(Row<uint8_t>(src, 0, y), Row<uint16_t>(dst, 0, y), x0, wBulk);
+    for (int32_t y = 0; y < height / 2; y++)
+        NV12RowToP010(Row<uint8_t>(src, 1, y), Row<uint16_t>(dst, 1, y), x0, wBulk);
+
+    if (wBulk < width)
+        NV12ToP010_C(src, dst, wBulk, width, height);
+}
+
+// 8 dwords -> 8 words
+static inline void StoreDwordsAsWords(uint16_t * p, __m256i v)
+{
+    v = _mm256_packus_epi32(v, v);
+    v = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0));
+    STORE128(p, _mm256_castsi256_si128(v));
+}
+
+void Y410ToP010_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    const __m256i m10  = _mm256_set1_epi32(0x3ff);
+    const __m256i rnd  = _mm256_set1_epi32(2);
+    const __m256i even = _mm256_set1_epi64x(0xffffffff);
+    int32_t wBulk = x0 + ((width - x0) & ~7);
+
+    for (int32_t y = 0; y < height; y += 2)
+    {
+        uint32_t const * s0 = Row<uint32_t>(src, 0, y);
+        uint32_t const * s1 = Row<uint32_t>(src, 0, y + 1);
+        uint16_t *       d0 = Row<uint16_t>(dst, 0, y);
+        uint16_t *       d1 = Row<uint16_t>(dst, 0, y + 1);
+        uint16_t *       uv = Row<uint16_t>(dst, 1, y / 2);
+
+        for (int32_t x = x0; x < wBulk; x += 8)
+        {
+            __m256i p0 = LOAD256(s0 + x);
+            __m256i p1 = LOAD256(s1 + x);
+
+            StoreDwordsAsWords(d0 + x, _mm256_slli_epi32(_mm256_and_si256(_mm256_srli_epi32(p0, 10), m10), 6));
+            StoreDwordsAsWords(d1 + x, _mm256_slli_epi32(_mm256_and_si256(_mm256_srli_epi32(p1, 10), m10), 6));
+
+            __m256i u = _mm256_add_epi32(_mm256_and_si256(p0, m10), _mm256_and_si256(p1, m10));
+            __m256i v = _mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(p0, 20), m10), _mm256_and_si256(_mm256_srli_epi32(p1, 20), m10));
+            u = _mm256_add_epi32(u, _mm256_srli_epi64(u, 32));
+            v = _mm256_add_epi32(v, _mm256_srli_epi64(v, 32));
+            u = _mm256_slli_epi32(_mm256_srli_epi32(_mm256_add_epi32(u, rnd), 2), 6);
+            v = _mm256_slli_epi32(_mm256_srli_epi32(_mm256_add_epi32(v, rnd), 2), 6);
+
+            StoreDwordsAsWords(uv + x, _mm256_or_si256(_mm256_and_si256(u, even), _mm256_slli_epi64(v, 32)));
+        }
+    }
+
+    if (wBulk < width)
+        Y410ToP010_C(src, dst, wBulk, width, height);
+}
+
+void P010ToY410_AVX2(Image const & src, Image const & dst, int32_t x0, int32_t width, int32_t height)
+{
+    const __m256i dup   = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i lo16  = _mm256_set1_epi32(0xffff);
+    const __m256i alpha = _mm256_set1_epi32((int32_t)(3u << 30));
+    int32_t wBulk = x0 + ((width - x0) & ~7);
+
+    for (int32_t y = 0; y < height; y++)
+    {
+        uint16_t const * s  = Row<uint16_t>(src, 0, y);
+        uint16_t const * uv = Row<uint16_t>(src, 1, y / 2);
+        uint32_t *       d  = Row<uint32_t>(dst, 0, y);
+
+        for (int32_t x = x0; x < wBulk; x += 8)
+        {
+            __m256i l = _mm256_srli_epi32(_mm256_cvtepu16_epi32(LOAD128(s + x)), 6);
+            __m256i c = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(LOAD128(uv + x)), dup);
+
+            __m256i u = _mm256_srli_epi32(_mm256_and_si256(c, lo16), 6);
+            __m256i v = _mm256_srli_epi32(c, 22);
+
+            __m256i px = _mm256_or_si256(_mm256_or_si256(u, _mm256_slli_epi32(l, 10)), _mm256_or_si256(_mm256_slli_epi32(v, 20), alpha));
+            STORE256(d + x, px);
+        }
+    }
+
+    if (wBulk < width)
+        P010ToY410_C(src, dst, wBulk, width, height);
+}
+
+} // namespace CC
+} // namespace UMC
+
+#endif // #if defined(__AVX2__)
@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #include "umc_color_space_conversion.h"
+#include "umc_cc_engine.h"
 #include "umc_video_data.h"
 #include "ippi.h"
 #include "ippcc.h"
@@ -263,6 +264,13 @@ Status ColorSpaceConversion::GetFrameInternal(MediaData *input, MediaData *outpu
     SwapValues(pDst[1], pDst[2]);
     SwapValues(pDstStep[1], pDstStep[2]);
   }
+  if (!((srcSize.width | srcSize.height) & 1) && CC::IsSupported(srcFormat, dstFormat)) {
+    CC::Image src = {srcFormat, {(uint8_t*)pSrc[0], (uint8_t*)pSrc[1], (uint8_t*)pSrc[2]},
+                     {(size_t)pSrcStep[0], (size_t)pSrcStep[1], (size_t)pSrcStep[2]}};
+    CC::Image dst = {dstFormat, {pDst[0], pDst[1], pDst[2]},
+                     {(size_t)pDstStep[0], (size_t)pDstStep[1], (size_t)pDstStep[2]}};
+    return CC::Convert(src, dst, srcSize.width, srcSize.height);
+  }
   if (srcFormat == YUV422 && dstFormat != YUV420) { // 422->X as 420->X
     pSrcStep[1] *= 2;
     pSrcStep[2] *= 2;
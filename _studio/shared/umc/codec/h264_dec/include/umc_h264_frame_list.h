@@ -26,6 +26,8 @@
 
 #include "umc_h264_frame.h"
 
+#include <bitset>
+
 namespace UMC
 {
 
@@ -52,15 +54,17 @@ public:
 
     int32_t GetFreeIndex()
     {
-        for (int32_t i = 0; i < 127; i++)
-        {
-            H264DecoderFrame *pFrm;
+        std::bitset<127> used;
 
-            for (pFrm = head(); pFrm && pFrm->m_index != i; pFrm = pFrm->future())
-            {
-            }
+        for (H264DecoderFrame *pFrm = head(); pFrm; pFrm = pFrm->future())
+        {
+            if (pFrm->m_index >= 0 && pFrm->m_index < 127)
+                used.set(pFrm->m_index);
+        }
 
-            if (pFrm == NULL)
+        for (int32_t i = 0; i < 127; i++)
+        {
+            if (!used.test(i))
             {
                 return i;
             }
@@ -69,6 +73,12 @@ public:
         VM_ASSERT(false);
         return -1;
     };
+
+    // Returns the number of frames in the list
+    uint32_t countAllFrames() const
+    {
+        return m_count;
+    }
 protected:
 
     // Release object
@@ -76,6 +86,7 @@ protected:
 
     H264DecoderFrame *m_pHead;                          // (H264DecoderFrame *) pointer to first frame in list
     H264DecoderFrame *m_pTail;                          // (H264DecoderFrame *) pointer to last frame in list
+    uint32_t          m_count;                          // number of frames in list
 };
 
 class H264DBPList : public H264DecoderFrameList
@@ -112,8 +123,6 @@ public:
 
     H264DecoderFrame *findInterViewRef(int32_t auIndex, uint32_t bottomFieldFlag);
 
-    uint32_t countAllFrames();
-
     void countActiveRefs(uint32_t &numShortTerm, uint32_t &numLongTerm);
     // Return number of active int16_t and long term reference frames.
 
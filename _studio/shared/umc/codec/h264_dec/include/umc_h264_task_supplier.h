@@ -130,6 +130,9 @@ public:
     bool IsShouldSkipDeblocking(H264DecoderFrame * pFrame, int32_t field);
     bool IsShouldSkipFrame(H264DecoderFrame * pFrame, int32_t field);
     void ChangeVideoDecodingSpeed(int32_t& num);
+    // decode key pictures only
+    void SetKeyFramesOnly(bool enable);
+    bool IsKeyFramesOnly() const;
     void Reset();
 
     struct SkipInfo
@@ -147,6 +150,7 @@ private:
     int32_t m_ModSkipCycle;
     int32_t m_PermanentTurnOffDeblocking;
     int32_t m_SkipFlag;
+    bool    m_KeyFramesOnly;
 
     int32_t m_NumberOfSkippedFrames;
 };
@@ -594,6 +598,10 @@ protected:
     void InitFrameCounter(H264DecoderFrame *pFrame, const H264Slice *pSlice);
 
     Status AddSlice(H264Slice * pSlice, bool force);
+    // in key frames only mode drops the slices of non-reference pictures before parsing them
+    bool IsShouldSkipNonKeySlice(NalUnit *nalUnit);
+    // in key frames only mode drops the pictures which need references for decoding
+    bool IsShouldSkipNonKeyAU();
     virtual Status CompleteFrame(H264DecoderFrame * pFrame, int32_t m_field_index);
     virtual void OnFullFrame(H264DecoderFrame * pFrame);
     virtual bool ProcessNonPairedField(H264DecoderFrame * pFrame) = 0;
@@ -32,6 +32,7 @@ H264DecoderFrameList::H264DecoderFrameList(void)
 {
     m_pHead = NULL;
     m_pTail = NULL;
+    m_count = 0;
 } // H264DecoderFrameList::H264DecoderFrameList(void)
 
 H264DecoderFrameList::~H264DecoderFrameList(void)
@@ -52,6 +53,7 @@ void H264DecoderFrameList::Release(void)
 
     m_pHead = NULL;
     m_pTail = NULL;
+    m_count = 0;
 
 } // void H264DecoderFrameList::Release(void)
 
@@ -96,7 +98,7 @@ void H264DecoderFrameList::append(H264DecoderFrame *pFrame)
     // The current is now the new tail
     m_pTail = pFrame;
     m_pTail->setFuture(0);
-    //
+    m_count++;
 }
 
 void H264DecoderFrameList::swapFrames(H264DecoderFrame *pFrame1, H264DecoderFrame *pFrame2)
@@ -302,20 +304,6 @@ H264DecoderFrame * H264DBPList::findOldestDisplayable(int32_t /*dbpSize*/ )
 
 }    // findOldestDisplayable
 
-uint32_t H264DBPList::countAllFrames()
-{
-    H264DecoderFrame *pCurr = head();
-    uint32_t count = 0;
-
-    while (pCurr)
-    {
-        count++;
-        pCurr = pCurr->future();
-    }
-
-    return count;
-}
-
 uint32_t H264DBPList::countNumDisplayable(int32_t& maxUID)
 {
     H264DecoderFrame *pCurr = head();
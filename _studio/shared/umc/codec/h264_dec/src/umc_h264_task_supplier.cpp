@@ -1248,6 +1248,7 @@ Skipping::Skipping()
     , m_ModSkipCycle(1)
     , m_PermanentTurnOffDeblocking(0)
     , m_SkipFlag(0)
+    , m_KeyFramesOnly(false)
     , m_NumberOfSkippedFrames(0)
 {
 }
@@ -1262,6 +1263,7 @@ void Skipping::Reset()
     m_SkipCycle = 0;
     m_ModSkipCycle = 0;
     m_PermanentTurnOffDeblocking = 0;
+    m_KeyFramesOnly = false;
     m_NumberOfSkippedFrames = 0;
 }
 
@@ -1370,6 +1372,18 @@ void Skipping::ChangeVideoDecodingSpeed(int32_t & num)
         m_PermanentTurnOffDeblocking = 3;
 }
 
+// key pictures are IDR, intra-only reference pictures and pictures recovered
+// at once by a recovery point SEI, they are decoded without references
+void Skipping::SetKeyFramesOnly(bool enable)
+{
+    m_KeyFramesOnly = enable;
+}
+
+bool Skipping::IsKeyFramesOnly() const
+{
+    return m_KeyFramesOnly;
+}
+
 Skipping::SkipInfo Skipping::GetSkipInfo() const
 {
     Skipping::SkipInfo info;
@@ -3317,6 +3331,9 @@ Status TaskSupplier::AddOneFrame(MediaData * pSource)
         case NAL_UT_AUXILIARY:
         case NAL_UT_CODED_SLICE_EXTENSION:
             {
+            if (IsShouldSkipNonKeySlice(nalUnit))
+                break;
+
             H264Slice * pSlice = DecodeSliceHeader(nalUnit);
             if (pSlice)
             {
@@ -3428,6 +3445,72 @@ bool IsFieldOfOneFrame(const H264DecoderFrame *pFrame, const H264Slice * pSlice1
     return true;
 }
 
+static
+bool IsRecoveryPoint(const SeiPayloadArray *payloads)
+{
+    H264SEIPayLoad * payload = payloads->FindPayload(SEI_RECOVERY_POINT_TYPE);
+    return payload && !payload->SEI_messages.recovery_point.recovery_frame_cnt;
+}
+
+static
+bool IsKeyPicture(const SetOfSlices *setOfSlices)
+{
+    size_t count = setOfSlices->GetSliceCount();
+    if (!count)
+        return false;
+
+    if (setOfSlices->GetSlice(0)->GetSliceHeader()->IdrPicFlag || IsRecoveryPoint(&setOfSlices->m_payloads))
+        return true;
+
+    // intra-only reference picture
+    for (size_t sliceId = 0; sliceId < count; sliceId++)
+    {
+        const H264SliceHeader *sliceHeader = setOfSlices->GetSlice(sliceId)->GetSliceHeader();
+        if (!sliceHeader->nal_ref_idc ||
+            (sliceHeader->slice_type != INTRASLICE && sliceHeader->slice_type != S_INTRASLICE))
+            return false;
+    }
+
+    return true;
+}
+
+bool TaskSupplier::IsShouldSkipNonKeySlice(NalUnit *nalUnit)
+{
+    if (!IsKeyFramesOnly() || NAL_UT_SLICE != nalUnit->GetNalUnitType())
+        return false;
+
+    // all slices of a picture have nal_ref_idc either zero or not
+    if (nalUnit->GetDataSize() && (*(uint8_t*)nalUnit->GetDataPointer() & NAL_STORAGE_IDC_BITS))
+        return false;
+
+    // the SEI comes before the first slice of the picture and is moved to its layer then
+    if (IsRecoveryPoint(&m_accessUnit.m_payloads))
+        return false;
+
+    SetOfSlices * setOfSlices = m_accessUnit.GetLastLayer();
+    return !setOfSlices || !IsRecoveryPoint(&setOfSlices->m_payloads);
+}
+
+bool TaskSupplier::IsShouldSkipNonKeyAU()
+{
+    if (!IsKeyFramesOnly() || !m_accessUnit.GetLayersCount())
+        return false;
+
+    // the base layer decides for the whole access unit
+    if (IsKeyPicture(m_accessUnit.GetLayer(0)))
+        return false;
+
+    // keep the SEI of the next picture in the access unit
+    size_t layersCount = m_accessUnit.GetLayersCount();
+    for (size_t i = 0; i < layersCount; i++)
+    {
+        m_accessUnit.GetLayer(i)->Release();
+    }
+
+    m_accessUnit.Reset();
+    return true;
+}
+
 H264Slice * TaskSupplier::CreateSlice()
 {
     return m_ObjHeap.AllocateObject<H264Slice>();
@@ -3612,6 +3695,13 @@ Status TaskSupplier::AddSlice(H264Slice * pSlice, bool force)
     if ((!pSlice || m_accessUnit.IsFullAU() || !m_accessUnit.AddSlice(pSlice)) && m_accessUnit.GetLayersCount())
     {
         m_pLastSlice = pSlice;
+        if (!m_accessUnit.m_isInitialized && IsShouldSkipNonKeyAU())
+        {
+            m_pLastSlice = 0;
+            // the slice starts the next access unit
+            return pSlice ? AddSlice(pSlice, force) : UMC_ERR_NOT_ENOUGH_DATA;
+        }
+
         if (!m_accessUnit.m_isInitialized)
         {
             InitializeLayers(&m_accessUnit, 0, 0);
@@ -3644,7 +3734,22 @@ Status TaskSupplier::AddSlice(H264Slice * pSlice, bool force)
                     }
                 }
 
-                if (view.GetPOCDecoder(0)->DetectFrameNumGap(slice))
+                if (IsKeyFramesOnly())
+                {
+                    // the pictures between key pictures are dropped, so a key picture
+                    // is decoded with empty reference lists and frame_num gaps are expected
+                    for (H264DecoderFrame *pFrame = view.GetDPBList(0)->head(); pFrame; pFrame = pFrame->future())
+                    {
+                        if (pFrame == view.pCurFrame)
+                            continue;
+
+                        pFrame->SetisShortTermRef(false, 0);
+                        pFrame->SetisShortTermRef(false, 1);
+                        pFrame->SetisLongTermRef(false, 0);
+                        pFrame->SetisLongTermRef(false, 1);
+                    }
+                }
+                else if (view.GetPOCDecoder(0)->DetectFrameNumGap(slice))
                 {
                     view.pCurFrame = 0;
 
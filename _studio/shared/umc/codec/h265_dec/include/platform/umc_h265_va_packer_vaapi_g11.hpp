@@ -167,21 +167,27 @@ namespace UMC_HEVC_DECODER
                 }
             }
 
-            VASliceParameterBufferBase* PackSliceParams(H265Slice const* slice, bool last_slice) override
+            VASliceParameterBufferBase* PeekSliceParams() override
             {
                 if (!(m_va->m_Profile & UMC::VA_PROFILE_REXT) ||
                     ! m_va->IsLongSliceControl())
-                    return G9::PackerVAAPI::PackSliceParams(slice, last_slice);
-
-                VAPictureParameterBufferHEVC* pp = nullptr;
-                GetParamsBuffer(m_va, &pp);
+                    return G9::PackerVAAPI::PeekSliceParams();
 
                 VASliceParameterBufferHEVCExtension* sp = nullptr;
                 PeekParamsBuffer(m_va, &sp);
+                return reinterpret_cast<VASliceParameterBufferBase*>(sp);
+            }
+
+            void PackSliceParams(VASliceParameterBufferBase* sp_base, H265Slice const* slice, VAPictureParameterBufferHEVC const* pp, bool last_slice) override
+            {
+                G9::PackerVAAPI::PackSliceParams(sp_base, slice, pp, last_slice);
 
-                G9::PackerVAAPI::PackSliceParams(reinterpret_cast<VASliceParameterBufferBase*>(sp), slice, last_slice);
+                if (!(m_va->m_Profile & UMC::VA_PROFILE_REXT) ||
+                    ! m_va->IsLongSliceControl())
+                    return;
+
+                auto sp = reinterpret_cast<VASliceParameterBufferHEVCExtension*>(sp_base);
                 PackSliceHeader(m_va, slice, pp, &sp->rext, last_slice);
-                return reinterpret_cast<VASliceParameterBufferBase*>(sp);
             }
         };
     } //G11
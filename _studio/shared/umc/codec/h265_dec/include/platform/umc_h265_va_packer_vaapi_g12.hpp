@@ -132,27 +132,35 @@ namespace UMC_HEVC_DECODER
                 }
             }
 
-            VASliceParameterBufferBase* PackSliceParams(H265Slice const* slice, bool last_slice) override
+            VASliceParameterBufferBase* PeekSliceParams() override
             {
-                VASliceParameterBufferBase* sp_base = nullptr;
                 if (!(m_va->m_Profile & UMC::VA_PROFILE_SCC) ||
                     ! m_va->IsLongSliceControl())
-                    sp_base = G11::PackerVAAPI::PackSliceParams(slice, last_slice);
-                else
-                {
-                    VAPictureParameterBufferHEVC* pp = nullptr;
-                    GetParamsBuffer(m_va, &pp);
+                    return G11::PackerVAAPI::PeekSliceParams();
 
-                    VASliceParameterBufferHEVCExtension* sp = nullptr;
-                    PeekParamsBuffer(m_va, &sp);
+                VASliceParameterBufferHEVCExtension* sp = nullptr;
+                PeekParamsBuffer(m_va, &sp);
+                return reinterpret_cast<VASliceParameterBufferBase*>(sp);
+            }
 
-                    G9::PackerVAAPI::PackSliceParams(reinterpret_cast<VASliceParameterBufferBase*>(sp), slice, last_slice);
+            void PackSliceParams(VASliceParameterBufferBase* sp_base, H265Slice const* slice, VAPictureParameterBufferHEVC const* pp, bool last_slice) override
+            {
+                if (!(m_va->m_Profile & UMC::VA_PROFILE_SCC) ||
+                    ! m_va->IsLongSliceControl())
+                    G11::PackerVAAPI::PackSliceParams(sp_base, slice, pp, last_slice);
+                else
+                {
+                    G9::PackerVAAPI::PackSliceParams(sp_base, slice, pp, last_slice);
 
                     //for SCC we need to pack [VASliceParameterBufferHEVCRext]
+                    auto sp = reinterpret_cast<VASliceParameterBufferHEVCExtension*>(sp_base);
                     G11::PackSliceHeader(m_va, slice, pp, &sp->rext, last_slice);
-                    sp_base = reinterpret_cast<VASliceParameterBufferBase*>(sp);
                 }
 
+                // short slice parameters have no room for the fields below
+                if (!m_va->IsLongSliceControl())
+                    return;
+
                 auto pps = slice->GetPicParam();
                 assert(pps);
 
@@ -165,10 +173,18 @@ namespace UMC_HEVC_DECODER
                     sp->num_entry_point_offsets        = p.second;
                     sp->entry_offset_to_subset_array   = p.first;
                 }
+            }
+
+            void EndSliceParams(VASliceParameterBufferBase* sp_base, H265Slice const* slice, VAPictureParameterBufferHEVC* pp, bool last_slice) override
+            {
+                G11::PackerVAAPI::EndSliceParams(sp_base, slice, pp, last_slice);
+
+                // the subsets buffer is requested from the accelerator, it is not done on the pool
+                auto pps = slice->GetPicParam();
+                assert(pps);
 
-                if (last_slice && pps->tiles_enabled_flag)
+                if (m_va->IsLongSliceControl() && last_slice && pps->tiles_enabled_flag)
                     PackSubsets(slice->GetCurrentFrame());
-                return sp_base;
             }
 
             void PackSubsets(H265DecoderFrame const* frame)
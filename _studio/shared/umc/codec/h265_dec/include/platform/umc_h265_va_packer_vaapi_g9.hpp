@@ -285,8 +285,9 @@ namespace UMC_HEVC_DECODER
         void PackSliceHeader(UMC::VideoAccelerator*, H265Slice const*, VAPictureParameterBufferHEVC const*, VASliceParameterBufferBase*, bool)
         { }
 
+        /* Reference lists aren't packed here, see [FillRPL] */
         inline
-        void PackSliceHeader(UMC::VideoAccelerator* va, H265Slice const* slice, VAPictureParameterBufferHEVC const* pp, VASliceParameterBufferHEVC* sp, bool last_slice)
+        void PackSliceHeader(UMC::VideoAccelerator*, H265Slice const* slice, VAPictureParameterBufferHEVC const* pp, VASliceParameterBufferHEVC* sp, bool last_slice)
         {
             do {
             if (!slice) break;
@@ -299,12 +300,6 @@ namespace UMC_HEVC_DECODER
             sp->slice_data_byte_offset = uint32_t(slice->m_BitStream.BytesDecoded() + 3 /* start code */);
             sp->slice_segment_address  = sh->slice_segment_address;
 
-            auto frame = slice->GetCurrentFrame();
-            if (!frame) break;
-
-            FillRPL(va, slice, pp, sp, PicListT<REF_PIC_LIST_0>{});
-            FillRPL(va, slice, pp, sp, PicListT<REF_PIC_LIST_1>{});
-
             auto& LongSliceFlags = sp->LongSliceFlags.fields;
             LongSliceFlags.LastSliceOfPic = last_slice ? 1 : 0;
             LongSliceFlags.dependent_slice_segment_flag                 = sh->dependent_slice_segment_flag;
@@ -438,9 +433,31 @@ namespace UMC_HEVC_DECODER
                 PackPicHeader(m_va, frame, dpb, pp);
             }
 
-            VASliceParameterBufferBase* PackSliceParams(H265Slice const* slice, bool last_slice) override
+            bool CanPackSlicesInParts(H265DecoderFrame const* frame, TaskSupplier_H265* supplier) override
+            {
+                assert(frame);
+                assert(supplier);
+
+                // short slice parameters don't fix up references
+                if (!m_va->IsLongSliceControl())
+                    return true;
+
+                H265DBPList const* dpb = supplier->GetDPBList();
+                if (!dpb)
+                    throw h265_exception(UMC::UMC_ERR_FAILED);
+
+                VAPictureParameterBufferHEVC pp = {};
+                PackPicHeader(m_va, frame, dpb, &pp);
+
+                // any slice may make 'Foll' reference to be 'Before/After' one (see [SanitizeReferenceFrames]),
+                // w/o such references picture parameters stay as they are packed
+                return std::none_of(pp.ReferenceFrames, pp.ReferenceFrames + std::extent<decltype(pp.ReferenceFrames)>::value,
+                    [](VAPictureHEVC const& p) { return p.picture_id != VA_INVALID_SURFACE && p.flags == 0; }
+                );
+            }
+
+            VASliceParameterBufferBase* PeekSliceParams() override
             {
-                assert(slice);
                 VASliceParameterBufferBase* sp_base = nullptr;
                 if (!m_va->IsLongSliceControl())
                     PeekParamsBuffer(m_va, &sp_base);
@@ -451,60 +468,38 @@ namespace UMC_HEVC_DECODER
                     sp_base = reinterpret_cast<VASliceParameterBufferBase*>(sp);
                 }
 
-                PackSliceParams(sp_base, slice, last_slice);
-
                 return sp_base;
             }
 
-            void PackSliceParams(VASliceParameterBufferBase* sp_base, H265Slice const* slice, bool last_slice) override
+            void PackSliceParams(VASliceParameterBufferBase* sp_base, H265Slice const* slice, VAPictureParameterBufferHEVC const* pp, bool last_slice) override
             {
                 assert(sp_base);
                 assert(slice);
 
+                // short slice parameters hold the slice data only
                 if (m_va->IsLongSliceControl())
-                {
-                    VAPictureParameterBufferHEVC* pp = nullptr;
-                    GetParamsBuffer(m_va, &pp);
-
-                    auto sp = reinterpret_cast<VASliceParameterBufferHEVC*>(sp_base);
-                    PackSliceHeader(m_va, slice, pp, sp, last_slice);
+                    PackSliceHeader(m_va, slice, pp, reinterpret_cast<VASliceParameterBufferHEVC*>(sp_base), last_slice);
+            }
 
-                    SanitizeReferenceFrames(slice, sp, pp, PicListT<REF_PIC_LIST_0>{});
-                    SanitizeReferenceFrames(slice, sp, pp, PicListT<REF_PIC_LIST_1>{});
-                }
+            void EndSliceParams(VASliceParameterBufferBase* sp_base, H265Slice const* slice, VAPictureParameterBufferHEVC* pp, bool) override
+            {
+                assert(sp_base);
+                assert(slice);
 
-                auto bs = slice->GetBitStream();
-                assert(bs);
-
-                uint32_t size = 0;
-                uint32_t* ptr = 0;
-                bs->GetOrg(&ptr, &size);
-                auto src = reinterpret_cast<uint8_t const*>(ptr);
-
-                static uint8_t constexpr start_code[] = { 0, 0, 1 };
-#if defined (MFX_HW_KMB) || defined(MFX_HW_KMB_TARGET)
-                int32_t sc_sz = 0;
-#else
-                int32_t sc_sz = sizeof(start_code);
-#endif
-                uint8_t* dst = nullptr;
-                auto offset = PeekSliceDataBuffer(m_va, &dst, size + sc_sz);
-                if (!dst)
-                    throw h265_exception(UMC::UMC_ERR_FAILED);
+                if (!m_va->IsLongSliceControl())
+                    return;
 
-                // auto xxx = dst;
-                // copy slice data to slice data buffer
-                if (sc_sz)
+                // reference lists take surfaces from the frame allocator and a slice
+                // may fix up references of the picture, so they are packed in order
+                auto sp = reinterpret_cast<VASliceParameterBufferHEVC*>(sp_base);
+                if (slice->GetCurrentFrame())
                 {
-                    std::copy(start_code, start_code + sc_sz, dst);
-                    dst += sizeof(start_code);
+                    FillRPL(m_va, slice, pp, sp, PicListT<REF_PIC_LIST_0>{});
+                    FillRPL(m_va, slice, pp, sp, PicListT<REF_PIC_LIST_1>{});
                 }
-                std::copy(src, src + size, dst);
-
-                sp_base->slice_data_size   = size + sc_sz;
-                sp_base->slice_data_offset = offset;
-                sp_base->slice_data_flag   = VA_SLICE_DATA_FLAG_ALL;
 
+                SanitizeReferenceFrames(slice, sp, pp, PicListT<REF_PIC_LIST_0>{});
+                SanitizeReferenceFrames(slice, sp, pp, PicListT<REF_PIC_LIST_1>{});
             }
         };
     } //G9
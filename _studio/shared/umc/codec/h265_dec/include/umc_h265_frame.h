@@ -35,6 +35,7 @@ namespace UMC_HEVC_DECODER
 class H265Slice;
 class H265DecoderFrameInfo;
 class H265CodingUnit;
+class H265DBPList;
 
 // Struct containing list 0 and list 1 reference picture lists for one slice.
 // Length is plus 1 to provide for null termination.
@@ -240,10 +241,7 @@ public:
     {
         return m_PicOrderCnt;
     }
-    void setPicOrderCnt(int32_t PicOrderCnt)
-    {
-        m_PicOrderCnt = PicOrderCnt;
-    }
+    void setPicOrderCnt(int32_t PicOrderCnt);
 
     bool isLongTermRef() const
     {
@@ -327,6 +325,13 @@ protected:
     static FakeFrameInitializer g_FakeFrameInitializer;
 
     bool CheckReferenceFrameError();
+
+    friend class H265DBPList;
+    // DPB which indexes the frame by its reference marking
+    H265DBPList *m_pDPB;
+
+    // Notifies the DPB about changed reference marking or POC
+    void InvalidateDPBIndex();
 };
 
 // Returns if frame is not needed by decoder
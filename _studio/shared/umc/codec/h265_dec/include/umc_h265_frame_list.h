@@ -25,6 +25,11 @@
 #define __UMC_H265_FRAME_LIST_H__
 
 #include "umc_h265_frame.h"
+#include "umc_mutex.h"
+
+#include <atomic>
+#include <bitset>
+#include <vector>
 
 namespace UMC_HEVC_DECODER
 {
@@ -51,23 +56,30 @@ public:
 
     int32_t GetFreeIndex()
     {
-        for(int32_t i = 0; i < 128; i++)
-        {
-            H265DecoderFrame *pFrm;
+        std::bitset<128> used;
 
-            for (pFrm = head(); pFrm && pFrm->m_index != i; pFrm = pFrm->future())
-            {}
+        for (H265DecoderFrame *pFrm = head(); pFrm; pFrm = pFrm->future())
+        {
+            if (pFrm->m_index >= 0 && pFrm->m_index < 128)
+                used.set(pFrm->m_index);
+        }
 
-            if(pFrm == NULL)
-            {
+        for (int32_t i = 0; i < 128; i++)
+        {
+            if (!used.test(i))
                 return i;
-            }
         }
 
         VM_ASSERT(false);
         return -1;
     };
 
+    // Returns the number of frames in the list
+    uint32_t countAllFrames() const
+    {
+        return m_count;
+    }
+
 protected:
 
     // Release object
@@ -75,6 +87,7 @@ protected:
 
     H265DecoderFrame *m_pHead;                          // (H265DecoderFrame *) pointer to first frame in list
     H265DecoderFrame *m_pTail;                          // (H265DecoderFrame *) pointer to last frame in list
+    uint32_t          m_count;                          // number of frames in list
 };
 
 class H265DBPList : public H265DecoderFrameList
@@ -83,6 +96,9 @@ public:
 
     H265DBPList();
 
+    // Append the given frame to our tail, the list tracks its reference state
+    void append(H265DecoderFrame *pFrame);
+
     // Searches DPB for a reusable frame with biggest POC
     H265DecoderFrame * GetOldestDisposable();
 
@@ -107,11 +123,8 @@ public:
     // Searches DPB for a long term reference frame with specified POC
     H265DecoderFrame *findLongTermRefPic(const H265DecoderFrame *excludeFrame, int32_t picPOC, uint32_t bitsForPOC, bool isUseMask) const;
 
-    // Returns the number of frames in DPB
-    uint32_t countAllFrames();
-
     // Return number of active short and long term reference frames.
-    void countActiveRefs(uint32_t &numShortTerm, uint32_t &numLongTerm);
+    void countActiveRefs(uint32_t &numShortTerm, uint32_t &numLongTerm) const;
 
     // Search through the list for the oldest displayable frame.
     H265DecoderFrame *findOldestDisplayable(int32_t dbpSize);
@@ -139,8 +152,26 @@ public:
     // Debug print
     void printDPB();
 
+    // Drops the reference index, it is rebuilt on the next lookup.
+    // Called by frames of the list when their reference marking or POC changes
+    void InvalidateRefIndex()
+    {
+        m_refIndexValid = false;
+    }
+
 protected:
     int32_t m_dpbSize;
+
+    // Rebuilds the reference index if a frame changed since the last lookup
+    void UpdateRefIndex() const;
+
+    // Reference frames of the list. Reference marking changes once per picture while
+    // the lookups run once per RPS entry of every slice, so the sets are kept between
+    // the changes instead of walking the whole list for every lookup.
+    mutable UMC::Mutex                      m_refIndexGuard;
+    mutable std::atomic<bool>               m_refIndexValid;
+    mutable std::vector<H265DecoderFrame *> m_shortTermRefs;    // sorted by POC, in list order within the same POC
+    mutable std::vector<H265DecoderFrame *> m_longTermRefs;     // in list order
 };
 
 } // end namespace UMC_HEVC_DECODER
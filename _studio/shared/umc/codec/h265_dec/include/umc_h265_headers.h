@@ -28,6 +28,8 @@
 #include "umc_media_data_ex.h"
 #include "umc_h265_heap.h"
 
+#include <string.h>
+
 namespace UMC_HEVC_DECODER
 {
 
@@ -41,6 +43,7 @@ public:
         : m_Header()
         , m_pObjHeap(pObjHeap)
         , m_currentID(-1)
+        , m_updateCount(0)
     {
     }
 
@@ -59,6 +62,12 @@ public:
         }
 
         m_currentID = id;
+        m_updateCount++;
+
+        if (id < m_RawData.size())
+        {
+            m_RawData[id].data.clear();
+        }
 
         if (m_Header[id])
         {
@@ -122,6 +131,49 @@ public:
         VM_ASSERT(m_Header[id] == hdr);
         m_Header[id]->DecrementReference();
         m_Header[id] = 0;
+
+        if (id < m_RawData.size())
+        {
+            m_RawData[id].data.clear();
+        }
+    }
+
+    // Remember the NAL unit bytes the header with given ID was decoded from.
+    // [context] holds the decoder state the decoding depends on besides the bytes
+    void SetRawData(int32_t id, const uint8_t *data, size_t size, uint32_t context)
+    {
+        if (!GetHeader(id) || !data || !size)
+            return;
+
+        if ((uint32_t)id >= m_RawData.size())
+        {
+            m_RawData.resize(id + 1);
+        }
+
+        m_RawData[id].data.assign(data, data + size);
+        m_RawData[id].context = context;
+    }
+
+    // Search for a header decoded from the same NAL unit bytes in the same context
+    T * FindHeaderByRawData(const uint8_t *data, size_t size, uint32_t context)
+    {
+        for (uint32_t i = 0; i < m_RawData.size(); i++)
+        {
+            RawData const& raw = m_RawData[i];
+            if (raw.data.size() == size && raw.context == context && m_Header[i] &&
+                !memcmp(raw.data.data(), data, size))
+            {
+                return m_Header[i];
+            }
+        }
+
+        return 0;
+    }
+
+    // Returns the number of headers added so far
+    uint32_t GetUpdateCount() const
+    {
+        return m_updateCount;
     }
 
     void Reset(bool isPartialReset = false)
@@ -134,6 +186,7 @@ public:
             }
 
             m_Header.clear();
+            m_RawData.clear();
             m_currentID = -1;
         }
     }
@@ -166,10 +219,18 @@ public:
     }
 
 private:
+    struct RawData
+    {
+        std::vector<uint8_t>  data;
+        uint32_t              context;
+    };
+
     std::vector<T*>           m_Header;
+    std::vector<RawData>      m_RawData;
     Heap_Objects             *m_pObjHeap;
 
     int32_t                    m_currentID;
+    uint32_t                   m_updateCount;
 };
 
 /****************************************************************************************************/
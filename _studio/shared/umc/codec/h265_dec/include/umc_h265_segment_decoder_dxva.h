@@ -73,6 +73,12 @@ public:
 
     void PackAllHeaders(H265DecoderFrame * pFrame);
 
+    // Begins the frame in accelerator and sends its slices parsed so far but the newest one,
+    // the frame is ended by [PackAllHeaders] when it is complete
+    void PackPartialFrame(H265DecoderFrame * pFrame);
+    // Ends the frame sent in parts which isn't going to be complete, e.g. it is skipped
+    void EndPartialFrame();
+
     virtual UMC::Status ProcessSegment(void);
 
     int32_t m_CurrentSliceID;
@@ -81,8 +87,15 @@ public:
 
 protected:
 
+    void CreatePacker();
+
     std::unique_ptr<Packer>  m_Packer;
 
+    // frame sent to accelerator in parts and number of its slices sent
+    H265DecoderFrame *       m_pPartialFrame;
+    size_t                   m_partialSlices;
+    H265Slice const *        m_pLastPartialSlice;
+
 private:
     H265_DXVA_SegmentDecoder & operator = (H265_DXVA_SegmentDecoder &)
     {
@@ -80,6 +80,9 @@ public:
     bool IsShouldSkipFrame(H265DecoderFrame * pFrame);
     // Set decoding skip frame mode
     void ChangeVideoDecodingSpeed(int32_t& num);
+    // Decode IRAP pictures only
+    void SetKeyFramesOnly(bool enable);
+    bool IsKeyFramesOnly() const;
     void Reset();
 
     struct SkipInfo
@@ -97,6 +100,7 @@ private:
     int32_t m_SkipCycle;
     int32_t m_ModSkipCycle;
     int32_t m_PermanentTurnOffDeblocking;
+    bool    m_KeyFramesOnly;
 
     int32_t m_NumberOfSkippedFrames;
 };
@@ -481,6 +485,11 @@ private:
     // Decode picture parameters set NAL unit
     UMC::Status xDecodePPS(H265HeadersBitstream *);
 
+    // Reuse the sequence parameters set decoded from the same NAL unit bytes
+    bool xReuseSPS(const uint8_t *data, size_t size, UMC::Status &sts);
+    // Reuse the picture parameters set decoded from the same NAL unit bytes
+    bool xReusePPS(const uint8_t *data, size_t size, UMC::Status &sts);
+
     TaskSupplier_H265 & operator = (TaskSupplier_H265 &)
     {
         return *this;
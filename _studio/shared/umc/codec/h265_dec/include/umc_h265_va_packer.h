@@ -160,6 +160,12 @@ public:
     virtual void EndFrame() = 0;
 
     virtual void PackAU(H265DecoderFrame const*, TaskSupplier_H265*) = 0;
+    /* Packs and executes slices of a picture sent to accelerator in parts, from [first] to the newest one
+       which is left for the last part. The first part packs picture parameters too, the [last] one ends
+       slices of the picture. Returns number of slices of the picture packed so far */
+    virtual size_t PackSlices(H265DecoderFrame const*, TaskSupplier_H265*, size_t first, bool last) = 0;
+    /* Tells if slices of a picture can be sent in parts, they mustn't change picture parameters sent with the first part */
+    virtual bool CanPackSlicesInParts(H265DecoderFrame const*, TaskSupplier_H265*) = 0;
     virtual void PackPicParams(H265DecoderFrame const*, TaskSupplier_H265*) = 0;
     virtual void PackQmatrix(const H265Slice *pSlice) = 0;
 
@@ -28,6 +28,9 @@
 
 #include "umc_h265_task_supplier.h"
 
+#include <algorithm>
+#include <vector>
+
 #ifdef MFX_HW_KMB
 #include "va_hantro/va_hantro.h"
 #endif
@@ -47,6 +50,8 @@ namespace UMC_HEVC_DECODER
 
         PackerVAAPI(UMC::VideoAccelerator* va)
             : Packer(va)
+            , m_picParams()
+            , m_picParamsSent(false)
         {}
 
         UMC::Status GetStatusReport(void*, size_t) override
@@ -60,22 +65,71 @@ namespace UMC_HEVC_DECODER
         { /* Nothing to do */}
 
         void PackAU(H265DecoderFrame const*, TaskSupplier_H265*) override;
+        size_t PackSlices(H265DecoderFrame const*, TaskSupplier_H265*, size_t first, bool last) override;
 
         bool PackSliceParams(H265Slice const* slice, size_t, bool last_slice) override
         { return PackSliceParams(slice, last_slice) ? true : false; }
 
     protected:
 
-        virtual VASliceParameterBufferBase* PackSliceParams(H265Slice const*, bool last_slice) = 0;
+        /* Packs parameters and data of one slice */
+        VASliceParameterBufferBase* PackSliceParams(H265Slice const*, bool last_slice);
         virtual void CreateSliceParamBuffer(size_t count) = 0;
-        virtual void PackSliceParams(VASliceParameterBufferBase* sp_base, H265Slice const* slice, bool last_slice) = 0;
+        /* Reserves the next entry of slice parameters buffer */
+        virtual VASliceParameterBufferBase* PeekSliceParams() = 0;
+        /* Packs the fields of slice parameters which depend on the slice only,
+           slices are packed in any order and on any thread */
+        virtual void PackSliceParams(VASliceParameterBufferBase* sp_base, H265Slice const* slice, VAPictureParameterBufferHEVC const* pp, bool last_slice) = 0;
+        /* Completes slice parameters in bitstream order, a slice may patch picture parameters */
+        virtual void EndSliceParams(VASliceParameterBufferBase* sp_base, H265Slice const* slice, VAPictureParameterBufferHEVC* pp, bool last_slice) = 0;
 	    void PackProcessingInfo(H265DecoderFrameInfo * sliceInfo);
+
+        /* Picture parameters the slices refer to. When the picture is sent in parts
+           the buffer goes with the first one, the next parts use a copy of it */
+        VAPictureParameterBufferHEVC* GetPicParams();
+
+        struct SliceData
+        {
+            uint8_t*       dst;    // start code goes first
+            uint8_t const* src;
+            uint32_t       size;   // w/o start code
+            size_t         offset; // of [dst] in slice data buffer
+        };
+
+        /* Reserves room for slice data and its start code in slice data buffer */
+        SliceData PeekSliceData(H265Slice const* slice);
+        /* Copies slice data to the room reserved by [PeekSliceData] and sets data fields of slice parameters */
+        static void PackSliceData(VASliceParameterBufferBase* sp_base, SliceData const& data);
 		
     private:
         void PackQmatrix(H265Slice const*) override;
 #ifdef MFX_VSI_USE_DEC_MISC
         void PackMisc();
 #endif
+        /* Packs slices [first, end) on the threads of UMC::ThreadPool */
+        void PackSliceRange(H265DecoderFrameInfo const* fi, size_t first, size_t end);
+
+        enum
+        {
+            // handing a task to a worker of the pool takes ~6 us, about the time to copy
+            // 64 KB of slice data (5 GB/s for data not in cache, 25 GB/s for cached one)
+            MIN_BYTES_PER_TASK = 64 * 1024
+        };
+
+        struct SliceParams
+        {
+            H265Slice const*            slice;
+            VASliceParameterBufferBase* sp_base;
+            SliceData                   data;
+            bool                        last;
+            int32_t                     status; // of packing on the pool
+        };
+
+        VAPictureParameterBufferHEVC m_picParams;
+        bool                         m_picParamsSent;
+
+        std::vector<SliceParams>     m_slices;
+        std::vector<size_t>          m_taskSlices; // first slice of every task and the end
     };
 
     template <>
@@ -118,17 +172,18 @@ namespace UMC_HEVC_DECODER
         return p.second;
     }
 
+    /* Creates slice data buffer for [count] slices starting from [first], all slices by default */
     inline
-    void CreateSliceDataBuffer(UMC::VideoAccelerator* va, H265DecoderFrameInfo const* si)
+    void CreateSliceDataBuffer(UMC::VideoAccelerator* va, H265DecoderFrameInfo const* si, size_t first = 0, size_t count = size_t(-1))
     {
         assert(va);
         assert(si);
 
-        auto const count = si->GetSliceCount();
+        count = std::min<size_t>(count, si->GetSliceCount() - first);
         size_t total = 0;
-        for (size_t i = 0; i < count; i++)
+        for (size_t i = first; i < first + count; i++)
         {
-            H265Slice const* slice = si->GetSlice(i);
+            H265Slice const* slice = si->GetSlice(int32_t(i));
             if (!slice)
                 throw h265_exception(UMC::UMC_ERR_FAILED);
 
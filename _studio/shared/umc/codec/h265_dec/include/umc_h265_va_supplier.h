@@ -63,6 +63,11 @@ protected:
 
     virtual void CompleteFrame(H265DecoderFrame * pFrame);
 
+    virtual UMC::Status AddOneFrame(UMC::MediaData * pSource);
+
+    // Sends the slices of incomplete frame parsed so far to accelerator
+    void SubmitPartialFrame(H265DecoderFrame * pFrame);
+
     virtual H265Slice * DecodeSliceHeader(UMC::MediaDataEx *nalUnit);
 
     virtual H265DecoderFrame *GetFrameToDisplayInternal(bool force);
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include "umc_h265_frame.h"
+#include "umc_h265_frame_list.h"
 #include "umc_h265_task_supplier.h"
 #include "umc_h265_debug.h"
 
@@ -43,6 +44,7 @@ H265DecoderFrame::H265DecoderFrame(UMC::MemoryAllocator *pMemoryAllocator, Heap_
     , m_UID(-1)
     , m_pSlicesInfo(nullptr)
     , m_pObjHeap(pObjHeap)
+    , m_pDPB(nullptr)
 {
     m_isShortTermRef = false;
     m_isLongTermRef = false;
@@ -131,6 +133,9 @@ void H265DecoderFrame::Reset()
 
     ResetRefCounter();
 
+    if (m_isShortTermRef || m_isLongTermRef)
+        InvalidateDPBIndex();
+
     m_isShortTermRef = false;
     m_isLongTermRef = false;
 
@@ -234,12 +239,18 @@ void H265DecoderFrame::SetisShortTermRef(bool isRef)
         if (!isShortTermRef() && !isLongTermRef())
             IncrementReference();
 
+        if (!m_isShortTermRef)
+            InvalidateDPBIndex();
+
         m_isShortTermRef = true;
     }
     else
     {
         bool wasRef = isShortTermRef() != 0;
 
+        if (wasRef)
+            InvalidateDPBIndex();
+
         m_isShortTermRef = false;
 
         if (wasRef && !isShortTermRef() && !isLongTermRef())
@@ -258,12 +269,18 @@ void H265DecoderFrame::SetisLongTermRef(bool isRef)
         if (!isShortTermRef() && !isLongTermRef())
             IncrementReference();
 
+        if (!m_isLongTermRef)
+            InvalidateDPBIndex();
+
         m_isLongTermRef = true;
     }
     else
     {
         bool wasRef = isLongTermRef() != 0;
 
+        if (wasRef)
+            InvalidateDPBIndex();
+
         m_isLongTermRef = false;
 
         if (wasRef && !isShortTermRef() && !isLongTermRef())
@@ -274,6 +291,21 @@ void H265DecoderFrame::SetisLongTermRef(bool isRef)
     }
 }
 
+void H265DecoderFrame::setPicOrderCnt(int32_t PicOrderCnt)
+{
+    if (m_PicOrderCnt != PicOrderCnt && (m_isShortTermRef || m_isLongTermRef))
+        InvalidateDPBIndex();
+
+    m_PicOrderCnt = PicOrderCnt;
+}
+
+// Notifies the DPB about changed reference marking or POC
+void H265DecoderFrame::InvalidateDPBIndex()
+{
+    if (m_pDPB)
+        m_pDPB->InvalidateRefIndex();
+}
+
 // Flag frame after it was output
 void H265DecoderFrame::setWasOutputted()
 {
@@ -25,6 +25,8 @@
 #include "umc_h265_debug.h"
 #include "umc_h265_task_supplier.h"
 
+#include <algorithm>
+
 namespace UMC_HEVC_DECODER
 {
 
@@ -32,6 +34,7 @@ H265DecoderFrameList::H265DecoderFrameList(void)
 {
     m_pHead = NULL;
     m_pTail = NULL;
+    m_count = 0;
 } // H265DecoderFrameList::H265DecoderFrameList(void)
 
 H265DecoderFrameList::~H265DecoderFrameList(void)
@@ -52,6 +55,7 @@ void H265DecoderFrameList::Release(void)
 
     m_pHead = NULL;
     m_pTail = NULL;
+    m_count = 0;
 
 } // void H265DecoderFrameList::Release(void)
 
@@ -93,12 +97,49 @@ void H265DecoderFrameList::append(H265DecoderFrame *pFrame)
     // The current is now the new tail
     m_pTail = pFrame;
     m_pTail->setFuture(0);
-    //
+    m_count++;
 }
 
 H265DBPList::H265DBPList()
     : m_dpbSize(0)
+    , m_refIndexValid(false)
+{
+}
+
+// Appends a new frame buffer to the DPB
+void H265DBPList::append(H265DecoderFrame *pFrame)
+{
+    if (!pFrame)
+        return;
+
+    H265DecoderFrameList::append(pFrame);
+
+    pFrame->m_pDPB = this;
+    InvalidateRefIndex();
+}
+
+// Rebuilds the reference index if a frame changed since the last lookup
+void H265DBPList::UpdateRefIndex() const
 {
+    if (m_refIndexValid)
+        return;
+
+    // frames marked after this point invalidate the index again
+    m_refIndexValid = true;
+
+    m_shortTermRefs.clear();
+    m_longTermRefs.clear();
+
+    for (H265DecoderFrame *pCurr = m_pHead; pCurr; pCurr = pCurr->future())
+    {
+        if (pCurr->isShortTermRef())
+            m_shortTermRefs.push_back(pCurr);
+        if (pCurr->isLongTermRef())
+            m_longTermRefs.push_back(pCurr);
+    }
+
+    std::stable_sort(m_shortTermRefs.begin(), m_shortTermRefs.end(),
+        [](const H265DecoderFrame *a, const H265DecoderFrame *b) { return a->PicOrderCnt() < b->PicOrderCnt(); });
 }
 
 // Searches DPB for a reusable frame with biggest POC
@@ -177,78 +218,37 @@ H265DecoderFrame * H265DBPList::GetDisposable(void)
 
 // Search through the list for the oldest displayable frame. It must be
 // not disposable, not outputted, and have smallest PicOrderCnt.
+// Frames of the same POC are output in decoding order.
 H265DecoderFrame * H265DBPList::findOldestDisplayable(int32_t /*dbpSize*/ )
 {
-    H265DecoderFrame *pCurr = m_pHead;
     H265DecoderFrame *pOldest = NULL;
     int32_t  SmallestPicOrderCnt = 0x7fffffff;    // very large positive
     int32_t  LargestRefPicListResetCount = 0;
     int32_t  uid = 0x7fffffff;
 
-    int32_t count = 0;
-    while (pCurr)
+    for (H265DecoderFrame *pCurr = m_pHead; pCurr; pCurr = pCurr->future())
     {
-        if (pCurr->isDisplayable() && !pCurr->wasOutputted())
-        {
-            // corresponding frame
-            if (pCurr->RefPicListResetCount() > LargestRefPicListResetCount)
-            {
-                pOldest = pCurr;
-                SmallestPicOrderCnt = pCurr->PicOrderCnt();
-                LargestRefPicListResetCount = pCurr->RefPicListResetCount();
-            }
-            else if (pCurr->PicOrderCnt() <= SmallestPicOrderCnt && pCurr->RefPicListResetCount() == LargestRefPicListResetCount)
-            {
-                pOldest = pCurr;
-                SmallestPicOrderCnt = pCurr->PicOrderCnt();
-            }
-
-            count++;
-        }
-
-        pCurr = pCurr->future();
-    }
-
-    if (!pOldest)
-        return 0;
+        if (!pCurr->isDisplayable() || pCurr->wasOutputted())
+            continue;
 
-    pCurr = m_pHead;
+        int32_t resetCount = pCurr->RefPicListResetCount();
+        int32_t poc = pCurr->PicOrderCnt();
 
-    while (pCurr)
-    {
-        if (pCurr->isDisplayable() && !pCurr->wasOutputted())
+        // corresponding frame
+        if (resetCount > LargestRefPicListResetCount ||
+            (resetCount == LargestRefPicListResetCount && (!pOldest || poc < SmallestPicOrderCnt ||
+            (poc == SmallestPicOrderCnt && pCurr->m_UID < uid))))
         {
-            // corresponding frame
-            if (pCurr->RefPicListResetCount() == LargestRefPicListResetCount && pCurr->PicOrderCnt() == SmallestPicOrderCnt && pCurr->m_UID < uid)
-            {
-                pOldest = pCurr;
-                SmallestPicOrderCnt = pCurr->PicOrderCnt();
-                LargestRefPicListResetCount = pCurr->RefPicListResetCount();
-                uid = pCurr->m_UID;
-            }
+            pOldest = pCurr;
+            SmallestPicOrderCnt = poc;
+            LargestRefPicListResetCount = resetCount;
+            uid = pCurr->m_UID;
         }
-
-        pCurr = pCurr->future();
     }
 
     return pOldest;
 }    // findOldestDisplayable
 
-// Returns the number of frames in DPB
-uint32_t H265DBPList::countAllFrames()
-{
-    H265DecoderFrame *pCurr = head();
-    uint32_t count = 0;
-
-    while (pCurr)
-    {
-        count++;
-        pCurr = pCurr->future();
-    }
-
-    return count;
-}
-
 void H265DBPList::calculateInfoForDisplay(uint32_t &countDisplayable, uint32_t &countDPBFullness, int32_t &maxUID)
 {
     H265DecoderFrame *pCurr = head();
@@ -285,21 +285,14 @@ void H265DBPList::calculateInfoForDisplay(uint32_t &countDisplayable, uint32_t &
 }    // calculateInfoForDisplay
 
 // Return number of active short and long term reference frames.
-void H265DBPList::countActiveRefs(uint32_t &NumShortTerm, uint32_t &NumLongTerm)
+void H265DBPList::countActiveRefs(uint32_t &NumShortTerm, uint32_t &NumLongTerm) const
 {
-    H265DecoderFrame *pCurr = m_pHead;
-    NumShortTerm = 0;
-    NumLongTerm = 0;
-
-    while (pCurr)
-    {
-        if (pCurr->isShortTermRef())
-            NumShortTerm++;
-        else if (pCurr->isLongTermRef())
-            NumLongTerm++;
-        pCurr = pCurr->future();
-    }
+    UMC::AutomaticUMCMutex guard(m_refIndexGuard);
+    UpdateRefIndex();
 
+    NumShortTerm = (uint32_t)m_shortTermRefs.size();
+    NumLongTerm = (uint32_t)std::count_if(m_longTermRefs.begin(), m_longTermRefs.end(),
+        [](const H265DecoderFrame *frame) { return !frame->isShortTermRef(); });
 }    // countActiveRefs
 
 // Marks all frames as not used as reference frames.
@@ -354,24 +347,18 @@ void H265DBPList::printDPB()
 // Searches DPB for a short term reference frame with specified POC
 H265DecoderFrame *H265DBPList::findShortRefPic(int32_t picPOC)
 {
-    H265DecoderFrame *pCurr = m_pHead;
-
-    while (pCurr)
-    {
-        if (pCurr->isShortTermRef() && pCurr->PicOrderCnt() == picPOC)
-            break;
+    UMC::AutomaticUMCMutex guard(m_refIndexGuard);
+    UpdateRefIndex();
 
-        pCurr = pCurr->future();
-    }
+    auto it = std::lower_bound(m_shortTermRefs.begin(), m_shortTermRefs.end(), picPOC,
+        [](const H265DecoderFrame *frame, int32_t poc) { return frame->PicOrderCnt() < poc; });
 
-    return pCurr;
+    return (it != m_shortTermRefs.end() && (*it)->PicOrderCnt() == picPOC) ? *it : NULL;
 }
 
 // Searches DPB for a long term reference frame with specified POC
 H265DecoderFrame *H265DBPList::findLongTermRefPic(const H265DecoderFrame *excludeFrame, int32_t picPOC, uint32_t bitsForPOC, bool isUseMask) const
 {
-    H265DecoderFrame *pCurr = m_pHead;
-    H265DecoderFrame *pStPic = pCurr;
     uint32_t POCmask = (1 << bitsForPOC) - 1;
 
     if (!isUseMask)
@@ -380,16 +367,16 @@ H265DecoderFrame *H265DBPList::findLongTermRefPic(const H265DecoderFrame *exclud
     int32_t excludeUID = excludeFrame ? excludeFrame->m_UID : 0x7fffffff;
     H265DecoderFrame *correctPic = 0;
 
-    while (pCurr)
+    UMC::AutomaticUMCMutex guard(m_refIndexGuard);
+    UpdateRefIndex();
+
+    for (H265DecoderFrame *pCurr : m_longTermRefs)
     {
         if ((pCurr->PicOrderCnt() & POCmask) == (picPOC & POCmask) && pCurr->m_UID < excludeUID)
         {
-            if (pCurr->isLongTermRef() && (!correctPic || correctPic->m_UID < pCurr->m_UID))
+            if (!correctPic || correctPic->m_UID < pCurr->m_UID)
                 correctPic = pCurr;
-            pStPic = pCurr;
         }
-
-        pCurr = pCurr->future();
     }
 
     return correctPic;
@@ -57,6 +57,9 @@ void H265_DXVA_SegmentDecoderCommon::SetVideoAccelerator(UMC::VideoAccelerator *
 H265_DXVA_SegmentDecoder::H265_DXVA_SegmentDecoder(TaskSupplier_H265 * pTaskSupplier)
     : H265_DXVA_SegmentDecoderCommon(pTaskSupplier)
     , m_CurrentSliceID(0)
+    , m_pPartialFrame(nullptr)
+    , m_partialSlices(0)
+    , m_pLastPartialSlice(nullptr)
 {
 }
 
@@ -69,13 +72,34 @@ UMC::Status H265_DXVA_SegmentDecoder::Init(int32_t iNumber)
     return H265SegmentDecoderBase::Init(iNumber);
 }
 
-void H265_DXVA_SegmentDecoder::PackAllHeaders(H265DecoderFrame * pFrame)
+void H265_DXVA_SegmentDecoder::CreatePacker()
 {
     if (!m_Packer.get())
     {
         m_Packer.reset(Packer::CreatePacker(m_va));
         VM_ASSERT(m_Packer.get());
     }
+}
+
+void H265_DXVA_SegmentDecoder::PackAllHeaders(H265DecoderFrame * pFrame)
+{
+    CreatePacker();
+
+    if (m_pPartialFrame == pFrame)
+    {
+        m_pPartialFrame = nullptr;
+
+        // the slices sent must not be reordered or dropped when the frame was completed
+        if (pFrame->GetAU()->GetSlice(int32_t(m_partialSlices - 1)) != m_pLastPartialSlice)
+            pFrame->SetErrorFlagged(UMC::ERROR_FRAME_MAJOR);
+
+        // the frame is begun by [PackPartialFrame], the slices left end it
+        m_Packer->PackSlices(pFrame, m_pTaskSupplier, m_partialSlices, true);
+        m_Packer->EndFrame();
+        return;
+    }
+
+    EndPartialFrame();
 
     m_Packer->BeginFrame(pFrame);
 
@@ -87,6 +111,52 @@ void H265_DXVA_SegmentDecoder::PackAllHeaders(H265DecoderFrame * pFrame)
     m_Packer->EndFrame();
 }
 
+void H265_DXVA_SegmentDecoder::PackPartialFrame(H265DecoderFrame * pFrame)
+{
+    // the newest slice is left for the last part
+    H265DecoderFrameInfo * pSliceInfo = pFrame->GetAU();
+    size_t const count = pSliceInfo->GetSliceCount();
+    if (count < 2 || (m_pPartialFrame == pFrame && m_partialSlices + 1 >= count))
+        return;
+
+    CreatePacker();
+
+    if (m_pPartialFrame != pFrame)
+    {
+        EndPartialFrame();
+
+        // the frame is sent when it is complete
+        if (!m_Packer->CanPackSlicesInParts(pFrame, m_pTaskSupplier))
+            return;
+
+        UMC::Status sts = m_va->BeginFrame(pFrame->GetFrameMID(), 0);
+        if (sts != UMC::UMC_OK)
+            throw h265_exception(sts);
+
+        m_pPartialFrame = pFrame;
+        m_partialSlices = 0;
+    }
+
+    m_partialSlices = m_Packer->PackSlices(pFrame, m_pTaskSupplier, m_partialSlices, false);
+    m_pLastPartialSlice = pSliceInfo->GetSlice(int32_t(m_partialSlices - 1));
+}
+
+void H265_DXVA_SegmentDecoder::EndPartialFrame()
+{
+    if (!m_pPartialFrame)
+        return;
+
+    // the slices sent can't be taken back, the frame is ended to release the accelerator
+    // and its surface holds a partly decoded picture
+    m_pPartialFrame->SetErrorFlagged(UMC::ERROR_FRAME_MAJOR);
+
+    m_pPartialFrame = nullptr;
+    m_partialSlices = 0;
+    m_pLastPartialSlice = nullptr;
+
+    m_va->EndFrame();
+}
+
 UMC::Status H265_DXVA_SegmentDecoder::ProcessSegment(void)
 {
     MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_HOTSPOTS, "H265_DXVA_SegmentDecoder::ProcessSegment");
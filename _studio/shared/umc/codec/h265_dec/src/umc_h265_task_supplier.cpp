@@ -279,6 +279,7 @@ Skipping_H265::Skipping_H265()
     , m_SkipCycle(1)
     , m_ModSkipCycle(1)
     , m_PermanentTurnOffDeblocking(0)
+    , m_KeyFramesOnly(false)
     , m_NumberOfSkippedFrames(0)
 {
 }
@@ -293,6 +294,7 @@ void Skipping_H265::Reset()
     m_SkipCycle = 0;
     m_ModSkipCycle = 0;
     m_PermanentTurnOffDeblocking = 0;
+    m_KeyFramesOnly = false;
     m_NumberOfSkippedFrames = 0;
 }
 
@@ -331,6 +333,17 @@ void Skipping_H265::ChangeVideoDecodingSpeed(int32_t & num)
         m_PermanentTurnOffDeblocking = 3;
 }
 
+// Decode IRAP pictures only, the others are dropped before their slice headers are parsed
+void Skipping_H265::SetKeyFramesOnly(bool enable)
+{
+    m_KeyFramesOnly = enable;
+}
+
+bool Skipping_H265::IsKeyFramesOnly() const
+{
+    return m_KeyFramesOnly;
+}
+
 // Get current skip mode state
 Skipping_H265::SkipInfo Skipping_H265::GetSkipInfo() const
 {
@@ -1362,12 +1375,72 @@ UMC::Status TaskSupplier_H265::xDecodePPS(H265HeadersBitstream * bs)
     return s;
 }
 
+// Reuse the sequence parameters set decoded from the same NAL unit bytes
+bool TaskSupplier_H265::xReuseSPS(const uint8_t *data, size_t size, UMC::Status &sts)
+{
+    // derived SPS values depend on the highest temporal layer of the previous SPS
+    H265SeqParamSet *sps = m_Headers.m_SeqParams.FindHeaderByRawData(data, size, HighestTid);
+    if (!sps)
+        return false;
+
+    // leave the same state as xDecodeSPS does
+    const H265SeqParamSet * old_sps = m_Headers.m_SeqParams.GetCurrentHeader();
+    bool newResolution = IsNeedSPSInvalidate(old_sps, sps);
+
+    HighestTid = sps->sps_max_sub_layers - 1;
+    sps->m_changed = false;
+
+    m_Headers.m_SeqParams.SetCurrentID(sps->GetID());
+    m_pNALSplitter->SetSuggestedSize(CalculateSuggestedSize(sps));
+
+    sts = newResolution ? UMC::UMC_NTF_NEW_RESOLUTION : UMC::UMC_OK;
+    return true;
+}
+
+// Reuse the picture parameters set decoded from the same NAL unit bytes
+bool TaskSupplier_H265::xReusePPS(const uint8_t *data, size_t size, UMC::Status &sts)
+{
+    // tiles and CTB address tables depend on the SPS, a new SPS invalidates them
+    H265PicParamSet *pps = m_Headers.m_PicParams.FindHeaderByRawData(data, size, m_Headers.m_SeqParams.GetUpdateCount());
+    if (!pps || !m_Headers.m_SeqParams.GetHeader(pps->pps_seq_parameter_set_id))
+        return false;
+
+    pps->m_changed = false;
+    m_Headers.m_PicParams.SetCurrentID(pps->GetID());
+
+    sts = UMC::UMC_OK;
+    return true;
+}
+
 // Decode a bitstream header NAL unit
 UMC::Status TaskSupplier_H265::DecodeHeaders(UMC::MediaDataEx *nalUnit)
 {
     //ViewItem_H265 *view = GetView(BASE_VIEW);
     UMC::Status umcRes = UMC::UMC_OK;
 
+    // Encoders often repeat unchanged SPS and PPS with every IRAP or even every picture,
+    // reuse the headers decoded from the same bytes instead of decoding them again
+    const uint8_t *rawData = (const uint8_t *)nalUnit->GetDataPointer();
+    size_t rawSize = nalUnit->GetDataSize();
+    UMC::MediaDataEx::_MediaDataEx *pMediaDataEx = nalUnit->GetExData();
+    NalUnitType rawType = pMediaDataEx ? (NalUnitType)pMediaDataEx->values[0] : NAL_UT_INVALID;
+    uint32_t rawContext = 0;
+
+    if (rawType == NAL_UT_SPS)
+    {
+        if (xReuseSPS(rawData, rawSize, umcRes))
+            return umcRes;
+
+        rawContext = HighestTid;
+    }
+    else if (rawType == NAL_UT_PPS)
+    {
+        if (xReusePPS(rawData, rawSize, umcRes))
+            return umcRes;
+
+        rawContext = m_Headers.m_SeqParams.GetUpdateCount();
+    }
+
     H265HeadersBitstream bitStream;
 
     try
@@ -1396,9 +1469,17 @@ UMC::Status TaskSupplier_H265::DecodeHeaders(UMC::MediaDataEx *nalUnit)
             break;
         case NAL_UT_SPS:
             umcRes = xDecodeSPS(&bitStream);
+            if ((umcRes == UMC::UMC_OK || umcRes == UMC::UMC_NTF_NEW_RESOLUTION) && nal_unit_type == rawType)
+            {
+                m_Headers.m_SeqParams.SetRawData(m_Headers.m_SeqParams.GetCurrentID(), rawData, rawSize, rawContext);
+            }
             break;
         case NAL_UT_PPS:
             umcRes = xDecodePPS(&bitStream);
+            if (umcRes == UMC::UMC_OK && nal_unit_type == rawType)
+            {
+                m_Headers.m_PicParams.SetRawData(m_Headers.m_PicParams.GetCurrentID(), rawData, rawSize, rawContext);
+            }
             break;
         default:
             break;
@@ -1785,6 +1866,9 @@ UMC::Status TaskSupplier_H265::AddOneFrame(UMC::MediaData * pSource)
             case NAL_UT_CODED_SLICE_CRA:
             case NAL_UT_CODED_SLICE_RADL_R:
             case NAL_UT_CODED_SLICE_RASL_R:
+                if (IsKeyFramesOnly() && (nut < NAL_UT_CODED_SLICE_BLA_W_LP || nut > NAL_UT_CODED_SLICE_CRA))
+                    break;
+
                 if(H265Slice *pSlice = DecodeSliceHeader(nalUnit))
                 {
                     UMC::Status sts = AddSlice(pSlice, !pSource);
@@ -2516,9 +2600,10 @@ void TaskSupplier_H265::InitFrameCounter(H265DecoderFrame * pFrame, const H265Sl
     const H265SliceHeader *sliceHeader = pSlice->GetSliceHeader();
     ViewItem_H265 &view = *GetView();
 
+    // key frames don't keep the previous ones for reference, the pictures using them are dropped
     if (sliceHeader->IdrPicFlag ||
         sliceHeader->nal_unit_type == NAL_UT_CODED_SLICE_BLA_N_LP || sliceHeader->nal_unit_type == NAL_UT_CODED_SLICE_BLA_W_RADL ||
-        sliceHeader->nal_unit_type == NAL_UT_CODED_SLICE_BLA_W_LP)
+        sliceHeader->nal_unit_type == NAL_UT_CODED_SLICE_BLA_W_LP || IsKeyFramesOnly())
     {
         view.pDPB->IncreaseRefPicListResetCount(pFrame);
     }
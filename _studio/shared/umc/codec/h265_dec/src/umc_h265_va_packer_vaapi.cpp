@@ -30,8 +30,20 @@
 
 #include <va/va_dec_hevc.h>
 
+#include "umc_thread_pool.h"
+#include "mfx_common.h" //  for trace routines
+
+#include <algorithm>
+
 namespace UMC_HEVC_DECODER
 {
+    static uint8_t constexpr start_code[] = { 0, 0, 1 };
+#if defined (MFX_HW_KMB) || defined(MFX_HW_KMB_TARGET)
+    static uint32_t constexpr start_code_size = 0;
+#else
+    static uint32_t constexpr start_code_size = sizeof(start_code);
+#endif
+
     void PackerVAAPI::BeginFrame(H265DecoderFrame* frame)
     {
         VAIQMatrixBufferHEVC* qmatrix = nullptr;
@@ -152,40 +164,211 @@ namespace UMC_HEVC_DECODER
         pipelineBuf->surface = m_va->GetSurfaceID(sliceInfo->m_pFrame->m_index); // should filled in packer
         pipelineBuf->additional_outputs = (VASurfaceID*)vpVA->GetCurrentOutputSurface();
     }
+
+    PackerVAAPI::SliceData PackerVAAPI::PeekSliceData(H265Slice const* slice)
+    {
+        assert(slice);
+
+        auto bs = slice->GetBitStream();
+        assert(bs);
+
+        uint32_t size = 0;
+        uint32_t* ptr = 0;
+        bs->GetOrg(&ptr, &size);
+
+        SliceData data = {};
+        data.offset = PeekSliceDataBuffer(m_va, &data.dst, size + start_code_size);
+        if (!data.dst)
+            throw h265_exception(UMC::UMC_ERR_FAILED);
+
+        data.src  = reinterpret_cast<uint8_t const*>(ptr);
+        data.size = size;
+
+        return data;
+    }
+
+    void PackerVAAPI::PackSliceData(VASliceParameterBufferBase* sp_base, SliceData const& data)
+    {
+        assert(sp_base);
+
+        // copy slice data to slice data buffer
+        std::copy(start_code, start_code + start_code_size, data.dst);
+        std::copy(data.src, data.src + data.size, data.dst + start_code_size);
+
+        sp_base->slice_data_size   = data.size + start_code_size;
+        sp_base->slice_data_offset = uint32_t(data.offset);
+        sp_base->slice_data_flag   = VA_SLICE_DATA_FLAG_ALL;
+    }
+
+    VASliceParameterBufferBase* PackerVAAPI::PackSliceParams(H265Slice const* slice, bool last_slice)
+    {
+        assert(slice);
+
+        VAPictureParameterBufferHEVC* pp = GetPicParams();
+        VASliceParameterBufferBase* sp_base = PeekSliceParams();
+
+        PackSliceParams(sp_base, slice, pp, last_slice);
+        PackSliceData(sp_base, PeekSliceData(slice));
+        EndSliceParams(sp_base, slice, pp, last_slice);
+
+        return sp_base;
+    }
+
+    void PackerVAAPI::PackSliceRange(H265DecoderFrameInfo const* fi, size_t first, size_t end)
+    {
+        MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_HOTSPOTS, "PackerVAAPI::PackSliceRange");
+
+        VAPictureParameterBufferHEVC* pp = GetPicParams();
+
+        // parameters and data of slices are placed to buffers in bitstream order,
+        // after that slices don't depend on each other and are packed by the pool
+        m_slices.clear();
+
+        size_t const count_all = fi->GetSliceCount();
+        size_t total = 0;
+        for (size_t n = first; n < end; n++)
+        {
+            auto slice = fi->GetSlice(int32_t(n));
+            if (!slice)
+                throw h265_exception(UMC::UMC_ERR_FAILED);
+
+            SliceParams s = {};
+            s.slice   = slice;
+            s.sp_base = PeekSliceParams();
+            s.data    = PeekSliceData(slice);
+            s.last    = n == count_all - 1;
+            s.status  = UMC::UMC_OK;
+
+            m_slices.push_back(s);
+            total += s.data.size;
+        }
+
+        UMC::ThreadPool & pool = UMC::ThreadPool::GetInstance();
+
+        uint32_t const numTasks = uint32_t(std::min<size_t>(
+            std::min<size_t>(pool.GetNumThreads(), m_slices.size()),
+            std::max<size_t>(1, total / MIN_BYTES_PER_TASK)));
+
+        // a task takes contiguous slices of about the same amount of data
+        m_taskSlices.assign(1, 0);
+        size_t done = 0;
+        for (size_t n = 0; n < m_slices.size(); n++)
+        {
+            done += m_slices[n].data.size;
+            if (done * numTasks >= total * m_taskSlices.size() && m_taskSlices.size() < numTasks)
+                m_taskSlices.push_back(n + 1);
+        }
+        m_taskSlices.push_back(m_slices.size());
+
+        MFX_LTRACE_1(MFX_TRACE_LEVEL_INTERNAL, "Slice packing tasks: ", "%d", int(m_taskSlices.size() - 1));
+
+        pool.ParallelFor(uint32_t(m_taskSlices.size() - 1), [this, pp](uint32_t task)
+        {
+            MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "PackerVAAPI::PackSliceRange task");
+
+            for (size_t n = m_taskSlices[task]; n < m_taskSlices[task + 1]; n++)
+            {
+                SliceParams & s = m_slices[n];
+
+                // tasks of the pool must not throw
+                try
+                {
+                    PackSliceParams(s.sp_base, s.slice, pp, s.last);
+                    PackSliceData(s.sp_base, s.data);
+                }
+                catch (h265_exception const& e)
+                {
+                    s.status = e.GetStatus();
+                }
+                catch (...)
+                {
+                    s.status = UMC::UMC_ERR_FAILED;
+                }
+            }
+        });
+
+        for (SliceParams const& s : m_slices)
+        {
+            if (s.status != UMC::UMC_OK)
+                throw h265_exception(s.status);
+
+            EndSliceParams(s.sp_base, s.slice, pp, s.last);
+        }
+    }
+
+    VAPictureParameterBufferHEVC* PackerVAAPI::GetPicParams()
+    {
+        if (m_picParamsSent)
+            return &m_picParams;
+
+        VAPictureParameterBufferHEVC* pp = nullptr;
+        GetParamsBuffer(m_va, &pp);
+        if (!pp)
+            throw h265_exception(UMC::UMC_ERR_FAILED);
+
+        return pp;
+    }
+
     void PackerVAAPI::PackAU(H265DecoderFrame const* frame, TaskSupplier_H265 * supplier)
+    {
+        PackSlices(frame, supplier, 0, true);
+    }
+
+    size_t PackerVAAPI::PackSlices(H265DecoderFrame const* frame, TaskSupplier_H265 * supplier, size_t first, bool last)
     {
         auto fi = frame->GetAU();
         if (!fi)
             throw h265_exception(UMC::UMC_ERR_FAILED);
 
-        auto count = fi->GetSliceCount();
-        if (!count)
-            return;
+        size_t const count_all = fi->GetSliceCount();
+        size_t const end = last ? count_all : (count_all ? count_all - 1 : 0);
+        if (first >= end)
+            return first;
 
         auto slice = fi->GetSlice(0);
         if (!slice)
-            return;
+            return first;
 
         auto pps = slice->GetPicParam();
         auto sps = slice->GetSeqParam();
         if (!sps || !pps)
             throw h265_exception(UMC::UMC_ERR_FAILED);
 
-        PackPicParams(frame, supplier);
-        if (sps->scaling_list_enabled_flag)
+        if (!first)
         {
-            PackQmatrix(slice);
-        }
+            m_picParamsSent = false;
+
+            PackPicParams(frame, supplier);
+            if (sps->scaling_list_enabled_flag)
+            {
+                PackQmatrix(slice);
+            }
 
 #ifdef MFX_VSI_USE_DEC_MISC
-        PackMisc();
+            PackMisc();
 #endif
+        }
 
+        size_t const count = end - first;
         CreateSliceParamBuffer(count);
-        CreateSliceDataBuffer(m_va, fi);
+        CreateSliceDataBuffer(m_va, fi, first, count);
+
+        PackSliceRange(fi, first, end);
 
-        for (size_t n = 0; n < count; n++)
-            PackSliceParams(fi->GetSlice(int32_t(n)), n, n == count - 1);
+        if (!last)
+        {
+            // the buffer is unmapped by the execution, the next parts read the copy,
+            // [CanPackSlicesInParts] makes sure they don't need to patch it
+            if (!m_picParamsSent)
+                m_picParams = *GetPicParams();
+            m_picParamsSent = true;
+
+            auto s = m_va->ExecutePartial();
+            if (s != UMC::UMC_OK)
+                throw h265_exception(s);
+
+            return end;
+        }
 
 #ifndef MFX_DEC_VIDEO_POSTPROCESS_DISABLE
         if (m_va->GetVideoProcessingVA())
@@ -194,6 +377,8 @@ namespace UMC_HEVC_DECODER
         auto s = m_va->Execute();
         if (s != UMC::UMC_OK)
             throw h265_exception(s);
+
+        return end;
     }
 
 } // namespace UMC_HEVC_DECODER
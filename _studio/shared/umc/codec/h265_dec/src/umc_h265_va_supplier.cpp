@@ -99,6 +99,9 @@ H265DecoderFrame * VATaskSupplier::GetFrameToDisplayInternal(bool force)
 
 void VATaskSupplier::Reset()
 {
+    if (m_pSegmentDecoder && m_pSegmentDecoder[0])
+        ((H265_DXVA_SegmentDecoder *)m_pSegmentDecoder[0])->EndPartialFrame();
+
     if (m_pTaskBroker)
         m_pTaskBroker->Reset();
 
@@ -125,12 +128,67 @@ void VATaskSupplier::CompleteFrame(H265DecoderFrame * pFrame)
     MFXTaskSupplier_H265::CompleteFrame(pFrame);
 
     if (H265DecoderFrameInfo::STATUS_FILLED != pFrame->GetAU()->GetStatus())
+    {
+        // the frame is skipped, its slices sent already have to be ended
+        if (m_va)
+            ((H265_DXVA_SegmentDecoder *)m_pSegmentDecoder[0])->EndPartialFrame();
         return;
+    }
 
     StartDecodingFrame(pFrame);
     EndDecodingFrame();
 }
 
+UMC::Status VATaskSupplier::AddOneFrame(UMC::MediaData * pSource)
+{
+    UMC::Status umcRes = MFXTaskSupplier_H265::AddOneFrame(pSource);
+
+    // all slices of the data are parsed, the frame isn't complete yet
+    if (umcRes == UMC::UMC_ERR_NOT_ENOUGH_DATA && pSource &&
+        (pSource->GetFlags() & UMC::MediaData::FLAG_VIDEO_DATA_COMPLETE_SLICES))
+        SubmitPartialFrame(GetView()->pCurFrame);
+
+    return umcRes;
+}
+
+void VATaskSupplier::SubmitPartialFrame(H265DecoderFrame * pFrame)
+{
+    if (!m_va || !pFrame)
+        return;
+
+    H265DecoderFrameInfo * pSliceInfo = pFrame->GetAU();
+    if (pSliceInfo->GetStatus() != H265DecoderFrameInfo::STATUS_NOT_FILLED)
+        return;
+
+    H265Slice * pFirstSlice = pSliceInfo->GetSlice(0);
+    if (!pFirstSlice)
+        return;
+
+    // RASL frame may be skipped when it is complete
+    H265SliceHeader const* firstHeader = pFirstSlice->GetSliceHeader();
+    if (firstHeader->dependent_slice_segment_flag ||
+        firstHeader->nal_unit_type == NAL_UT_CODED_SLICE_RASL_N ||
+        firstHeader->nal_unit_type == NAL_UT_CODED_SLICE_RASL_R)
+        return;
+
+    // slices sent can't be reordered or dropped on completion of the frame,
+    // the frames which would need it are sent when they are complete
+    uint32_t const count = pSliceInfo->GetSliceCount();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        H265Slice * pSlice = pSliceInfo->GetSlice(i);
+        if (pSlice->IsError() ||
+            (i && pSlice->GetFirstMB() <= pSliceInfo->GetSlice(i - 1)->GetFirstMB()) ||
+            pSlice->GetSliceHeader()->slice_temporal_mvp_enabled_flag != firstHeader->slice_temporal_mvp_enabled_flag)
+            return;
+    }
+
+    for (uint32_t i = 0; i < m_iThreadNum; i++)
+        ((H265_DXVA_SegmentDecoder *)m_pSegmentDecoder[i])->SetVideoAccelerator(m_va);
+
+    ((H265_DXVA_SegmentDecoder *)m_pSegmentDecoder[0])->PackPartialFrame(pFrame);
+}
+
 void VATaskSupplier::InitFrameCounter(H265DecoderFrame * pFrame, const H265Slice *pSlice)
 {
     TaskSupplier_H265::InitFrameCounter(pFrame, pSlice);
@@ -39,7 +39,8 @@ public:
     {
         FLAG_VIDEO_DATA_NOT_FULL_FRAME = 1,
         FLAG_VIDEO_DATA_NOT_FULL_UNIT  = 2,
-        FLAG_VIDEO_DATA_END_OF_STREAM  = 4
+        FLAG_VIDEO_DATA_END_OF_STREAM  = 4,
+        FLAG_VIDEO_DATA_COMPLETE_SLICES = 8  // data ends with a complete slice, it may be decoded before the frame is complete
     };
 
     struct AuxInfo
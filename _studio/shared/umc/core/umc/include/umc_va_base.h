@@ -250,6 +250,9 @@ public:
                                  int32_t            size  = -1,
                                  int32_t            index = -1) = 0; // request buffer
     virtual Status Execute      (void) = 0;          // execute decoding
+    // execute buffers requested after the previous call, next requests get new buffers,
+    // so the picture can be sent in parts before EndFrame
+    virtual Status ExecutePartial(void) { return UMC_ERR_UNSUPPORTED; }
     virtual Status ExecuteExtensionBuffer(void * buffer) = 0;
     virtual Status ExecuteStatusReportBuffer(void * buffer, int32_t size) = 0;
     virtual Status SyncTask(int32_t index, void * error = NULL) = 0;
@@ -0,0 +1,84 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __UMC_THREAD_POOL_H__
+#define __UMC_THREAD_POOL_H__
+
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace UMC
+{
+
+// Persistent pool of worker threads for short data-parallel jobs (picture stripes,
+// slice ranges) issued from codec threads. The calling thread always takes part in
+// its job, so a job completes even if no worker thread could be created.
+class ThreadPool
+{
+public:
+    typedef std::function<void(uint32_t)> Task;
+
+    // numWorkers == 0 creates one worker less than the number of CPUs
+    explicit ThreadPool(uint32_t numWorkers = 0);
+    ~ThreadPool();
+
+    // process-wide pool, workers are created at the first call
+    static ThreadPool & GetInstance();
+
+    // number of threads a job may run on: workers plus the calling thread
+    uint32_t GetNumThreads() const { return (uint32_t)m_workers.size() + 1; }
+
+    // runs task(i) for every i in [0, numTasks) and returns when all of them are done,
+    // task must not throw
+    void ParallelFor(uint32_t numTasks, Task const & task);
+
+private:
+    struct Job
+    {
+        Task const *            task;
+        uint32_t                numTasks;
+        uint32_t                next;     // first index not taken yet
+        uint32_t                done;
+        std::condition_variable finished;
+    };
+
+    // takes next index of the job, the job leaves the queue with its last index
+    uint32_t TakeIndex(Job & job);
+    void RunIndex(std::unique_lock<std::mutex> & lock, Job & job, uint32_t index);
+    void WorkerLoop();
+
+    std::mutex               m_mutex;
+    std::condition_variable  m_wake;
+    std::deque<Job *>        m_jobs;
+    bool                     m_stop;
+    std::vector<std::thread> m_workers;
+
+    ThreadPool(ThreadPool const &);
+    ThreadPool & operator=(ThreadPool const &);
+};
+
+} // namespace UMC
+
+#endif // __UMC_THREAD_POOL_H__
@@ -0,0 +1,137 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "umc_thread_pool.h"
+
+#include <algorithm>
+#include <system_error>
+
+namespace UMC
+{
+
+ThreadPool::ThreadPool(uint32_t numWorkers)
+    : m_stop(false)
+{
+    if (!numWorkers)
+        numWorkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+    m_workers.reserve(numWorkers);
+
+    // the pool runs with as many workers as the system lets it create, down to none
+    for (uint32_t i = 0; i < numWorkers; i++)
+    {
+        try
+        {
+            m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+        catch (std::system_error const &)
+        {
+            break;
+        }
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread & t : m_workers)
+        t.join();
+}
+
+ThreadPool & ThreadPool::GetInstance()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+uint32_t ThreadPool::TakeIndex(Job & job)
+{
+    uint32_t index = job.next++;
+
+    if (job.next == job.numTasks)
+        m_jobs.erase(std::find(m_jobs.begin(), m_jobs.end(), &job));
+
+    return index;
+}
+
+void ThreadPool::RunIndex(std::unique_lock<std::mutex> & lock, Job & job, uint32_t index)
+{
+    lock.unlock();
+    (*job.task)(index);
+    lock.lock();
+
+    if (++job.done == job.numTasks)
+        job.finished.notify_all();
+}
+
+void ThreadPool::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;)
+    {
+        m_wake.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+
+        if (m_stop)
+            return;
+
+        Job & job = *m_jobs.front();
+        RunIndex(lock, job, TakeIndex(job));
+    }
+}
+
+void ThreadPool::ParallelFor(uint32_t numTasks, Task const & task)
+{
+    if (numTasks <= 1 || m_workers.empty())
+    {
+        for (uint32_t i = 0; i < numTasks; i++)
+            task(i);
+        return;
+    }
+
+    Job job;
+    job.task     = &task;
+    job.numTasks = numTasks;
+    job.next     = 0;
+    job.done     = 0;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_jobs.push_back(&job);
+
+    if (numTasks - 1 < m_workers.size())
+        for (uint32_t i = 0; i < numTasks - 1; i++)
+            m_wake.notify_one();
+    else
+        m_wake.notify_all();
+
+    // caller works on its own job until all indices are taken
+    while (job.next < job.numTasks)
+        RunIndex(lock, job, TakeIndex(job));
+
+    job.finished.wait(lock, [&job] { return job.done == job.numTasks; });
+}
+
+} // namespace UMC
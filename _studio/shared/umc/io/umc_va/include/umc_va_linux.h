@@ -22,9 +22,13 @@
 #define __UMC_VA_LINUX_H__
 
 #include "umc_va_base.h"
+#include "umc_va_linux_buffer_pool.h"
 
 
+#include <chrono>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace UMC
 {
@@ -111,6 +115,7 @@ public:
     // gets buffer from cache if it exists or HW otherwise, buffers will be released in EndFrame
     virtual void* GetCompBuffer(int32_t buffer_type, UMCVACompBuffer **buf, int32_t size, int32_t index);
     virtual Status Execute      (void);
+    virtual Status ExecutePartial(void);
     virtual Status EndFrame     (void*);
     virtual int32_t GetSurfaceID (int32_t idx);
 
@@ -133,6 +138,8 @@ protected:
 
     // LinuxVideoAccelerator methods
     uint16_t GetDecodingError();
+    // whether Execute() sets the number of elements of slice parameter buffers
+    bool NeedSetNumElements(void) const;
 
     void SetTraceStrings(uint32_t umc_codec);
 
@@ -142,12 +149,24 @@ protected:
     VAContextID*  m_pContext;
     bool*         m_pKeepVAState;
     lvaFrameState m_FrameState;
+    // surface of the frame between BeginFrame() and EndFrame()
+    VASurfaceID   m_RenderTarget;
 
     int32_t   m_NumOfFrameBuffers;
     uint32_t   m_uiCompBuffersNum;
     uint32_t   m_uiCompBuffersUsed;
+    // buffers before this one are rendered by ExecutePartial(), they aren't requested nor rendered again
+    uint32_t   m_uiCompBuffersRendered;
     std::mutex m_SyncMutex;
     VACompBuffer** m_pCompBuffers;
+    // buffers of the context reused by frames
+    std::unique_ptr<VABufferBackend> m_bufferBackend;
+    std::unique_ptr<VABufferPool>    m_bufferPool;
+    // buffers passed to vaRenderPicture by Execute()
+    std::vector<VABufferID> m_RenderBuffers;
+    // submission of the current frame, traced at EndFrame()
+    std::chrono::steady_clock::duration m_SubmitWallTime;
+    uint32_t                            m_SubmitBuffers;
 
     const char * m_sDecodeTraceStart;
     const char * m_sDecodeTraceEnd;
@@ -0,0 +1,139 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __UMC_VA_LINUX_BUFFER_POOL_H__
+#define __UMC_VA_LINUX_BUFFER_POOL_H__
+
+#include <va/va.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace UMC
+{
+
+/* VABufferBackend -----------------------------------------------------------*/
+
+// Driver calls made by the pool, a test can provide its own implementation
+class VABufferBackend
+{
+public:
+    virtual ~VABufferBackend(void) {}
+
+    virtual VAStatus CreateBuffer (VABufferType type, uint32_t size, uint32_t numElements, VABufferID* id) = 0;
+    virtual VAStatus MapBuffer    (VABufferID id, void** ptr) = 0;
+    virtual VAStatus DestroyBuffer(VABufferID id) = 0;
+    virtual VAStatus QuerySurfaceStatus(VASurfaceID surface, VASurfaceStatus* status) = 0;
+};
+
+class VAContextBufferBackend : public VABufferBackend
+{
+public:
+    VAContextBufferBackend(VADisplay dpy, VAContextID context)
+        : m_dpy(dpy)
+        , m_context(context)
+    {}
+
+    virtual VAStatus CreateBuffer (VABufferType type, uint32_t size, uint32_t numElements, VABufferID* id);
+    virtual VAStatus MapBuffer    (VABufferID id, void** ptr);
+    virtual VAStatus DestroyBuffer(VABufferID id);
+    virtual VAStatus QuerySurfaceStatus(VASurfaceID surface, VASurfaceStatus* status);
+
+protected:
+    VADisplay   m_dpy;
+    VAContextID m_context;
+};
+
+/* VABufferPool --------------------------------------------------------------*/
+
+// Keeps the buffers of a VA context for reuse across frames instead of
+// creating and destroying them for every picture.
+// Buffers are matched by type and element size: parameter buffers need the exact
+// number of elements, unless the caller rounds it up itself, data buffers
+// (slice data, bitplanes) are created in size classes and grow with the stream.
+// A released buffer is handed out again only when the surface the picture was
+// rendered to has completed, not to write into a buffer the device may still read.
+// The pool isn't thread safe.
+class VABufferPool
+{
+public:
+    struct Buffer
+    {
+        VABufferID   id;
+        uint32_t     size;        // element size
+        uint32_t     numElements;
+        void*        ptr;         // mapped data
+    };
+
+    VABufferPool(VABufferBackend* backend, bool bExactSize = false, uint32_t maxFree = 64);
+    ~VABufferPool(void);
+
+    // returns a mapped buffer holding at least numElements elements of the given size
+    VAStatus Acquire(VABufferType type, uint32_t size, uint32_t numElements, Buffer& buffer);
+    // gives back the unmapped buffer when the picture rendered to the surface is submitted
+    void     Release(VABufferID id, VASurfaceID surface);
+    // destroys the buffer instead of giving it back, e.g. after a failure
+    VAStatus Discard(VABufferID id);
+    // marks the end of a picture, buffers released earlier are older
+    void     NextFrame(void);
+    // destroys all buffers, ones in use too
+    VAStatus Reset(void);
+
+    size_t GetNumBuffers(void) const { return m_buffers.size(); }
+    size_t GetNumFree(void) const;
+
+    // data buffers of a size are created with this size
+    static uint32_t GetSizeClass(uint32_t size);
+    // whether buffers of the type are matched by size in bytes
+    static bool IsDataBuffer(VABufferType type);
+
+protected:
+    struct Entry
+    {
+        VABufferID   id;
+        VABufferType type;
+        uint32_t     size;
+        uint32_t     numElements;
+        bool         bFree;
+        bool         bDone;       // the device is done with the buffer
+        VASurfaceID  surface;     // render target of the picture the buffer was released with
+        uint64_t     releaseFrame;
+    };
+
+    bool     IsReusable(Entry& entry, VABufferType type, uint32_t size, uint32_t numElements);
+    // queries the surface of the entry, a completed surface frees all buffers rendered to it
+    bool     IsSurfaceDone(Entry& entry);
+    VAStatus DestroyEntry(size_t i);
+    void     Trim(void);
+
+    VABufferBackend*   m_backend;
+    bool               m_bExactSize;
+    uint32_t           m_maxFree;
+    uint64_t           m_frame;
+    std::vector<Entry> m_buffers;
+
+private:
+    VABufferPool(const VABufferPool&);
+    VABufferPool& operator=(const VABufferPool&);
+};
+
+}; // namespace UMC
+
+#endif // #ifndef __UMC_VA_LINUX_BUFFER_POOL_H__
@@ -305,11 +305,13 @@ LinuxVideoAccelerator::LinuxVideoAccelerator(void)
     m_pConfigId  = NULL;
     m_pKeepVAState = NULL;
     m_FrameState = lvaBeforeBegin;
+    m_RenderTarget = VA_INVALID_SURFACE;
 
     m_pCompBuffers  = NULL;
     m_NumOfFrameBuffers = 0;
     m_uiCompBuffersNum  = 0;
     m_uiCompBuffersUsed = 0;
+    m_uiCompBuffersRendered = 0;
 
 #if defined(ANDROID)
     m_isUseStatuReport  = false;
@@ -319,6 +321,9 @@ LinuxVideoAccelerator::LinuxVideoAccelerator(void)
 
     m_bH264MVCSupport   = false;
     memset(&m_guidDecoder, 0 , sizeof(GUID));
+
+    m_SubmitWallTime = std::chrono::steady_clock::duration::zero();
+    m_SubmitBuffers  = 0;
 }
 
 LinuxVideoAccelerator::~LinuxVideoAccelerator(void)
@@ -563,6 +568,10 @@ Status LinuxVideoAccelerator::Init(VideoAcceleratorParams* pInfo)
         delete[] va_entrypoints;
     }
 
+    // buffers of the previous context
+    m_bufferPool.reset();
+    m_bufferBackend.reset();
+
     // creating context
     if (UMC_OK == umcRes)
     {
@@ -591,6 +600,18 @@ Status LinuxVideoAccelerator::Init(VideoAcceleratorParams* pInfo)
         }
     }
 
+    if (UMC_OK == umcRes)
+    {
+        // the size of parameter buffers is kept as asked for, the driver doesn't resize them on KMB
+#if defined(MFX_HW_KMB)
+        const bool bExactSize = true;
+#else
+        const bool bExactSize = false;
+#endif
+        m_bufferBackend.reset(new VAContextBufferBackend(m_dpy, *m_pContext));
+        m_bufferPool.reset(new VABufferPool(m_bufferBackend.get(), bExactSize));
+    }
+
     return umcRes;
 }
 
@@ -602,17 +623,25 @@ Status LinuxVideoAccelerator::Close(void)
     {
         for (uint32_t i = 0; i < m_uiCompBuffersUsed; ++i)
         {
-            if (m_pCompBuffers[i]->NeedDestroy() && (NULL != m_dpy))
+            if (m_pCompBuffers[i]->NeedDestroy() && m_bufferPool)
             {
-                VABufferID id = m_pCompBuffers[i]->GetID();
-                mfxStatus sts = CheckAndDestroyVAbuffer(m_dpy, id);
-                std::ignore = MFX_STS_TRACE(sts);
+                VAStatus vaSts = m_bufferPool->Discard(m_pCompBuffers[i]->GetID());
+                std::ignore = MFX_STS_TRACE(vaSts);
             }
             UMC_DELETE(m_pCompBuffers[i]);
         }
         delete[] m_pCompBuffers;
         m_pCompBuffers = nullptr;
     }
+    if (m_bufferPool)
+    {
+        // buffers go before the context
+        VAStatus vaSts = m_bufferPool->Reset();
+        std::ignore = MFX_STS_TRACE(vaSts);
+
+        m_bufferPool.reset();
+        m_bufferBackend.reset();
+    }
     if (NULL != m_dpy)
     {
         if ((m_pContext && (*m_pContext != VA_INVALID_ID)) && !(m_pKeepVAState && *m_pKeepVAState))
@@ -641,6 +670,7 @@ Status LinuxVideoAccelerator::Close(void)
     m_FrameState = lvaBeforeBegin;
     m_uiCompBuffersNum  = 0;
     m_uiCompBuffersUsed = 0;
+    m_uiCompBuffersRendered = 0;
 
     return VideoAccelerator::Close();
 }
@@ -668,7 +698,11 @@ Status LinuxVideoAccelerator::BeginFrame(int32_t FrameBufIndex)
                 va_res = vaBeginPicture(m_dpy, *m_pContext, *surface);
             }
             umcRes = va_to_umc_res(va_res);
-            if (UMC_OK == umcRes) m_FrameState = lvaBeforeEnd;
+            if (UMC_OK == umcRes)
+            {
+                m_FrameState   = lvaBeforeEnd;
+                m_RenderTarget = *surface;
+            }
         }
     }
     return umcRes;
@@ -711,7 +745,7 @@ void* LinuxVideoAccelerator::GetCompBuffer(int32_t buffer_type, UMCVACompBuffer
     if (NULL != buf) *buf = NULL;
 
     std::lock_guard<std::mutex> guard(m_SyncMutex);
-    for (i = 0; i < m_uiCompBuffersUsed; ++i)
+    for (i = m_uiCompBuffersRendered; i < m_uiCompBuffersUsed; ++i)
     {
         pCompBuf = m_pCompBuffers[i];
         if ((pCompBuf->GetType() == buffer_type) && (pCompBuf->GetIndex() == index)) break;
@@ -738,11 +772,12 @@ VACompBuffer* LinuxVideoAccelerator::GetCompBufferHW(int32_t type, int32_t size,
 {
     MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "GetCompBufferHW");
     VAStatus   va_res = VA_STATUS_SUCCESS;
-    VABufferID id;
-    uint8_t*      buffer = NULL;
-    uint32_t     buffer_size = 0;
+    VABufferPool::Buffer buffer = {};
     VACompBuffer* pCompBuffer = NULL;
 
+    if (!m_bufferPool)
+        return NULL;
+
     if (VA_STATUS_SUCCESS == va_res)
     {
         VABufferType va_type         = (VABufferType)type;
@@ -812,25 +847,40 @@ VACompBuffer* LinuxVideoAccelerator::GetCompBufferHW(int32_t type, int32_t size,
             va_size         = size;
             va_num_elements = 1;
         }
-        buffer_size = va_size * va_num_elements;
 
-        va_res = vaCreateBuffer(m_dpy, *m_pContext, va_type, va_size, va_num_elements, NULL, &id);
-    }
-    if (VA_STATUS_SUCCESS == va_res)
-    {
-        va_res = vaMapBuffer(m_dpy, id, (void**)&buffer);
+        // Execute() sets the actual number of slices, so a buffer of more slices
+        // can be taken and the slice buffers of the next frames fit in it
+        if ((VASliceParameterBufferType == va_type) && NeedSetNumElements() && va_num_elements)
+        {
+            unsigned int num_elements = 1;
+            while (num_elements < va_num_elements)
+                num_elements <<= 1;
+            va_num_elements = num_elements;
+        }
+
+        va_res = m_bufferPool->Acquire(va_type, va_size, va_num_elements, buffer);
     }
     if (VA_STATUS_SUCCESS == va_res)
     {
         pCompBuffer = new VACompBuffer();
-        pCompBuffer->SetBufferPointer(buffer, buffer_size);
+        pCompBuffer->SetBufferPointer((uint8_t*)buffer.ptr, buffer.size * buffer.numElements);
         pCompBuffer->SetDataSize(0);
-        pCompBuffer->SetBufferInfo(type, id, index);
+        pCompBuffer->SetBufferInfo(type, buffer.id, index);
         pCompBuffer->SetDestroyStatus(true);
     }
     return pCompBuffer;
 }
 
+bool LinuxVideoAccelerator::NeedSetNumElements(void) const
+{
+    return !m_bH264ShortSlice
+#if defined (MFX_HW_KMB)
+        && ((m_Profile & VA_CODEC) != UMC::VA_H265)
+        && ((m_Profile & VA_CODEC) != UMC::VA_VP9)
+#endif
+        ;
+}
+
 Status
 LinuxVideoAccelerator::Execute()
 {
@@ -845,17 +895,17 @@ LinuxVideoAccelerator::Execute()
     if (UMC_OK == umcRes)
     {
         std::lock_guard<std::mutex> guard(m_SyncMutex);
-        for (i = 0; i < m_uiCompBuffersUsed; i++)
+#ifdef MFX_TRACE_ENABLE
+        auto start = std::chrono::steady_clock::now();
+#endif
+
+        m_RenderBuffers.clear();
+        for (i = m_uiCompBuffersRendered; i < m_uiCompBuffersUsed; i++)
         {
             pCompBuf = m_pCompBuffers[i];
             id = pCompBuf->GetID();
 
-            if (!m_bH264ShortSlice
-#if defined (MFX_HW_KMB)
-            && ((m_Profile & VA_CODEC) != UMC::VA_H265)
-            && ((m_Profile & VA_CODEC) != UMC::VA_VP9)
-#endif
-            )
+            if (NeedSetNumElements())
             {
                 if (pCompBuf->GetType() == VASliceParameterBufferType)
                 {
@@ -867,13 +917,22 @@ LinuxVideoAccelerator::Execute()
             va_sts = vaUnmapBuffer(m_dpy, id);
             if (VA_STATUS_SUCCESS == va_res) va_res = va_sts;
 
+            m_RenderBuffers.push_back(id);
+        }
 
-            {
-                MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_EXTCALL, "vaRenderPicture");
-                va_sts = vaRenderPicture(m_dpy, *m_pContext, &id, 1); // TODO: send all at once?
-                if (VA_STATUS_SUCCESS == va_res) va_res = va_sts;
-            }
+        // all buffers at once, the driver takes them in the order they were
+        // requested, so slice parameters stay followed by their slice data
+        if (!m_RenderBuffers.empty())
+        {
+            MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_EXTCALL, "vaRenderPicture");
+            va_sts = vaRenderPicture(m_dpy, *m_pContext, m_RenderBuffers.data(), (int)m_RenderBuffers.size());
+            if (VA_STATUS_SUCCESS == va_res) va_res = va_sts;
         }
+
+#ifdef MFX_TRACE_ENABLE
+        m_SubmitWallTime += std::chrono::steady_clock::now() - start;
+        m_SubmitBuffers += (uint32_t)m_RenderBuffers.size();
+#endif
     }
 
     if (UMC_OK == umcRes)
@@ -883,6 +942,17 @@ LinuxVideoAccelerator::Execute()
     return umcRes;
 }
 
+Status LinuxVideoAccelerator::ExecutePartial()
+{
+    Status umcRes = Execute();
+
+    // the rendered buffers are unmapped, they stay with the picture till EndFrame()
+    std::lock_guard<std::mutex> guard(m_SyncMutex);
+    m_uiCompBuffersRendered = m_uiCompBuffersUsed;
+
+    return umcRes;
+}
+
 Status LinuxVideoAccelerator::EndFrame(void*)
 {
     MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "EndFrame");
@@ -892,8 +962,20 @@ Status LinuxVideoAccelerator::EndFrame(void*)
 
     {
         MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_EXTCALL, "vaEndPicture");
+#ifdef MFX_TRACE_ENABLE
+        auto start = std::chrono::steady_clock::now();
+#endif
         va_res = vaEndPicture(m_dpy, *m_pContext);
         MFX_LTRACE_2(MFX_TRACE_LEVEL_EXTCALL, m_sDecodeTraceEnd, "%d|%d", *m_pContext, 0);
+#ifdef MFX_TRACE_ENABLE
+        m_SubmitWallTime += std::chrono::steady_clock::now() - start;
+
+        // wall time of the frame spent in Execute() and vaEndPicture, waits for the driver included
+        MFX_LTRACE_2(MFX_TRACE_LEVEL_INTERNAL, "Frame submit: ", "%u buffers, %u us wall", m_SubmitBuffers,
+            (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(m_SubmitWallTime).count());
+        m_SubmitWallTime = std::chrono::steady_clock::duration::zero();
+        m_SubmitBuffers  = 0;
+#endif
     }
     std::ignore = MFX_STS_TRACE(va_res);
     Status stsRet = va_to_umc_res(va_res);
@@ -902,18 +984,15 @@ Status LinuxVideoAccelerator::EndFrame(void*)
 
     for (uint32_t i = 0; i < m_uiCompBuffersUsed; ++i)
     {
+        // the buffer is unmapped by Execute(), it goes back to the pool till the surface is decoded
         if (m_pCompBuffers[i]->NeedDestroy())
-        {
-            VABufferID id = m_pCompBuffers[i]->GetID();
-            mfxStatus sts = CheckAndDestroyVAbuffer(m_dpy, id);
-            std::ignore = MFX_STS_TRACE(sts);
-
-            if (sts != MFX_ERR_NONE)
-                stsRet = UMC_ERR_FAILED;
-        }
+            m_bufferPool->Release(m_pCompBuffers[i]->GetID(), m_RenderTarget);
         UMC_DELETE(m_pCompBuffers[i]);
     }
     m_uiCompBuffersUsed = 0;
+    m_uiCompBuffersRendered = 0;
+    if (m_bufferPool)
+        m_bufferPool->NextFrame();
 
     return stsRet;
 }
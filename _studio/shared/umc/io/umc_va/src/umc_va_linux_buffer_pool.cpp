@@ -0,0 +1,277 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "umc_va_linux_buffer_pool.h"
+
+#include <algorithm>
+
+namespace UMC
+{
+
+// smallest data buffer, smaller requests share its class
+static const uint32_t VA_BUFFER_POOL_MIN_DATA_SIZE = 4096;
+// above it data buffers grow in steps of this size instead of doubling
+static const uint32_t VA_BUFFER_POOL_DATA_STEP     = 1024 * 1024;
+
+VAStatus VAContextBufferBackend::CreateBuffer(VABufferType type, uint32_t size, uint32_t numElements, VABufferID* id)
+{
+    return vaCreateBuffer(m_dpy, m_context, type, size, numElements, NULL, id);
+}
+
+VAStatus VAContextBufferBackend::MapBuffer(VABufferID id, void** ptr)
+{
+    return vaMapBuffer(m_dpy, id, ptr);
+}
+
+VAStatus VAContextBufferBackend::DestroyBuffer(VABufferID id)
+{
+    return vaDestroyBuffer(m_dpy, id);
+}
+
+VAStatus VAContextBufferBackend::QuerySurfaceStatus(VASurfaceID surface, VASurfaceStatus* status)
+{
+    return vaQuerySurfaceStatus(m_dpy, surface, status);
+}
+
+VABufferPool::VABufferPool(VABufferBackend* backend, bool bExactSize, uint32_t maxFree)
+    : m_backend(backend)
+    , m_bExactSize(bExactSize)
+    , m_maxFree(maxFree)
+    , m_frame(0)
+{
+}
+
+VABufferPool::~VABufferPool(void)
+{
+    Reset();
+}
+
+uint32_t VABufferPool::GetSizeClass(uint32_t size)
+{
+    if (size <= VA_BUFFER_POOL_MIN_DATA_SIZE)
+        return VA_BUFFER_POOL_MIN_DATA_SIZE;
+
+    if (size > VA_BUFFER_POOL_DATA_STEP)
+        return (size + VA_BUFFER_POOL_DATA_STEP - 1) / VA_BUFFER_POOL_DATA_STEP * VA_BUFFER_POOL_DATA_STEP;
+
+    uint32_t sizeClass = VA_BUFFER_POOL_MIN_DATA_SIZE;
+    while (sizeClass < size)
+        sizeClass <<= 1;
+    return sizeClass;
+}
+
+bool VABufferPool::IsDataBuffer(VABufferType type)
+{
+    return (VASliceDataBufferType == type) || (VABitPlaneBufferType == type);
+}
+
+size_t VABufferPool::GetNumFree(void) const
+{
+    return std::count_if(m_buffers.begin(), m_buffers.end(),
+        [](const Entry& entry) { return entry.bFree; });
+}
+
+bool VABufferPool::IsSurfaceDone(Entry& entry)
+{
+    VASurfaceStatus status = VASurfaceRendering;
+
+    // a surface which can't be queried keeps its buffers till they are trimmed
+    if (VA_STATUS_SUCCESS != m_backend->QuerySurfaceStatus(entry.surface, &status) || (status & VASurfaceRendering))
+        return false;
+
+    // pictures rendered to the surface before are done too
+    for (Entry& other : m_buffers)
+    {
+        if (other.bFree && other.surface == entry.surface)
+            other.bDone = true;
+    }
+    return true;
+}
+
+bool VABufferPool::IsReusable(Entry& entry, VABufferType type, uint32_t size, uint32_t numElements)
+{
+    if (!entry.bFree || (entry.type != type))
+        return false;
+
+    bool bFits = false;
+    if (IsDataBuffer(type) && !m_bExactSize)
+        bFits = (uint64_t)entry.size * entry.numElements >= (uint64_t)size * numElements;
+    else
+        // parameter buffers are taken by the driver as they are
+        bFits = (entry.size == size) && (entry.numElements == numElements);
+
+    return bFits && (entry.bDone || IsSurfaceDone(entry));
+}
+
+VAStatus VABufferPool::Acquire(VABufferType type, uint32_t size, uint32_t numElements, Buffer& buffer)
+{
+    VAStatus va_res = VA_STATUS_SUCCESS;
+    size_t   found  = m_buffers.size();
+
+    // the smallest fitting buffer, of equal ones the longest released
+    for (size_t i = 0; i < m_buffers.size(); ++i)
+    {
+        Entry& entry = m_buffers[i];
+        if (!IsReusable(entry, type, size, numElements))
+            continue;
+
+        if (found == m_buffers.size())
+        {
+            found = i;
+            continue;
+        }
+
+        const Entry& best = m_buffers[found];
+        uint64_t capacity     = (uint64_t)entry.size * entry.numElements;
+        uint64_t bestCapacity = (uint64_t)best.size * best.numElements;
+        if ((capacity < bestCapacity) || ((capacity == bestCapacity) && (entry.releaseFrame < best.releaseFrame)))
+            found = i;
+    }
+
+    if (found < m_buffers.size())
+    {
+        Entry& entry = m_buffers[found];
+
+        void* ptr = NULL;
+        va_res = m_backend->MapBuffer(entry.id, &ptr);
+        if (VA_STATUS_SUCCESS != va_res)
+        {
+            DestroyEntry(found);
+            return va_res;
+        }
+
+        entry.bFree        = false;
+        buffer.id          = entry.id;
+        buffer.size        = entry.size;
+        buffer.numElements = entry.numElements;
+        buffer.ptr         = ptr;
+        return VA_STATUS_SUCCESS;
+    }
+
+    Entry entry = {};
+    entry.type        = type;
+    entry.size        = size;
+    entry.numElements = numElements;
+
+    if (IsDataBuffer(type) && !m_bExactSize)
+    {
+        entry.size        = GetSizeClass(size * numElements);
+        entry.numElements = 1;
+
+        // the stream needs more than the free buffers have, they won't fit anymore
+        for (size_t i = m_buffers.size(); i > 0; --i)
+        {
+            const Entry& smaller = m_buffers[i - 1];
+            if (smaller.bFree && (smaller.type == type) && ((uint64_t)smaller.size * smaller.numElements < entry.size))
+                DestroyEntry(i - 1);
+        }
+    }
+
+    va_res = m_backend->CreateBuffer(entry.type, entry.size, entry.numElements, &entry.id);
+    if (VA_STATUS_SUCCESS != va_res)
+        return va_res;
+
+    void* ptr = NULL;
+    va_res = m_backend->MapBuffer(entry.id, &ptr);
+    if (VA_STATUS_SUCCESS != va_res)
+    {
+        m_backend->DestroyBuffer(entry.id);
+        return va_res;
+    }
+
+    m_buffers.push_back(entry);
+
+    buffer.id          = entry.id;
+    buffer.size        = entry.size;
+    buffer.numElements = entry.numElements;
+    buffer.ptr         = ptr;
+    return VA_STATUS_SUCCESS;
+}
+
+void VABufferPool::Release(VABufferID id, VASurfaceID surface)
+{
+    for (Entry& entry : m_buffers)
+    {
+        if (entry.id == id && !entry.bFree)
+        {
+            entry.bFree        = true;
+            entry.bDone        = false;
+            entry.surface      = surface;
+            entry.releaseFrame = m_frame;
+            break;
+        }
+    }
+    Trim();
+}
+
+VAStatus VABufferPool::Discard(VABufferID id)
+{
+    for (size_t i = 0; i < m_buffers.size(); ++i)
+    {
+        if (m_buffers[i].id == id)
+            return DestroyEntry(i);
+    }
+    return VA_STATUS_ERROR_INVALID_BUFFER;
+}
+
+void VABufferPool::NextFrame(void)
+{
+    ++m_frame;
+}
+
+VAStatus VABufferPool::Reset(void)
+{
+    VAStatus va_res = VA_STATUS_SUCCESS;
+
+    while (!m_buffers.empty())
+    {
+        VAStatus va_sts = DestroyEntry(m_buffers.size() - 1);
+        if (VA_STATUS_SUCCESS == va_res) va_res = va_sts;
+    }
+    return va_res;
+}
+
+VAStatus VABufferPool::DestroyEntry(size_t i)
+{
+    VAStatus va_res = m_backend->DestroyBuffer(m_buffers[i].id);
+
+    m_buffers[i] = m_buffers.back();
+    m_buffers.pop_back();
+    return va_res;
+}
+
+void VABufferPool::Trim(void)
+{
+    size_t numFree = GetNumFree();
+
+    while (numFree > m_maxFree)
+    {
+        size_t oldest = m_buffers.size();
+        for (size_t i = 0; i < m_buffers.size(); ++i)
+        {
+            if (m_buffers[i].bFree && ((oldest == m_buffers.size()) || (m_buffers[i].releaseFrame < m_buffers[oldest].releaseFrame)))
+                oldest = i;
+        }
+        DestroyEntry(oldest);
+        --numFree;
+    }
+}
+
+}; // namespace UMC
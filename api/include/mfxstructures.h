@@ -172,9 +172,17 @@ enum {
 
 /* DataFlag in mfxFrameData */
 enum {
-    MFX_FRAMEDATA_ORIGINAL_TIMESTAMP = 0x0001
+    MFX_FRAMEDATA_ORIGINAL_TIMESTAMP = 0x0001,
 };
 
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+/* LockFlag in mfxFrameData */
+enum {
+    /* the frame is locked for reading only, the allocator may skip writing the data back */
+    MFX_FRAMELOCK_READ_ONLY = 0x0001,
+};
+#endif
+
 /* Corrupted in mfxFrameData */
 enum {
     MFX_CORRUPTION_MINOR           = 0x0001,
@@ -218,7 +226,12 @@ typedef struct {
     };
     mfxU16  NumExtParam;
 
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    mfxU16      reserved[8];
+    mfxU16      LockFlag;
+#else
     mfxU16      reserved[9];
+#endif
     mfxU16      MemType;
     mfxU16      PitchHigh;
 
@@ -861,7 +874,11 @@ enum {
 /* Data Flag for mfxBitstream*/
 enum {
     MFX_BITSTREAM_COMPLETE_FRAME    = 0x0001,        /* the bitstream contains a complete frame or field pair of data */
-    MFX_BITSTREAM_EOS               = 0x0002
+    MFX_BITSTREAM_EOS               = 0x0002,
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    /* the bitstream ends with a complete slice, the decoder may start decoding of the frame before it is complete */
+    MFX_BITSTREAM_COMPLETE_SLICES   = 0x0004,
+#endif
 };
 /* Extended Buffer Ids */
 enum {
@@ -941,6 +958,11 @@ enum {
     MFX_EXTBUFF_AVC_SCALING_MATRIX              = MFX_MAKEFOURCC('A','V','S','M'),
     MFX_EXTBUFF_MPEG2_QUANT_MATRIX              = MFX_MAKEFOURCC('M','2','Q','M'),
     MFX_EXTBUFF_TASK_DEPENDENCY                 = MFX_MAKEFOURCC('S','Y','N','C'),
+    MFX_EXTBUFF_AVC_TASK_STAGE_STAT             = MFX_MAKEFOURCC('A','T','S','S'),
+    MFX_EXTBUFF_AVC_SLICE_OUTPUT                = MFX_MAKEFOURCC('A','S','L','O'),
+    MFX_EXTBUFF_SHARED_THREAD_POOL              = MFX_MAKEFOURCC('S','T','P','L'),
+    MFX_EXTBUFF_THREADS_AFFINITY                = MFX_MAKEFOURCC('T','A','F','F'),
+    MFX_EXTBUFF_SURFACE_COMPLETION              = MFX_MAKEFOURCC('S','C','M','P'),
 #endif
 #if (MFX_VERSION >= 1031)
     MFX_EXTBUFF_PARTIAL_BITSTREAM_PARAM         = MFX_MAKEFOURCC('P','B','O','P'),
@@ -1191,7 +1213,10 @@ typedef enum {
 typedef enum {
     MFX_SKIPMODE_NOSKIP=0,
     MFX_SKIPMODE_MORE=1,
-    MFX_SKIPMODE_LESS=2
+    MFX_SKIPMODE_LESS=2,
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    MFX_SKIPMODE_KEY_FRAMES_ONLY=3
+#endif
 } mfxSkipMode;
 
 MFX_PACK_BEGIN_STRUCT_W_PTR()
@@ -2415,6 +2440,100 @@ typedef struct {
 MFX_PACK_END()
 #endif
 
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+/* AVCTaskStage */
+enum {
+    MFX_AVC_TASK_STAGE_FREE         = 0,
+    MFX_AVC_TASK_STAGE_INCOMING     = 1,
+    MFX_AVC_TASK_STAGE_SCD_STARTED  = 2,
+    MFX_AVC_TASK_STAGE_SCD_FINISHED = 3,
+    MFX_AVC_TASK_STAGE_REORDERING   = 4,
+    MFX_AVC_TASK_STAGE_LA_STARTED   = 5,
+    MFX_AVC_TASK_STAGE_LA_FINISHED  = 6,
+    MFX_AVC_TASK_STAGE_HIST_RUN     = 7,
+    MFX_AVC_TASK_STAGE_HIST_WAIT    = 8,
+    MFX_AVC_TASK_STAGE_ENCODING     = 9,
+
+    MFX_AVC_NUM_TASK_STAGES         = 10
+};
+
+MFX_PACK_BEGIN_STRUCT_W_L_TYPE()
+typedef struct {
+    mfxU32  NumEntered;     /* number of tasks moved into the stage since Init/Reset */
+    mfxU32  Occupancy;      /* number of tasks currently in the stage */
+    mfxU32  MaxOccupancy;   /* peak of Occupancy */
+    mfxU32  reserved;
+    mfxU64  TotalDwellTime; /* sum of time spent in the stage by tasks which left it, in ticks */
+} mfxTaskStageStat;
+MFX_PACK_END()
+
+/* per-stage task counters of the AVC encoder, returned by GetVideoParam */
+MFX_PACK_BEGIN_STRUCT_W_L_TYPE()
+typedef struct {
+    mfxExtBuffer     Header;
+    mfxU64           TimerFrequency; /* ticks per second for TotalDwellTime */
+    mfxU32           reserved[8];
+    mfxTaskStageStat Stage[MFX_AVC_NUM_TASK_STAGES];
+} mfxExtAvcTaskStageStat;
+MFX_PACK_END()
+
+/* low-latency slice delivery of the AVC encoder, attached to mfxBitstream passed to EncodeFrameAsync */
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+typedef struct {
+    mfxExtBuffer Header;
+    mfxHDL       pthis;
+    /* called for every slice as soon as it is written to bs, bs->Data[offset, offset + size) includes
+       units preceding the slice; returning an error stops delivery of the remaining slices of the frame */
+    mfxStatus    (MFX_CDECL *SliceReady)(mfxHDL pthis, mfxBitstream *bs, mfxU32 offset, mfxU32 size, mfxU16 sliceId, mfxU16 lastSliceInFrame);
+    mfxU16       NumSlicesDelivered; /* out: number of slices accepted by the application for the frame */
+    mfxU16       reserved[11];
+} mfxExtAvcSliceOutput;
+MFX_PACK_END()
+
+/* opt-in for the session to run its tasks on the process-wide pool of threads shared with other sessions,
+   attached to mfxInitParam, share of the pool given to the session follows MFXSetPriority */
+MFX_PACK_BEGIN_USUAL_STRUCT()
+typedef struct {
+    mfxExtBuffer Header;
+    mfxU16       NumThread; /* size of the pool if it is created by this session, 0 - number of CPU cores */
+    mfxU16       reserved[11];
+} mfxExtSharedThreadPool;
+MFX_PACK_END()
+
+/* ThreadsAffinityPolicy */
+enum {
+    MFX_THREADS_AFFINITY_NONE        = 0, /* threads float over all available CPUs */
+    MFX_THREADS_AFFINITY_COMPACT     = 1, /* thread N runs on CPU N, NUMA nodes are filled one by one */
+    MFX_THREADS_AFFINITY_SPREAD      = 2, /* threads run on one CPU each, distributed round robin over NUMA nodes */
+    MFX_THREADS_AFFINITY_NODE        = 3, /* threads float over CPUs of NUMA node Node */
+    MFX_THREADS_AFFINITY_DEVICE_NODE = 4  /* threads float over CPUs of NUMA node the device is attached to */
+};
+
+/* placement of the session's threads on CPUs, attached to mfxInitParam. with policies confining threads
+   to a single NUMA node system memory frames are allocated on that node as well */
+MFX_PACK_BEGIN_USUAL_STRUCT()
+typedef struct {
+    mfxExtBuffer Header;
+    mfxU16       Policy; /* see ThreadsAffinityPolicy enumerator */
+    mfxU16       Node;   /* NUMA node for MFX_THREADS_AFFINITY_NODE */
+    mfxU16       reserved[10];
+} mfxExtThreadsAffinity;
+MFX_PACK_END()
+
+/* completion notification of the operation writing to the surface, attached to mfxFrameData::ExtParam
+   of decoder working surfaces or VPP output surfaces, must stay valid until the notification */
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+typedef struct {
+    mfxExtBuffer Header;
+    mfxHDL       pthis;
+    /* called once per operation from a library thread with the final status of it, should return quickly
+       but may submit the surface to the next component */
+    void         (MFX_CDECL *OnComplete)(mfxHDL pthis, mfxFrameSurface1 *surface, mfxStatus sts);
+    mfxU16       reserved[12];
+} mfxExtSurfaceCompletion;
+MFX_PACK_END()
+#endif
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -76,6 +76,11 @@ EXTBUF(mfxExtVP9Param                    , MFX_EXTBUFF_VP9_PARAM
 #if (MFX_VERSION >= MFX_VERSION_NEXT)
 EXTBUF(mfxExtAVCScalingMatrix            , MFX_EXTBUFF_AVC_SCALING_MATRIX              )
 EXTBUF(mfxExtDPB                         , MFX_EXTBUFF_DPB                             )
+EXTBUF(mfxExtAvcTaskStageStat            , MFX_EXTBUFF_AVC_TASK_STAGE_STAT             )
+EXTBUF(mfxExtAvcSliceOutput              , MFX_EXTBUFF_AVC_SLICE_OUTPUT                )
+EXTBUF(mfxExtSharedThreadPool            , MFX_EXTBUFF_SHARED_THREAD_POOL              )
+EXTBUF(mfxExtThreadsAffinity             , MFX_EXTBUFF_THREADS_AFFINITY                )
+EXTBUF(mfxExtSurfaceCompletion           , MFX_EXTBUFF_SURFACE_COMPLETION              )
 #endif
 
 #if (MFX_VERSION >= 1034)
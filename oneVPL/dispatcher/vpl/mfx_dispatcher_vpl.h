@@ -8,9 +8,11 @@
 #define SRC_DISPATCHER_VPL_MFX_DISPATCHER_VPL_H_
 
 #include <list>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "vpl/mfxdispatcher.h"
 #include "vpl/mfxvideo.h"
@@ -54,6 +56,14 @@ typedef char CHAR_TYPE;
     #define ENV_OS_PATH             "LD_LIBRARY_PATH"
 #endif
 
+// location of the on-disk cache of implementation capabilities
+// cache is disabled unless this variable points to a writable file
+#if defined(_WIN32) || defined(_WIN64)
+    #define ENV_ONEVPL_CAPS_CACHE L"ONEVPL_CAPS_CACHE"
+#else
+    #define ENV_ONEVPL_CAPS_CACHE "ONEVPL_CAPS_CACHE"
+#endif
+
 // internal function to load dll by full path, fail if unsuccessful
 mfxStatus MFXInitEx2(mfxInitParam par, mfxSession* session, CHAR_TYPE* dllName);
 
@@ -202,8 +212,18 @@ struct LibInfo {
     void* hModuleVPL;
     VPLFunctionPtr vplFuncTable[NumVPLFunctions]; // NOLINT
 
+    // set if capabilities were found in the caps cache
+    //   (library is not loaded in this case)
+    bool bCachedCaps;
+
     // avoid warnings
-    LibInfo() : libNameFull(), libNameBase(), libPriority(0), hModuleVPL(nullptr), vplFuncTable() {}
+    LibInfo()
+            : libNameFull(),
+              libNameBase(),
+              libPriority(0),
+              hModuleVPL(nullptr),
+              vplFuncTable(),
+              bCachedCaps(false) {}
 };
 
 struct ImplInfo {
@@ -227,6 +247,75 @@ struct ImplInfo {
     ImplInfo() : libInfo(nullptr), implDesc(nullptr), initPar(), libImplIdx(0), vplImplIdx(0) {}
 };
 
+// on-disk cache of implementation descriptions
+// entries are keyed by full library path, file size and modification time,
+//   so a library which was replaced or updated is queried again
+// libraries which are not valid implementations are cached as well,
+//   so they are not loaded by subsequent loaders
+class CapsCacheVPL {
+public:
+    CapsCacheVPL();
+    ~CapsCacheVPL();
+
+    // read cache file named by ENV_ONEVPL_CAPS_CACHE (no-op if not set)
+    mfxStatus Load();
+
+    // write cache file if any entries were added or are stale
+    mfxStatus Save();
+
+    bool IsEnabled() const {
+        return !m_cachePath.empty();
+    }
+
+    // returns true if library has a valid entry in the cache
+    // if bValidLib is false, library is not a oneVPL implementation
+    bool Lookup(const STRING_TYPE& libNameFull, bool& bValidLib);
+
+    // returns descriptions of a cached valid library
+    // descriptions are owned by the cache and remain valid until it is destroyed
+    mfxStatus GetImplDescriptions(const STRING_TYPE& libNameFull, std::list<mfxHDL>& implDescs);
+
+    // add entry for a library which is not a oneVPL implementation
+    mfxStatus StoreInvalid(const STRING_TYPE& libNameFull);
+
+    // add entry with deep copies of the descriptions returned by library
+    mfxStatus StoreImplDescriptions(const STRING_TYPE& libNameFull, mfxHDL* hImpl, mfxU32 numImpls);
+
+private:
+    // flattened mfxImplDescription with all pointers relative to start of blob
+    struct ImplBlob {
+        std::vector<mfxU8> data;
+        std::vector<mfxU32> relocs; // positions of pointer fields inside data
+    };
+
+    struct CacheEntry {
+        mfxU64 fileSize;
+        mfxI64 fileTimeSec;
+        mfxI64 fileTimeNsec;
+        bool bValidLib;
+        bool bUsed; // looked up or stored by this loader
+        std::list<ImplBlob> impls;
+
+        CacheEntry()
+                : fileSize(0),
+                  fileTimeSec(0),
+                  fileTimeNsec(0),
+                  bValidLib(false),
+                  bUsed(false),
+                  impls() {}
+    };
+
+    void Insert(const STRING_TYPE& libNameFull, CacheEntry& entry);
+
+    static bool GetFileStamp(const STRING_TYPE& libNameFull, CacheEntry& entry);
+    static mfxStatus FlattenImplDesc(const mfxImplDescription* implDesc, ImplBlob& blob);
+    static bool RelocateImplDesc(ImplBlob& blob);
+
+    STRING_TYPE m_cachePath;
+    std::map<STRING_TYPE, CacheEntry> m_entries;
+    bool m_bDirty;
+};
+
 // loader class implementation
 class LoaderCtxVPL {
 public:
@@ -259,6 +348,7 @@ private:
 
     std::list<LibInfo*> m_libInfoList;
     std::list<ImplInfo*> m_implInfoList;
+    CapsCacheVPL m_capsCache;
     std::list<ConfigCtxVPL*> m_configCtxList;
 
     std::list<STRING_TYPE> m_userSearchDirs;
@@ -0,0 +1,544 @@
+/*############################################################################
+  # Copyright (C) 2020 Intel Corporation
+  #
+  # SPDX-License-Identifier: MIT
+  ############################################################################*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "vpl/mfx_dispatcher_vpl.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <unistd.h>
+#endif
+
+// cache file layout (native byte order, not portable between architectures):
+//   header: magic, format version, pointer size, sizeof(mfxImplDescription), number of entries
+//   entry:  path length, path, file size, mtime (sec, nsec), valid flag, number of impls
+//   impl:   blob size, number of relocations, blob, relocations
+#define CAPS_CACHE_MAGIC   0x434C5056 // 'VPLC'
+#define CAPS_CACHE_VERSION 1
+
+// sanity limits when reading the cache, anything larger is treated as corruption
+#define CAPS_CACHE_MAX_ENTRIES 4096
+#define CAPS_CACHE_MAX_IMPLS   64
+#define CAPS_CACHE_MAX_BLOB    (1 << 24)
+
+struct CapsCacheHeader {
+    mfxU32 magic;
+    mfxU32 version;
+    mfxU32 ptrSize;
+    mfxU32 implDescSize;
+    mfxU32 numEntries;
+};
+
+CapsCacheVPL::CapsCacheVPL() : m_cachePath(), m_entries(), m_bDirty(false) {
+    return;
+}
+
+CapsCacheVPL::~CapsCacheVPL() {
+    return;
+}
+
+template <typename T>
+static bool ReadVal(FILE* f, T& val) {
+    return fread(&val, sizeof(T), 1, f) == 1;
+}
+
+template <typename T>
+static bool WriteVal(FILE* f, const T& val) {
+    return fwrite(&val, sizeof(T), 1, f) == 1;
+}
+
+static FILE* OpenCacheFile(const STRING_TYPE& path, const CHAR_TYPE* mode) {
+#if defined(_WIN32) || defined(_WIN64)
+    FILE* f = nullptr;
+    if (_wfopen_s(&f, path.c_str(), mode))
+        return nullptr;
+    return f;
+#else
+    return fopen(path.c_str(), mode);
+#endif
+}
+
+// get size and modification time of library
+bool CapsCacheVPL::GetFileStamp(const STRING_TYPE& libNameFull, CacheEntry& entry) {
+#if defined(_WIN32) || defined(_WIN64)
+    struct _stat64 st;
+    if (_wstat64(libNameFull.c_str(), &st))
+        return false;
+
+    entry.fileSize     = (mfxU64)st.st_size;
+    entry.fileTimeSec  = (mfxI64)st.st_mtime;
+    entry.fileTimeNsec = 0;
+#else
+    struct stat st;
+    if (stat(libNameFull.c_str(), &st))
+        return false;
+
+    entry.fileSize     = (mfxU64)st.st_size;
+    entry.fileTimeSec  = (mfxI64)st.st_mtim.tv_sec;
+    entry.fileTimeNsec = (mfxI64)st.st_mtim.tv_nsec;
+#endif
+
+    return true;
+}
+
+mfxStatus CapsCacheVPL::Load() {
+    m_entries.clear();
+    m_bDirty = false;
+
+#if defined(_WIN32) || defined(_WIN64)
+    CHAR_TYPE envVar[MAX_VPL_SEARCH_PATH] = { L"" };
+    if (!GetEnvironmentVariableW(ENV_ONEVPL_CAPS_CACHE, envVar, MAX_VPL_SEARCH_PATH))
+        return MFX_ERR_NONE; // cache disabled
+    m_cachePath = envVar;
+#else
+    CHAR_TYPE* envVar = getenv(ENV_ONEVPL_CAPS_CACHE);
+    if (!envVar || !envVar[0])
+        return MFX_ERR_NONE; // cache disabled
+    m_cachePath = envVar;
+#endif
+
+    FILE* f = OpenCacheFile(m_cachePath, MAKE_STRING("rb"));
+    if (!f)
+        return MFX_ERR_NONE; // not created yet, will be written on Save()
+
+    CapsCacheHeader hdr = {};
+    bool bOk = ReadVal(f, hdr) && hdr.magic == CAPS_CACHE_MAGIC &&
+               hdr.version == CAPS_CACHE_VERSION && hdr.ptrSize == sizeof(void*) &&
+               hdr.implDescSize == sizeof(mfxImplDescription) &&
+               hdr.numEntries <= CAPS_CACHE_MAX_ENTRIES;
+
+    for (mfxU32 i = 0; bOk && i < hdr.numEntries; i++) {
+        mfxU32 pathLen = 0, bValidLib = 0, numImpls = 0;
+        CacheEntry entry;
+
+        bOk = ReadVal(f, pathLen) && pathLen > 0 && pathLen < MAX_VPL_SEARCH_PATH;
+        if (!bOk)
+            break;
+
+        STRING_TYPE path(pathLen, 0);
+        bOk = fread(&path[0], sizeof(CHAR_TYPE), pathLen, f) == pathLen &&
+              ReadVal(f, entry.fileSize) && ReadVal(f, entry.fileTimeSec) &&
+              ReadVal(f, entry.fileTimeNsec) && ReadVal(f, bValidLib) &&
+              ReadVal(f, numImpls) && numImpls <= CAPS_CACHE_MAX_IMPLS;
+
+        for (mfxU32 j = 0; bOk && j < numImpls; j++) {
+            mfxU32 blobSize = 0, numRelocs = 0;
+
+            bOk = ReadVal(f, blobSize) && ReadVal(f, numRelocs) &&
+                  blobSize >= sizeof(mfxImplDescription) && blobSize <= CAPS_CACHE_MAX_BLOB &&
+                  numRelocs <= blobSize / sizeof(void*);
+            if (!bOk)
+                break;
+
+            entry.impls.push_back(ImplBlob());
+            ImplBlob& blob = entry.impls.back();
+            blob.data.resize(blobSize);
+            blob.relocs.resize(numRelocs);
+
+            bOk = fread(blob.data.data(), 1, blobSize, f) == blobSize &&
+                  (!numRelocs ||
+                   fread(blob.relocs.data(), sizeof(mfxU32), numRelocs, f) == numRelocs) &&
+                  RelocateImplDesc(blob);
+        }
+
+        entry.bValidLib = (bValidLib != 0);
+        if (bOk)
+            Insert(path, entry);
+    }
+
+    fclose(f);
+
+    if (!bOk) {
+        // corrupted or incompatible file - start over, rewrite on Save()
+        m_entries.clear();
+        m_bDirty = true;
+    }
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus CapsCacheVPL::Save() {
+    if (!IsEnabled())
+        return MFX_ERR_NONE;
+
+    // drop entries for libraries which were removed or replaced since caching
+    std::map<STRING_TYPE, CacheEntry>::iterator it = m_entries.begin();
+    while (it != m_entries.end()) {
+        CacheEntry stamp;
+        if (!it->second.bUsed &&
+            (!GetFileStamp(it->first, stamp) || stamp.fileSize != it->second.fileSize ||
+             stamp.fileTimeSec != it->second.fileTimeSec ||
+             stamp.fileTimeNsec != it->second.fileTimeNsec)) {
+            it       = m_entries.erase(it);
+            m_bDirty = true;
+            continue;
+        }
+        it++;
+    }
+
+    if (!m_bDirty)
+        return MFX_ERR_NONE;
+
+    // write to temporary file and rename, so concurrent loaders
+    //   never see a partially written cache
+#if defined(_WIN32) || defined(_WIN64)
+    STRING_TYPE tmpPath = m_cachePath + L"." + std::to_wstring(GetCurrentProcessId());
+#else
+    STRING_TYPE tmpPath = m_cachePath + "." + std::to_string(getpid());
+#endif
+
+    FILE* f = OpenCacheFile(tmpPath, MAKE_STRING("wb"));
+    if (!f)
+        return MFX_ERR_NOT_FOUND;
+
+    CapsCacheHeader hdr = {};
+    hdr.magic           = CAPS_CACHE_MAGIC;
+    hdr.version         = CAPS_CACHE_VERSION;
+    hdr.ptrSize         = sizeof(void*);
+    hdr.implDescSize    = sizeof(mfxImplDescription);
+    hdr.numEntries      = (mfxU32)m_entries.size();
+
+    bool bOk = WriteVal(f, hdr);
+
+    for (it = m_entries.begin(); bOk && it != m_entries.end(); it++) {
+        const CacheEntry& entry = it->second;
+
+        bOk = WriteVal(f, (mfxU32)it->first.size()) &&
+              fwrite(it->first.data(), sizeof(CHAR_TYPE), it->first.size(), f) ==
+                  it->first.size() &&
+              WriteVal(f, entry.fileSize) && WriteVal(f, entry.fileTimeSec) &&
+              WriteVal(f, entry.fileTimeNsec) && WriteVal(f, (mfxU32)entry.bValidLib) &&
+              WriteVal(f, (mfxU32)entry.impls.size());
+
+        std::list<ImplBlob>::const_iterator itImpl = entry.impls.begin();
+        for (; bOk && itImpl != entry.impls.end(); itImpl++) {
+            std::vector<mfxU8> data = itImpl->data;
+
+            // store pointers as offsets from the start of the blob
+            for (size_t r = 0; r < itImpl->relocs.size(); r++) {
+                uintptr_t ptr;
+                memcpy(&ptr, &data[itImpl->relocs[r]], sizeof(ptr));
+                ptr -= (uintptr_t)itImpl->data.data();
+                memcpy(&data[itImpl->relocs[r]], &ptr, sizeof(ptr));
+            }
+
+            bOk = WriteVal(f, (mfxU32)data.size()) &&
+                  WriteVal(f, (mfxU32)itImpl->relocs.size()) &&
+                  fwrite(data.data(), 1, data.size(), f) == data.size() &&
+                  (itImpl->relocs.empty() ||
+                   fwrite(itImpl->relocs.data(), sizeof(mfxU32), itImpl->relocs.size(), f) ==
+                       itImpl->relocs.size());
+        }
+    }
+
+    bOk = (fclose(f) == 0) && bOk;
+
+#if defined(_WIN32) || defined(_WIN64)
+    if (bOk)
+        bOk = (MoveFileExW(tmpPath.c_str(), m_cachePath.c_str(), MOVEFILE_REPLACE_EXISTING) != 0);
+    if (!bOk)
+        _wremove(tmpPath.c_str());
+#else
+    if (bOk)
+        bOk = (rename(tmpPath.c_str(), m_cachePath.c_str()) == 0);
+    if (!bOk)
+        remove(tmpPath.c_str());
+#endif
+
+    if (!bOk)
+        return MFX_ERR_UNKNOWN;
+
+    m_bDirty = false;
+
+    return MFX_ERR_NONE;
+}
+
+// blobs contain pointers to themselves, so entries are moved into the map
+//   by swapping lists (which keeps the blob storage in place) rather than copied
+void CapsCacheVPL::Insert(const STRING_TYPE& libNameFull, CacheEntry& entry) {
+    CacheEntry& dst  = m_entries[libNameFull];
+    dst.fileSize     = entry.fileSize;
+    dst.fileTimeSec  = entry.fileTimeSec;
+    dst.fileTimeNsec = entry.fileTimeNsec;
+    dst.bValidLib    = entry.bValidLib;
+    dst.bUsed        = entry.bUsed;
+    dst.impls.swap(entry.impls);
+}
+
+bool CapsCacheVPL::Lookup(const STRING_TYPE& libNameFull, bool& bValidLib) {
+    if (!IsEnabled())
+        return false;
+
+    std::map<STRING_TYPE, CacheEntry>::iterator it = m_entries.find(libNameFull);
+    if (it == m_entries.end())
+        return false;
+
+    CacheEntry stamp;
+    if (!GetFileStamp(libNameFull, stamp) || stamp.fileSize != it->second.fileSize ||
+        stamp.fileTimeSec != it->second.fileTimeSec ||
+        stamp.fileTimeNsec != it->second.fileTimeNsec) {
+        // library changed - entry will be replaced after querying it again
+        m_entries.erase(it);
+        m_bDirty = true;
+        return false;
+    }
+
+    it->second.bUsed = true;
+    bValidLib        = it->second.bValidLib;
+
+    return true;
+}
+
+mfxStatus CapsCacheVPL::GetImplDescriptions(const STRING_TYPE& libNameFull,
+                                            std::list<mfxHDL>& implDescs) {
+    implDescs.clear();
+
+    std::map<STRING_TYPE, CacheEntry>::iterator it = m_entries.find(libNameFull);
+    if (it == m_entries.end() || !it->second.bValidLib)
+        return MFX_ERR_NOT_FOUND;
+
+    std::list<ImplBlob>::iterator itImpl = it->second.impls.begin();
+    while (itImpl != it->second.impls.end()) {
+        implDescs.push_back((mfxHDL)(itImpl->data.data()));
+        itImpl++;
+    }
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus CapsCacheVPL::StoreInvalid(const STRING_TYPE& libNameFull) {
+    if (!IsEnabled())
+        return MFX_ERR_NONE;
+
+    CacheEntry entry;
+    if (!GetFileStamp(libNameFull, entry))
+        return MFX_ERR_NOT_FOUND;
+
+    entry.bValidLib = false;
+    entry.bUsed     = true;
+
+    Insert(libNameFull, entry);
+    m_bDirty = true;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus CapsCacheVPL::StoreImplDescriptions(const STRING_TYPE& libNameFull,
+                                              mfxHDL* hImpl,
+                                              mfxU32 numImpls) {
+    if (!IsEnabled())
+        return MFX_ERR_NONE;
+
+    if (!hImpl || numImpls > CAPS_CACHE_MAX_IMPLS)
+        return MFX_ERR_UNSUPPORTED;
+
+    CacheEntry entry;
+    if (!GetFileStamp(libNameFull, entry))
+        return MFX_ERR_NOT_FOUND;
+
+    entry.bValidLib = true;
+    entry.bUsed     = true;
+
+    for (mfxU32 i = 0; i < numImpls; i++) {
+        mfxImplDescription* implDesc = reinterpret_cast<mfxImplDescription*>(hImpl[i]);
+
+        // descriptions with extension buffers cannot be flattened - do not cache library
+        if (!implDesc || implDesc->NumExtParam)
+            return MFX_ERR_UNSUPPORTED;
+
+        entry.impls.push_back(ImplBlob());
+        mfxStatus sts = FlattenImplDesc(implDesc, entry.impls.back());
+        if (sts != MFX_ERR_NONE)
+            return sts;
+    }
+
+    Insert(libNameFull, entry);
+    m_bDirty = true;
+
+    return MFX_ERR_NONE;
+}
+
+// helper for building flattened description
+// arrays are appended to the blob, and the pointer field which refers
+//   to each array is recorded in the relocation table
+class ImplBlobWriter {
+public:
+    ImplBlobWriter(std::vector<mfxU8>& data, std::vector<mfxU32>& relocs)
+            : m_data(data),
+              m_relocs(relocs) {}
+
+    // copy array and point field at ptrPos to it, returns offset of array (0 if empty)
+    size_t PutArray(size_t ptrPos, const void* src, size_t elemSize, size_t count) {
+        uintptr_t off = 0;
+
+        if (src && count) {
+            off = Append(src, elemSize * count);
+            m_relocs.push_back((mfxU32)ptrPos);
+        }
+        memcpy(&m_data[ptrPos], &off, sizeof(off));
+
+        return (size_t)off;
+    }
+
+    size_t Append(const void* src, size_t size) {
+        // keep all arrays pointer-aligned
+        size_t off = (m_data.size() + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+        m_data.resize(off + size);
+        memcpy(&m_data[off], src, size);
+        return off;
+    }
+
+    template <typename T>
+    const T* At(size_t off) const {
+        return reinterpret_cast<const T*>(&m_data[off]);
+    }
+
+private:
+    std::vector<mfxU8>& m_data;
+    std::vector<mfxU32>& m_relocs;
+
+    // prevent copies
+    ImplBlobWriter(const ImplBlobWriter&);
+    ImplBlobWriter& operator=(const ImplBlobWriter&);
+};
+
+// make self-contained copy of implementation description
+// all pointer fields are overwritten, so no pointer into the library survives
+mfxStatus CapsCacheVPL::FlattenImplDesc(const mfxImplDescription* implDesc, ImplBlob& blob) {
+    blob.data.clear();
+    blob.relocs.clear();
+
+    ImplBlobWriter w(blob.data, blob.relocs);
+
+    size_t root = w.Append(implDesc, sizeof(mfxImplDescription));
+
+    // extension buffers are not supported (checked by caller)
+    w.PutArray(root + offsetof(mfxImplDescription, ExtParams), nullptr, 0, 0);
+
+    // device
+    w.PutArray(root + offsetof(mfxImplDescription, Dev) +
+                   offsetof(mfxDeviceDescription, SubDevices),
+               implDesc->Dev.SubDevices,
+               sizeof(mfxDeviceDescription::subdevices),
+               implDesc->Dev.NumSubDevices);
+
+    // decoders
+    size_t decOff = w.PutArray(root + offsetof(mfxImplDescription, Dec) +
+                                   offsetof(mfxDecoderDescription, Codecs),
+                               implDesc->Dec.Codecs,
+                               sizeof(DecCodec),
+                               implDesc->Dec.NumCodecs);
+    for (mfxU32 c = 0; decOff && c < implDesc->Dec.NumCodecs; c++) {
+        size_t codecPos        = decOff + c * sizeof(DecCodec);
+        const DecCodec* codec  = &implDesc->Dec.Codecs[c];
+        size_t profOff         = w.PutArray(codecPos + offsetof(DecCodec, Profiles),
+                                    codec->Profiles,
+                                    sizeof(DecProfile),
+                                    codec->NumProfiles);
+        for (mfxU32 p = 0; profOff && p < codec->NumProfiles; p++) {
+            size_t profPos         = profOff + p * sizeof(DecProfile);
+            const DecProfile* prof = &codec->Profiles[p];
+            size_t memOff          = w.PutArray(profPos + offsetof(DecProfile, MemDesc),
+                                       prof->MemDesc,
+                                       sizeof(DecMemDesc),
+                                       prof->NumMemTypes);
+            for (mfxU32 m = 0; memOff && m < prof->NumMemTypes; m++) {
+                w.PutArray(memOff + m * sizeof(DecMemDesc) + offsetof(DecMemDesc, ColorFormats),
+                           prof->MemDesc[m].ColorFormats,
+                           sizeof(mfxU32),
+                           prof->MemDesc[m].NumColorFormats);
+            }
+        }
+    }
+
+    // encoders
+    size_t encOff = w.PutArray(root + offsetof(mfxImplDescription, Enc) +
+                                   offsetof(mfxEncoderDescription, Codecs),
+                               implDesc->Enc.Codecs,
+                               sizeof(EncCodec),
+                               implDesc->Enc.NumCodecs);
+    for (mfxU32 c = 0; encOff && c < implDesc->Enc.NumCodecs; c++) {
+        size_t codecPos        = encOff + c * sizeof(EncCodec);
+        const EncCodec* codec  = &implDesc->Enc.Codecs[c];
+        size_t profOff         = w.PutArray(codecPos + offsetof(EncCodec, Profiles),
+                                    codec->Profiles,
+                                    sizeof(EncProfile),
+                                    codec->NumProfiles);
+        for (mfxU32 p = 0; profOff && p < codec->NumProfiles; p++) {
+            size_t profPos         = profOff + p * sizeof(EncProfile);
+            const EncProfile* prof = &codec->Profiles[p];
+            size_t memOff          = w.PutArray(profPos + offsetof(EncProfile, MemDesc),
+                                       prof->MemDesc,
+                                       sizeof(EncMemDesc),
+                                       prof->NumMemTypes);
+            for (mfxU32 m = 0; memOff && m < prof->NumMemTypes; m++) {
+                w.PutArray(memOff + m * sizeof(EncMemDesc) + offsetof(EncMemDesc, ColorFormats),
+                           prof->MemDesc[m].ColorFormats,
+                           sizeof(mfxU32),
+                           prof->MemDesc[m].NumColorFormats);
+            }
+        }
+    }
+
+    // VPP filters
+    size_t vppOff = w.PutArray(root + offsetof(mfxImplDescription, VPP) +
+                                   offsetof(mfxVPPDescription, Filters),
+                               implDesc->VPP.Filters,
+                               sizeof(VPPFilter),
+                               implDesc->VPP.NumFilters);
+    for (mfxU32 f = 0; vppOff && f < implDesc->VPP.NumFilters; f++) {
+        size_t filterPos          = vppOff + f * sizeof(VPPFilter);
+        const VPPFilter* filter   = &implDesc->VPP.Filters[f];
+        size_t memOff             = w.PutArray(filterPos + offsetof(VPPFilter, MemDesc),
+                                   filter->MemDesc,
+                                   sizeof(VPPMemDesc),
+                                   filter->NumMemTypes);
+        for (mfxU32 m = 0; memOff && m < filter->NumMemTypes; m++) {
+            size_t memPos           = memOff + m * sizeof(VPPMemDesc);
+            const VPPMemDesc* mem   = &filter->MemDesc[m];
+            size_t fmtOff           = w.PutArray(memPos + offsetof(VPPMemDesc, Formats),
+                                       mem->Formats,
+                                       sizeof(VPPFormat),
+                                       mem->NumInFormats);
+            for (mfxU32 i = 0; fmtOff && i < mem->NumInFormats; i++) {
+                w.PutArray(fmtOff + i * sizeof(VPPFormat) + offsetof(VPPFormat, OutFormats),
+                           mem->Formats[i].OutFormats,
+                           sizeof(mfxU32),
+                           mem->Formats[i].NumOutFormat);
+            }
+        }
+    }
+
+    // convert offsets to pointers into this blob
+    return RelocateImplDesc(blob) ? MFX_ERR_NONE : MFX_ERR_UNKNOWN;
+}
+
+// rebase pointer fields (stored as offsets) to the address of the blob
+// returns false if the relocation table does not fit the blob
+bool CapsCacheVPL::RelocateImplDesc(ImplBlob& blob) {
+    mfxU8* base = blob.data.data();
+    size_t size = blob.data.size();
+
+    for (size_t r = 0; r < blob.relocs.size(); r++) {
+        size_t pos = blob.relocs[r];
+        uintptr_t off;
+
+        if (pos + sizeof(off) > size || (pos % sizeof(void*)))
+            return false;
+
+        memcpy(&off, base + pos, sizeof(off));
+        if (off == 0 || off >= size)
+            return false;
+
+        off += (uintptr_t)base;
+        memcpy(base + pos, &off, sizeof(off));
+    }
+
+    return true;
+}
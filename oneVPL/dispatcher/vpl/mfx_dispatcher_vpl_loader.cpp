@@ -24,6 +24,7 @@ static const VPLFunctionDesc FunctionDesc2[NumVPLFunctions] = {
 LoaderCtxVPL::LoaderCtxVPL()
         : m_libInfoList(),
           m_implInfoList(),
+          m_capsCache(),
           m_configCtxList(),
           m_implIdxNext(0),
           m_userSearchDirs(),
@@ -214,12 +215,28 @@ mfxStatus LoaderCtxVPL::BuildListOfCandidateLibs() {
 
 // return number of valid libraries found
 mfxU32 LoaderCtxVPL::CheckValidLibraries() {
+    // libraries with an up-to-date entry in the caps cache are not loaded
+    m_capsCache.Load();
+
     // load all libraries
     std::list<LibInfo*>::iterator it = m_libInfoList.begin();
     while (it != m_libInfoList.end()) {
         mfxU32 i         = 0;
         LibInfo* libInfo = (*it);
 
+        bool bValidLib = false;
+        if (m_capsCache.Lookup(libInfo->libNameFull, bValidLib)) {
+            if (bValidLib) {
+                libInfo->bCachedCaps = true;
+                it++;
+            }
+            else {
+                delete libInfo;
+                it = m_libInfoList.erase(it);
+            }
+            continue;
+        }
+
 #if defined(_WIN32) || defined(_WIN64)
         // load DLL
         libInfo->hModuleVPL = MFX::mfx_dll_load(libInfo->libNameFull.c_str());
@@ -264,6 +281,7 @@ mfxU32 LoaderCtxVPL::CheckValidLibraries() {
         else {
             // required function is missing from DLL
             // remove this library from the list of options
+            m_capsCache.StoreInvalid(libInfo->libNameFull);
             delete libInfo;
             it = m_libInfoList.erase(it);
         }
@@ -281,11 +299,14 @@ mfxStatus LoaderCtxVPL::UnloadAllLibraries() {
         LibInfo* libInfo = (*it);
 
         if (libInfo) {
+            // libraries with cached caps were never loaded
+            if (libInfo->hModuleVPL) {
 #if defined(_WIN32) || defined(_WIN64)
-            MFX::mfx_dll_free(libInfo->hModuleVPL);
+                MFX::mfx_dll_free(libInfo->hModuleVPL);
 #else
-            dlclose(libInfo->hModuleVPL);
+                dlclose(libInfo->hModuleVPL);
 #endif
+            }
             delete libInfo;
         }
         it++;
@@ -314,16 +335,31 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
         mfxU32 num_impls = 0;
         LibInfo* libInfo = (*it);
 
-        VPLFunctionPtr pFunc = libInfo->vplFuncTable[IdxMFXQueryImplsDescription];
-
-        // call MFXQueryImplsDescription() for this implementation
-        // return handle to description in requested format
+        std::vector<mfxHDL> cachedImpls;
         mfxHDL* hImpl;
-        hImpl = (*(mfxHDL * (MFX_CDECL*)(mfxImplCapsDeliveryFormat, mfxU32*))
-                     pFunc)(MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &num_impls);
 
-        if (!hImpl)
-            return MFX_ERR_UNSUPPORTED;
+        if (libInfo->bCachedCaps) {
+            // descriptions are owned by the caps cache
+            std::list<mfxHDL> implDescs;
+            m_capsCache.GetImplDescriptions(libInfo->libNameFull, implDescs);
+
+            cachedImpls.assign(implDescs.begin(), implDescs.end());
+            num_impls = (mfxU32)cachedImpls.size();
+            hImpl     = cachedImpls.data();
+        }
+        else {
+            VPLFunctionPtr pFunc = libInfo->vplFuncTable[IdxMFXQueryImplsDescription];
+
+            // call MFXQueryImplsDescription() for this implementation
+            // return handle to description in requested format
+            hImpl = (*(mfxHDL * (MFX_CDECL*)(mfxImplCapsDeliveryFormat, mfxU32*))
+                         pFunc)(MFX_IMPLCAPS_IMPLDESCSTRUCTURE, &num_impls);
+
+            if (!hImpl)
+                return MFX_ERR_UNSUPPORTED;
+
+            m_capsCache.StoreImplDescriptions(libInfo->libNameFull, hImpl, num_impls);
+        }
 
         for (mfxU32 i = 0; i < num_impls; i++) {
             ImplInfo* implInfo = new ImplInfo;
@@ -356,6 +392,9 @@ mfxStatus LoaderCtxVPL::QueryLibraryCaps() {
         it++;
     }
 
+    // failure to write the cache is not fatal, libraries are queried again next time
+    m_capsCache.Save();
+
     return MFX_ERR_NONE;
 }
 
@@ -395,10 +434,13 @@ mfxStatus LoaderCtxVPL::ReleaseImpl(mfxHDL idesc) {
         if (implInfo->implDesc == idesc) {
             LibInfo* libInfo = implInfo->libInfo;
 
-            VPLFunctionPtr pFunc = libInfo->vplFuncTable[IdxMFXReleaseImplDescription];
+            // cached descriptions are freed together with the loader
+            if (!libInfo->bCachedCaps) {
+                VPLFunctionPtr pFunc = libInfo->vplFuncTable[IdxMFXReleaseImplDescription];
 
-            // call MFXReleaseImplDescription() for this implementation
-            sts = (*(mfxStatus(MFX_CDECL*)(mfxHDL))pFunc)(implInfo->implDesc);
+                // call MFXReleaseImplDescription() for this implementation
+                sts = (*(mfxStatus(MFX_CDECL*)(mfxHDL))pFunc)(implInfo->implDesc);
+            }
 
             implInfo->implDesc = nullptr; // no longer valid
 
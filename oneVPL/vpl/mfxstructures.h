@@ -272,6 +272,13 @@ typedef struct
 } mfxA2RGB10;
 MFX_PACK_END()
 
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+/*! The LockFlag enumerator itemizes flags of the frame lock. */
+enum {
+    MFX_FRAMELOCK_READ_ONLY = 0x0001 /*!< The frame is locked for reading only, the allocator may skip writing the data back. */
+};
+#endif
+
 /*! Describes frame buffer pointers. */
 MFX_PACK_BEGIN_STRUCT_W_L_TYPE()
 typedef struct {
@@ -287,7 +294,12 @@ typedef struct {
 
     /*!  @name General members */
     /*! @{ */
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    mfxU16      reserved[8]; /*!< Reserved for future use. */
+    mfxU16      LockFlag;    /*!< Flags of the lock, set by the caller of the frame allocator Lock function. See the LockFlag enumerator for details. */
+#else
     mfxU16      reserved[9]; /*!< Reserved for future use. */
+#endif
     mfxU16      MemType;     /*!< Allocated memory type. See the ExtMemFrameType enumerator for details. Used for better integration of
                                   3rd party plugins into the pipeline. */
     mfxU16      PitchHigh;   /*!< Distance in bytes between the start of two consecutive rows in a frame. */
@@ -2038,6 +2050,18 @@ enum {
     MFX_EXTBUFF_AVC_SCALING_MATRIX              = MFX_MAKEFOURCC('A','V','S','M'),
     MFX_EXTBUFF_MPEG2_QUANT_MATRIX              = MFX_MAKEFOURCC('M','2','Q','M'),
     MFX_EXTBUFF_TASK_DEPENDENCY                 = MFX_MAKEFOURCC('S','Y','N','C'),
+    /*!
+       See the mfxExtSharedThreadPool structure for details.
+    */
+    MFX_EXTBUFF_SHARED_THREAD_POOL              = MFX_MAKEFOURCC('S','T','P','L'),
+    /*!
+       See the mfxExtThreadsAffinity structure for details.
+    */
+    MFX_EXTBUFF_THREADS_AFFINITY                = MFX_MAKEFOURCC('T','A','F','F'),
+    /*!
+       See the mfxExtSurfaceCompletion structure for details.
+    */
+    MFX_EXTBUFF_SURFACE_COMPLETION              = MFX_MAKEFOURCC('S','C','M','P'),
 #endif
     /*!
        See the mfxExtPartialBitstreamParam structure for details.
@@ -4341,6 +4365,63 @@ typedef struct {
 } mfxExtAV1FilmGrainParam;
 MFX_PACK_END()
 
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+MFX_PACK_BEGIN_USUAL_STRUCT()
+/*!
+   Makes the session run its tasks on the process-wide pool of threads shared with other sessions instead of creating
+   own threads. Attached to mfxInitParam or mfxInitializationParam. The share of the pool given to the session follows
+   the priority set by MFXSetPriority.
+*/
+typedef struct {
+    mfxExtBuffer Header;    /*!< Extension buffer header. Header.BufferId must be equal to MFX_EXTBUFF_SHARED_THREAD_POOL. */
+    mfxU16       NumThread; /*!< Number of threads of the pool if it is created by this session. Value 0 means number of CPU cores. */
+    mfxU16       reserved[11];
+} mfxExtSharedThreadPool;
+MFX_PACK_END()
+
+/*! The ThreadsAffinityPolicy enumerator itemizes placements of the session threads on CPUs. */
+enum {
+    MFX_THREADS_AFFINITY_NONE        = 0, /*!< Threads float over all available CPUs. */
+    MFX_THREADS_AFFINITY_COMPACT     = 1, /*!< Thread N runs on CPU N, NUMA nodes are filled one by one. */
+    MFX_THREADS_AFFINITY_SPREAD      = 2, /*!< Threads run on one CPU each, distributed round robin over NUMA nodes. */
+    MFX_THREADS_AFFINITY_NODE        = 3, /*!< Threads float over CPUs of the NUMA node set by mfxExtThreadsAffinity::Node. */
+    MFX_THREADS_AFFINITY_DEVICE_NODE = 4  /*!< Threads float over CPUs of the NUMA node the device is attached to. */
+};
+
+MFX_PACK_BEGIN_USUAL_STRUCT()
+/*!
+   Sets placement of the session threads on CPUs. Attached to mfxInitParam or mfxInitializationParam. With the policies
+   confining threads to a single NUMA node, system memory frames are allocated on that node as well.
+*/
+typedef struct {
+    mfxExtBuffer Header; /*!< Extension buffer header. Header.BufferId must be equal to MFX_EXTBUFF_THREADS_AFFINITY. */
+    mfxU16       Policy; /*!< Placement policy. See the ThreadsAffinityPolicy enumerator for values of this option. */
+    mfxU16       Node;   /*!< NUMA node for MFX_THREADS_AFFINITY_NODE. */
+    mfxU16       reserved[10];
+} mfxExtThreadsAffinity;
+MFX_PACK_END()
+
+MFX_PACK_BEGIN_STRUCT_W_PTR()
+/*!
+   Requests notification on completion of the operation writing to the surface. Attached to mfxFrameData::ExtParam of
+   decoder working surfaces or VPP output surfaces. The buffer must stay valid until the notification.
+*/
+typedef struct {
+    mfxExtBuffer Header; /*!< Extension buffer header. Header.BufferId must be equal to MFX_EXTBUFF_SURFACE_COMPLETION. */
+    mfxHDL       pthis;  /*!< Pointer passed to OnComplete. */
+    /*!
+       Called once per operation from a library thread with the final status of the operation. It should return
+       quickly, but it may submit the surface to the next component.
+       @param[in] pthis   Value of the pthis field of the buffer.
+       @param[in] surface Surface written by the operation.
+       @param[in] sts     Final status of the operation.
+    */
+    void         (MFX_CDECL *OnComplete)(mfxHDL pthis, mfxFrameSurface1 *surface, mfxStatus sts);
+    mfxU16       reserved[12];
+} mfxExtSurfaceCompletion;
+MFX_PACK_END()
+#endif
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
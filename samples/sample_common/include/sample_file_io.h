@@ -0,0 +1,137 @@
+/******************************************************************************\
+Copyright (c) 2005-2020, Intel Corporation
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+This sample was distributed or derived from the Intel's Media Samples package.
+The original version of this sample may be obtained from https://software.intel.com/en-us/intel-media-server-studio
+or https://software.intel.com/en-us/media-client-solutions-support.
+\**********************************************************************************/
+
+#ifndef __SAMPLE_FILE_IO_H__
+#define __SAMPLE_FILE_IO_H__
+
+#include <stdio.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "mfxdefs.h"
+#include "vm/strings_defs.h"
+#include "vm/file_defs.h"
+
+// Sequential access to the raw and elementary stream files of the samples.
+// Readers and writers of the frames copy rows from or to memory, the disk
+// is accessed in bulk outside of the pipeline thread:
+//  - regular input files are memory mapped where the OS supports it,
+//  - other inputs (pipes, devices) are read ahead by a thread into a pair of buffers,
+//  - output is written behind by a thread from a pair of buffers.
+// Read/Write follow fread/fwrite semantics and return the number of complete items.
+
+class CSmplFileReader
+{
+public:
+    CSmplFileReader();
+    ~CSmplFileReader();
+
+    mfxStatus Open(const msdk_char *strFileName);
+    void      Close();
+    bool      IsOpen() const { return m_fSource || m_pMapped; }
+
+    size_t    Read(void *pDst, size_t size, size_t count);
+    // absolute position from the beginning of the file
+    mfxStatus Seek(mfxU64 offset);
+    // true after a read reached the end of the file
+    bool      IsEOF() const { return m_bEOF; }
+
+protected:
+    struct Chunk
+    {
+        std::vector<mfxU8> data;
+        size_t             size;
+    };
+
+    void StartPrefetch();
+    void StopPrefetch();
+    void PrefetchRoutine();
+    bool NextChunk();
+
+    // memory mapped file
+    mfxU8 *m_pMapped;
+    mfxU64 m_mappedSize;
+    mfxU64 m_position;
+    mfxU64 m_adviseEnd;
+
+    // read ahead from the stream
+    FILE                               *m_fSource;
+    std::thread                         m_thread;
+    std::mutex                          m_mutex;
+    std::condition_variable             m_cond;
+    std::deque<std::unique_ptr<Chunk> > m_filled;
+    std::deque<std::unique_ptr<Chunk> > m_free;
+    std::unique_ptr<Chunk>              m_current;
+    size_t                              m_currentPos;
+    bool                                m_bStop;
+    bool                                m_bEnd;
+
+    bool   m_bEOF;
+
+private:
+    CSmplFileReader(const CSmplFileReader &);
+    CSmplFileReader & operator=(const CSmplFileReader &);
+};
+
+class CSmplFileWriter
+{
+public:
+    CSmplFileWriter();
+    ~CSmplFileWriter();
+
+    mfxStatus Open(const msdk_char *strFileName);
+    // writes the rest of the data and closes the file
+    mfxStatus Close();
+    bool      IsOpen() const { return m_fDest != NULL; }
+
+    // a write error is reported by one of the following calls
+    size_t    Write(const void *pSrc, size_t size, size_t count);
+    // hands the collected data to the writing thread without waiting
+    void      Flush();
+
+protected:
+    struct Chunk
+    {
+        std::vector<mfxU8> data;
+        size_t             size;
+    };
+
+    void WriteRoutine();
+
+    FILE                               *m_fDest;
+    std::thread                         m_thread;
+    std::mutex                          m_mutex;
+    std::condition_variable             m_cond;
+    std::deque<std::unique_ptr<Chunk> > m_filled;
+    std::deque<std::unique_ptr<Chunk> > m_free;
+    std::unique_ptr<Chunk>              m_current;
+    bool                                m_bStop;
+    std::atomic<bool>                   m_bError;
+
+private:
+    CSmplFileWriter(const CSmplFileWriter &);
+    CSmplFileWriter & operator=(const CSmplFileWriter &);
+};
+
+#endif // __SAMPLE_FILE_IO_H__
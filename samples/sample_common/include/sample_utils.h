@@ -50,6 +50,7 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include "vm/thread_defs.h"
 
 #include "sample_types.h"
+#include "sample_file_io.h"
 
 #include "abstract_splitter.h"
 #include "avc_bitstream.h"
@@ -813,7 +814,7 @@ public :
 
 protected:
 
-    std::vector<FILE*> m_files;
+    std::vector<std::unique_ptr<CSmplFileReader> > m_files;
 
     bool shouldShift10BitsHigh;
     bool m_bInited;
@@ -833,7 +834,7 @@ public :
     mfxU32 m_nProcessedFramesNum;
 
 protected:
-    FILE*       m_fSource;
+    CSmplFileWriter m_fSource;
     bool        m_bInited;
     msdk_string m_sFile;
 };
@@ -854,7 +855,8 @@ public :
     void SetMultiView() { m_bIsMultiView = true; }
 
 protected:
-    FILE         *m_fDest, **m_fDestMVC;
+    std::unique_ptr<CSmplFileWriter> m_fDest;
+    std::vector<std::unique_ptr<CSmplFileWriter> > m_fDestMVC;
     bool         m_bInited, m_bIsMultiView;
     mfxU32       m_numCreatedFiles;
     msdk_string  m_sFile;
@@ -875,7 +877,7 @@ public :
     virtual mfxStatus ReadNextFrame(mfxBitstream *pBS);
 
 protected:
-    FILE*     m_fSource;
+    CSmplFileReader m_fSource;
     bool      m_bInited;
 };
 
@@ -42,6 +42,9 @@ struct vaapiMemId
     VABufferInfo m_buffer_info;
     // pointer to private export data
     void*        m_custom;
+    // mapping of m_image, kept after a read-only lock until the surface goes to the device
+    mfxU8*       m_mapped;
+    bool         m_keep_mapped;
 };
 
 namespace MfxLoader
@@ -104,6 +107,9 @@ protected:
     virtual mfxStatus AllocImpl(mfxFrameAllocRequest *request, mfxFrameAllocResponse *response);
     virtual mfxStatus ReallocImpl(mfxMemId midIn, const mfxFrameInfo *info, mfxU16 memType, mfxMemId *midOut);
 
+    // drops the derived image and its mapping, if any
+    void ReleaseMapping(vaapiMemId* vaapi_mid);
+
     VADisplay m_dpy;
     MfxLoader::VA_Proxy * m_libva;
     mfxU32 m_export_mode;
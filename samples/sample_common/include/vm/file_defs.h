@@ -29,12 +29,14 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #define MSDK_FOPEN(file, name, mode) _tfopen_s(&file, name, mode)
 
 #define msdk_fgets  _fgetts
+#define msdk_remove _tremove
 #else // #if defined(_WIN32) || defined(_WIN64)
 #include <unistd.h>
 
 #define MSDK_FOPEN(file, name, mode) !(file = fopen(name, mode))
 
 #define msdk_fgets  fgets
+#define msdk_remove remove
 #endif // #if defined(_WIN32) || defined(_WIN64)
 
 #endif // #ifndef __FILE_DEFS_H__
@@ -0,0 +1,413 @@
+/******************************************************************************\
+Copyright (c) 2005-2020, Intel Corporation
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+This sample was distributed or derived from the Intel's Media Samples package.
+The original version of this sample may be obtained from https://software.intel.com/en-us/intel-media-server-studio
+or https://software.intel.com/en-us/media-client-solutions-support.
+\**********************************************************************************/
+
+#include "mfx_samples_config.h"
+
+#include <string.h>
+#include <algorithm>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "sample_file_io.h"
+
+namespace
+{
+    // size of the buffers exchanged with the I/O threads and
+    // of the read ahead window of the mapped files
+    const size_t IO_CHUNK_SIZE  = 4 << 20;
+    const size_t IO_CHUNK_COUNT = 2;
+}
+
+CSmplFileReader::CSmplFileReader()
+    : m_pMapped(NULL)
+    , m_mappedSize(0)
+    , m_position(0)
+    , m_adviseEnd(0)
+    , m_fSource(NULL)
+    , m_currentPos(0)
+    , m_bStop(false)
+    , m_bEnd(false)
+    , m_bEOF(false)
+{
+}
+
+CSmplFileReader::~CSmplFileReader()
+{
+    Close();
+}
+
+mfxStatus CSmplFileReader::Open(const msdk_char *strFileName)
+{
+    Close();
+
+#if !defined(_WIN32) && !defined(_WIN64)
+    int fd = open(strFileName, O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (0 == fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0)
+        {
+            void *pMapped = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED != pMapped)
+            {
+                madvise(pMapped, st.st_size, MADV_SEQUENTIAL);
+
+                m_pMapped    = (mfxU8 *)pMapped;
+                m_mappedSize = st.st_size;
+            }
+        }
+        // the mapping stays valid after closing the descriptor
+        close(fd);
+
+        if (m_pMapped)
+            return MFX_ERR_NONE;
+    }
+#endif
+
+    // not a regular file or mapping is not supported, read it ahead by chunks
+    MSDK_FOPEN(m_fSource, strFileName, MSDK_STRING("rb"));
+    if (!m_fSource)
+        return MFX_ERR_NULL_PTR;
+
+    for (size_t i = 0; i < IO_CHUNK_COUNT; i++)
+    {
+        m_free.emplace_back(new Chunk);
+        m_free.back()->data.resize(IO_CHUNK_SIZE);
+        m_free.back()->size = 0;
+    }
+
+    StartPrefetch();
+
+    return MFX_ERR_NONE;
+}
+
+void CSmplFileReader::Close()
+{
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (m_pMapped)
+    {
+        munmap(m_pMapped, m_mappedSize);
+    }
+#endif
+    m_pMapped    = NULL;
+    m_mappedSize = 0;
+    m_position   = 0;
+    m_adviseEnd  = 0;
+
+    if (m_fSource)
+    {
+        StopPrefetch();
+
+        fclose(m_fSource);
+        m_fSource = NULL;
+    }
+    m_free.clear();
+
+    m_bEOF = false;
+}
+
+size_t CSmplFileReader::Read(void *pDst, size_t size, size_t count)
+{
+    const size_t bytes = size * count;
+    size_t done = 0;
+
+    if (!bytes || !IsOpen())
+        return 0;
+
+    if (m_pMapped)
+    {
+        done = (size_t)std::min<mfxU64>(bytes, m_position < m_mappedSize ? m_mappedSize - m_position : 0);
+
+#if !defined(_WIN32) && !defined(_WIN64)
+        // keep the next window being read by the kernel while the current one is copied
+        while (m_adviseEnd < m_mappedSize && m_position + done + IO_CHUNK_SIZE > m_adviseEnd)
+        {
+            size_t length = (size_t)std::min<mfxU64>(IO_CHUNK_SIZE, m_mappedSize - m_adviseEnd);
+            madvise(m_pMapped + m_adviseEnd, length, MADV_WILLNEED);
+            m_adviseEnd += length;
+        }
+#endif
+
+        memcpy(pDst, m_pMapped + m_position, done);
+        m_position += done;
+    }
+    else
+    {
+        while (done < bytes)
+        {
+            if (!m_current || m_currentPos == m_current->size)
+            {
+                if (!NextChunk())
+                    break;
+                continue;
+            }
+
+            size_t length = std::min(bytes - done, m_current->size - m_currentPos);
+            memcpy((mfxU8 *)pDst + done, m_current->data.data() + m_currentPos, length);
+            m_currentPos += length;
+            done += length;
+        }
+    }
+
+    if (done < bytes)
+    {
+        m_bEOF = true;
+    }
+
+    return done / size;
+}
+
+mfxStatus CSmplFileReader::Seek(mfxU64 offset)
+{
+    if (!IsOpen())
+        return MFX_ERR_NOT_INITIALIZED;
+
+    m_bEOF = false;
+
+    if (m_pMapped)
+    {
+        // like fseek, positioning beyond the end is allowed, reads return nothing
+        m_position  = offset;
+        m_adviseEnd = offset - offset % IO_CHUNK_SIZE;
+        return MFX_ERR_NONE;
+    }
+
+    StopPrefetch();
+    int res = fseek(m_fSource, (long)offset, SEEK_SET);
+    StartPrefetch();
+
+    return res ? MFX_ERR_UNSUPPORTED : MFX_ERR_NONE;
+}
+
+void CSmplFileReader::StartPrefetch()
+{
+    m_bStop = false;
+    m_bEnd  = false;
+
+    m_thread = std::thread(&CSmplFileReader::PrefetchRoutine, this);
+}
+
+void CSmplFileReader::StopPrefetch()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_cond.notify_all();
+
+    if (m_thread.joinable())
+        m_thread.join();
+
+    // drop the data read ahead
+    if (m_current)
+        m_free.push_back(std::move(m_current));
+    while (!m_filled.empty())
+    {
+        m_free.push_back(std::move(m_filled.front()));
+        m_filled.pop_front();
+    }
+    m_currentPos = 0;
+}
+
+void CSmplFileReader::PrefetchRoutine()
+{
+    for (;;)
+    {
+        std::unique_ptr<Chunk> chunk;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this] { return m_bStop || !m_free.empty(); });
+            if (m_bStop)
+                return;
+
+            chunk = std::move(m_free.front());
+            m_free.pop_front();
+        }
+
+        chunk->size = fread(chunk->data.data(), 1, chunk->data.size(), m_fSource);
+        const bool bLast = chunk->size < chunk->data.size();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_filled.push_back(std::move(chunk));
+            m_bEnd = bLast;
+        }
+        m_cond.notify_all();
+
+        if (bLast)
+            return;
+    }
+}
+
+bool CSmplFileReader::NextChunk()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_current)
+    {
+        m_free.push_back(std::move(m_current));
+        m_cond.notify_all();
+    }
+
+    m_cond.wait(lock, [this] { return !m_filled.empty() || m_bEnd; });
+    if (m_filled.empty())
+        return false;
+
+    m_current = std::move(m_filled.front());
+    m_filled.pop_front();
+    m_currentPos = 0;
+
+    return true;
+}
+
+CSmplFileWriter::CSmplFileWriter()
+    : m_fDest(NULL)
+    , m_bStop(false)
+    , m_bError(false)
+{
+}
+
+CSmplFileWriter::~CSmplFileWriter()
+{
+    Close();
+}
+
+mfxStatus CSmplFileWriter::Open(const msdk_char *strFileName)
+{
+    Close();
+
+    MSDK_FOPEN(m_fDest, strFileName, MSDK_STRING("wb"));
+    if (!m_fDest)
+        return MFX_ERR_NULL_PTR;
+
+    for (size_t i = 0; i < IO_CHUNK_COUNT; i++)
+    {
+        m_free.emplace_back(new Chunk);
+        m_free.back()->data.resize(IO_CHUNK_SIZE);
+        m_free.back()->size = 0;
+    }
+    m_current = std::move(m_free.front());
+    m_free.pop_front();
+
+    m_bStop  = false;
+    m_bError = false;
+
+    m_thread = std::thread(&CSmplFileWriter::WriteRoutine, this);
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus CSmplFileWriter::Close()
+{
+    if (!m_fDest)
+        return MFX_ERR_NONE;
+
+    Flush();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_cond.notify_all();
+
+    if (m_thread.joinable())
+        m_thread.join();
+
+    if (fclose(m_fDest))
+        m_bError = true;
+    m_fDest = NULL;
+
+    m_current.reset();
+    m_filled.clear();
+    m_free.clear();
+
+    return m_bError ? MFX_ERR_UNDEFINED_BEHAVIOR : MFX_ERR_NONE;
+}
+
+size_t CSmplFileWriter::Write(const void *pSrc, size_t size, size_t count)
+{
+    const size_t bytes = size * count;
+    size_t done = 0;
+
+    if (!bytes || !m_fDest || m_bError)
+        return 0;
+
+    while (done < bytes)
+    {
+        size_t length = std::min(bytes - done, m_current->data.size() - m_current->size);
+        memcpy(m_current->data.data() + m_current->size, (const mfxU8 *)pSrc + done, length);
+        m_current->size += length;
+        done += length;
+
+        if (m_current->size == m_current->data.size())
+            Flush();
+    }
+
+    return count;
+}
+
+void CSmplFileWriter::Flush()
+{
+    if (!m_fDest || !m_current->size)
+        return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_filled.push_back(std::move(m_current));
+    m_cond.notify_all();
+
+    // waits only if the disk is slower than the pipeline
+    m_cond.wait(lock, [this] { return !m_free.empty(); });
+    m_current = std::move(m_free.front());
+    m_free.pop_front();
+}
+
+void CSmplFileWriter::WriteRoutine()
+{
+    for (;;)
+    {
+        std::unique_ptr<Chunk> chunk;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this] { return m_bStop || !m_filled.empty(); });
+            if (m_filled.empty())
+                return; // stopped and everything is written
+
+            chunk = std::move(m_filled.front());
+            m_filled.pop_front();
+        }
+
+        if (!m_bError)
+        {
+            if (fwrite(chunk->data.data(), 1, chunk->size, m_fDest) != chunk->size || fflush(m_fDest))
+                m_bError = true;
+        }
+        chunk->size = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free.push_back(std::move(chunk));
+        }
+        m_cond.notify_all();
+    }
+}
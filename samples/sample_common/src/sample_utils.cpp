@@ -137,11 +137,11 @@ mfxStatus CSmplYUVReader::Init(std::list<msdk_string> inputs, mfxU32 ColorFormat
 
     for (ls_iterator it = inputs.begin(); it != inputs.end(); it++)
     {
-        FILE *f = 0;
-        MSDK_FOPEN(f, (*it).c_str(), MSDK_STRING("rb"));
-        MSDK_CHECK_POINTER(f, MFX_ERR_NULL_PTR);
+        std::unique_ptr<CSmplFileReader> f(new CSmplFileReader);
+        if (MFX_ERR_NONE != f->Open((*it).c_str()))
+            return MFX_ERR_NULL_PTR;
 
-        m_files.push_back(f);
+        m_files.push_back(std::move(f));
     }
 
     m_ColorFormat = ColorFormat;
@@ -158,10 +158,6 @@ CSmplYUVReader::~CSmplYUVReader()
 
 void CSmplYUVReader::Close()
 {
-    for (mfxU32 i = 0; i < m_files.size(); i++)
-    {
-        fclose(m_files[i]);
-    }
     m_files.clear();
     m_bInited = false;
 }
@@ -170,7 +166,7 @@ void CSmplYUVReader::Reset()
 {
     for (mfxU32 i = 0; i < m_files.size(); i++)
     {
-        fseek(m_files[i], 0, SEEK_SET);
+        m_files[i]->Seek(0);
     }
 }
 
@@ -185,7 +181,7 @@ mfxStatus CSmplYUVReader::SkipNframesFromBeginning(mfxU16 w, mfxU16 h, mfxU32 vi
         return MFX_ERR_UNSUPPORTED;
     }
 
-    if (0 != fseek(m_files[viewId], frameLength * nframes, SEEK_SET))
+    if (MFX_ERR_NONE != m_files[viewId]->Seek((mfxU64)frameLength * nframes))
         return MFX_ERR_MORE_DATA;
 
     return MFX_ERR_NONE;
@@ -247,7 +243,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 
             for(i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 4*w, m_files[vid]);
+                nBytesRead = (mfxU32)m_files[vid]->Read(ptr + i * pitch, 1, 4*w);
 
                 if ((mfxU32)4*w != nBytesRead)
                 {
@@ -264,7 +260,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 
             for(i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, 2, w, m_files[vid]);
+                nBytesRead = (mfxU32)m_files[vid]->Read(ptr + i * pitch, 2, w);
 
                 if ((mfxU32)w != nBytesRead)
                 {
@@ -278,7 +274,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 
             for (i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, 4, w, m_files[vid]);
+                nBytesRead = (mfxU32)m_files[vid]->Read(ptr + i * pitch, 4, w);
 
                 if ((mfxU32)w != nBytesRead)
                 {
@@ -295,7 +291,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 
             for (i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 4 * w, m_files[vid]);
+                nBytesRead = (mfxU32)m_files[vid]->Read(ptr + i * pitch, 1, 4 * w);
 
                 if ((mfxU32)4 * w != nBytesRead)
                 {
@@ -326,7 +322,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, nBytesPerPixel, w, m_files[vid]);
+            nBytesRead = (mfxU32)m_files[vid]->Read(ptr + i * pitch, nBytesPerPixel, w);
 
             if (w != nBytesRead)
             {
@@ -375,7 +371,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
                 // load first chroma plane: U (input == I420) or V (input == YV12)
                 for (i = 0; i < h; i++)
                 {
-                    nBytesRead = (mfxU32)fread(buf, 1, w, m_files[vid]);
+                    nBytesRead = (mfxU32)m_files[vid]->Read(buf, 1, w);
                     if (w != nBytesRead)
                     {
                         return MFX_ERR_MORE_DATA;
@@ -390,7 +386,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
                 for (i = 0; i < h; i++)
                 {
 
-                    nBytesRead = (mfxU32)fread(buf, 1, w, m_files[vid]);
+                    nBytesRead = (mfxU32)m_files[vid]->Read(buf, 1, w);
 
                     if (w != nBytesRead)
                     {
@@ -419,7 +415,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
                 for(i = 0; i < h; i++)
                 {
 
-                    nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_files[vid]);
+                    nBytesRead = (mfxU32)m_files[vid]->Read(ptr + i * pitch, 1, w);
 
                     if (w != nBytesRead)
                     {
@@ -428,7 +424,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
                 }
                 for(i = 0; i < h; i++)
                 {
-                    nBytesRead = (mfxU32)fread(ptr2 + i * pitch, 1, w, m_files[vid]);
+                    nBytesRead = (mfxU32)m_files[vid]->Read(ptr2 + i * pitch, 1, w);
 
                     if (w != nBytesRead)
                     {
@@ -450,7 +446,7 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
             ptr  = pData.UV + pInfo.CropX + (pInfo.CropY / 2) * pitch;
             for(i = 0; i < h; i++)
             {
-                nBytesRead = (mfxU32)fread(ptr + i * pitch, nBytesPerPixel, w, m_files[vid]);
+                nBytesRead = (mfxU32)m_files[vid]->Read(ptr + i * pitch, nBytesPerPixel, w);
 
                 if (w != nBytesRead)
                 {
@@ -483,7 +479,6 @@ mfxStatus CSmplYUVReader::LoadNextFrame(mfxFrameSurface1* pSurface)
 
 CSmplBitstreamWriter::CSmplBitstreamWriter()
 {
-    m_fSource = NULL;
     m_bInited = false;
     m_nProcessedFramesNum = 0;
 }
@@ -495,11 +490,7 @@ CSmplBitstreamWriter::~CSmplBitstreamWriter()
 
 void CSmplBitstreamWriter::Close()
 {
-    if (m_fSource)
-    {
-        fclose(m_fSource);
-        m_fSource = NULL;
-    }
+    m_fSource.Close();
 
     m_bInited = false;
 }
@@ -511,7 +502,7 @@ mfxStatus CSmplBitstreamWriter::Init(const msdk_char *strFileName)
         return MFX_ERR_NONE;
 
     if (0 == msdk_strcmp(strFileName, FILENAME_NULL)) {
-        m_fSource = 0;
+        m_fSource.Close();
         m_bInited = true;
         return MFX_ERR_NONE;
     }
@@ -519,8 +510,8 @@ mfxStatus CSmplBitstreamWriter::Init(const msdk_char *strFileName)
     Close();
 
     //init file to write encoded data
-    MSDK_FOPEN(m_fSource, strFileName, MSDK_STRING("wb+"));
-    MSDK_CHECK_POINTER(m_fSource, MFX_ERR_NULL_PTR);
+    if (MFX_ERR_NONE != m_fSource.Open(strFileName))
+        return MFX_ERR_NULL_PTR;
 
     m_sFile = msdk_string(strFileName);
     //set init state to true in case of success
@@ -541,8 +532,12 @@ mfxStatus CSmplBitstreamWriter::WriteNextFrame(mfxBitstream *pMfxBitstream, bool
 
     mfxU32 nBytesWritten = 0;
 
-    nBytesWritten = (mfxU32)fwrite(pMfxBitstream->Data + pMfxBitstream->DataOffset, 1, pMfxBitstream->DataLength, m_fSource);
-    MSDK_CHECK_NOT_EQUAL(nBytesWritten, pMfxBitstream->DataLength, MFX_ERR_UNDEFINED_BEHAVIOR);
+    // the data is written to the disk behind, "null" output isn't written at all
+    if (m_fSource.IsOpen())
+    {
+        nBytesWritten = (mfxU32)m_fSource.Write(pMfxBitstream->Data + pMfxBitstream->DataOffset, 1, pMfxBitstream->DataLength);
+        MSDK_CHECK_NOT_EQUAL(nBytesWritten, pMfxBitstream->DataLength, MFX_ERR_UNDEFINED_BEHAVIOR);
+    }
 
     // mark that we don't need bit stream data any more
     pMfxBitstream->DataLength = 0;
@@ -623,7 +618,6 @@ void CSmplBitstreamDuplicateWriter::Close()
 
 CSmplBitstreamReader::CSmplBitstreamReader()
 {
-    m_fSource = NULL;
     m_bInited = false;
 }
 
@@ -634,11 +628,7 @@ CSmplBitstreamReader::~CSmplBitstreamReader()
 
 void CSmplBitstreamReader::Close()
 {
-    if (m_fSource)
-    {
-        fclose(m_fSource);
-        m_fSource = NULL;
-    }
+    m_fSource.Close();
 
     m_bInited = false;
 }
@@ -648,7 +638,7 @@ void CSmplBitstreamReader::Reset()
     if (!m_bInited)
         return;
 
-    fseek(m_fSource, 0, SEEK_SET);
+    m_fSource.Seek(0);
 }
 
 mfxStatus CSmplBitstreamReader::Init(const msdk_char *strFileName)
@@ -660,15 +650,15 @@ mfxStatus CSmplBitstreamReader::Init(const msdk_char *strFileName)
     Close();
 
     //open file to read input stream
-    MSDK_FOPEN(m_fSource, strFileName, MSDK_STRING("rb"));
-    MSDK_CHECK_POINTER(m_fSource, MFX_ERR_NULL_PTR);
+    if (MFX_ERR_NONE != m_fSource.Open(strFileName))
+        return MFX_ERR_NULL_PTR;
 
     m_bInited = true;
     return MFX_ERR_NONE;
 }
 
 #define CHECK_SET_EOS(pBitstream)                  \
-    if (feof(m_fSource))                           \
+    if (m_fSource.IsEOF())                         \
     {                                              \
         pBitstream->DataFlag |= MFX_BITSTREAM_EOS; \
     }
@@ -686,7 +676,7 @@ mfxStatus CSmplBitstreamReader::ReadNextFrame(mfxBitstream *pBS)
 
     memmove(pBS->Data, pBS->Data + pBS->DataOffset, pBS->DataLength);
     pBS->DataOffset = 0;
-    mfxU32 nBytesRead = (mfxU32)fread(pBS->Data + pBS->DataLength, 1, pBS->MaxLength - pBS->DataLength, m_fSource);
+    mfxU32 nBytesRead = (mfxU32)m_fSource.Read(pBS->Data + pBS->DataLength, 1, pBS->MaxLength - pBS->DataLength);
 
     CHECK_SET_EOS(pBS);
 
@@ -741,7 +731,7 @@ CIVFFrameReader::CIVFFrameReader()
 
 #define READ_BYTES(pBuf, size)\
 {\
-    mfxU32 nBytesRead = (mfxU32)fread(pBuf, 1, size, m_fSource);\
+    mfxU32 nBytesRead = (mfxU32)m_fSource.Read(pBuf, 1, size);\
     if (nBytesRead !=size)\
         return MFX_ERR_MORE_DATA;\
 }\
@@ -759,7 +749,7 @@ mfxStatus CIVFFrameReader::ReadHeader()
     READ_BYTES(&m_hdr.time_scale, sizeof(m_hdr.time_scale));
     READ_BYTES(&m_hdr.num_frames, sizeof(m_hdr.num_frames));
     READ_BYTES(&m_hdr.unused, sizeof(m_hdr.unused));
-    MSDK_CHECK_NOT_EQUAL(fseek(m_fSource, m_hdr.header_len, SEEK_SET), 0, MFX_ERR_UNSUPPORTED);
+    MSDK_CHECK_NOT_EQUAL(m_fSource.Seek(m_hdr.header_len), MFX_ERR_NONE, MFX_ERR_UNSUPPORTED);
     return MFX_ERR_NONE;
 }
 
@@ -834,8 +824,6 @@ CSmplYUVWriter::CSmplYUVWriter()
 {
     m_bInited = false;
     m_bIsMultiView = false;
-    m_fDest = NULL;
-    m_fDestMVC = NULL;
     m_numCreatedFiles = 0;
     m_nViews = 0;
 };
@@ -854,8 +842,9 @@ mfxStatus CSmplYUVWriter::Init(const msdk_char *strFileName, const mfxU32 numVie
 
     if (!m_bIsMultiView)
     {
-        MSDK_FOPEN(m_fDest, m_sFile.c_str(), MSDK_STRING("wb"));
-        MSDK_CHECK_POINTER(m_fDest, MFX_ERR_NULL_PTR);
+        m_fDest.reset(new CSmplFileWriter);
+        if (MFX_ERR_NONE != m_fDest->Open(m_sFile.c_str()))
+            return MFX_ERR_NULL_PTR;
         ++m_numCreatedFiles;
     }
     else
@@ -864,11 +853,11 @@ mfxStatus CSmplYUVWriter::Init(const msdk_char *strFileName, const mfxU32 numVie
 
         MSDK_CHECK_ERROR(numViews, 0, MFX_ERR_NOT_INITIALIZED);
 
-        m_fDestMVC = new FILE*[numViews];
         for (i = 0; i < numViews; ++i)
         {
-            MSDK_FOPEN(m_fDestMVC[i], FormMVCFileName(m_sFile.c_str(), i).c_str(), MSDK_STRING("wb"));
-            MSDK_CHECK_POINTER(m_fDestMVC[i], MFX_ERR_NULL_PTR);
+            m_fDestMVC.emplace_back(new CSmplFileWriter);
+            if (MFX_ERR_NONE != m_fDestMVC.back()->Open(FormMVCFileName(m_sFile.c_str(), i).c_str()))
+                return MFX_ERR_NULL_PTR;
             ++m_numCreatedFiles;
         }
     }
@@ -893,26 +882,9 @@ CSmplYUVWriter::~CSmplYUVWriter()
 
 void CSmplYUVWriter::Close()
 {
-    if (m_fDest)
-    {
-        fclose(m_fDest);
-        m_fDest = NULL;
-    }
-
-    if (m_fDestMVC)
-    {
-        mfxU32 i = 0;
-        for (i = 0; i < m_numCreatedFiles; ++i)
-        {
-            if  (m_fDestMVC[i] != NULL)
-            {
-                fclose(m_fDestMVC[i]);
-                m_fDestMVC[i] = NULL;
-            }
-        }
-        delete [] m_fDestMVC;
-        m_fDestMVC = NULL;
-    }
+    // writers complete the data written behind on closing
+    m_fDest.reset();
+    m_fDestMVC.clear();
 
     m_numCreatedFiles = 0;
     m_bInited = false;
@@ -992,11 +964,11 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
     }
     else
     {
-        MSDK_CHECK_POINTER(m_fDestMVC, MFX_ERR_NULL_PTR);
+        MSDK_CHECK_ERROR(vid < m_fDestMVC.size(), false, MFX_ERR_NULL_PTR);
         MSDK_CHECK_POINTER(m_fDestMVC[vid], MFX_ERR_NULL_PTR);
     }
 
-    FILE* dstFile = m_bIsMultiView ? m_fDestMVC[vid] : m_fDest;
+    CSmplFileWriter* dstFile = m_bIsMultiView ? m_fDestMVC[vid].get() : m_fDest.get();
 
     mfxU32 ChromaW, ChromaH;
     if (MFX_ERR_NONE != GetChromaSize(pInfo, ChromaW, ChromaH))
@@ -1009,7 +981,7 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
         for (i = 0; i < pInfo.CropH; i++)
         {
             MSDK_CHECK_NOT_EQUAL(
-                fwrite(pData.Y + (pInfo.CropY * pData.Pitch + pInfo.CropX) + i * pData.Pitch, 1, pInfo.CropW, dstFile),
+                dstFile->Write(pData.Y + (pInfo.CropY * pData.Pitch + pInfo.CropX) + i * pData.Pitch, 1, pInfo.CropW),
                 pInfo.CropW, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
         break;
@@ -1033,13 +1005,13 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
                 }
 
                 MSDK_CHECK_NOT_EQUAL(
-                    fwrite(((const mfxU8*)tmp.data()), 4, pInfo.CropW, dstFile),
+                    dstFile->Write(((const mfxU8*)tmp.data()), 4, pInfo.CropW),
                     pInfo.CropW, MFX_ERR_UNDEFINED_BEHAVIOR);
             }
             else
             {
                 MSDK_CHECK_NOT_EQUAL(
-                    fwrite(pBuffer, 4, pInfo.CropW, dstFile),
+                    dstFile->Write(pBuffer, 4, pInfo.CropW),
                     pInfo.CropW, MFX_ERR_UNDEFINED_BEHAVIOR);
             }
         }
@@ -1054,7 +1026,7 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
         for (i = 0; i < pInfo.CropH; i++)
         {
             MSDK_CHECK_NOT_EQUAL(
-                fwrite(pBuffer + (pInfo.CropY * pData.Pitch + pInfo.CropX * 4) + i * pData.Pitch, 4, pInfo.CropW, dstFile),
+                dstFile->Write(pBuffer + (pInfo.CropY * pData.Pitch + pInfo.CropX * 4) + i * pData.Pitch, 4, pInfo.CropW),
                 pInfo.CropW, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
         return MFX_ERR_NONE;
@@ -1077,13 +1049,13 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
                 }
 
                 MSDK_CHECK_NOT_EQUAL(
-                    fwrite(((const mfxU8*)tmp.data()), 8, pInfo.CropW, dstFile),
+                    dstFile->Write(((const mfxU8*)tmp.data()), 8, pInfo.CropW),
                     pInfo.CropW, MFX_ERR_UNDEFINED_BEHAVIOR);
             }
             else
             {
                 MSDK_CHECK_NOT_EQUAL(
-                    fwrite(pBuffer, 8, pInfo.CropW, dstFile),
+                    dstFile->Write(pBuffer, 8, pInfo.CropW),
                     pInfo.CropW, MFX_ERR_UNDEFINED_BEHAVIOR);
             }
         }
@@ -1112,14 +1084,14 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
                 }
 
                 MSDK_CHECK_NOT_EQUAL(
-                    fwrite(&tmp[0], 1, (mfxU32)pInfo.CropW * 2, dstFile),
+                    dstFile->Write(&tmp[0], 1, (mfxU32)pInfo.CropW * 2),
                     (mfxU32)pInfo.CropW * 2, MFX_ERR_UNDEFINED_BEHAVIOR);
 
             }
             else
             {
                 MSDK_CHECK_NOT_EQUAL(
-                    fwrite(shortPtr, 1, (mfxU32)pInfo.CropW * 2, dstFile),
+                    dstFile->Write(shortPtr, 1, (mfxU32)pInfo.CropW * 2),
                     (mfxU32)pInfo.CropW * 2, MFX_ERR_UNDEFINED_BEHAVIOR);
             }
         }
@@ -1143,13 +1115,13 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
         for (i = 0; i < ChromaH; i++)
         {
             MSDK_CHECK_NOT_EQUAL(
-                fwrite(pData.V + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2) + i * pData.Pitch, 1, ChromaW, dstFile),
+                dstFile->Write(pData.V + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2) + i * pData.Pitch, 1, ChromaW),
                 ChromaW, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
         for (i = 0; i < ChromaH; i++)
         {
             MSDK_CHECK_NOT_EQUAL(
-                fwrite(pData.U + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2) + i * pData.Pitch / 2, 1, ChromaW, dstFile),
+                dstFile->Write(pData.U + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2) + i * pData.Pitch / 2, 1, ChromaW),
                 ChromaW, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
         break;
@@ -1159,7 +1131,7 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
         for (i = 0; i < ChromaH; i++)
         {
             MSDK_CHECK_NOT_EQUAL(
-                fwrite(pData.UV + (pInfo.CropY * pData.Pitch + pInfo.CropX) + i * pData.Pitch, 1, ChromaW, dstFile),
+                dstFile->Write(pData.UV + (pInfo.CropY * pData.Pitch + pInfo.CropX) + i * pData.Pitch, 1, ChromaW),
                 ChromaW, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
         break;
@@ -1185,14 +1157,14 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
                 }
 
                 MSDK_CHECK_NOT_EQUAL(
-                    fwrite(&tmp[0], 1, ChromaW * 2, dstFile),
+                    dstFile->Write(&tmp[0], 1, ChromaW * 2),
                     (mfxU32)ChromaW * 2, MFX_ERR_UNDEFINED_BEHAVIOR);
 
             }
             else
             {
                 MSDK_CHECK_NOT_EQUAL(
-                    fwrite(shortPtr, 1, ChromaW * 2, dstFile),
+                    dstFile->Write(shortPtr, 1, ChromaW * 2),
                     ChromaW * 2, MFX_ERR_UNDEFINED_BEHAVIOR);
             }
         }
@@ -1211,9 +1183,9 @@ mfxStatus CSmplYUVWriter::WriteNextFrame(mfxFrameSurface1 *pSurface)
 
         for (i = 0; i < ChromaH; i++)
         {
-            MSDK_CHECK_NOT_EQUAL(fwrite(ptr + i * pData.Pitch, 1, 4 * ChromaW, dstFile), 4 * ChromaW, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL(dstFile->Write(ptr + i * pData.Pitch, 1, 4 * ChromaW), 4 * ChromaW, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
-        fflush(dstFile);
+        dstFile->Flush();
         break;
     }
 
@@ -1241,7 +1213,7 @@ mfxStatus CSmplYUVWriter::WriteNextFrameI420(mfxFrameSurface1 *pSurface)
     }
     else
     {
-        MSDK_CHECK_POINTER(m_fDestMVC, MFX_ERR_NULL_PTR);
+        MSDK_CHECK_ERROR(vid < m_fDestMVC.size(), false, MFX_ERR_NULL_PTR);
         MSDK_CHECK_POINTER(m_fDestMVC[vid], MFX_ERR_NULL_PTR);
     }
 
@@ -1260,13 +1232,13 @@ mfxStatus CSmplYUVWriter::WriteNextFrameI420(mfxFrameSurface1 *pSurface)
                 if (!m_bIsMultiView)
                 {
                     MSDK_CHECK_NOT_EQUAL(
-                        fwrite(pData.Y + (pInfo.CropY * pData.Pitch + pInfo.CropX)+ i * pData.Pitch, 1, pInfo.CropW, m_fDest),
+                        m_fDest->Write(pData.Y + (pInfo.CropY * pData.Pitch + pInfo.CropX)+ i * pData.Pitch, 1, pInfo.CropW),
                         pInfo.CropW, MFX_ERR_UNDEFINED_BEHAVIOR);
                 }
                 else
                 {
                     MSDK_CHECK_NOT_EQUAL(
-                        fwrite(pData.Y + (pInfo.CropY * pData.Pitch + pInfo.CropX)+ i * pData.Pitch, 1, pInfo.CropW, m_fDestMVC[vid]),
+                        m_fDestMVC[vid]->Write(pData.Y + (pInfo.CropY * pData.Pitch + pInfo.CropX)+ i * pData.Pitch, 1, pInfo.CropW),
                         pInfo.CropW, MFX_ERR_UNDEFINED_BEHAVIOR);
                 }
             }
@@ -1289,13 +1261,13 @@ mfxStatus CSmplYUVWriter::WriteNextFrameI420(mfxFrameSurface1 *pSurface)
                 if (!m_bIsMultiView)
                 {
                     MSDK_CHECK_NOT_EQUAL(
-                        fwrite(pData.U + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2)+ i * pData.Pitch / 2, 1, ChromaW, m_fDest),
+                        m_fDest->Write(pData.U + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2)+ i * pData.Pitch / 2, 1, ChromaW),
                         (mfxU32)pInfo.CropW/2, MFX_ERR_UNDEFINED_BEHAVIOR);
                 }
                 else
                 {
                     MSDK_CHECK_NOT_EQUAL(
-                        fwrite(pData.U + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2)+ i * pData.Pitch / 2, 1, ChromaW, m_fDestMVC[vid]),
+                        m_fDestMVC[vid]->Write(pData.U + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2)+ i * pData.Pitch / 2, 1, ChromaW),
                         (mfxU32)pInfo.CropW/2, MFX_ERR_UNDEFINED_BEHAVIOR);
                 }
             }
@@ -1304,13 +1276,13 @@ mfxStatus CSmplYUVWriter::WriteNextFrameI420(mfxFrameSurface1 *pSurface)
                 if (!m_bIsMultiView)
                 {
                     MSDK_CHECK_NOT_EQUAL(
-                        fwrite(pData.V + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2)+ i * pData.Pitch / 2, 1, ChromaW, m_fDest),
+                        m_fDest->Write(pData.V + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2)+ i * pData.Pitch / 2, 1, ChromaW),
                         (mfxU32)pInfo.CropW/2, MFX_ERR_UNDEFINED_BEHAVIOR);
                 }
                 else
                 {
                     MSDK_CHECK_NOT_EQUAL(
-                        fwrite(pData.V + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2)+ i * pData.Pitch / 2, 1, ChromaW, m_fDestMVC[vid]),
+                        m_fDestMVC[vid]->Write(pData.V + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX / 2)+ i * pData.Pitch / 2, 1, ChromaW),
                         (mfxU32)pInfo.CropW/2, MFX_ERR_UNDEFINED_BEHAVIOR);
                 }
             }
@@ -1325,13 +1297,13 @@ mfxStatus CSmplYUVWriter::WriteNextFrameI420(mfxFrameSurface1 *pSurface)
                     if (!m_bIsMultiView)
                     {
                         MSDK_CHECK_NOT_EQUAL(
-                            fwrite(pData.UV + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX) + i * pData.Pitch + j, 1, 1, m_fDest),
+                            m_fDest->Write(pData.UV + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX) + i * pData.Pitch + j, 1, 1),
                             1, MFX_ERR_UNDEFINED_BEHAVIOR);
                     }
                     else
                     {
                         MSDK_CHECK_NOT_EQUAL(
-                            fwrite(pData.UV + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX) + i * pData.Pitch + j, 1, 1, m_fDestMVC[vid]),
+                            m_fDestMVC[vid]->Write(pData.UV + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX) + i * pData.Pitch + j, 1, 1),
                             1, MFX_ERR_UNDEFINED_BEHAVIOR);
                     }
                 }
@@ -1343,13 +1315,13 @@ mfxStatus CSmplYUVWriter::WriteNextFrameI420(mfxFrameSurface1 *pSurface)
                     if (!m_bIsMultiView)
                     {
                         MSDK_CHECK_NOT_EQUAL(
-                            fwrite(pData.UV + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX)+ i * pData.Pitch + j, 1, 1, m_fDest),
+                            m_fDest->Write(pData.UV + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX)+ i * pData.Pitch + j, 1, 1),
                             1, MFX_ERR_UNDEFINED_BEHAVIOR);
                     }
                     else
                     {
                         MSDK_CHECK_NOT_EQUAL(
-                            fwrite(pData.UV + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX)+ i * pData.Pitch + j, 1, 1, m_fDestMVC[vid]),
+                            m_fDestMVC[vid]->Write(pData.UV + (pInfo.CropY * pData.Pitch / 2 + pInfo.CropX)+ i * pData.Pitch + j, 1, 1),
                             1, MFX_ERR_UNDEFINED_BEHAVIOR);
                     }
                 }
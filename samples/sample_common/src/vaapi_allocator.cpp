@@ -222,6 +222,7 @@ mfxStatus vaapiFrameAllocator::ReallocImpl(mfxMemId mid, const mfxFrameInfo *inf
     VASurfaceID surfaces[1];
     VASurfaceAttrib attrib[2];
     vaapiMemId *vaapiMid = (vaapiMemId *)mid;
+    ReleaseMapping(vaapiMid);
     surfaces[0] = *vaapiMid->m_surface;
     m_libva->vaDestroySurfaces(m_dpy, surfaces, 1);
 
@@ -502,6 +503,7 @@ mfxStatus vaapiFrameAllocator::ReleaseResponse(mfxFrameAllocResponse *response)
         {
             if (MFX_FOURCC_P8 == vaapi_mids[i].m_fourcc) m_libva->vaDestroyBuffer(m_dpy, surfaces[i]);
             else if (vaapi_mids[i].m_sys_buffer) free(vaapi_mids[i].m_sys_buffer);
+            if (MFX_FOURCC_P8 != vaapi_mids[i].m_fourcc) ReleaseMapping(&vaapi_mids[i]);
             if (m_export_mode != vaapiAllocatorParams::DONOT_EXPORT) {
                 if (m_exporter && vaapi_mids[i].m_custom) {
                     m_exporter->release(&vaapi_mids[i], vaapi_mids[i].m_custom);
@@ -553,14 +555,33 @@ mfxStatus vaapiFrameAllocator::LockFrame(mfxMemId mid, mfxFrameData *ptr)
     }
     else   // Image processing
     {
-        va_res = m_libva->vaDeriveImage(m_dpy, *(vaapi_mid->m_surface), &(vaapi_mid->m_image));
-        mfx_res = va_to_mfx_status(va_res);
-
-        if (MFX_ERR_NONE == mfx_res)
+        if (vaapi_mid->m_mapped)
         {
-            va_res = m_libva->vaMapBuffer(m_dpy, vaapi_mid->m_image.buf, (void **)&pBuffer);
+            // vaMapBuffer waits for the device, the mapping kept from a read-only lock doesn't
+            va_res = m_libva->vaSyncSurface(m_dpy, *(vaapi_mid->m_surface));
             mfx_res = va_to_mfx_status(va_res);
+            pBuffer = vaapi_mid->m_mapped;
+        }
+        else
+        {
+            va_res = m_libva->vaDeriveImage(m_dpy, *(vaapi_mid->m_surface), &(vaapi_mid->m_image));
+            mfx_res = va_to_mfx_status(va_res);
+
+            if (MFX_ERR_NONE == mfx_res)
+            {
+                va_res = m_libva->vaMapBuffer(m_dpy, vaapi_mid->m_image.buf, (void **)&pBuffer);
+                mfx_res = va_to_mfx_status(va_res);
+                if (MFX_ERR_NONE != mfx_res)
+                    m_libva->vaDestroyImage(m_dpy, vaapi_mid->m_image.image_id);
+            }
+            if (MFX_ERR_NONE == mfx_res)
+                vaapi_mid->m_mapped = pBuffer;
         }
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        vaapi_mid->m_keep_mapped = !!(ptr->LockFlag & MFX_FRAMELOCK_READ_ONLY);
+#else
+        vaapi_mid->m_keep_mapped = false;
+#endif
         if (MFX_ERR_NONE == mfx_res)
         {
             switch (vaapi_mid->m_image.format.fourcc)
@@ -740,8 +761,7 @@ mfxStatus vaapiFrameAllocator::LockFrame(mfxMemId mid, mfxFrameData *ptr)
                 break;
 #endif
             default:
-                m_libva->vaUnmapBuffer(m_dpy, vaapi_mid->m_image.buf);
-                m_libva->vaDestroyImage(m_dpy, vaapi_mid->m_image.image_id);
+                ReleaseMapping(vaapi_mid);
                 return MFX_ERR_LOCK_MEMORY;
             }
         }
@@ -766,8 +786,9 @@ mfxStatus vaapiFrameAllocator::UnlockFrame(mfxMemId mid, mfxFrameData *ptr)
     }
     else  // Image processing
     {
-        m_libva->vaUnmapBuffer(m_dpy, vaapi_mid->m_image.buf);
-        m_libva->vaDestroyImage(m_dpy, vaapi_mid->m_image.image_id);
+        // nothing was written after a read-only lock, the mapping is reused by the next lock
+        if (!vaapi_mid->m_keep_mapped)
+            ReleaseMapping(vaapi_mid);
 
         if (NULL != ptr)
         {
@@ -788,8 +809,22 @@ mfxStatus vaapiFrameAllocator::GetFrameHDL(mfxMemId mid, mfxHDL *handle)
 
     if (!handle || !vaapi_mid || !(vaapi_mid->m_surface)) return MFX_ERR_INVALID_HANDLE;
 
+    // the device is going to access the surface, a kept mapping is stale after it
+    ReleaseMapping(vaapi_mid);
+
     *handle = vaapi_mid->m_surface; //VASurfaceID* <-> mfxHDL
     return MFX_ERR_NONE;
 }
 
+void vaapiFrameAllocator::ReleaseMapping(vaapiMemId* vaapi_mid)
+{
+    if (!vaapi_mid->m_mapped)
+        return;
+
+    m_libva->vaUnmapBuffer(m_dpy, vaapi_mid->m_image.buf);
+    m_libva->vaDestroyImage(m_dpy, vaapi_mid->m_image.image_id);
+    vaapi_mid->m_mapped = NULL;
+    vaapi_mid->m_keep_mapped = false;
+}
+
 #endif // #if defined(LIBVA_SUPPORT)
@@ -0,0 +1,101 @@
+/******************************************************************************\
+Copyright (c) 2020, Intel Corporation
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+This sample was distributed or derived from the Intel's Media Samples package.
+The original version of this sample may be obtained from https://software.intel.com/en-us/intel-media-server-studio
+or https://software.intel.com/en-us/media-client-solutions-support.
+\**********************************************************************************/
+
+#ifndef __GOP_PARALLEL_DECODE_H__
+#define __GOP_PARALLEL_DECODE_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "hw_device.h"
+#include "pipeline_decode.h"
+
+// Offline decoding of H.264 and HEVC elementary streams by several sessions
+// at once. The input is split at closed GOP boundaries (IDR, BLA and CRA
+// pictures without RASL pictures), each part is decoded on its own from the
+// parameter sets seen before it and the output is written in stream order.
+//
+// The split assumes the pictures before a boundary are all output before it,
+// i.e. no_output_of_prior_pics_flag of an IDR picture isn't honored.
+
+struct GopSegment
+{
+    mfxU64 offset;
+    mfxU64 size;
+    // parameter sets to decode the segment from, in Annex B format
+    std::vector<mfxU8> header;
+};
+
+// scans the file for the decoding entry points, neighbouring ones are merged
+// until the segment is at least minSize bytes long
+mfxStatus FindGopSegments(const msdk_char *strFileName, mfxU32 codecId, mfxU64 minSize, std::vector<GopSegment> &segments);
+
+class CGopParallelDecoder
+{
+public:
+    CGopParallelDecoder();
+    virtual ~CGopParallelDecoder();
+
+    virtual mfxStatus Init(sInputParams *pParams);
+    virtual mfxStatus RunDecoding();
+    virtual void Close();
+    virtual void PrintInfo();
+
+protected:
+    struct SegmentResult
+    {
+        SegmentResult() : bDone(false), sts(MFX_ERR_NONE), nFrames(0) {}
+
+        bool      bDone;
+        mfxStatus sts;
+        mfxU32    nFrames;
+    };
+
+    mfxStatus InitSession(MFXVideoSession &session);
+    mfxStatus DecodeSegment(MFXVideoSession &session, size_t idx, mfxU32 &nFrames);
+    // appends the part of the segment to the output and removes it
+    mfxStatus WriteOutput(CSmplFileWriter &output, size_t idx);
+    void      WorkerRoutine();
+    msdk_string PartFileName(size_t idx) const;
+
+    sInputParams              m_params;
+    std::vector<GopSegment>   m_segments;
+    std::vector<SegmentResult> m_results;
+    std::atomic<size_t>       m_nextSegment;
+    std::atomic<bool>         m_bStop;
+    std::mutex                m_mutex;
+    std::condition_variable   m_cond;
+    std::vector<std::thread>  m_threads;
+
+    std::unique_ptr<CHWDevice> m_hwdev;
+#if defined(MFX_ONEVPL)
+    mfxLoader                 m_loader;
+#endif
+    mfxU32                    m_nFrames;
+
+private:
+    CGopParallelDecoder(const CGopParallelDecoder&);
+    void operator=(const CGopParallelDecoder&);
+};
+
+#endif // __GOP_PARALLEL_DECODE_H__
@@ -95,6 +95,7 @@ struct sInputParams
     mfxU32  numViews; // number of views for Multi-View Codec
     mfxU32  nRotation; // rotation for Motion JPEG Codec
     mfxU16  nAsyncDepth; // asyncronous queue
+    mfxU16  nGopParallel; // number of sessions decoding closed GOPs in parallel
     mfxU16  nTimeout; // timeout in seconds
     mfxU16  gpuCopy; // GPU Copy mode (three-state option)
     bool    bSoftRobustFlag;
@@ -0,0 +1,749 @@
+/******************************************************************************\
+Copyright (c) 2020, Intel Corporation
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+This sample was distributed or derived from the Intel's Media Samples package.
+The original version of this sample may be obtained from https://software.intel.com/en-us/intel-media-server-studio
+or https://software.intel.com/en-us/media-client-solutions-support.
+\**********************************************************************************/
+
+#include "gop_parallel_decode.h"
+#include "sample_file_io.h"
+#include "sysmem_allocator.h"
+#include "version.h"
+
+#if defined(LIBVA_SUPPORT)
+#include "vaapi_device.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+const mfxU32 ScanChunkSize    = 1024 * 1024;
+const mfxU32 BitstreamSize    = 4 * 1024 * 1024;
+const size_t NalHeaderSize    = 3;
+const size_t MaxParamSetSize  = 64 * 1024;
+const size_t MaxParamSets     = 64;
+
+enum eSliceKind
+{
+    SLICE_OTHER,
+    SLICE_IDR,      // IDR and BLA pictures, always a boundary
+    SLICE_CRA,      // a boundary if no RASL picture follows
+    SLICE_RASL,
+    SLICE_TRAILING
+};
+
+// Annex B scanner, the units are processed when the next start code is found
+class CGopScanner
+{
+public:
+    CGopScanner(mfxU32 codecId, mfxU64 minSize)
+        : m_codecId(codecId)
+        , m_minSize(minSize)
+        , m_zeros(0)
+        , m_bInNal(false)
+        , m_bParamSet(false)
+        , m_nalOffset(0)
+        , m_bPrefix(false)
+        , m_prefixOffset(0)
+        , m_bCandidate(false)
+        , m_candidateOffset(0)
+        , m_lastOffset(0)
+    {
+    }
+
+    void Push(const mfxU8 *data, size_t size, mfxU64 offset)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            const mfxU8 b = data[i];
+
+            if (1 == b && m_zeros >= 2)
+            {
+                // the leading zero byte of a 4 byte start code goes with it
+                const mfxU64 start = offset + i - std::min<mfxU32>(m_zeros, 3);
+                if (m_bInNal)
+                    OnNal();
+
+                m_bInNal    = true;
+                m_bParamSet = false;
+                m_nalOffset = start;
+                m_nal.clear();
+                m_zeros = 0;
+                continue;
+            }
+
+            m_zeros = b ? 0 : m_zeros + 1;
+
+            if (!m_bInNal)
+                continue;
+
+            // only the header of slices is needed, parameter sets are kept whole
+            if (m_nal.size() < NalHeaderSize || (m_bParamSet && m_nal.size() <= MaxParamSetSize))
+            {
+                m_nal.push_back(b);
+                if (1 == m_nal.size() || 2 == m_nal.size())
+                    m_bParamSet = IsParamSet();
+            }
+        }
+    }
+
+    void Finish()
+    {
+        if (m_bInNal)
+            OnNal();
+        m_bInNal = false;
+    }
+
+    std::vector<GopSegment> & Segments() { return m_segments; }
+
+protected:
+    bool IsParamSet() const
+    {
+        if (MFX_CODEC_HEVC == m_codecId)
+        {
+            if (m_nal.size() < 2)
+                return false;
+            const mfxU32 type = (m_nal[0] >> 1) & 0x3f;
+            return type >= 32 && type <= 34;
+        }
+
+        const mfxU32 type = m_nal[0] & 0x1f;
+        return 7 == type || 8 == type || 13 == type || 15 == type;
+    }
+
+    void OnNal()
+    {
+        // the zeros of the next start code and the trailing zero bytes
+        while (!m_nal.empty() && !m_nal.back())
+            m_nal.pop_back();
+        if (m_nal.empty())
+            return;
+
+        if (MFX_CODEC_HEVC == m_codecId)
+            OnNalHEVC();
+        else
+            OnNalAVC();
+    }
+
+    void OnNalHEVC()
+    {
+        if (m_nal.size() < 2)
+            return;
+
+        const mfxU32 type  = (m_nal[0] >> 1) & 0x3f;
+        const mfxU32 layer = ((m_nal[0] & 1) << 5) | (m_nal[1] >> 3);
+        if (layer)
+            return;
+
+        if (type < 32)
+        {
+            const bool bFirst = m_nal.size() > 2 && (m_nal[2] & 0x80);
+            eSliceKind kind = SLICE_OTHER;
+            if (type <= 5)
+                kind = SLICE_TRAILING;
+            else if (8 == type || 9 == type)
+                kind = SLICE_RASL;
+            else if (type >= 16 && type <= 20)
+                kind = SLICE_IDR;
+            else if (21 == type)
+                kind = SLICE_CRA;
+            OnSlice(bFirst, kind);
+            return;
+        }
+
+        if (m_bParamSet)
+            StoreParamSet();
+
+        // AUD, parameter sets, prefix SEI and the reserved prefix types
+        const bool bPrefix = type <= 35 || 39 == type || (type >= 41 && type <= 44) || (type >= 48 && type <= 55);
+        OnPrefix(35 == type, bPrefix);
+    }
+
+    void OnNalAVC()
+    {
+        const mfxU32 type = m_nal[0] & 0x1f;
+
+        if (1 == type || 2 == type || 5 == type)
+        {
+            // first_mb_in_slice equal to 0 is the single bit '1'
+            const bool bFirst = m_nal.size() > 1 && (m_nal[1] & 0x80);
+            OnSlice(bFirst, 5 == type ? SLICE_IDR : SLICE_OTHER);
+            return;
+        }
+        if (3 == type || 4 == type)
+        {
+            OnSlice(false, SLICE_OTHER);
+            return;
+        }
+
+        if (m_bParamSet)
+            StoreParamSet();
+
+        const bool bPrefix = (type >= 6 && type <= 9) || (type >= 13 && type <= 18);
+        OnPrefix(9 == type, bPrefix);
+    }
+
+    void OnPrefix(bool bDelimiter, bool bPrefix)
+    {
+        if (bDelimiter || (bPrefix && !m_bPrefix))
+        {
+            m_bPrefix      = true;
+            m_prefixOffset = m_nalOffset;
+        }
+    }
+
+    void OnSlice(bool bFirst, eSliceKind kind)
+    {
+        if (!bFirst)
+        {
+            m_bPrefix = false;
+            return;
+        }
+
+        // the access unit starts with the prefix units before its first slice
+        const mfxU64 start = m_bPrefix ? m_prefixOffset : m_nalOffset;
+        m_bPrefix = false;
+
+        switch (kind)
+        {
+        case SLICE_IDR:
+            m_bCandidate = false;
+            AddBoundary(start, GetHeader());
+            break;
+        case SLICE_CRA:
+            if (m_bCandidate)
+                AddBoundary(m_candidateOffset, m_candidateHeader);
+            m_bCandidate      = true;
+            m_candidateOffset = start;
+            m_candidateHeader = GetHeader();
+            break;
+        case SLICE_RASL:
+            m_bCandidate = false;
+            break;
+        case SLICE_TRAILING:
+            // trailing pictures follow all leading pictures in decoding order
+            if (m_bCandidate)
+                AddBoundary(m_candidateOffset, m_candidateHeader);
+            m_bCandidate = false;
+            break;
+        default:
+            break;
+        }
+    }
+
+    void StoreParamSet()
+    {
+        if (m_nal.size() > MaxParamSetSize)
+            return;
+
+        // kept in the order of the last occurrence, so a later one takes precedence
+        auto it = std::find(m_paramSets.begin(), m_paramSets.end(), m_nal);
+        if (it != m_paramSets.end())
+            m_paramSets.erase(it);
+        m_paramSets.push_back(m_nal);
+
+        if (m_paramSets.size() > MaxParamSets)
+            m_paramSets.erase(m_paramSets.begin());
+    }
+
+    std::vector<mfxU8> GetHeader() const
+    {
+        static const mfxU8 startCode[] = { 0, 0, 0, 1 };
+
+        std::vector<mfxU8> header;
+        for (const auto & ps : m_paramSets)
+        {
+            header.insert(header.end(), startCode, startCode + sizeof(startCode));
+            header.insert(header.end(), ps.begin(), ps.end());
+        }
+        return header;
+    }
+
+    void AddBoundary(mfxU64 offset, const std::vector<mfxU8> &header)
+    {
+        if (m_segments.empty())
+        {
+            // the stream itself is the first entry point
+            GopSegment first = {};
+            m_segments.push_back(first);
+        }
+        if (offset - m_lastOffset < m_minSize)
+            return;
+
+        GopSegment segment = {};
+        segment.offset = offset;
+        segment.header = header;
+        m_segments.push_back(segment);
+        m_lastOffset = offset;
+    }
+
+    const mfxU32 m_codecId;
+    const mfxU64 m_minSize;
+
+    mfxU32             m_zeros;
+    bool               m_bInNal;
+    bool               m_bParamSet;
+    mfxU64             m_nalOffset;
+    std::vector<mfxU8> m_nal;
+
+    bool               m_bPrefix;
+    mfxU64             m_prefixOffset;
+
+    bool               m_bCandidate;
+    mfxU64             m_candidateOffset;
+    std::vector<mfxU8> m_candidateHeader;
+
+    std::vector<std::vector<mfxU8> > m_paramSets;
+    std::vector<GopSegment>          m_segments;
+    mfxU64                           m_lastOffset;
+};
+
+} // namespace
+
+mfxStatus FindGopSegments(const msdk_char *strFileName, mfxU32 codecId, mfxU64 minSize, std::vector<GopSegment> &segments)
+{
+    MSDK_CHECK_POINTER(strFileName, MFX_ERR_NULL_PTR);
+
+    if (MFX_CODEC_AVC != codecId && MFX_CODEC_HEVC != codecId)
+        return MFX_ERR_UNSUPPORTED;
+
+    CSmplFileReader reader;
+    mfxStatus sts = reader.Open(strFileName);
+    MSDK_CHECK_STATUS(sts, "reader.Open failed");
+
+    CGopScanner scanner(codecId, minSize);
+    std::vector<mfxU8> chunk(ScanChunkSize);
+    mfxU64 offset = 0;
+
+    for (;;)
+    {
+        size_t size = reader.Read(chunk.data(), 1, chunk.size());
+        if (!size)
+            break;
+
+        scanner.Push(chunk.data(), size, offset);
+        offset += size;
+    }
+    scanner.Finish();
+
+    segments.swap(scanner.Segments());
+    if (segments.empty())
+    {
+        GopSegment first = {};
+        segments.push_back(first);
+    }
+
+    for (size_t i = 0; i < segments.size(); i++)
+        segments[i].size = (i + 1 < segments.size() ? segments[i + 1].offset : offset) - segments[i].offset;
+
+    return MFX_ERR_NONE;
+}
+
+CGopParallelDecoder::CGopParallelDecoder()
+    : m_params()
+    , m_nextSegment(0)
+    , m_bStop(false)
+#if defined(MFX_ONEVPL)
+    , m_loader(nullptr)
+#endif
+    , m_nFrames(0)
+{
+}
+
+CGopParallelDecoder::~CGopParallelDecoder()
+{
+    Close();
+}
+
+mfxStatus CGopParallelDecoder::Init(sInputParams *pParams)
+{
+    MSDK_CHECK_POINTER(pParams, MFX_ERR_NULL_PTR);
+
+    m_params = *pParams;
+
+    if (MFX_CODEC_AVC != m_params.videoType && MFX_CODEC_HEVC != m_params.videoType)
+    {
+        msdk_printf(MSDK_STRING("error: GOP parallel decoding supports only h264 and h265 streams\n"));
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    // segments of a few GOPs keep the decoder initialization negligible
+    const mfxU64 minSegmentSize = 4 * 1024 * 1024;
+
+    mfxStatus sts = FindGopSegments(m_params.strSrcFile, m_params.videoType, minSegmentSize, m_segments);
+    MSDK_CHECK_STATUS(sts, "FindGopSegments failed");
+
+#if defined(LIBVA_SUPPORT)
+    // on Linux MediaSDK doesn't create device internally, one display serves all sessions
+    if (m_params.bUseHWLib && !m_params.useHDDL)
+    {
+        m_hwdev.reset(CreateVAAPIDevice(m_params.strDevicePath, MFX_LIBVA_DRM));
+        MSDK_CHECK_POINTER(m_hwdev.get(), MFX_ERR_MEMORY_ALLOC);
+
+        sts = m_hwdev->Init(&m_params.monitorType, 0, 0);
+        MSDK_CHECK_STATUS(sts, "m_hwdev->Init failed");
+    }
+#endif
+
+#if defined(MFX_ONEVPL)
+    m_loader = MFXLoad();
+    MSDK_CHECK_POINTER(m_loader, MFX_ERR_NULL_PTR);
+
+    auto cfg = MFXCreateConfig(m_loader);
+    MSDK_CHECK_POINTER(cfg, MFX_ERR_NULL_PTR);
+
+    mfxVariant ImplValue = { 0 };
+    ImplValue.Type = MFX_VARIANT_TYPE_U32;
+    ImplValue.Data.U32 = m_params.videoType;
+    sts = MFXSetConfigFilterProperty(cfg, (mfxU8*)"mfxImplDescription.mfxDecoderDescription.decoder.CodecID", ImplValue);
+    MSDK_CHECK_STATUS(sts, "MFXSetConfigFilterProperty failed");
+#endif
+
+    return MFX_ERR_NONE;
+}
+
+void CGopParallelDecoder::Close()
+{
+    m_bStop = true;
+    for (auto & thread : m_threads)
+        thread.join();
+    m_threads.clear();
+
+#if defined(MFX_ONEVPL)
+    if (m_loader)
+        MFXUnload(m_loader);
+    m_loader = nullptr;
+#endif
+
+    m_hwdev.reset();
+}
+
+void CGopParallelDecoder::PrintInfo()
+{
+    msdk_printf(MSDK_STRING("Decoding Sample Version %s\n\n"), GetMSDKSampleVersion().c_str());
+    msdk_printf(MSDK_STRING("Input video\t%s\n"), CodecIdToStr(m_params.videoType).c_str());
+    msdk_printf(MSDK_STRING("GOP parallel\t%u sessions, %u segments\n"),
+        (mfxU32)m_params.nGopParallel, (mfxU32)m_segments.size());
+    msdk_printf(MSDK_STRING("Output\t\t%s\n"), MODE_FILE_DUMP == m_params.mode ? m_params.strDstFile : MSDK_STRING("none"));
+    msdk_printf(MSDK_STRING("\n"));
+}
+
+msdk_string CGopParallelDecoder::PartFileName(size_t idx) const
+{
+    msdk_stringstream name;
+    name << m_params.strDstFile << MSDK_STRING(".part") << idx;
+    return name.str();
+}
+
+mfxStatus CGopParallelDecoder::InitSession(MFXVideoSession &session)
+{
+    mfxStatus sts = MFX_ERR_NONE;
+
+#if !defined(MFX_ONEVPL)
+    mfxInitParamlWrap initPar;
+    initPar.Version.Major = 1;
+    initPar.Version.Minor = 0;
+    initPar.GPUCopy = m_params.gpuCopy;
+
+    if (!m_params.bUseHWLib)
+        initPar.Implementation = MFX_IMPL_SOFTWARE;
+    else if (m_params.useHDDL)
+        initPar.Implementation = MFX_IMPL_VIA_HDDL;
+    else
+        initPar.Implementation = MFX_IMPL_HARDWARE_ANY;
+
+    sts = session.InitEx(initPar);
+    MSDK_CHECK_STATUS(sts, "session.InitEx failed");
+#else
+    mfxSession hdl = nullptr;
+    sts = MFXCreateSession(m_loader, 0, &hdl);
+    MSDK_CHECK_STATUS(sts, "Not able to create VPL session");
+
+    session.SetSession(hdl);
+#endif
+
+#if defined(LIBVA_SUPPORT)
+    if (m_hwdev)
+    {
+        mfxHDL hdl = NULL;
+        sts = m_hwdev->GetHandle(MFX_HANDLE_VA_DISPLAY, &hdl);
+        MSDK_CHECK_STATUS(sts, "m_hwdev->GetHandle failed");
+        sts = session.SetHandle(MFX_HANDLE_VA_DISPLAY, hdl);
+        MSDK_CHECK_STATUS(sts, "session.SetHandle failed");
+    }
+#endif
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus CGopParallelDecoder::DecodeSegment(MFXVideoSession &session, size_t idx, mfxU32 &nFrames)
+{
+    const GopSegment &segment = m_segments[idx];
+    mfxStatus sts = MFX_ERR_NONE;
+
+    CSmplFileReader reader;
+    sts = reader.Open(m_params.strSrcFile);
+    MSDK_CHECK_STATUS(sts, "reader.Open failed");
+    sts = reader.Seek(segment.offset);
+    MSDK_CHECK_STATUS(sts, "reader.Seek failed");
+
+    // the parameter sets go first, the segment may not repeat them
+    mfxBitstreamWrapper bs(std::max<mfxU32>(BitstreamSize, (mfxU32)segment.header.size() * 2));
+    std::copy(segment.header.begin(), segment.header.end(), bs.Data);
+    bs.DataLength = (mfxU32)segment.header.size();
+
+    mfxU64 left = segment.size;
+    auto ReadMore = [&]() -> bool
+    {
+        if (!left)
+            return false;
+
+        memmove(bs.Data, bs.Data + bs.DataOffset, bs.DataLength);
+        bs.DataOffset = 0;
+        if (bs.DataLength == bs.MaxLength)
+            bs.Extend(bs.MaxLength * 2);
+
+        size_t size = (size_t)std::min<mfxU64>(bs.MaxLength - bs.DataLength, left);
+        size = reader.Read(bs.Data + bs.DataLength, 1, size);
+        if (!size)
+        {
+            left = 0;
+            return false;
+        }
+        bs.DataLength += (mfxU32)size;
+        left -= size;
+        return true;
+    };
+    ReadMore();
+
+    // the frames are freed after the decoder is closed
+    SysMemFrameAllocator allocator;
+    std::vector<mfxFrameSurface1> surfaces;
+    MFXVideoDECODE decoder(session);
+
+    mfxVideoParam par = {};
+    par.mfx.CodecId = m_params.videoType;
+    par.IOPattern = MFX_IOPATTERN_OUT_SYSTEM_MEMORY;
+    par.AsyncDepth = m_params.nAsyncDepth;
+
+    for (;;)
+    {
+        sts = decoder.DecodeHeader(&bs, &par);
+        if (MFX_ERR_MORE_DATA == sts && ReadMore())
+            continue;
+        break;
+    }
+    MSDK_IGNORE_MFX_STS(sts, MFX_WRN_PARTIAL_ACCELERATION);
+    MSDK_CHECK_STATUS(sts, "decoder.DecodeHeader failed");
+
+    mfxFrameAllocRequest request = {};
+    sts = decoder.QueryIOSurf(&par, &request);
+    MSDK_IGNORE_MFX_STS(sts, MFX_WRN_PARTIAL_ACCELERATION);
+    MSDK_CHECK_STATUS(sts, "decoder.QueryIOSurf failed");
+
+    sts = allocator.Init(nullptr);
+    MSDK_CHECK_STATUS(sts, "allocator.Init failed");
+
+    mfxFrameAllocResponse response = {};
+    sts = allocator.Alloc(allocator.pthis, &request, &response);
+    MSDK_CHECK_STATUS(sts, "allocator.Alloc failed");
+
+    // the decoder works with the pointers, the frames stay locked
+    surfaces.resize(response.NumFrameActual);
+    for (mfxU16 i = 0; i < response.NumFrameActual; i++)
+    {
+        surfaces[i].Info = par.mfx.FrameInfo;
+        sts = allocator.Lock(allocator.pthis, response.mids[i], &surfaces[i].Data);
+        MSDK_CHECK_STATUS(sts, "allocator.Lock failed");
+    }
+
+    sts = decoder.Init(&par);
+    MSDK_IGNORE_MFX_STS(sts, MFX_WRN_PARTIAL_ACCELERATION);
+    MSDK_CHECK_STATUS(sts, "decoder.Init failed");
+
+    CSmplYUVWriter writer;
+    const bool bOutput = MODE_FILE_DUMP == m_params.mode;
+    if (bOutput)
+    {
+        sts = writer.Init(PartFileName(idx).c_str(), 1);
+        MSDK_CHECK_STATUS(sts, "writer.Init failed");
+    }
+
+    bool bDrain = !left && !bs.DataLength;
+    while (!m_bStop)
+    {
+        mfxU16 nIndex = GetFreeSurfaceIndex(surfaces.data(), (mfxU16)surfaces.size());
+        if (MSDK_INVALID_SURF_IDX == nIndex)
+            return MFX_ERR_NOT_ENOUGH_BUFFER;
+
+        mfxFrameSurface1 *pOutSurface = nullptr;
+        mfxSyncPoint syncp = nullptr;
+
+        sts = decoder.DecodeFrameAsync(bDrain ? nullptr : &bs, &surfaces[nIndex], &pOutSurface, &syncp);
+
+        if (MFX_WRN_DEVICE_BUSY == sts)
+        {
+            MSDK_SLEEP(1);
+            continue;
+        }
+        if (MFX_ERR_MORE_DATA == sts)
+        {
+            if (bDrain)
+                break;
+            bDrain = !ReadMore();
+            continue;
+        }
+        if (MFX_ERR_MORE_SURFACE == sts)
+            continue;
+        if (sts > MFX_ERR_NONE && syncp)
+            sts = MFX_ERR_NONE;
+        MSDK_CHECK_STATUS(sts, "decoder.DecodeFrameAsync failed");
+
+        if (!syncp)
+            continue;
+
+        sts = session.SyncOperation(syncp, MSDK_DEC_WAIT_INTERVAL);
+        MSDK_CHECK_STATUS(sts, "session.SyncOperation failed");
+
+        if (bOutput)
+        {
+            sts = m_params.outI420 ? writer.WriteNextFrameI420(pOutSurface) : writer.WriteNextFrame(pOutSurface);
+            MSDK_CHECK_STATUS(sts, "writer.WriteNextFrame failed");
+        }
+        nFrames++;
+    }
+
+    decoder.Close();
+    return m_bStop ? MFX_ERR_ABORTED : MFX_ERR_NONE;
+}
+
+void CGopParallelDecoder::WorkerRoutine()
+{
+    MFXVideoSession session;
+    const mfxStatus initSts = InitSession(session);
+
+    // every segment is marked done, so the output thread never waits for a stopped worker
+    for (size_t idx = m_nextSegment++; idx < m_segments.size(); idx = m_nextSegment++)
+    {
+        mfxU32 nFrames = 0;
+        mfxStatus sts = initSts;
+        if (MFX_ERR_NONE == sts)
+            sts = m_bStop ? MFX_ERR_ABORTED : DecodeSegment(session, idx, nFrames);
+        if (sts < MFX_ERR_NONE)
+            m_bStop = true;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results[idx].bDone   = true;
+        m_results[idx].sts     = sts;
+        m_results[idx].nFrames = nFrames;
+        m_cond.notify_all();
+    }
+
+    session.Close();
+}
+
+mfxStatus CGopParallelDecoder::WriteOutput(CSmplFileWriter &output, size_t idx)
+{
+    const msdk_string name = PartFileName(idx);
+
+    CSmplFileReader part;
+    mfxStatus sts = part.Open(name.c_str());
+    MSDK_CHECK_STATUS(sts, "part.Open failed");
+
+    std::vector<mfxU8> chunk(ScanChunkSize);
+    for (;;)
+    {
+        size_t size = part.Read(chunk.data(), 1, chunk.size());
+        if (!size)
+            break;
+        if (output.Write(chunk.data(), 1, size) != size)
+        {
+            sts = MFX_ERR_UNDEFINED_BEHAVIOR;
+            break;
+        }
+    }
+    part.Close();
+
+    msdk_remove(name.c_str());
+    return sts;
+}
+
+mfxStatus CGopParallelDecoder::RunDecoding()
+{
+    mfxStatus sts = MFX_ERR_NONE;
+    const bool bOutput = MODE_FILE_DUMP == m_params.mode;
+
+    CSmplFileWriter output;
+    if (bOutput)
+    {
+        sts = output.Open(m_params.strDstFile);
+        MSDK_CHECK_STATUS(sts, "output.Open failed");
+    }
+
+    CTimer timer;
+    timer.Start();
+
+    m_results.assign(m_segments.size(), SegmentResult());
+    m_nextSegment = 0;
+    m_bStop = false;
+    m_nFrames = 0;
+
+    const size_t nThreads = std::min<size_t>(std::max<mfxU16>(m_params.nGopParallel, 1), m_segments.size());
+    for (size_t i = 0; i < nThreads; i++)
+        m_threads.emplace_back(&CGopParallelDecoder::WorkerRoutine, this);
+
+    // the parts are joined in stream order as soon as they are ready
+    for (size_t idx = 0; idx < m_segments.size(); idx++)
+    {
+        mfxStatus segmentSts = MFX_ERR_NONE;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [&] { return m_results[idx].bDone; });
+            segmentSts = m_results[idx].sts;
+            m_nFrames += m_results[idx].nFrames;
+        }
+
+        if (MFX_ERR_NONE == sts)
+            sts = segmentSts;
+
+        if (MFX_ERR_NONE == sts && bOutput)
+            sts = WriteOutput(output, idx);
+        else if (bOutput)
+            msdk_remove(PartFileName(idx).c_str());
+
+        if (sts < MFX_ERR_NONE)
+            m_bStop = true;
+    }
+
+    for (auto & thread : m_threads)
+        thread.join();
+    m_threads.clear();
+
+    if (bOutput)
+    {
+        mfxStatus closeSts = output.Close();
+        if (MFX_ERR_NONE == sts)
+            sts = closeSts;
+    }
+
+    mfxF64 time = timer.GetTime();
+    msdk_printf(MSDK_STRING("Frame number: %u, segments: %u, time: %.3f s, fps: %.2f\n"),
+        m_nFrames, (mfxU32)m_segments.size(), time, time > 0 ? m_nFrames / time : 0.);
+
+    return sts;
+}
@@ -20,6 +20,7 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include "mfx_samples_config.h"
 
 #include "pipeline_decode.h"
+#include "gop_parallel_decode.h"
 #include <sstream>
 #include "version.h"
 
@@ -117,6 +118,7 @@ void PrintHelp(msdk_char *strAppName, const msdk_char *strErrorMessage)
     msdk_printf(MSDK_STRING("   [-low_latency]            - configures decoder for low latency mode (supported only for H.264 and JPEG codec)\n"));
     msdk_printf(MSDK_STRING("   [-calc_latency]           - calculates latency during decoding and prints log (supported only for H.264 and JPEG codec)\n"));
     msdk_printf(MSDK_STRING("   [-async]                  - depth of asynchronous pipeline. default value is 4. must be between 1 and 20\n"));
+    msdk_printf(MSDK_STRING("   [-gop_parallel n]         - offline decoding of closed GOPs by n sessions in parallel (supported only for H.264 and HEVC codec)\n"));
     msdk_printf(MSDK_STRING("   [-gpucopy::<on,off>] Enable or disable GPU copy mode\n"));
     msdk_printf(MSDK_STRING("   [-robust:soft]            - GPU hang recovery by inserting an IDR frame\n"));
     msdk_printf(MSDK_STRING("   [-timeout]                - timeout in seconds\n"));
@@ -385,6 +387,19 @@ mfxStatus ParseInputString(msdk_char* strInput[], mfxU8 nArgNum, sInputParams* p
                 return MFX_ERR_UNSUPPORTED;
             }
         }
+        else if (0 == msdk_strcmp(strInput[i], MSDK_STRING("-gop_parallel")))
+        {
+            if(i + 1 >= nArgNum)
+            {
+                PrintHelp(strInput[0], MSDK_STRING("Not enough parameters for -gop_parallel key"));
+                return MFX_ERR_UNSUPPORTED;
+            }
+            if (MFX_ERR_NONE != msdk_opt_read(strInput[++i], pParams->nGopParallel) || !pParams->nGopParallel)
+            {
+                PrintHelp(strInput[0], MSDK_STRING("gop_parallel is invalid"));
+                return MFX_ERR_UNSUPPORTED;
+            }
+        }
         else if (0 == msdk_strcmp(strInput[i], MSDK_STRING("-timeout")))
         {
             if(i + 1 >= nArgNum)
@@ -709,6 +724,20 @@ mfxStatus ParseInputString(msdk_char* strInput[], mfxU8 nArgNum, sInputParams* p
         return MFX_ERR_UNSUPPORTED;
     }
 
+    if (pParams->nGopParallel)
+    {
+        if (MFX_CODEC_AVC != pParams->videoType && MFX_CODEC_HEVC != pParams->videoType)
+        {
+            PrintHelp(strInput[0], MSDK_STRING("-gop_parallel is supported only for H.264 and HEVC codecs"));
+            return MFX_ERR_UNSUPPORTED;
+        }
+        if (MODE_RENDERING == pParams->mode || pParams->bIsMVC || pParams->Width || pParams->Height)
+        {
+            PrintHelp(strInput[0], MSDK_STRING("-gop_parallel doesn't support rendering, MVC and resizing"));
+            return MFX_ERR_UNSUPPORTED;
+        }
+    }
+
     if (pParams->nAsyncDepth == 0)
     {
         pParams->nAsyncDepth = MAX_ASYNC_DEPTH; //set by default;
@@ -746,6 +775,23 @@ int main(int argc, char *argv[])
     }
     MSDK_CHECK_PARSE_RESULT(sts, MFX_ERR_NONE, 1);
 
+    if (Params.nGopParallel)
+    {
+        CGopParallelDecoder Decoder;
+
+        sts = Decoder.Init(&Params);
+        MSDK_CHECK_STATUS(sts, "Decoder.Init failed");
+
+        Decoder.PrintInfo();
+
+        msdk_printf(MSDK_STRING("Decoding started\n"));
+        sts = Decoder.RunDecoding();
+        MSDK_CHECK_STATUS(sts, "Decoder.RunDecoding failed");
+        msdk_printf(MSDK_STRING("\nDecoding finished\n"));
+
+        return 0;
+    }
+
     if (Params.bIsMVC)
         Pipeline.SetMultiView();
 
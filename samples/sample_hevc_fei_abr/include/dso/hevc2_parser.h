@@ -421,6 +421,7 @@ private:
     Bs8u  intra_chroma_pred_mode[2][2] = {};
 
     bool report_TCLevels = false;
+    bool report_Flat     = false;
     std::vector<Bs32s> TCLevels;
 
     template<class T> T* Alloc(Bs16u n_elem = 1)
@@ -477,7 +478,10 @@ private:
 public:
     BS_MEM::Allocator* m_pAllocator;
 
-    SDParser(bool report_TC = false);
+    SDParser(bool report_TC = false, bool report_flat = false);
+
+    //fill Slice::data, see PARSE_SSD_FLAT
+    inline void ReportFlat(bool report_flat) { report_Flat = report_flat; }
 
     inline Bs32u u(Bs32u n)  { return GetBits(n); };
     inline Bs32u u1()        { return GetBit(); };
@@ -35,6 +35,7 @@ enum INIT_MODE
     PARALLEL_SD         = 0x04,
     PARALLEL_TILES      = 0x08,
     PARSE_SSD_TC        = 0x10 | PARSE_SSD,
+    PARSE_SSD_FLAT      = 0x20 | PARSE_SSD,
 
     ASYNC               = (PARALLEL_AU | PARALLEL_SD | PARALLEL_TILES)
 };
@@ -875,6 +876,25 @@ struct CTU
     CTU* Next;
 };
 
+// Slice segment data in contiguous arrays (PARSE_SSD_FLAT), Slice::ctu holds the CTUs.
+// Elements are stored in decoding order and linked by indices:
+// CUs of ctu[i] are Cu[CtuCu[i]] .. Cu[CtuCu[i + 1] - 1],
+// PUs and TUs of Cu[j] are Pu[CuPu[j]] .. Pu[CuPu[j + 1] - 1] and Tu[CuTu[j]] .. Tu[CuTu[j + 1] - 1].
+struct SliceData
+{
+    Bs32u NumCU;
+    Bs32u NumPU;
+    Bs32u NumTU;
+
+    CU*   Cu;
+    PU*   Pu;
+    TU*   Tu;
+
+    Bs32u* CtuCu; //[NumCTU + 1]
+    Bs32u* CuPu;  //[NumCU + 1]
+    Bs32u* CuTu;  //[NumCU + 1]
+};
+
 struct Slice
 {
     Bs32u first_slice_segment_in_pic_flag           : 1;
@@ -953,6 +973,8 @@ struct Slice
     PPS    *pps;
     SPS    *sps;
     CTU    *ctu;
+
+    SliceData *data; //PARSE_SSD_FLAT only
 };
 
 struct NALU
@@ -64,7 +64,7 @@ class FEI_Encode : public IEncoder
 public:
     FEI_Encode(MFXVideoSession* session, MfxVideoParamsWrapper& par,
         const mfxExtFeiHevcEncFrameCtrl& frame_ctrl, const PerFrameTypeCtrl& frametype_ctrl,
-        const msdk_char* outFile, const sBrcParams& brc_params = sBrcParams());
+        const msdk_char* outFile, const sBrcParams& brc_params = sBrcParams(), mfxU32 mvpLayout = 0);
 
     ~FEI_Encode();
 
@@ -116,6 +116,7 @@ private:
 
     mfxExtFeiHevcEncFrameCtrl m_defFrameCtrl; // contain default and user-specified options per frame
     PerFrameTypeCtrl          m_ctrlPerFrameType; // contain default and user-specified options per frame type
+    mfxU32                    m_mvpLayout = 0;    // index of the MV predictors in HevcTaskDSO::m_mvp
 
     mfxStatus DoWork(std::shared_ptr<HevcTaskDSO> & task);
     mfxStatus EncodeFrame(mfxFrameSurface1* pSurf);
@@ -135,11 +136,12 @@ private:
 class MVPOverlay : public IEncoder
 {
 public:
-    MVPOverlay(IEncoder * pBase, MFXFrameAllocator * allocator, std::shared_ptr<FeiBufferAllocator> & bufferAllocator, std::string & file)
+    MVPOverlay(IEncoder * pBase, MFXFrameAllocator * allocator, std::shared_ptr<FeiBufferAllocator> & bufferAllocator, std::string & file, mfxU32 mvpLayout = 0)
         : m_pBase(pBase)
         , m_allocator(allocator)
         , m_buffAlloc(bufferAllocator)
-        , m_yuvName(file) {}
+        , m_yuvName(file)
+        , m_mvpLayout(mvpLayout) {}
 
     virtual ~MVPOverlay() {};
     virtual mfxStatus Init();
@@ -205,6 +207,8 @@ private:
     mfxU32                     m_width = 0;
     mfxU32                     m_height = 0;
 
+    mfxU32                     m_mvpLayout = 0;
+
 private:
     DISALLOW_COPY_AND_ASSIGN(MVPOverlay);
 };
@@ -23,13 +23,21 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include "task.h"
 #include "fei_utils.h"
 #include "bs_parser++.h"
+#include "fei_worker.h"
+
+// MV predictors layout requested by the encoders and the pool of its buffers
+struct MVPLayout
+{
+    mfxU16                   BlockSize = 7; // DSOMVPBlockSize
+    std::shared_ptr<MVPPool> Pool;
+};
 
 class HevcSwDso : public IYUVSource
 {
 public:
     HevcSwDso(const SourceFrameInfo& inPars,
               SurfacesPool* sp,
-              std::shared_ptr<MVPPool> & mvpPool,
+              const std::vector<MVPLayout> & mvpLayouts,
               std::shared_ptr<CTUCtrlPool> & ctuCtrlPool,
               bool calc_BRC_stat = false,
               bool dump_mvp      = false,
@@ -37,18 +45,28 @@ public:
               DIST_EST_ALGO alg  = NNZ)
         : IYUVSource(inPars, sp)
         , m_inPars(inPars)
-        , m_parser(est_dist ? BS_HEVC2::PARSE_SSD_TC : BS_HEVC2::PARSE_SSD)
-        , m_mvpPool(mvpPool)
+        , m_parser((est_dist ? BS_HEVC2::PARSE_SSD_TC : BS_HEVC2::PARSE_SSD) | BS_HEVC2::PARSE_SSD_FLAT)
+        , m_mvpLayouts(mvpLayouts)
         , m_ctuCtrlPool(ctuCtrlPool)
         , m_bCalcBRCStat(calc_BRC_stat)
         , m_bDumpFinalMVPs(dump_mvp)
         , m_bEstimateDistortion(est_dist)
         , m_AlgorithmType(alg)
     {
+        // the first layout is built on the calling thread, others on own workers
+        for (size_t i = 1; i < m_mvpLayouts.size(); ++i)
+        {
+            m_workers.emplace_back(new Worker);
+            m_workers.back()->Start();
+        }
     }
 
     virtual ~HevcSwDso()
     {
+        for (auto & worker : m_workers)
+        {
+            worker->Stop();
+        }
     }
 
     virtual mfxStatus SetBufferAllocator(std::shared_ptr<FeiBufferAllocator> & bufferAlloc) override
@@ -69,7 +87,8 @@ public:
 
 protected:
     void FillFrameTask(const BS_HEVC2::NALU* header, HevcTaskDSO & task);
-    void FillMVP(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncMVPredictors & mvp, mfxU32 nMvPredictors[2]);
+    void FillMVPLayout(const BS_HEVC2::NALU* header, mfxU32 layout, MVPredictors & mvp);
+    void FillMVP(const BS_HEVC2::NALU* header, mfxU16 blockSize, mfxExtFeiHevcEncMVPredictors & mvp, mfxU32 nMvPredictors[2]);
     void FillCtuControls(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncCtuCtrl & ctuCtrls);
 
     void FillBRCParams(const BS_HEVC2::NALU* header, HevcTaskDSO & task);
@@ -79,9 +98,11 @@ protected:
     BS_HEVC2_parser                     m_parser;
 
     std::shared_ptr<FeiBufferAllocator> m_buffAlloc;
-    std::shared_ptr<MVPPool>            m_mvpPool;
+    std::vector<MVPLayout>              m_mvpLayouts;
     std::shared_ptr<CTUCtrlPool>        m_ctuCtrlPool;
 
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
 private:
     bool m_bCalcBRCStat        = false;
     bool m_bDumpFinalMVPs      = false;
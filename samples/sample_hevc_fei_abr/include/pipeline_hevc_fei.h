@@ -27,6 +27,7 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include "vaapi_device.h"
 #include "fei_utils.h"
 #include "hevc_fei_encode.h"
+#include "hevc_sw_dso.h"
 
 class EncoderContext
 {
@@ -38,7 +39,8 @@ public:
                       mfxHDL hdl,
                       std::shared_ptr<FeiBufferAllocator> & bufferAllocator,
                       const sInputParams & params,
-                      const mfxFrameInfo & inFrameInfo);
+                      const mfxFrameInfo & inFrameInfo,
+                      mfxU32 mvpLayout);
 
     mfxStatus Query()
     {
@@ -76,7 +78,7 @@ public:
     // Function generates common mfxVideoParam ENCODE
     // from user cmd line parameters and frame info from upstream component in pipeline.
     MfxVideoParamsWrapper GetEncodeParams(const sInputParams& userParam, const mfxFrameInfo& info);
-    mfxStatus CreateEncoder(const sInputParams & params, const mfxFrameInfo & info);
+    mfxStatus CreateEncoder(const sInputParams & params, const mfxFrameInfo & info, mfxU32 mvpLayout);
 
 private:
     mfxHDL                     m_hdl = nullptr;
@@ -117,7 +119,7 @@ private:
     SurfacesPool                             m_EncSurfPool;
 
     std::shared_ptr<FeiBufferAllocator>      m_bufferAllocator;
-    std::shared_ptr<MVPPool>                 m_mvpPool;
+    std::vector<MVPLayout>                   m_mvpLayouts; // distinct MVP layouts of the encoders
     std::shared_ptr<CTUCtrlPool>             m_ctuCtrlPool;
 
     MFXVideoSession                          m_mfxSession;
@@ -148,6 +150,8 @@ private:
     mfxStatus CreateAllocator();
     mfxStatus AllocFrames();
 
+    mfxU32    GetMVPLayout(mfxU16 blockSize) const;
+
     mfxStatus CreateBufferAllocator(mfxU32 w, mfxU32 h);
     mfxStatus AllocBuffers();
 
@@ -87,6 +87,13 @@ struct FrameStatData
     }
 };
 
+// MV predictors built by DSO in the layout requested by a group of encoders
+struct MVPredictors
+{
+    MVPPool::Type m_mvp;
+    mfxU32        m_nMvPredictors[2] = {0, 0};
+};
+
 struct HevcTaskDSO
 {
     HevcTaskDSO()                              = default;
@@ -102,8 +109,8 @@ struct HevcTaskDSO
     std::vector<mfxI32> m_dpb;
     std::vector<mfxI32> m_refListActive[2];
 
-    MVPPool::Type       m_mvp;
-    mfxU32              m_nMvPredictors[2] = {0, 0};
+    // indexed by MVP layout, encoders requesting the same layout share the buffer
+    std::vector<MVPredictors> m_mvp;
 
     CTUCtrlPool::Type   m_ctuCtrl;
     bool                m_isGPBFrame = false;
@@ -27,7 +27,7 @@ using namespace BsThread;
 //Scheduler Parser::m_thread;
 
 Parser::Parser(Bs32u mode)
-    : SDParser((mode & PARSE_SSD_TC) == PARSE_SSD_TC)
+    : SDParser((mode & PARSE_SSD_TC) == PARSE_SSD_TC, (mode & PARSE_SSD_FLAT) == PARSE_SSD_FLAT)
     , m_mode(mode)
     , m_au(0)
     , m_bNewSequence(true)
@@ -75,6 +75,7 @@ Parser::Parser(Bs32u mode)
             sdt.p.m_pAllocator = &(BS_MEM::Allocator&)*this;
             sdt.p.SetEmulation(false);
             sdt.p.SetTraceLevel(TRACE_DEFAULT);
+            sdt.p.ReportFlat((m_mode & PARSE_SSD_FLAT) == PARSE_SSD_FLAT);
 
             id++;
         }
@@ -735,7 +736,8 @@ Bs32u Parser::ParseSSDSubmit(SDThread*& pSDT, NALU* AU)
 
     if (   pSlice->num_entry_point_offsets
         && colWidth.size() * rowHeight.size() > 1
-        && (m_mode & PARALLEL_TILES))
+        && (m_mode & PARALLEL_TILES)
+        && (m_mode & PARSE_SSD_FLAT) != PARSE_SSD_FLAT) //split slice would not be contiguous
     {
         Bs16u AddrInTs = CtbAddrRsToTs[pSlice->slice_segment_address];
         Bs16u Tid = TileId[AddrInTs];
@@ -29,10 +29,11 @@ using namespace BsReader2;
  if (TraceOffset()) fprintf(GetLog(), "0x%016llX[%i]|%3u|%3u: ",\
      GetByteOffset(), GetBitOffset(), GetR(), GetV());
 
-SDParser::SDParser(bool report_TC)
+SDParser::SDParser(bool report_TC, bool report_flat)
     : Reader()
     , CABAC((Reader&)*this)
     , report_TCLevels(report_TC)
+    , report_Flat(report_flat)
     , m_pAllocator(nullptr)
 {
     SetTraceLevel(TRACE_DEFAULT);
@@ -243,22 +244,51 @@ CTU* SDParser::parseSSD(NALU& nalu, NALU* pColPic, Bs32u NumCtb)
             if (pTC_levels) std::copy(std::begin(m_TC_lvl), std::end(m_TC_lvl), pTC_levels);
         }
 
+        //elements are allocated in decoding order, so the arrays above are the flat layout
+        //and index ranges are collected while the links are relocated
+        SliceData* pSD = nullptr;
+        if (report_Flat && nCTU)
+        {
+            pSD = m_pAllocator->alloc<SliceData>(pCTU);
+            pSD->NumCU = (Bs32u)nCU;
+            pSD->NumPU = (Bs32u)nPU;
+            pSD->NumTU = (Bs32u)nTU;
+            pSD->Cu    = pCU;
+            pSD->Pu    = pPU;
+            pSD->Tu    = pTU;
+            pSD->CtuCu = m_pAllocator->alloc<Bs32u>(pCTU, (Bs32u)nCTU + 1);
+            pSD->CuPu  = m_pAllocator->alloc<Bs32u>(pCTU, (Bs32u)nCU + 1);
+            pSD->CuTu  = m_pAllocator->alloc<Bs32u>(pCTU, (Bs32u)nCU + 1);
+        }
+        Bs32u iCTU = 0, iCU = 0, iPU = 0, iTU = 0;
+
         auto pcCTU = pCTU;
 
         for (;;)
         {
+            if (pSD)
+                pSD->CtuCu[iCTU++] = iCU;
+
             if (pcCTU->Cu)
             {
                 auto pcCU = pcCTU->Cu = pCU + (pcCTU->Cu - pCU0);
 
                 for (;;)
                 {
+                    if (pSD)
+                    {
+                        pSD->CuPu[iCU] = iPU;
+                        pSD->CuTu[iCU] = iTU;
+                        iCU++;
+                    }
+
                     if (pcCU->Pu)
                     {
                         auto pcPU = pcCU->Pu = pPU + (pcCU->Pu - pPU0);
 
                         for (;;)
                         {
+                            iPU++;
                             if (!pcPU->Next)
                                 break;
                             pcPU = pcPU->Next = pPU + (pcPU->Next - pPU0);
@@ -271,6 +301,7 @@ CTU* SDParser::parseSSD(NALU& nalu, NALU* pColPic, Bs32u NumCtb)
 
                         for (;;)
                         {
+                            iTU++;
                             if (report_TCLevels && pcTU->tc_levels_luma)
                             {
                                 pcTU->tc_levels_luma = pTC_levels + std::distance(m_TC_lvl.data(), pcTU->tc_levels_luma);
@@ -293,6 +324,14 @@ CTU* SDParser::parseSSD(NALU& nalu, NALU* pColPic, Bs32u NumCtb)
             pcCTU = pcCTU->Next = pCTU + (pcCTU->Next - pCTU0);
         }
 
+        if (pSD)
+        {
+            pSD->CtuCu[nCTU] = (Bs32u)nCU;
+            pSD->CuPu[nCU]   = (Bs32u)nPU;
+            pSD->CuTu[nCU]   = (Bs32u)nTU;
+        }
+        slice.data = pSD;
+
         BS2_SET((Bs32u)nCTU, slice.NumCTU);
 
         //printf("NumCTU = %d\n", slice.NumCTU);
@@ -22,7 +22,7 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 
 FEI_Encode::FEI_Encode(MFXVideoSession* session, MfxVideoParamsWrapper& par,
         const mfxExtFeiHevcEncFrameCtrl& frame_ctrl, const PerFrameTypeCtrl& frametype_ctrl,
-        const msdk_char* outFile, const sBrcParams& brc_params)
+        const msdk_char* outFile, const sBrcParams& brc_params, mfxU32 mvpLayout)
     : m_pmfxSession(session)
     , m_mfxENCODE(*m_pmfxSession)
     , m_videoParams(par)
@@ -30,6 +30,7 @@ FEI_Encode::FEI_Encode(MFXVideoSession* session, MfxVideoParamsWrapper& par,
     , m_dstFileName(outFile)
     , m_defFrameCtrl(frame_ctrl)
     , m_ctrlPerFrameType(frametype_ctrl)
+    , m_mvpLayout(mvpLayout)
     , m_pBRC(CreateBRC(brc_params, m_videoParams))
 {
     m_encodeCtrl.FrameType = MFX_FRAMETYPE_UNKNOWN;
@@ -223,16 +224,20 @@ mfxStatus FEI_Encode::SetCtrlParams(const HevcTaskDSO& task)
     // 7 - inherit size of block from buffers CTU setting (default for external file with predictors)
     ctrl->MVPredictor = (m_encodeCtrl.FrameType & MFX_FRAMETYPE_I) ? 0 : m_defFrameCtrl.MVPredictor;
 
+    MSDK_CHECK_ERROR(m_mvpLayout < task.m_mvp.size(), false, MFX_ERR_NOT_INITIALIZED);
+    const MVPredictors & mvp = task.m_mvp[m_mvpLayout];
+
     if (ctrl->MVPredictor)
     {
         mfxExtFeiHevcEncMVPredictors* pMVP = m_encodeCtrl.GetExtBuffer<mfxExtFeiHevcEncMVPredictors>();
         MSDK_CHECK_POINTER(pMVP, MFX_ERR_NOT_INITIALIZED);
+        MSDK_CHECK_POINTER(mvp.m_mvp.get(), MFX_ERR_NOT_INITIALIZED);
 
-        *pMVP = *task.m_mvp; // shallow copy
+        *pMVP = *mvp.m_mvp; // shallow copy, the buffer is shared by encoders of the same layout
     }
 
-    ctrl->NumMvPredictors[0] = task.m_nMvPredictors[0];
-    ctrl->NumMvPredictors[1] = task.m_nMvPredictors[1];
+    ctrl->NumMvPredictors[0] = mvp.m_nMvPredictors[0];
+    ctrl->NumMvPredictors[1] = mvp.m_nMvPredictors[1];
 
     switch (m_encodeCtrl.FrameType  & (MFX_FRAMETYPE_I | MFX_FRAMETYPE_P | MFX_FRAMETYPE_B))
     {
@@ -346,9 +351,9 @@ mfxStatus MVPOverlay::SubmitFrame(std::shared_ptr<HevcTaskDSO> & task)
         sts = m_allocator->Unlock(m_allocator->pthis, s.Data.MemId, &s.Data);
         MSDK_CHECK_STATUS(sts, "m_allocator->Unlock failed");
 
-        if (task->m_mvp.get())
+        if (m_mvpLayout < task->m_mvp.size() && task->m_mvp[m_mvpLayout].m_mvp.get())
         {
-            mfxExtFeiHevcEncMVPredictors & mvp = *task->m_mvp.get();
+            mfxExtFeiHevcEncMVPredictors & mvp = *task->m_mvp[m_mvpLayout].m_mvp.get();
             AutoBufferLocker<mfxExtFeiHevcEncMVPredictors> lock(*m_buffAlloc.get(), mvp);
 
             for (mfxU32 tileIdx = 0; tileIdx < mvp.Pitch * mvp.Height; ++tileIdx)
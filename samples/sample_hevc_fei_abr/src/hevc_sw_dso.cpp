@@ -23,6 +23,7 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include <string>
 #include <fstream>
 #include <numeric>
+#include <future>
 
 using namespace BS_HEVC2;
 
@@ -59,9 +60,10 @@ mfxStatus HevcSwDso::Init()
     return MFX_ERR_NONE;
 }
 
-void DumpMVPs(mfxExtFeiHevcEncMVPredictors & mvp, mfxU32 encorder)
+void DumpMVPs(mfxExtFeiHevcEncMVPredictors & mvp, mfxU32 encorder, mfxU32 layout)
 {
-    std::string fname = "MVPdump_encorder_frame_" + std::to_string(encorder + 1) + ".bin";
+    std::string fname = "MVPdump_" + (layout ? "layout_" + std::to_string(layout) + "_" : std::string())
+                      + "encorder_frame_" + std::to_string(encorder + 1) + ".bin";
     std::fstream out_file(fname, std::ios::out | std::ios::binary);
     out_file.write((char*) mvp.Data, sizeof(mfxFeiHevcEncMVPredictors) * mvp.Pitch * mvp.Height);
     out_file.close();
@@ -82,36 +84,64 @@ mfxStatus HevcSwDso::GetFrame(HevcTaskDSO & task)
 
     FillFrameTask(hdr, task);
 
+    task.m_mvp.resize(m_mvpLayouts.size());
+
     if (!(task.m_frameType & MFX_FRAMETYPE_IDR || task.m_frameType & MFX_FRAMETYPE_I))
     {
-        auto mvp = m_mvpPool->GetBuffer();
+        // The picture is parsed once, the predictors of the layouts are
+        // repacked from it concurrently
+        std::vector<std::future<void>> jobs;
+        for (mfxU32 i = 1; i < m_mvpLayouts.size(); ++i)
         {
-            AutoBufferLocker<mfxExtFeiHevcEncMVPredictors> lock(*m_buffAlloc.get(), *mvp);
+            auto job = std::make_shared<std::packaged_task<void()>>(
+                [this, hdr, i, &task] { FillMVPLayout(hdr, i, task.m_mvp[i]); });
 
-            FillMVP(hdr, *mvp, task.m_nMvPredictors);
+            jobs.push_back(job->get_future());
+            m_workers[i - 1]->Push([job] { (*job)(); });
+        }
 
-            if (m_bDumpFinalMVPs)
+        std::exception_ptr error;
+        try
+        {
+            if (!m_mvpLayouts.empty())
             {
-                DumpMVPs(*mvp, m_ProcessedFrames);
+                FillMVPLayout(hdr, 0, task.m_mvp[0]);
             }
-        }
 
-        task.m_mvp = std::move(mvp);
+            if (m_ctuCtrlPool.get()) // "ForceTo" is optional
+            {
+                auto ctuCtrl = m_ctuCtrlPool->GetBuffer();
+                {
+                    AutoBufferLocker<mfxExtFeiHevcEncCtuCtrl> lock(*m_buffAlloc.get(), *ctuCtrl);
 
-        if (m_ctuCtrlPool.get()) // "ForceTo" is optional
+                    FillCtuControls(hdr, *ctuCtrl);
+                }
+                task.m_ctuCtrl = std::move(ctuCtrl);
+            }
+        }
+        catch (...)
         {
-            auto ctuCtrl = m_ctuCtrlPool->GetBuffer();
-            {
-                AutoBufferLocker<mfxExtFeiHevcEncCtuCtrl> lock(*m_buffAlloc.get(), *ctuCtrl);
+            error = std::current_exception();
+        }
 
-                FillCtuControls(hdr, *ctuCtrl);
+        // workers read the parsed picture, it must stay alive until they finish
+        for (auto & job : jobs)
+        {
+            try
+            {
+                job.get();
+            }
+            catch (...)
+            {
+                if (!error)
+                    error = std::current_exception();
             }
-            task.m_ctuCtrl = std::move(ctuCtrl);
         }
-    }
-    else
-    {
-        task.m_nMvPredictors[0] = task.m_nMvPredictors[1] = 0;
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
     }
 
     m_ProcessedFrames++;
@@ -119,6 +149,23 @@ mfxStatus HevcSwDso::GetFrame(HevcTaskDSO & task)
     return MFX_ERR_NONE;
 }
 
+void HevcSwDso::FillMVPLayout(const BS_HEVC2::NALU* header, mfxU32 layout, MVPredictors & mvp)
+{
+    auto buffer = m_mvpLayouts[layout].Pool->GetBuffer();
+    {
+        AutoBufferLocker<mfxExtFeiHevcEncMVPredictors> lock(*m_buffAlloc.get(), *buffer);
+
+        FillMVP(header, m_mvpLayouts[layout].BlockSize, *buffer, mvp.m_nMvPredictors);
+
+        if (m_bDumpFinalMVPs)
+        {
+            DumpMVPs(*buffer, m_ProcessedFrames, layout);
+        }
+    }
+
+    mvp.m_mvp = std::move(buffer);
+}
+
 inline bool IsHEVCSlice(mfxU32 nut)
 {
     return (nut <= 21) && ((nut < 10) || (nut > 15));
@@ -191,9 +238,9 @@ void HevcSwDso::FillFrameTask(const BS_HEVC2::NALU* header, HevcTaskDSO & task)
     }
 }
 
-void CountRefPixels(const BS_HEVC2::CU & cu, HevcTaskDSO & task, mfxI32 base)
+void CountRefPixels(const BS_HEVC2::SliceData & sd, mfxU32 cuIdx, HevcTaskDSO & task, mfxI32 base)
 {
-    for (auto pu = cu.Pu; pu; pu = pu->Next)
+    for (auto pu = sd.Pu + sd.CuPu[cuIdx]; pu != sd.Pu + sd.CuPu[cuIdx + 1]; ++pu)
     {
         switch (pu->inter_pred_idc)
         {
@@ -237,42 +284,46 @@ void HevcSwDso::FillBRCParams(const BS_HEVC2::NALU* header, HevcTaskDSO & task)
          if (!pNALU->slice)
              throw mfxError(MFX_ERR_NULL_PTR, "ERROR : HevcSwDso::FillBRCParams : pNALU->slice pointer is null");
 
-         for (auto ctu = pNALU->slice->ctu; ctu; ctu = ctu->Next)
+         if (!pNALU->slice->data)
+             throw mfxError(MFX_ERR_NULL_PTR, "ERROR : HevcSwDso::FillBRCParams : slice->data pointer is null");
+
+         const SliceData & sd = *pNALU->slice->data;
+
+         for (mfxU32 i = 0; i < sd.NumCU; ++i)
          {
-             for (auto cu = ctu->Cu; cu; cu = cu->Next)
+             const CU & cu = sd.Cu[i];
+
+             if (m_bEstimateDistortion)
              {
-                 if (m_bEstimateDistortion)
+                 for (auto tu = sd.Tu + sd.CuTu[i]; tu != sd.Tu + sd.CuTu[i + 1]; ++tu)
                  {
-                     for (auto tu = cu->Tu; tu; tu = tu->Next)
+                     if (!tu->tc_levels_luma)
+                         continue;
+
+                     switch (m_AlgorithmType)
                      {
-                         if (!tu->tc_levels_luma)
-                             continue;
-
-                         switch (m_AlgorithmType)
-                         {
-                         case NNZ:
-                             // Count Number of Non-Zero luma transform coefficients
-                             task.m_statData.VisualDistortion += std::count_if(tu->tc_levels_luma, tu->tc_levels_luma + (1 << (tu->log2TrafoSize << 1)),
-                                                                                    [](mfxI32 coeff) { return coeff != 0; });
-                             break;
-                         case SSC:
-                             // Count Sum of Squared luma transform Coefficients
-                             task.m_statData.VisualDistortion += std::accumulate(tu->tc_levels_luma, tu->tc_levels_luma + (1 << (tu->log2TrafoSize << 1)), mfxU64(0),
-                                                                                    [](mfxU64 sum_sq, mfxI32 coeff) { return sum_sq + coeff*coeff; });
-                             break;
-                         default:
-                             break;
-                         }
+                     case NNZ:
+                         // Count Number of Non-Zero luma transform coefficients
+                         task.m_statData.VisualDistortion += std::count_if(tu->tc_levels_luma, tu->tc_levels_luma + (1 << (tu->log2TrafoSize << 1)),
+                                                                                [](mfxI32 coeff) { return coeff != 0; });
+                         break;
+                     case SSC:
+                         // Count Sum of Squared luma transform Coefficients
+                         task.m_statData.VisualDistortion += std::accumulate(tu->tc_levels_luma, tu->tc_levels_luma + (1 << (tu->log2TrafoSize << 1)), mfxU64(0),
+                                                                                [](mfxU64 sum_sq, mfxI32 coeff) { return sum_sq + coeff*coeff; });
+                         break;
+                     default:
+                         break;
                      }
                  }
+             }
 
-                 CountRefPixels(*cu, task, m_DisplayOrderSinceLastIDR);
+             CountRefPixels(sd, i, task, m_DisplayOrderSinceLastIDR);
 
-                 if (cu->PredMode == MODE_INTRA)
-                 {
-                     // Number of pixels in CU is (2^log2CbSize)^2 = 2^(2*log2CbSize)
-                     numPixelsIntra += 1 << (cu->log2CbSize << 1);
-                 }
+             if (cu.PredMode == MODE_INTRA)
+             {
+                 // Number of pixels in CU is (2^log2CbSize)^2 = 2^(2*log2CbSize)
+                 numPixelsIntra += 1 << (cu.log2CbSize << 1);
              }
          }
     }
@@ -320,7 +371,7 @@ public:
     }
 };
 
-void HevcSwDso::FillMVP(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncMVPredictors & mvps, mfxU32 nMvPredictors[2])
+void HevcSwDso::FillMVP(const BS_HEVC2::NALU* header, mfxU16 blockSize, mfxExtFeiHevcEncMVPredictors & mvps, mfxU32 nMvPredictors[2])
 {
     std::for_each(mvps.Data, mvps.Data + mvps.Pitch * mvps.Height,
             [](mfxFeiHevcEncMVPredictors& mvp)
@@ -333,7 +384,7 @@ void HevcSwDso::FillMVP(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncMVPredicto
             }
          );
 
-    if (m_inPars.DSOMVPBlockSize == 0)
+    if (blockSize == 0)
     {
         return; // No DSO MVPs requested
     }
@@ -349,18 +400,26 @@ void HevcSwDso::FillMVP(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncMVPredicto
 
         auto& slice = *pNALU->slice;
 
-        mfxU32 ctuAddr = 0;
+        if (!slice.data)
+            throw mfxError(MFX_ERR_NULL_PTR, "ERROR : HevcSwDso::FillMVP : slice.data pointer is null");
+
+        const SliceData& sd = *slice.data;
+
         mfxU32 lastProcessed16x16BlockIdx = 0;
         std::vector<PU*> pusFrom8x8CUs;        // For DSOBlockSize 1 (16x16), need to keep the PUs
                                                // from 8x8 CUs here to populate the target 16x16 block
                                                // with MVPs from PUs in descending order of size
 
-        for (auto ctu = slice.ctu; ctu; ctu = ctu->Next, ctuAddr++)
+        for (mfxU32 ctuIdx = 0; ctuIdx < slice.NumCTU; ++ctuIdx)
         {
             std::map<mfxU32, mfxU8> usedBlockEntries; // serves to check how many MVP entries inside 16x16 are used. Used for handling CU 8x8
 
-            for (auto cu = ctu->Cu; cu; cu = cu->Next)
+            for (mfxU32 cuIdx = sd.CtuCu[ctuIdx]; cuIdx < sd.CtuCu[ctuIdx + 1]; ++cuIdx)
             {
+                const CU* cu = &sd.Cu[cuIdx];
+                PU* const firstPu = sd.Pu + sd.CuPu[cuIdx];
+                PU* const lastPu  = sd.Pu + sd.CuPu[cuIdx + 1];
+
                 if (cu->PredMode == MODE_INTRA)
                     continue;
 
@@ -381,7 +440,7 @@ void HevcSwDso::FillMVP(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncMVPredicto
                 mfxFeiHevcEncMVPredictors & baseBlock = mvps.Data[baseBlockIdx];
                 mfxFeiHevcEncMVPredictors & mvpBlock  = mvps.Data[mvpBlockIdx];
 
-                if (m_inPars.DSOMVPBlockSize == 1) // Repacked MVPs will be per 16x16 block
+                if (blockSize == 1) // Repacked MVPs will be per 16x16 block
                 {
                     if (lastProcessed16x16BlockIdx != mvpBlockIdx)
                     {   // Finished processing the last 16x16 block; if previous 16x16 block
@@ -408,7 +467,7 @@ void HevcSwDso::FillMVP(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncMVPredicto
 
                     std::vector<PU*> puVec;
                     puVec.reserve(4); // 4 PUs in a CU max
-                    for (auto pu = cu->Pu; pu; pu = pu->Next)
+                    for (auto pu = firstPu; pu != lastPu; ++pu)
                     {
                         puVec.emplace_back(pu);
                     }
@@ -449,19 +508,19 @@ void HevcSwDso::FillMVP(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncMVPredicto
                         pusFrom8x8CUs.insert(pusFrom8x8CUs.end(), puVec.begin(), puVec.end());
                     }
                 }
-                else if (m_inPars.DSOMVPBlockSize == 2)
+                else if (blockSize == 2)
                 {
                     // TODO: implement this
                     throw std::string("ERROR: DSOMVPBlockSize 2 not implemented yet");
                 }
-                else if (m_inPars.DSOMVPBlockSize == 7) // Repack MVPs as closely to the DSO MVs as possible
+                else if (blockSize == 7) // Repack MVPs as closely to the DSO MVs as possible
                 {
                     if (5 == cu->log2CbSize) // 32x32 - MVs from each PU (up to 4 in total) will be written
                     {                        // into the "base" 16x16 MVP structure
                         mvpBlock.BlockSize = 2;
 
                         mfxU32 i = 0;
-                        for (auto pu = cu->Pu; pu; pu = pu->Next, ++i)
+                        for (auto pu = firstPu; pu != lastPu; ++pu, ++i)
                         {
                             PU2MVP(*pu, mvpBlock, i);
                         }
@@ -472,7 +531,7 @@ void HevcSwDso::FillMVP(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncMVPredicto
                         mvpBlock.BlockSize  = 1;
 
                         mfxU32 i = 0;
-                        for (auto pu = cu->Pu; pu; pu = pu->Next, ++i)
+                        for (auto pu = firstPu; pu != lastPu; ++pu, ++i)
                         {
                             PU2MVP(*pu, mvpBlock, i);
                         }
@@ -482,9 +541,9 @@ void HevcSwDso::FillMVP(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncMVPredicto
                         baseBlock.BlockSize = 1;
                         mvpBlock.BlockSize  = 1;
 
-                        auto pu = cu->Pu;
+                        auto pu = firstPu;
                         // Take only the first PU in 8x8 CU, ignore the other if any
-                        if (pu)
+                        if (pu != lastPu)
                         {
                             auto & entryIdx = usedBlockEntries[mvpBlockIdx];
 
@@ -521,11 +580,16 @@ void HevcSwDso::FillCtuControls(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncCt
 
         auto& slice = *pNALU->slice;
 
-        for (auto ctu = slice.ctu; ctu; ctu = ctu->Next)
+        if (!slice.data)
+            throw mfxError(MFX_ERR_NULL_PTR, "ERROR : HevcSwDso::FillCtuControls : slice.data pointer is null");
+
+        const SliceData& sd = *slice.data;
+
+        for (mfxU32 ctuIdx = 0; ctuIdx < slice.NumCTU; ++ctuIdx)
         {
             mfxU32 nCU = 0, nInter = 0, nIntra = 0;
 
-            for (auto cu = ctu->Cu; cu; cu = cu->Next)
+            for (auto cu = sd.Cu + sd.CtuCu[ctuIdx]; cu != sd.Cu + sd.CtuCu[ctuIdx + 1]; ++cu)
             {
                 // Count number of CUs of intra or inter/skip types
                 switch (cu->PredMode)
@@ -541,7 +605,7 @@ void HevcSwDso::FillCtuControls(const BS_HEVC2::NALU* header, mfxExtFeiHevcEncCt
                 ++nCU;
             }
 
-            mfxFeiHevcEncCtuCtrl & ctrl = ctuCtrls.Data[ctu->CtbAddrInRs];
+            mfxFeiHevcEncCtuCtrl & ctrl = ctuCtrls.Data[slice.ctu[ctuIdx].CtbAddrInRs];
 
             // Force to INTRA/INTER if all CUs have the same type
             ctrl.ForceToIntra = false;
@@ -27,7 +27,6 @@ CFeiTranscodingPipeline::CFeiTranscodingPipeline(const std::vector<sInputParams>
     : m_inParamsArray(std::move(inputParamsArray))
     , m_impl(MFX_IMPL_HARDWARE_ANY | MFX_IMPL_VIA_VAAPI)
     , m_EncSurfPool()
-    , m_mvpPool(new MVPPool)
     , m_ctuCtrlPool(nullptr)
     , m_FramesToProcess(0)
     , m_processedFrames(0)
@@ -42,6 +41,25 @@ CFeiTranscodingPipeline::CFeiTranscodingPipeline(const std::vector<sInputParams>
     }
     m_la_queue.reset(new LA_queue(LookAheadDepth, m_inParamsArray[0].sBRCparams.strYUVFile));
 
+    // DSO builds MV predictors once per distinct layout, encoders requesting
+    // the same layout share the buffers
+    for (auto const & param : m_inParamsArray)
+    {
+        if (param.pipeMode == Producer)
+            continue;
+
+        auto it = std::find_if(m_mvpLayouts.begin(), m_mvpLayouts.end(),
+            [&param](const MVPLayout & layout) { return layout.BlockSize == param.input.DSOMVPBlockSize; });
+        if (it == m_mvpLayouts.end())
+        {
+            MVPLayout layout;
+            layout.BlockSize = param.input.DSOMVPBlockSize;
+            layout.Pool.reset(new MVPPool);
+
+            m_mvpLayouts.push_back(layout);
+        }
+    }
+
     for (auto const & param : m_inParamsArray)
     {
         if (param.input.forceToIntra || param.input.forceToInter)
@@ -90,7 +108,7 @@ mfxStatus CFeiTranscodingPipeline::Init()
                     m_source.reset(CreateYUVSource());
                     MSDK_CHECK_POINTER(m_source.get(), MFX_ERR_NOT_INITIALIZED);
 
-                    m_dso.reset(new HevcSwDso(param.input, &m_EncSurfPool, m_mvpPool, m_ctuCtrlPool, param.sBRCparams.eBrcType == LOOKAHEAD, param.dumpMVP, !param.sBRCparams.strYUVFile[0], param.sBRCparams.eAlgType));
+                    m_dso.reset(new HevcSwDso(param.input, &m_EncSurfPool, m_mvpLayouts, m_ctuCtrlPool, param.sBRCparams.eBrcType == LOOKAHEAD, param.dumpMVP, !param.sBRCparams.strYUVFile[0], param.sBRCparams.eAlgType));
 
                     sts = m_source->PreInit();
                     MSDK_CHECK_STATUS(sts, "m_source PreInit failed");
@@ -106,7 +124,7 @@ mfxStatus CFeiTranscodingPipeline::Init()
 
                     std::unique_ptr<EncoderContext> encoder(new EncoderContext);
 
-                    sts = encoder->PreInit(m_pMFXAllocator.get(), hdl, m_bufferAllocator, param, frameInfo);
+                    sts = encoder->PreInit(m_pMFXAllocator.get(), hdl, m_bufferAllocator, param, frameInfo, GetMVPLayout(param.input.DSOMVPBlockSize));
                     MSDK_CHECK_STATUS(sts, "FEI ENCODE Init failed");
 
                     m_encoders.push_back(std::move(encoder));
@@ -119,7 +137,7 @@ mfxStatus CFeiTranscodingPipeline::Init()
                     m_source.reset(CreateYUVSource());
                     MSDK_CHECK_POINTER(m_source.get(), MFX_ERR_NOT_INITIALIZED);
 
-                    m_dso.reset(new HevcSwDso(param.input, &m_EncSurfPool, m_mvpPool, m_ctuCtrlPool, param.sBRCparams.eBrcType == LOOKAHEAD, param.dumpMVP, !param.sBRCparams.strYUVFile[0], param.sBRCparams.eAlgType));
+                    m_dso.reset(new HevcSwDso(param.input, &m_EncSurfPool, m_mvpLayouts, m_ctuCtrlPool, param.sBRCparams.eBrcType == LOOKAHEAD, param.dumpMVP, !param.sBRCparams.strYUVFile[0], param.sBRCparams.eAlgType));
 
                     sts = m_source->PreInit();
                     MSDK_CHECK_STATUS(sts, "m_source PreInit failed");
@@ -142,7 +160,7 @@ mfxStatus CFeiTranscodingPipeline::Init()
 
                     std::unique_ptr<EncoderContext> encoder(new EncoderContext);
 
-                    sts = encoder->PreInit(m_pMFXAllocator.get(), hdl, m_bufferAllocator, param, frameInfo);
+                    sts = encoder->PreInit(m_pMFXAllocator.get(), hdl, m_bufferAllocator, param, frameInfo, GetMVPLayout(param.input.DSOMVPBlockSize));
                     MSDK_CHECK_STATUS(sts, "FEI ENCODE Init failed");
 
                     m_encoders.push_back(std::move(encoder));
@@ -299,6 +317,16 @@ mfxStatus CFeiTranscodingPipeline::CreateAllocator()
     return sts;
 }
 
+mfxU32 CFeiTranscodingPipeline::GetMVPLayout(mfxU16 blockSize) const
+{
+    auto it = std::find_if(m_mvpLayouts.begin(), m_mvpLayouts.end(),
+        [blockSize](const MVPLayout & layout) { return layout.BlockSize == blockSize; });
+    if (it == m_mvpLayouts.end())
+        throw mfxError(MFX_ERR_NOT_FOUND, "MVP layout is not registered");
+
+    return mfxU32(it - m_mvpLayouts.begin());
+}
+
 mfxStatus CFeiTranscodingPipeline::CreateBufferAllocator(mfxU32 w, mfxU32 h)
 {
     mfxStatus sts = MFX_ERR_NONE;
@@ -309,7 +337,10 @@ mfxStatus CFeiTranscodingPipeline::CreateBufferAllocator(mfxU32 w, mfxU32 h)
         MSDK_CHECK_STATUS(sts, "m_pHWdev->GetHandle failed");
 
         m_bufferAllocator.reset(new FeiBufferAllocator(hdl, w, h));
-        m_mvpPool->SetDeleter(m_bufferAllocator);
+        for (auto & layout : m_mvpLayouts)
+        {
+            layout.Pool->SetDeleter(m_bufferAllocator);
+        }
 
         if (m_ctuCtrlPool.get())
         {
@@ -418,11 +449,14 @@ mfxStatus CFeiTranscodingPipeline::AllocBuffers()
 
         for (mfxU32 i = 0; i < lookaheadRequest.NumFrameSuggested; ++i)
         {
-            std::unique_ptr<mfxExtFeiHevcEncMVPredictors> mvp(new mfxExtFeiHevcEncMVPredictors);
-            init_ext_buffer(*mvp);
+            for (auto & layout : m_mvpLayouts)
+            {
+                std::unique_ptr<mfxExtFeiHevcEncMVPredictors> mvp(new mfxExtFeiHevcEncMVPredictors);
+                init_ext_buffer(*mvp);
 
-            m_bufferAllocator->Alloc(mvp.get(), request);
-            m_mvpPool->Add(std::move(mvp));
+                m_bufferAllocator->Alloc(mvp.get(), request);
+                layout.Pool->Add(std::move(mvp));
+            }
 
             if (m_ctuCtrlPool.get())
             {
@@ -571,7 +605,8 @@ mfxStatus EncoderContext::PreInit(MFXFrameAllocator * mfxAllocator,
                                   mfxHDL hdl,
                                   std::shared_ptr<FeiBufferAllocator> & bufferAllocator,
                                   const sInputParams & params,
-                                  const mfxFrameInfo & inFrameInfo)
+                                  const mfxFrameInfo & inFrameInfo,
+                                  mfxU32 mvpLayout)
 {
     mfxInitParam initPar;
     MSDK_ZERO_MEMORY(initPar);
@@ -605,7 +640,7 @@ mfxStatus EncoderContext::PreInit(MFXFrameAllocator * mfxAllocator,
     m_hdl = hdl;
     m_bufferAllocator = bufferAllocator;
 
-    sts = CreateEncoder(params, inFrameInfo);
+    sts = CreateEncoder(params, inFrameInfo, mvpLayout);
     MSDK_CHECK_STATUS(sts, "CreateEncoder failed");
 
     sts = m_encoder->PreInit();
@@ -614,7 +649,7 @@ mfxStatus EncoderContext::PreInit(MFXFrameAllocator * mfxAllocator,
     return sts;
 }
 
-mfxStatus EncoderContext::CreateEncoder(const sInputParams & params, const mfxFrameInfo & info)
+mfxStatus EncoderContext::CreateEncoder(const sInputParams & params, const mfxFrameInfo & info, mfxU32 mvpLayout)
 {
     mfxStatus sts = MFX_ERR_NONE;
 
@@ -627,14 +662,14 @@ mfxStatus EncoderContext::CreateEncoder(const sInputParams & params, const mfxFr
     MfxVideoParamsWrapper pars = GetEncodeParams(params, info);
 
     std::unique_ptr<IEncoder> encoder;
-    encoder.reset(new FEI_Encode(&m_mfxSession, pars, params.encodeCtrl, params.frameCtrl, params.strDstFile, params.sBRCparams));
+    encoder.reset(new FEI_Encode(&m_mfxSession, pars, params.encodeCtrl, params.frameCtrl, params.strDstFile, params.sBRCparams, mvpLayout));
 
     if (params.drawMVP)
     {
         std::string name = params.strDstFile;
         name += "." + std::to_string(info.CropW) + "x" + std::to_string(info.CropH) + ".mvp.nv12";
 
-        IEncoder* overlay = new MVPOverlay(encoder.get(), m_MFXAllocator, m_bufferAllocator, name);
+        IEncoder* overlay = new MVPOverlay(encoder.get(), m_MFXAllocator, m_bufferAllocator, name, mvpLayout);
         encoder.release();
         encoder.reset(overlay);
     }
@@ -60,6 +60,7 @@ or https://software.intel.com/en-us/media-client-solutions-support.
 #include "mfxplugin.h"
 
 #include "base_allocator.h"
+#include "sample_file_io.h"
 #include "sample_vpp_config.h"
 #include "sample_vpp_roi.h"
 
@@ -380,7 +381,7 @@ public :
 private:
     mfxStatus  GetPreAllocFrame(mfxFrameSurfaceWrap **pSurface);
 
-    FILE*       m_fSrc;
+    CSmplFileReader m_fSrc;
     std::list<mfxFrameSurfaceWrap>::iterator m_it;
     std::list<mfxFrameSurfaceWrap>        m_SurfacesList;
     bool                                  m_isPerfMode;
@@ -414,7 +415,7 @@ private:
         mfxFrameData* pData,
         mfxFrameInfo* pInfo);
 
-    FILE*      m_fDst;
+    CSmplFileWriter m_fDst;
     PTSMaker                              *m_pPTSMaker;
     mfxU32                                m_forcedOutputFourcc;
 };
@@ -939,7 +939,6 @@ void WipeParams(sInputParams* pParams)
 
 CRawVideoReader::CRawVideoReader()
 {
-    m_fSrc = 0;
     m_isPerfMode = false;
     m_Repeat = 0;
     m_pPTSMaker = 0;
@@ -952,8 +951,8 @@ mfxStatus CRawVideoReader::Init(const msdk_char *strFileName, PTSMaker *pPTSMake
 
     MSDK_CHECK_POINTER(strFileName, MFX_ERR_NULL_PTR);
 
-    MSDK_FOPEN(m_fSrc,strFileName, MSDK_STRING("rb"));
-    MSDK_CHECK_POINTER(m_fSrc, MFX_ERR_ABORTED);
+    if (MFX_ERR_NONE != m_fSrc.Open(strFileName))
+        return MFX_ERR_ABORTED;
 
     m_pPTSMaker = pPTSMaker;
     m_initFcc = fcc;
@@ -967,11 +966,7 @@ CRawVideoReader::~CRawVideoReader()
 
 void CRawVideoReader::Close()
 {
-    if (m_fSrc != 0)
-    {
-        fclose(m_fSrc);
-        m_fSrc = 0;
-    }
+    m_fSrc.Close();
     m_SurfacesList.clear();
 
 }
@@ -1013,7 +1008,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
@@ -1024,14 +1019,14 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         ptr = (pInfo->FourCC == MFX_FOURCC_I420 ? pData->U : pData->V) + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
         // load V/U
         ptr  = (pInfo->FourCC == MFX_FOURCC_I420 ? pData->V : pData->U) + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1042,7 +1037,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1053,7 +1048,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
@@ -1063,14 +1058,14 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
         // load V
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1081,7 +1076,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
@@ -1091,14 +1086,14 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
         // load V
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1109,7 +1104,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
@@ -1119,14 +1114,14 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
         // load V
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1137,7 +1132,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
@@ -1145,14 +1140,14 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
         // load V
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1163,7 +1158,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for (i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
@@ -1176,7 +1171,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
                 ptr = pData->UV + pInfo->CropX + (pInfo->CropY >> 1) * pitch;
                 for (i = 0; i < h; i++)
                 {
-                    nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+                    nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
                     IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
                 }
                 break;
@@ -1206,7 +1201,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
                 // load first chroma plane: U (input == I420) or V (input == YV12)
                 for (i = 0; i < h; i++)
                 {
-                    nBytesRead = (mfxU32)fread(buf, 1, w, m_fSrc);
+                    nBytesRead = (mfxU32)m_fSrc.Read(buf, 1, w);
                     if (w != nBytesRead)
                     {
                         return MFX_ERR_MORE_DATA;
@@ -1221,7 +1216,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
                 for (i = 0; i < h; i++)
                 {
 
-                    nBytesRead = (mfxU32)fread(buf, 1, w, m_fSrc);
+                    nBytesRead = (mfxU32)m_fSrc.Read(buf, 1, w);
 
                     if (w != nBytesRead)
                     {
@@ -1243,7 +1238,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
@@ -1251,7 +1246,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         ptr = pData->UV + pInfo->CropX + (pInfo->CropY >> 1) * pitch;
         for (i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1262,7 +1257,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w * 2, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w * 2);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w*2, MFX_ERR_MORE_DATA);
         }
 
@@ -1271,7 +1266,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         ptr = pData->UV + pInfo->CropX + (pInfo->CropY >> 1) * pitch;
         for (i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w*2, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w*2);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w*2, MFX_ERR_MORE_DATA);
         }
     }
@@ -1282,7 +1277,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w * 2, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w * 2);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w*2, MFX_ERR_MORE_DATA);
         }
 
@@ -1290,7 +1285,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         ptr = pData->UV + pInfo->CropX + (pInfo->CropY >> 1) * pitch;
         for (i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w*2, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w*2);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w*2, MFX_ERR_MORE_DATA);
         }
     }
@@ -1306,7 +1301,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
 
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 2*w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, 2*w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, 2*w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1322,7 +1317,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
 
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 3*w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, 3*w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, 3*w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1339,7 +1334,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
 
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 4*w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, 4*w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, 4*w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1349,7 +1344,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
 
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 2*w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, 2*w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, 2*w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1359,7 +1354,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
 
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 2*w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, 2*w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, 2*w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1370,7 +1365,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         // read luminance plane
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
@@ -1380,14 +1375,14 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
         // load V
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1398,7 +1393,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
 
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 4*w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, 4*w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, 4*w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1409,7 +1404,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
 
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 4*w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, 4*w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, 4*w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1419,7 +1414,7 @@ mfxStatus CRawVideoReader::LoadNextFrame(mfxFrameData* pData, mfxFrameInfo* pInf
 
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fread(ptr + i * pitch, 1, 4*w, m_fSrc);
+            nBytesRead = (mfxU32)m_fSrc.Read(ptr + i * pitch, 1, 4*w);
             IOSTREAM_MSDK_CHECK_NOT_EQUAL(nBytesRead, 4*w, MFX_ERR_MORE_DATA);
         }
     }
@@ -1532,7 +1527,6 @@ mfxStatus  CRawVideoReader::PreAllocateFrameChunk(mfxVideoParam* pVideoParam,
 
 CRawVideoWriter::CRawVideoWriter()
 {
-    m_fDst = 0;
     m_pPTSMaker = 0;
     m_forcedOutputFourcc = 0;
     return;
@@ -1549,8 +1543,8 @@ mfxStatus CRawVideoWriter::Init(const msdk_char *strFileName, PTSMaker *pPTSMake
 
     //CHECK_POINTER(strFileName, MFX_ERR_NULL_PTR);
 
-    MSDK_FOPEN(m_fDst,strFileName, MSDK_STRING("wb"));
-    MSDK_CHECK_POINTER(m_fDst, MFX_ERR_ABORTED);
+    if (MFX_ERR_NONE != m_fDst.Open(strFileName))
+        return MFX_ERR_ABORTED;
     m_forcedOutputFourcc = forcedOutputFourcc;
 
     return MFX_ERR_NONE;
@@ -1565,11 +1559,7 @@ CRawVideoWriter::~CRawVideoWriter()
 
 void CRawVideoWriter::Close()
 {
-    if (m_fDst != 0){
-
-        fclose(m_fDst);
-        m_fDst = 0;
-    }
+    m_fDst.Close();
 
     return;
 }
@@ -1580,7 +1570,7 @@ mfxStatus CRawVideoWriter::PutNextFrame(
     mfxFrameSurfaceWrap* pSurface)
 {
     mfxStatus sts;
-    if (m_fDst)
+    if (m_fDst.IsOpen())
     {
         if (pSurface->Data.MemId)
         {
@@ -1650,7 +1640,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL(fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL(m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         w     >>= 1;
@@ -1660,14 +1650,14 @@ mfxStatus CRawVideoWriter::WriteFrame(
         ptr  = (pInfo->FourCC == MFX_FOURCC_I420 ? outData.U : outData.V) + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fwrite(ptr + i * pitch, 1, w, m_fDst);
+            nBytesRead = (mfxU32)m_fDst.Write(ptr + i * pitch, 1, w);
             MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
         ptr  = (pInfo->FourCC == MFX_FOURCC_I420 ? outData.V : outData.U) + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if(pInfo->FourCC == MFX_FOURCC_YUV400)
@@ -1676,7 +1666,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         w     >>= 1;
@@ -1686,14 +1676,14 @@ mfxStatus CRawVideoWriter::WriteFrame(
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fwrite(ptr + i * pitch, 1, w, m_fDst);
+            nBytesRead = (mfxU32)m_fDst.Write(ptr + i * pitch, 1, w);
             MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if(pInfo->FourCC == MFX_FOURCC_YUV411)
@@ -1702,7 +1692,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         w     /= 4;
@@ -1711,14 +1701,14 @@ mfxStatus CRawVideoWriter::WriteFrame(
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fwrite(ptr + i * pitch, 1, w, m_fDst);
+            nBytesRead = (mfxU32)m_fDst.Write(ptr + i * pitch, 1, w);
             MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if(pInfo->FourCC == MFX_FOURCC_YUV422H)
@@ -1727,7 +1717,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         w     >>= 1;
@@ -1736,14 +1726,14 @@ mfxStatus CRawVideoWriter::WriteFrame(
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fwrite(ptr + i * pitch, 1, w, m_fDst);
+            nBytesRead = (mfxU32)m_fDst.Write(ptr + i * pitch, 1, w);
             MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if(pInfo->FourCC == MFX_FOURCC_YUV422V)
@@ -1752,7 +1742,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         h     >>= 1;
@@ -1760,14 +1750,14 @@ mfxStatus CRawVideoWriter::WriteFrame(
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fwrite(ptr + i * pitch, 1, w, m_fDst);
+            nBytesRead = (mfxU32)m_fDst.Write(ptr + i * pitch, 1, w);
             MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if(pInfo->FourCC == MFX_FOURCC_YUV444)
@@ -1776,20 +1766,20 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fwrite(ptr + i * pitch, 1, w, m_fDst);
+            nBytesRead = (mfxU32)m_fDst.Write(ptr + i * pitch, 1, w);
             MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if (pInfo->FourCC == MFX_FOURCC_NV12)
@@ -1798,7 +1788,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL(fwrite(ptr + i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL(m_fDst.Write(ptr + i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         switch (m_forcedOutputFourcc)
@@ -1816,14 +1806,14 @@ mfxStatus CRawVideoWriter::WriteFrame(
             {
                 for (j = 0; j < w; j++)
                 {
-                    fputc(ptr[i*pitch + j * 2], m_fDst);
+                    m_fDst.Write(&ptr[i*pitch + j * 2], 1, 1);
                 }
             }
             for (i = 0; i < h; i++)
             {
                 for (j = 0; j < w; j++)
                 {
-                    fputc(ptr[i*pitch + j * 2 + 1], m_fDst);
+                    m_fDst.Write(&ptr[i*pitch + j * 2 + 1], 1, 1);
                 }
             }
         }
@@ -1842,14 +1832,14 @@ mfxStatus CRawVideoWriter::WriteFrame(
             {
                 for (j = 0; j < w; j++)
                 {
-                    fputc(ptr[i*pitch + j * 2 + 1], m_fDst);
+                    m_fDst.Write(&ptr[i*pitch + j * 2 + 1], 1, 1);
                 }
             }
             for (i = 0; i < h; i++)
             {
                 for (j = 0; j < w; j++)
                 {
-                    fputc(ptr[i*pitch + j * 2], m_fDst);
+                    m_fDst.Write(&ptr[i*pitch + j * 2], 1, 1);
                 }
             }
         }
@@ -1863,7 +1853,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
             for (i = 0; i < h; i++)
             {
-                MSDK_CHECK_NOT_EQUAL(fwrite(ptr + i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+                MSDK_CHECK_NOT_EQUAL(m_fDst.Write(ptr + i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
             }
         }
         break;
@@ -1875,7 +1865,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         // write UV data
@@ -1883,7 +1873,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if( pInfo->FourCC == MFX_FOURCC_P010 )
@@ -1892,7 +1882,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w * 2, m_fDst), w * 2u, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w * 2), w * 2u, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         // write UV data
@@ -1901,7 +1891,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w*2, m_fDst), w*2u, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w*2), w*2u, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if( pInfo->FourCC == MFX_FOURCC_P210 )
@@ -1910,7 +1900,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w * 2, m_fDst), w * 2u, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w * 2), w * 2u, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         // write UV data
@@ -1918,7 +1908,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w*2, m_fDst), w*2u, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w*2), w*2u, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if( pInfo->FourCC == MFX_FOURCC_YUY2 )
@@ -1927,7 +1917,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, 2*w, m_fDst), 2u*w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, 2*w), 2u*w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if ( pInfo->FourCC == MFX_FOURCC_IMC3 )
@@ -1936,7 +1926,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for (i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
 
         w     >>= 1;
@@ -1945,14 +1935,14 @@ mfxStatus CRawVideoWriter::WriteFrame(
         ptr  = pData->U + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            nBytesRead = (mfxU32)fwrite(ptr + i * pitch, 1, w, m_fDst);
+            nBytesRead = (mfxU32)m_fDst.Write(ptr + i * pitch, 1, w);
             MSDK_CHECK_NOT_EQUAL(nBytesRead, w, MFX_ERR_MORE_DATA);
         }
 
         ptr  = pData->V + (pInfo->CropX >> 1) + (pInfo->CropY >> 1) * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr+ i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr+ i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if (pInfo->FourCC == MFX_FOURCC_RGB4 || pInfo->FourCC == MFX_FOURCC_A2RGB10)
@@ -1968,7 +1958,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr + i * pitch, 1, 4*w, m_fDst), 4u*w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr + i * pitch, 1, 4*w), 4u*w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
 #if !(defined(_WIN32) || defined(_WIN64))
@@ -1981,17 +1971,17 @@ mfxStatus CRawVideoWriter::WriteFrame(
         ptr = pData->R + pInfo->CropX + pInfo->CropY * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr + i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr + i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
         ptr = pData->G + pInfo->CropX + pInfo->CropY * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr + i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr + i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
         ptr = pData->B + pInfo->CropX + pInfo->CropY * pitch;
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr + i * pitch, 1, w, m_fDst), w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr + i * pitch, 1, w), w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
 #endif
@@ -2002,7 +1992,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL( fwrite(ptr + i * pitch, 1, 4*w, m_fDst), 4u*w, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL( m_fDst.Write(ptr + i * pitch, 1, 4*w), 4u*w, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
 #if (MFX_VERSION >= 1027)
@@ -2012,7 +2002,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL(fwrite(ptr + i * pitch, 1, 4*w, m_fDst), w * 4u, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL(m_fDst.Write(ptr + i * pitch, 1, 4*w), w * 4u, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
     else if (pInfo->FourCC == MFX_FOURCC_Y410)
@@ -2021,7 +2011,7 @@ mfxStatus CRawVideoWriter::WriteFrame(
 
         for(i = 0; i < h; i++)
         {
-            MSDK_CHECK_NOT_EQUAL(fwrite(ptr + i * pitch, 1, 4*w, m_fDst), w * 4u, MFX_ERR_UNDEFINED_BEHAVIOR);
+            MSDK_CHECK_NOT_EQUAL(m_fDst.Write(ptr + i * pitch, 1, 4*w), w * 4u, MFX_ERR_UNDEFINED_BEHAVIOR);
         }
     }
 #endif
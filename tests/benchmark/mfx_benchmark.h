@@ -0,0 +1,159 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef MFX_BENCHMARK_H
+#define MFX_BENCHMARK_H
+
+// Minimal harness following the Google Benchmark interface, so the cases
+// read the same and the JSON output is understood by its compare tools:
+//
+//   static void BM_Something(mfx_benchmark::State& state)
+//   {
+//       Prepare(state.range(0));
+//       while (state.KeepRunning())
+//           DoSomething();
+//       state.SetBytesProcessed(state.iterations() * size);
+//   }
+//   MFX_BENCHMARK(BM_Something)->Arg(1920)->Arg(3840);
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mfx_benchmark
+{
+
+class State
+{
+public:
+    State(int64_t maxIterations, const std::vector<int64_t> &args);
+
+    // returns true while the measured loop has to continue,
+    // the timer starts on the first call and stops on the last one
+    bool KeepRunning()
+    {
+        if (m_iterations < m_maxIterations)
+        {
+            if (0 == m_iterations++)
+                StartTimer();
+            return true;
+        }
+        if (m_bRunning)
+            StopTimer();
+        return false;
+    }
+
+    // exclude preparation of an iteration from the measurement
+    void PauseTiming()  { StopTimer(); }
+    void ResumeTiming() { StartTimer(); }
+
+    int64_t range(size_t i = 0) const { return i < m_args.size() ? m_args[i] : 0; }
+    int64_t iterations() const        { return m_iterations; }
+
+    void SetBytesProcessed(int64_t bytes) { m_bytes = bytes; }
+    void SetItemsProcessed(int64_t items) { m_items = items; }
+    void SetLabel(const std::string &label) { m_label = label; }
+
+    // stops the case, its result is reported as an error
+    void SkipWithError(const char *msg);
+    // stops the case which can't run here, e.g. the CPU lacks the instruction set,
+    // it is reported but doesn't fail the run
+    void SkipWithMessage(const char *msg);
+
+    // custom values reported per case, like the "counters" of Google Benchmark
+    std::map<std::string, double> counters;
+
+protected:
+    friend class Runner;
+
+    void StartTimer();
+    void StopTimer();
+
+    const int64_t m_maxIterations;
+    const std::vector<int64_t> m_args;
+    int64_t m_iterations;
+
+    bool m_bRunning;
+    std::chrono::steady_clock::time_point m_realStart;
+    double m_cpuStart;
+    double m_realTime;
+    double m_cpuTime;
+
+    int64_t m_bytes;
+    int64_t m_items;
+    std::string m_label;
+    std::string m_error;
+    std::string m_skipped;
+};
+
+typedef void (*Function)(State &);
+
+class Benchmark
+{
+public:
+    Benchmark(const char *name, Function fn);
+
+    // every Arg/Args adds one instance of the case
+    Benchmark *Arg(int64_t arg);
+    Benchmark *Args(const std::vector<int64_t> &args);
+    // run the case with real time instead of CPU time deciding the iteration count,
+    // for cases spending their time in other threads
+    Benchmark *UseRealTime();
+
+    const std::string & Name() const { return m_name; }
+    const std::vector<std::vector<int64_t>> & ArgSets() const { return m_args; }
+    bool IsRealTime() const { return m_bUseRealTime; }
+
+protected:
+    friend class Runner;
+
+    std::string m_name;
+    Function m_fn;
+    std::vector<std::vector<int64_t>> m_args;
+    bool m_bUseRealTime;
+};
+
+Benchmark *RegisterBenchmark(const char *name, Function fn);
+
+// keep the compiler from optimizing out the measured computations
+template <typename T>
+inline void DoNotOptimize(T const &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void ClobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+} // namespace mfx_benchmark
+
+#define MFX_BENCHMARK_CONCAT2(a, b) a##b
+#define MFX_BENCHMARK_CONCAT(a, b) MFX_BENCHMARK_CONCAT2(a, b)
+
+#define MFX_BENCHMARK(fn)                                                    \
+    static mfx_benchmark::Benchmark *MFX_BENCHMARK_CONCAT(g_benchmark_, __LINE__) = \
+        mfx_benchmark::RegisterBenchmark(#fn, fn)
+
+#endif /* MFX_BENCHMARK_H */
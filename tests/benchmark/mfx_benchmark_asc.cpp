@@ -0,0 +1,251 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_benchmark.h"
+
+#include "mfx_common.h"
+
+#if defined(MFX_ENABLE_ASC)
+
+#include "asc_c_impl.h"
+#if !defined(MFX_HW_VSI_TARGET)
+#include "asc_sse4_impl.h"
+#include "asc_avx2_impl.h"
+#endif
+
+#include <vector>
+
+using namespace mfx_benchmark;
+
+namespace
+{
+
+// ASC works on a downscaled luma plane of this size
+const mfxU32 AscWidth  = 112;
+const mfxU32 AscHeight = 64;
+const mfxU32 AscPitch  = 128;
+
+enum
+{
+    IMPL_C    = 0,
+    IMPL_SSE4 = 1,
+    IMPL_AVX2 = 2,
+};
+
+struct Planes
+{
+    Planes(mfxU32 pitch, mfxU32 height)
+        : src(pitch * height)
+        , ref(pitch * height)
+    {
+        // the reference is a shifted and darker copy of the source
+        for (size_t i = 0; i < src.size(); i += 1)
+        {
+            src[i] = (mfxU8)((i * 13) ^ (i >> 7));
+            ref[i] = (mfxU8)(((i + 3) * 13) ^ ((i + 3) >> 7)) >> 1;
+        }
+    }
+
+    std::vector<mfxU8> src;
+    std::vector<mfxU8> ref;
+};
+
+// returns false and skips the case if the CPU can't run the implementation
+bool CheckImpl(State &state, int impl)
+{
+#if defined(MFX_HW_VSI_TARGET)
+    if (IMPL_C != impl)
+    {
+        state.SkipWithMessage("only C implementation is built");
+        return false;
+    }
+#else
+    if (IMPL_SSE4 == impl && !__builtin_cpu_supports("sse4.1"))
+    {
+        state.SkipWithMessage("SSE4.1 is not supported");
+        return false;
+    }
+    if (IMPL_AVX2 == impl && !__builtin_cpu_supports("avx2"))
+    {
+        state.SkipWithMessage("AVX2 is not supported");
+        return false;
+    }
+#endif
+    state.SetLabel(IMPL_C == impl ? "C" : (IMPL_SSE4 == impl ? "SSE4" : "AVX2"));
+    return true;
+}
+
+} // namespace
+
+// block search of the ASC motion estimation over the whole picture
+static void BM_ASC_ME_SAD_8x8_Block_Search(State &state)
+{
+    const int impl = (int)state.range(0);
+    if (!CheckImpl(state, impl))
+        return;
+
+    Planes planes(AscPitch, AscHeight + 32);
+    const int range = 16;
+    mfxU32 numBlocks = 0;
+
+    while (state.KeepRunning())
+    {
+        numBlocks = 0;
+        for (mfxU32 y = range; y + 8 + range <= AscHeight; y += 8)
+        {
+            for (mfxU32 x = range; x + 8 + range <= AscWidth; x += 8)
+            {
+                mfxU16 bestSAD = 0xffff;
+                int bestX = 0, bestY = 0;
+                mfxU8 *pSrc = &planes.src[y * AscPitch + x];
+                mfxU8 *pRef = &planes.ref[(y - range) * AscPitch + x - range];
+
+#if !defined(MFX_HW_VSI_TARGET)
+                if (IMPL_AVX2 == impl)
+                    ME_SAD_8x8_Block_Search_AVX2(pSrc, pRef, AscPitch, 2 * range, 2 * range, &bestSAD, &bestX, &bestY);
+                else if (IMPL_SSE4 == impl)
+                    ME_SAD_8x8_Block_Search_SSE4(pSrc, pRef, AscPitch, 2 * range, 2 * range, &bestSAD, &bestX, &bestY);
+                else
+#endif
+                    ME_SAD_8x8_Block_Search_C(pSrc, pRef, AscPitch, 2 * range, 2 * range, &bestSAD, &bestX, &bestY);
+
+                DoNotOptimize(bestSAD);
+                numBlocks += 1;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numBlocks);
+}
+MFX_BENCHMARK(BM_ASC_ME_SAD_8x8_Block_Search)->Arg(IMPL_C)->Arg(IMPL_SSE4)->Arg(IMPL_AVX2);
+
+// spatial complexity of 4x4 blocks
+static void BM_ASC_RsCsCalc_4x4(State &state)
+{
+    const int impl = (int)state.range(0);
+    if (!CheckImpl(state, impl))
+        return;
+
+    Planes planes(AscPitch, AscHeight);
+    const int wblocks = AscWidth / 4, hblocks = AscHeight / 4;
+    std::vector<mfxU16> rs(wblocks * hblocks), cs(wblocks * hblocks);
+
+    while (state.KeepRunning())
+    {
+#if !defined(MFX_HW_VSI_TARGET)
+        if (IMPL_AVX2 == impl)
+            RsCsCalc_4x4_AVX2(planes.src.data(), AscPitch, wblocks, hblocks, rs.data(), cs.data());
+        else if (IMPL_SSE4 == impl)
+            RsCsCalc_4x4_SSE4(planes.src.data(), AscPitch, wblocks, hblocks, rs.data(), cs.data());
+        else
+#endif
+            RsCsCalc_4x4_C(planes.src.data(), AscPitch, wblocks, hblocks, rs.data(), cs.data());
+        ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * AscWidth * AscHeight);
+}
+MFX_BENCHMARK(BM_ASC_RsCsCalc_4x4)->Arg(IMPL_C)->Arg(IMPL_SSE4)->Arg(IMPL_AVX2);
+
+// histogram of the difference between two pictures
+static void BM_ASC_ImageDiffHistogram(State &state)
+{
+    const int impl = (int)state.range(0);
+    if (!CheckImpl(state, impl))
+        return;
+
+    Planes planes(AscPitch, AscHeight);
+
+    while (state.KeepRunning())
+    {
+        mfxI32 histogram[5] = {};
+        mfxI64 srcDC = 0, refDC = 0;
+
+#if !defined(MFX_HW_VSI_TARGET)
+        if (IMPL_AVX2 == impl)
+            ImageDiffHistogram_AVX2(planes.src.data(), planes.ref.data(), AscPitch, AscWidth, AscHeight, histogram, &srcDC, &refDC);
+        else if (IMPL_SSE4 == impl)
+            ImageDiffHistogram_SSE4(planes.src.data(), planes.ref.data(), AscPitch, AscWidth, AscHeight, histogram, &srcDC, &refDC);
+        else
+#endif
+            ImageDiffHistogram_C(planes.src.data(), planes.ref.data(), AscPitch, AscWidth, AscHeight, histogram, &srcDC, &refDC);
+        DoNotOptimize(histogram);
+    }
+    state.SetBytesProcessed(state.iterations() * AscWidth * AscHeight * 2);
+}
+MFX_BENCHMARK(BM_ASC_ImageDiffHistogram)->Arg(IMPL_C)->Arg(IMPL_SSE4)->Arg(IMPL_AVX2);
+
+// brightness compensation between the pictures
+static void BM_ASC_GainOffset(State &state)
+{
+    const int impl = (int)state.range(0);
+    if (!CheckImpl(state, impl))
+        return;
+
+    Planes planes(AscPitch, AscHeight);
+
+    while (state.KeepRunning())
+    {
+        mfxU8 *pSrc = planes.src.data();
+        mfxU8 *pDst = planes.ref.data();
+
+#if !defined(MFX_HW_VSI_TARGET)
+        if (IMPL_AVX2 == impl)
+            GainOffset_AVX2(&pSrc, &pDst, AscWidth, AscHeight, AscPitch, 3);
+        else if (IMPL_SSE4 == impl)
+            GainOffset_SSE4(&pSrc, &pDst, AscWidth, AscHeight, AscPitch, 3);
+        else
+#endif
+            GainOffset_C(&pSrc, &pDst, AscWidth, AscHeight, AscPitch, 3);
+        ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * AscWidth * AscHeight);
+}
+MFX_BENCHMARK(BM_ASC_GainOffset)->Arg(IMPL_C)->Arg(IMPL_SSE4)->Arg(IMPL_AVX2);
+
+// spatial complexity of the full resolution picture
+static void BM_ASC_Calc_RaCa_pic(State &state)
+{
+    const int impl = (int)state.range(0);
+    if (!CheckImpl(state, impl))
+        return;
+
+    const mfxI32 width = 1920, height = 1080, pitch = 1920;
+    std::vector<mfxU8> pic(pitch * height);
+    for (size_t i = 0; i < pic.size(); i += 1)
+        pic[i] = (mfxU8)((i * 13) ^ (i >> 11));
+
+    while (state.KeepRunning())
+    {
+        mfxF64 RsCs = 0;
+
+#if !defined(MFX_HW_VSI_TARGET)
+        if (IMPL_AVX2 == impl)
+            Calc_RaCa_pic_AVX2(pic.data(), width, height, pitch, RsCs);
+        else if (IMPL_SSE4 == impl)
+            Calc_RaCa_pic_SSE4(pic.data(), width, height, pitch, RsCs);
+        else
+#endif
+            Calc_RaCa_pic_C(pic.data(), width, height, pitch, RsCs);
+        DoNotOptimize(RsCs);
+    }
+    state.SetBytesProcessed(state.iterations() * width * height);
+}
+MFX_BENCHMARK(BM_ASC_Calc_RaCa_pic)->Arg(IMPL_C)->Arg(IMPL_SSE4)->Arg(IMPL_AVX2);
+
+#endif // MFX_ENABLE_ASC
@@ -0,0 +1,225 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "mfx_benchmark.h"
+
+#include "mfx_common.h"
+
+#include <memory>
+#include <vector>
+
+#if defined(MFX_ENABLE_H265_VIDEO_DECODE)
+#include "umc_h265_nal_spl.h"
+#endif
+
+#if defined(MFX_ENABLE_H265_VIDEO_ENCODE)
+#include "hevcehw_base_packer.h"
+#endif
+
+using namespace mfx_benchmark;
+
+#if defined(MFX_ENABLE_H265_VIDEO_DECODE)
+
+namespace
+{
+
+// Annex B stream of NAL units with short start codes and payloads
+// of varying size which never contain a start code emulation
+std::vector<mfxU8> MakeAnnexBStream(size_t size, size_t &numNalu)
+{
+    std::vector<mfxU8> stream;
+    stream.reserve(size + 16384);
+    numNalu = 0;
+
+    for (mfxU32 n = 0; stream.size() < size; n += 1)
+    {
+        const mfxU8 nalType = (n % 32) ? 1 : 19; // TRAIL_R, IDR_W_RADL each 32 pictures
+        const size_t payload = 200 + (n * 2731) % 8000;
+
+        stream.insert(stream.end(), { 0, 0, 1, (mfxU8)(nalType << 1), 1 });
+        for (size_t i = 0; i < payload; i += 1)
+            stream.push_back((mfxU8)((i * 37 + n) % 255 + 1));
+
+        numNalu += 1;
+    }
+    return stream;
+}
+
+} // namespace
+
+// start code search of the decoder over a whole buffer
+static void BM_H265_NALUnitSplitter(State &state)
+{
+    size_t numNalu = 0;
+    std::vector<mfxU8> stream = MakeAnnexBStream((size_t)state.range(0) << 20, numNalu);
+
+    UMC_HEVC_DECODER::NALUnitSplitter_H265 splitter;
+    splitter.Init();
+
+    size_t found = 0;
+    while (state.KeepRunning())
+    {
+        UMC::MediaData source;
+        source.SetBufferPointer(stream.data(), stream.size());
+        source.SetDataSize(stream.size());
+
+        splitter.Reset();
+        found = 0;
+        while (UMC::MediaDataEx *nalu = splitter.GetNalUnits(&source))
+        {
+            DoNotOptimize(nalu);
+            found += 1;
+        }
+    }
+
+    if (found != numNalu)
+        state.SkipWithError("unexpected number of NAL units");
+
+    state.SetBytesProcessed(state.iterations() * stream.size());
+    state.SetItemsProcessed(state.iterations() * numNalu);
+}
+MFX_BENCHMARK(BM_H265_NALUnitSplitter)->Arg(4);
+
+#endif // MFX_ENABLE_H265_VIDEO_DECODE
+
+#if defined(MFX_ENABLE_H265_VIDEO_ENCODE)
+
+using namespace HEVCEHW::Base;
+
+namespace
+{
+
+// parameter sets of a 1080p Main profile stream with IPPP structure
+struct HeaderSet
+{
+    HeaderSet()
+    {
+        vps = {};
+        vps.max_sub_layers_minus1 = 0;
+        vps.temporal_id_nesting_flag = 1;
+        vps.general.profile_idc = 1;
+        vps.general.level_idc = 123;
+        vps.general.profile_compatibility_flags = 0x60000000;
+        vps.general.progressive_source_flag = 1;
+        vps.general.frame_only_constraint_flag = 1;
+        vps.sub_layer[0].max_dec_pic_buffering_minus1 = 2;
+
+        sps = {};
+        static_cast<LayersInfo&>(sps) = vps;
+        sps.temporal_id_nesting_flag = 1;
+        sps.chroma_format_idc = 1;
+        sps.pic_width_in_luma_samples = 1920;
+        sps.pic_height_in_luma_samples = 1088;
+        sps.conformance_window_flag = 1;
+        sps.conf_win_bottom_offset = 4;
+        sps.log2_max_pic_order_cnt_lsb_minus4 = 4;
+        sps.log2_min_luma_coding_block_size_minus3 = 0;
+        sps.log2_diff_max_min_luma_coding_block_size = 3;
+        sps.log2_min_transform_block_size_minus2 = 0;
+        sps.log2_diff_max_min_transform_block_size = 3;
+        sps.max_transform_hierarchy_depth_inter = 2;
+        sps.max_transform_hierarchy_depth_intra = 2;
+        sps.amp_enabled_flag = 1;
+        sps.sample_adaptive_offset_enabled_flag = 1;
+        sps.num_short_term_ref_pic_sets = 1;
+        sps.strps[0].num_negative_pics = 1;
+        sps.strps[0].pic[0].delta_poc_sx_minus1 = 0;
+        sps.strps[0].pic[0].used_by_curr_pic_sx_flag = 1;
+        sps.temporal_mvp_enabled_flag = 1;
+
+        pps = {};
+        pps.cabac_init_present_flag = 1;
+        pps.cu_qp_delta_enabled_flag = 1;
+        pps.deblocking_filter_control_present_flag = 1;
+        pps.loop_filter_across_slices_enabled_flag = 1;
+    }
+
+    VPS vps;
+    SPS sps;
+    PPS pps;
+};
+
+} // namespace
+
+// AUD/VPS/SPS/PPS packing done on every encoder Reset
+static void BM_HEVC_Packer_Headers(State &state)
+{
+    std::unique_ptr<Packer> packer(new Packer(0));
+    HeaderSet hs;
+    std::vector<SliceInfo> si(1, SliceInfo{ 0, 510 });
+    PackedHeaders ph = {};
+
+    mfxU64 bytes = 0;
+    while (state.KeepRunning())
+    {
+        if (MFX_ERR_NONE != packer->Reset(hs.vps, hs.sps, hs.pps, si, ph))
+        {
+            state.SkipWithError("Packer::Reset failed");
+            return;
+        }
+        bytes = (ph.VPS.BitLen + ph.SPS.BitLen + ph.PPS.BitLen) / 8;
+        ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+MFX_BENCHMARK(BM_HEVC_Packer_Headers);
+
+// slice segment headers of one picture, argument is the number of slices
+static void BM_HEVC_Packer_SSH(State &state)
+{
+    std::unique_ptr<Packer> packer(new Packer(0));
+    HeaderSet hs;
+    const mfxU32 numSlices = (mfxU32)state.range(0);
+    const mfxU32 numLCU = (1920 / 64) * (1088 / 64);
+    std::vector<mfxU8> buf(numSlices * 64);
+
+    NALU nalu = { 0, TRAIL_R, 0, 1 };
+    Slice slice = {};
+    slice.type = 1; // P
+    slice.short_term_ref_pic_set_sps_flag = 1;
+    slice.temporal_mvp_enabled_flag = 1;
+    slice.sao_luma_flag = 1;
+    slice.sao_chroma_flag = 1;
+    slice.collocated_from_l0_flag = 1;
+    slice.five_minus_max_num_merge_cand = 0;
+    slice.slice_qp_delta = 4;
+    slice.loop_filter_across_slices_enabled_flag = 1;
+
+    mfxU64 bits = 0;
+    while (state.KeepRunning())
+    {
+        BitstreamWriter bs(buf.data(), (mfxU32)buf.size());
+        for (mfxU32 i = 0; i < numSlices; i += 1)
+        {
+            slice.first_slice_segment_in_pic_flag = (0 == i);
+            slice.segment_address = i * numLCU / numSlices;
+            slice.pic_order_cnt_lsb = (mfxU32)(state.iterations() & 0xff);
+            packer->PackSSH(bs, nalu, hs.sps, hs.pps, slice);
+        }
+        bits = bs.GetOffset();
+        ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * (bits / 8));
+    state.SetItemsProcessed(state.iterations() * numSlices);
+}
+MFX_BENCHMARK(BM_HEVC_Packer_SSH)->Arg(1)->Arg(8)->Arg(68);
+
+#endif // MFX_ENABLE_H265_VIDEO_ENCODE
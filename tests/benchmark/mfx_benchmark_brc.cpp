@@ -0,0 +1,101 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "mfx_benchmark.h"
+
+#include "mfx_brc_common.h"
+
+// the software BRC is built along with the AVC or MPEG2 encoders
+#if defined(MFX_ENABLE_VIDEO_BRC_COMMON) && (defined(MFX_ENABLE_H264_VIDEO_ENCODE) || defined(MFX_ENABLE_H265_VIDEO_ENCODE))
+
+#include <cmath>
+
+using namespace mfx_benchmark;
+
+// GetFrameCtrl/Update pair of the HEVC software BRC done for every encoded frame,
+// the argument is the rate control method
+static void BM_ExtBRC_Update(State &state)
+{
+    const mfxU16 rateControl = (mfxU16)state.range(0);
+    const mfxU16 gopPicSize = 60;
+
+    mfxVideoParam par = {};
+    par.mfx.CodecId = MFX_CODEC_HEVC;
+    par.mfx.RateControlMethod = rateControl;
+    par.mfx.TargetKbps = 6000;
+    par.mfx.MaxKbps = (MFX_RATECONTROL_VBR == rateControl) ? 9000 : 6000;
+    par.mfx.BufferSizeInKB = 1500;
+    par.mfx.InitialDelayInKB = 750;
+    par.mfx.GopPicSize = gopPicSize;
+    par.mfx.GopRefDist = 1;
+    par.mfx.FrameInfo.Width = 1920;
+    par.mfx.FrameInfo.Height = 1088;
+    par.mfx.FrameInfo.CropW = 1920;
+    par.mfx.FrameInfo.CropH = 1080;
+    par.mfx.FrameInfo.FrameRateExtN = 30;
+    par.mfx.FrameInfo.FrameRateExtD = 1;
+    par.mfx.FrameInfo.ChromaFormat = MFX_CHROMAFORMAT_YUV420;
+    par.mfx.FrameInfo.FourCC = MFX_FOURCC_NV12;
+
+    MfxHwH265EncodeBRC::ExtBRC brc;
+    if (MFX_ERR_NONE != brc.Init(&par))
+    {
+        state.SkipWithError("ExtBRC::Init failed");
+        return;
+    }
+
+    // coded size follows the QP like a real encoder would, I frames are 4 times bigger
+    const mfxF64 bytesPerFrame = par.mfx.TargetKbps * 1000.0 / 8 / 30;
+    mfxU32 order = 0;
+    mfxU64 recodes = 0;
+
+    while (state.KeepRunning())
+    {
+        mfxBRCFrameParam frame = {};
+        mfxBRCFrameCtrl ctrl = {};
+        mfxBRCFrameStatus status = {};
+        const bool bIntra = 0 == order % gopPicSize;
+
+        frame.EncodedOrder = order;
+        frame.DisplayOrder = order % gopPicSize;
+        frame.FrameType = bIntra
+            ? (mfxU16)(MFX_FRAMETYPE_I | MFX_FRAMETYPE_REF | MFX_FRAMETYPE_IDR)
+            : (mfxU16)(MFX_FRAMETYPE_P | MFX_FRAMETYPE_REF);
+
+        brc.GetFrameCtrl(&frame, &ctrl);
+
+        mfxF64 size = bytesPerFrame * (bIntra ? 4 : 1) * std::pow(2.0, (26 - ctrl.QpY) / 6.0);
+        frame.CodedFrameSize = (mfxU32)(size * (0.9 + 0.2 * ((order * 7) % 11) / 10.0));
+
+        brc.Update(&frame, &ctrl, &status);
+        recodes += (MFX_BRC_OK != status.BRCStatus);
+
+        order += 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["recodes"] = (double)recodes;
+    state.SetLabel(MFX_RATECONTROL_VBR == rateControl ? "VBR" : "CBR");
+
+    brc.Close();
+}
+MFX_BENCHMARK(BM_ExtBRC_Update)->Arg(MFX_RATECONTROL_CBR)->Arg(MFX_RATECONTROL_VBR);
+
+#endif // MFX_ENABLE_VIDEO_BRC_COMMON
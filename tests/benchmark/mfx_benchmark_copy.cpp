@@ -0,0 +1,197 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_benchmark.h"
+
+#include "fast_copy.h"
+#include "libmfx_core.h"
+#include "libmfx_core_factory.h"
+
+#include <memory>
+#include <vector>
+
+using namespace mfx_benchmark;
+
+namespace
+{
+
+// NV12 frame of the given width and height, the pitch is 64 aligned as in the allocators
+struct Frame
+{
+    Frame(mfxU32 width, mfxU32 height, mfxU32 bytesPerSample = 1)
+        : pitch((width * bytesPerSample + 63) & ~63)
+        , roi{ (int)(width * bytesPerSample), (int)(height * 3 / 2) }
+        , data(pitch * roi.height + 64)
+    {
+        for (size_t i = 0; i < data.size(); i += 1)
+            data[i] = (mfxU8)(i * 7 + (i >> 12));
+    }
+
+    mfxU8 * Ptr() { return (mfxU8 *)(((size_t)data.data() + 63) & ~(size_t)63); }
+    mfxU64 Size() const { return (mfxU64)roi.width * roi.height; }
+
+    mfxU32 pitch;
+    mfxSize roi;
+    std::vector<mfxU8> data;
+};
+
+typedef void (*RowCopy)(const mfxU8 *src, mfxU8 *dst, int width);
+
+void CopyRows(RowCopy copy, Frame &src, Frame &dst)
+{
+    const mfxU8 *pSrc = src.Ptr();
+    mfxU8 *pDst = dst.Ptr();
+
+    for (int y = 0; y < src.roi.height; y += 1)
+    {
+        copy(pSrc, pDst, src.roi.width);
+        pSrc += src.pitch;
+        pDst += dst.pitch;
+    }
+}
+
+bool HasSSE41()
+{
+#if defined(MFX_HW_VSI_TARGET)
+    return false;
+#else
+    return !!__builtin_cpu_supports("sse4.1");
+#endif
+}
+
+} // namespace
+
+static void BM_FastCopy_VideoToSys_C(State &state)
+{
+    Frame src((mfxU32)state.range(0), (mfxU32)state.range(1));
+    Frame dst((mfxU32)state.range(0), (mfxU32)state.range(1));
+
+    while (state.KeepRunning())
+    {
+        CopyRows(copyVideoToSys_C, src, dst);
+        ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * src.Size());
+}
+MFX_BENCHMARK(BM_FastCopy_VideoToSys_C)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
+
+#if !defined(MFX_HW_VSI_TARGET)
+static void BM_FastCopy_VideoToSys_SSE4(State &state)
+{
+    if (!HasSSE41())
+    {
+        state.SkipWithMessage("SSE4.1 is not supported");
+        return;
+    }
+
+    Frame src((mfxU32)state.range(0), (mfxU32)state.range(1));
+    Frame dst((mfxU32)state.range(0), (mfxU32)state.range(1));
+
+    while (state.KeepRunning())
+    {
+        CopyRows(copyVideoToSys_SSE4, src, dst);
+        ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * src.Size());
+}
+MFX_BENCHMARK(BM_FastCopy_VideoToSys_SSE4)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
+#endif
+
+// the dispatched entry point used by the cores, flag selects the path
+static void BM_FastCopy_Copy(State &state)
+{
+    Frame src((mfxU32)state.range(0), (mfxU32)state.range(1));
+    Frame dst((mfxU32)state.range(0), (mfxU32)state.range(1));
+    const int flag = (int)state.range(2);
+
+    while (state.KeepRunning())
+    {
+        FastCopy::Copy(dst.Ptr(), dst.pitch, src.Ptr(), src.pitch, src.roi, flag);
+        ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * src.Size());
+    state.SetLabel(flag == COPY_VIDEO_TO_SYS ? "video_to_sys" : "sys_to_sys");
+}
+MFX_BENCHMARK(BM_FastCopy_Copy)
+    ->Args({ 1920, 1080, COPY_SYS_TO_SYS })
+    ->Args({ 1920, 1080, COPY_VIDEO_TO_SYS })
+    ->Args({ 3840, 2160, COPY_SYS_TO_SYS })
+    ->Args({ 3840, 2160, COPY_VIDEO_TO_SYS });
+
+// P010 copy with the shift between MSB and LSB aligned samples
+static void BM_FastCopy_CopyAndShift(State &state)
+{
+    Frame src((mfxU32)state.range(0), (mfxU32)state.range(1), 2);
+    Frame dst((mfxU32)state.range(0), (mfxU32)state.range(1), 2);
+    mfxSize roi = { src.roi.width / 2, src.roi.height };
+
+    while (state.KeepRunning())
+    {
+        FastCopy::CopyAndShift((mfxU16 *)dst.Ptr(), dst.pitch, (mfxU16 *)src.Ptr(), src.pitch,
+            roi, 0, 6, COPY_VIDEO_TO_SYS);
+        ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * src.Size());
+}
+MFX_BENCHMARK(BM_FastCopy_CopyAndShift)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
+
+// lock/unlock round trip of internal system memory frames of the software core,
+// the path every component goes through to reach frame data
+static void BM_CommonCORE_LockUnlock(State &state)
+{
+    std::unique_ptr<VideoCORE> core(FactoryCORE::CreateCORE(MFX_HW_NO, 0, 0, nullptr));
+    if (!core)
+    {
+        state.SkipWithError("can't create the core");
+        return;
+    }
+
+    mfxFrameAllocRequest request = {};
+    request.Info.FourCC = MFX_FOURCC_NV12;
+    request.Info.ChromaFormat = MFX_CHROMAFORMAT_YUV420;
+    request.Info.Width = 1920;
+    request.Info.Height = 1088;
+    request.Info.CropW = 1920;
+    request.Info.CropH = 1080;
+    request.Type = MFX_MEMTYPE_INTERNAL_FRAME | MFX_MEMTYPE_SYSTEM_MEMORY | MFX_MEMTYPE_FROM_DECODE;
+    request.NumFrameMin = request.NumFrameSuggested = (mfxU16)state.range(0);
+
+    mfxFrameAllocResponse response = {};
+    if (MFX_ERR_NONE != core->AllocFrames(&request, &response))
+    {
+        state.SkipWithError("can't allocate frames");
+        return;
+    }
+
+    mfxU32 i = 0;
+    while (state.KeepRunning())
+    {
+        mfxFrameData data = {};
+        mfxMemId mid = response.mids[i++ % response.NumFrameActual];
+
+        core->LockFrame(mid, &data);
+        DoNotOptimize(data.Y);
+        core->UnlockFrame(mid, &data);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    core->FreeFrames(&response, false);
+}
+MFX_BENCHMARK(BM_CommonCORE_LockUnlock)->Arg(1)->Arg(16);
@@ -0,0 +1,178 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "mfx_benchmark.h"
+
+#include "mfx_common.h"
+
+// the software JPEG codec is built with the fallback only
+#if defined(MFX_ENABLE_SW_FALLBACK) && defined(MFX_ENABLE_MJPEG_VIDEO_ENCODE) && defined(MFX_ENABLE_MJPEG_VIDEO_DECODE)
+
+#include "jpegenc.h"
+#include "jpegdec.h"
+#include "membuffout.h"
+
+#include <memory>
+#include <vector>
+
+using namespace mfx_benchmark;
+
+namespace
+{
+
+const int Quality = 90;
+
+// planar 4:2:0 picture with smooth gradients and some texture
+struct Picture
+{
+    Picture(int w, int h)
+        : width(w)
+        , height(h)
+        , y(w * h)
+        , u(w * h / 4)
+        , v(w * h / 4)
+    {
+        for (int j = 0; j < h; j += 1)
+            for (int i = 0; i < w; i += 1)
+                y[j * w + i] = (mfxU8)((i + j) / 8 + ((i * j) & 15));
+
+        for (int j = 0; j < h / 2; j += 1)
+            for (int i = 0; i < w / 2; i += 1)
+            {
+                u[j * w / 2 + i] = (mfxU8)(128 + (i - w / 4) / 8);
+                v[j * w / 2 + i] = (mfxU8)(128 + (j - h / 4) / 8);
+            }
+    }
+
+    int width;
+    int height;
+    std::vector<mfxU8> y;
+    std::vector<mfxU8> u;
+    std::vector<mfxU8> v;
+};
+
+// returns the size of the encoded picture or 0 on failure
+size_t Encode(CJPEGEncoder &enc, Picture &pic, std::vector<mfxU8> &out)
+{
+    CMemBuffOutput stream;
+    uint8_t *pSrc[4] = { pic.y.data(), pic.u.data(), pic.v.data(), nullptr };
+    int srcStep[4] = { pic.width, pic.width / 2, pic.width / 2, 0 };
+    mfxSize size = { pic.width, pic.height };
+
+    if (JPEG_OK != stream.Open(out.data(), (int)out.size()) ||
+        JPEG_OK != enc.SetDestination(&stream) ||
+        JPEG_OK != enc.SetSource(pSrc, srcStep, size, 3, JC_YCBCR, JS_420, 8) ||
+        JPEG_OK != enc.SetParams(JPEG_BASELINE, JC_YCBCR, JS_420, 0, 1, 1, 0, 0, 0, 0, Quality) ||
+        JPEG_OK != enc.SetJFIFApp0Resolution(JRU_NONE, 1, 1) ||
+        JPEG_OK != enc.WriteHeader() ||
+        JPEG_OK != enc.WriteData())
+        return 0;
+
+    return stream.GetPosition();
+}
+
+bool InitEncoder(CJPEGEncoder &enc)
+{
+    return JPEG_OK == enc.SetDefaultQuantTable(Quality)
+        && JPEG_OK == enc.SetDefaultACTable()
+        && JPEG_OK == enc.SetDefaultDCTable();
+}
+
+} // namespace
+
+static void BM_JPEG_Encode(State &state)
+{
+    Picture pic((int)state.range(0), (int)state.range(1));
+    std::vector<mfxU8> out(pic.y.size() * 2);
+    std::unique_ptr<CJPEGEncoder> enc(new CJPEGEncoder());
+
+    if (!InitEncoder(*enc))
+    {
+        state.SkipWithError("can't init the encoder");
+        return;
+    }
+
+    size_t size = 0;
+    while (state.KeepRunning())
+    {
+        size = Encode(*enc, pic, out);
+        if (!size)
+        {
+            state.SkipWithError("encoding failed");
+            return;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * pic.width * pic.height * 3 / 2);
+    state.counters["compressed_bytes"] = (double)size;
+}
+MFX_BENCHMARK(BM_JPEG_Encode)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
+
+// decoding into NV12 as done by the MJPEG decoder of the library
+static void BM_JPEG_Decode(State &state)
+{
+    Picture pic((int)state.range(0), (int)state.range(1));
+    std::vector<mfxU8> jpeg(pic.y.size() * 2);
+    size_t jpegSize = 0;
+    {
+        std::unique_ptr<CJPEGEncoder> enc(new CJPEGEncoder());
+        if (InitEncoder(*enc))
+            jpegSize = Encode(*enc, pic, jpeg);
+    }
+    if (!jpegSize)
+    {
+        state.SkipWithError("can't prepare the picture");
+        return;
+    }
+
+    std::vector<mfxU8> nv12(pic.width * pic.height * 3 / 2);
+    uint8_t *pDst[4] = { nv12.data(), nv12.data() + pic.width * pic.height, nullptr, nullptr };
+    int dstStep[4] = { pic.width, pic.width, 0, 0 };
+    std::unique_ptr<CJPEGDecoder> dec(new CJPEGDecoder());
+
+    while (state.KeepRunning())
+    {
+        int width = 0, height = 0, channels = 0, precision = 0;
+        JCOLOR color = JC_UNKNOWN;
+        JSS sampling = JS_OTHER;
+
+        dec->Reset();
+        if (JPEG_OK != dec->SetSource(jpeg.data(), jpegSize) ||
+            JPEG_OK != dec->ReadHeader(&width, &height, &channels, &color, &sampling, &precision))
+        {
+            state.SkipWithError("can't read the header");
+            return;
+        }
+
+        mfxSize size = { width, height };
+        if (JPEG_OK != dec->SetDestination(pDst, dstStep, size, channels, JC_NV12, JS_420) ||
+            JPEG_OK != dec->ReadData())
+        {
+            state.SkipWithError("decoding failed");
+            return;
+        }
+        ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * jpegSize);
+    state.SetItemsProcessed(state.iterations());
+}
+MFX_BENCHMARK(BM_JPEG_Decode)->Args({ 1920, 1080 })->Args({ 3840, 2160 });
+
+#endif // MFX_ENABLE_SW_FALLBACK && MFX_ENABLE_MJPEG_VIDEO_ENCODE && MFX_ENABLE_MJPEG_VIDEO_DECODE
@@ -0,0 +1,516 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_benchmark.h"
+
+#include <algorithm>
+#include <memory>
+#include <regex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace mfx_benchmark
+{
+
+namespace
+{
+
+const int64_t MaxIterations = 1000000000;
+
+double GetProcessCpuTime()
+{
+    struct timespec ts = {};
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+std::vector<std::unique_ptr<Benchmark>> & GetRegistry()
+{
+    static std::vector<std::unique_ptr<Benchmark>> registry;
+    return registry;
+}
+
+struct Result
+{
+    std::string name;
+    int64_t iterations;
+    // per iteration, ns
+    double realTime;
+    double cpuTime;
+    double bytesPerSecond;
+    double itemsPerSecond;
+    std::string label;
+    std::string error;
+    std::string skipped;
+    std::map<std::string, double> counters;
+};
+
+struct Options
+{
+    std::string filter = ".";
+    double minTime = 0.5;
+    bool bJsonFormat = false;
+    std::string out;
+    bool bJsonOut = true;
+    bool bList = false;
+};
+
+std::string EscapeJson(const std::string &str)
+{
+    std::string res;
+
+    for (char c : str)
+    {
+        switch (c)
+        {
+        case '"':  res += "\\\""; break;
+        case '\\': res += "\\\\"; break;
+        case '\n': res += "\\n"; break;
+        case '\t': res += "\\t"; break;
+        default:
+            if ((unsigned char)c < 0x20)
+            {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                res += buf;
+            }
+            else
+            {
+                res += c;
+            }
+        }
+    }
+    return res;
+}
+
+void WriteJson(FILE *f, const char *executable, const std::vector<Result> &results)
+{
+    char date[64] = {};
+    char host[256] = {};
+    time_t now = time(nullptr);
+    struct tm tmNow = {};
+
+    localtime_r(&now, &tmNow);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", &tmNow);
+    gethostname(host, sizeof(host) - 1);
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"context\": {\n");
+    fprintf(f, "    \"date\": \"%s\",\n", date);
+    fprintf(f, "    \"host_name\": \"%s\",\n", EscapeJson(host).c_str());
+    fprintf(f, "    \"executable\": \"%s\",\n", EscapeJson(executable).c_str());
+    fprintf(f, "    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+#if defined(NDEBUG)
+    fprintf(f, "    \"library_build_type\": \"release\"\n");
+#else
+    fprintf(f, "    \"library_build_type\": \"debug\"\n");
+#endif
+    fprintf(f, "  },\n");
+    fprintf(f, "  \"benchmarks\": [");
+
+    for (size_t i = 0; i < results.size(); i += 1)
+    {
+        const Result &res = results[i];
+        const std::string name = EscapeJson(res.name);
+
+        fprintf(f, "%s\n    {\n", i ? "," : "");
+        fprintf(f, "      \"name\": \"%s\",\n", name.c_str());
+        fprintf(f, "      \"run_name\": \"%s\",\n", name.c_str());
+        fprintf(f, "      \"run_type\": \"iteration\",\n");
+        fprintf(f, "      \"repetitions\": 1,\n");
+        fprintf(f, "      \"repetition_index\": 0,\n");
+        fprintf(f, "      \"threads\": 1,\n");
+        if (!res.error.empty())
+        {
+            fprintf(f, "      \"error_occurred\": true,\n");
+            fprintf(f, "      \"error_message\": \"%s\",\n", EscapeJson(res.error).c_str());
+        }
+        if (!res.skipped.empty())
+        {
+            fprintf(f, "      \"skipped\": true,\n");
+            fprintf(f, "      \"skip_message\": \"%s\",\n", EscapeJson(res.skipped).c_str());
+        }
+        fprintf(f, "      \"iterations\": %lld,\n", (long long)res.iterations);
+        fprintf(f, "      \"real_time\": %.6e,\n", res.realTime);
+        fprintf(f, "      \"cpu_time\": %.6e,\n", res.cpuTime);
+        if (res.bytesPerSecond > 0)
+            fprintf(f, "      \"bytes_per_second\": %.6e,\n", res.bytesPerSecond);
+        if (res.itemsPerSecond > 0)
+            fprintf(f, "      \"items_per_second\": %.6e,\n", res.itemsPerSecond);
+        for (auto &counter : res.counters)
+            fprintf(f, "      \"%s\": %.6e,\n", EscapeJson(counter.first).c_str(), counter.second);
+        if (!res.label.empty())
+            fprintf(f, "      \"label\": \"%s\",\n", EscapeJson(res.label).c_str());
+        fprintf(f, "      \"time_unit\": \"ns\"\n");
+        fprintf(f, "    }");
+    }
+
+    fprintf(f, "\n  ]\n}\n");
+}
+
+std::string FormatRate(double value, const char *unit)
+{
+    const char *prefixes[] = { "", "k", "M", "G", "T" };
+    size_t i = 0;
+    char buf[64];
+
+    while (value >= 1024. && i + 1 < sizeof(prefixes) / sizeof(prefixes[0]))
+    {
+        value /= 1024.;
+        i += 1;
+    }
+    snprintf(buf, sizeof(buf), "%.4g%s%s/s", value, prefixes[i], unit);
+    return buf;
+}
+
+void WriteConsoleHeader(FILE *f, size_t nameWidth)
+{
+    fprintf(f, "%-*s %15s %15s %12s\n", (int)nameWidth, "Benchmark", "Time", "CPU", "Iterations");
+    fprintf(f, "%s\n", std::string(nameWidth + 45, '-').c_str());
+}
+
+void WriteConsoleResult(FILE *f, size_t nameWidth, const Result &res)
+{
+    fprintf(f, "%-*s ", (int)nameWidth, res.name.c_str());
+    if (!res.error.empty())
+    {
+        fprintf(f, "ERROR OCCURRED: '%s'\n", res.error.c_str());
+        return;
+    }
+    if (!res.skipped.empty())
+    {
+        fprintf(f, "SKIPPED: '%s'\n", res.skipped.c_str());
+        return;
+    }
+
+    fprintf(f, "%12.0f ns %12.0f ns %12lld", res.realTime, res.cpuTime, (long long)res.iterations);
+    if (res.bytesPerSecond > 0)
+        fprintf(f, " %s", FormatRate(res.bytesPerSecond, "B").c_str());
+    if (res.itemsPerSecond > 0)
+        fprintf(f, " %s", FormatRate(res.itemsPerSecond, "").c_str());
+    for (auto &counter : res.counters)
+        fprintf(f, " %s=%g", counter.first.c_str(), counter.second);
+    if (!res.label.empty())
+        fprintf(f, " %s", res.label.c_str());
+    fprintf(f, "\n");
+}
+
+bool ParseFlag(const char *arg, const char *flag, std::string &value)
+{
+    size_t len = strlen(flag);
+
+    if (strncmp(arg, flag, len))
+        return false;
+    if ('\0' == arg[len])
+    {
+        value = "true";
+        return true;
+    }
+    if ('=' != arg[len])
+        return false;
+    value = arg + len + 1;
+    return true;
+}
+
+void PrintUsage(const char *executable)
+{
+    printf("Usage: %s [options]\n", executable);
+    printf("  --benchmark_filter=<regex>          run the cases matching the regular expression\n");
+    printf("  --benchmark_min_time=<seconds>      minimal time to measure each case, default 0.5\n");
+    printf("  --benchmark_format=<console|json>   format of the standard output\n");
+    printf("  --benchmark_out=<file>              write the results to the file as well\n");
+    printf("  --benchmark_out_format=<json|console> format of the file, default json\n");
+    printf("  --benchmark_list_tests              list the cases and exit\n");
+}
+
+} // namespace
+
+class Runner
+{
+public:
+    static Result Run(const Benchmark &bm, const std::vector<int64_t> &args,
+                      const std::string &name, double minTime)
+    {
+        Result res = {};
+        int64_t iterations = 1;
+
+        res.name = name;
+
+        for (;;)
+        {
+            State state(iterations, args);
+
+            bm.m_fn(state);
+            if (state.m_bRunning)
+                state.StopTimer();
+
+            if (!state.m_error.empty() || !state.m_skipped.empty())
+            {
+                res.error = state.m_error;
+                res.skipped = state.m_skipped;
+                return res;
+            }
+
+            const double measured = bm.m_bUseRealTime ? state.m_realTime : state.m_cpuTime;
+
+            if (measured >= minTime || iterations >= MaxIterations)
+            {
+                const double n = (double)std::max<int64_t>(state.m_iterations, 1);
+
+                res.iterations = state.m_iterations;
+                res.realTime = state.m_realTime * 1e9 / n;
+                res.cpuTime = state.m_cpuTime * 1e9 / n;
+                if (measured > 0)
+                {
+                    res.bytesPerSecond = state.m_bytes / measured;
+                    res.itemsPerSecond = state.m_items / measured;
+                }
+                res.label = state.m_label;
+                res.counters = state.counters;
+                return res;
+            }
+
+            // aim slightly above the minimal time, jump faster while far from it
+            double multiplier = (measured > 0) ? minTime * 1.4 / measured : 10.;
+            if (measured < minTime * 0.1)
+                multiplier = std::min(multiplier, 10.);
+
+            iterations = std::min<int64_t>(MaxIterations,
+                std::max<int64_t>(iterations + 1, (int64_t)(iterations * multiplier)));
+        }
+    }
+};
+
+State::State(int64_t maxIterations, const std::vector<int64_t> &args)
+    : m_maxIterations(maxIterations)
+    , m_args(args)
+    , m_iterations(0)
+    , m_bRunning(false)
+    , m_cpuStart(0)
+    , m_realTime(0)
+    , m_cpuTime(0)
+    , m_bytes(0)
+    , m_items(0)
+{
+}
+
+void State::StartTimer()
+{
+    if (m_bRunning)
+        return;
+
+    m_bRunning = true;
+    m_cpuStart = GetProcessCpuTime();
+    m_realStart = std::chrono::steady_clock::now();
+}
+
+void State::StopTimer()
+{
+    if (!m_bRunning)
+        return;
+
+    std::chrono::duration<double> real = std::chrono::steady_clock::now() - m_realStart;
+    m_realTime += real.count();
+    m_cpuTime += GetProcessCpuTime() - m_cpuStart;
+    m_bRunning = false;
+}
+
+void State::SkipWithError(const char *msg)
+{
+    m_error = msg ? msg : "unknown error";
+    // KeepRunning returns false from now on
+    m_iterations = m_maxIterations;
+}
+
+void State::SkipWithMessage(const char *msg)
+{
+    m_skipped = msg ? msg : "skipped";
+    m_iterations = m_maxIterations;
+}
+
+Benchmark::Benchmark(const char *name, Function fn)
+    : m_name(name)
+    , m_fn(fn)
+    , m_bUseRealTime(false)
+{
+}
+
+Benchmark *Benchmark::Arg(int64_t arg)
+{
+    m_args.push_back({ arg });
+    return this;
+}
+
+Benchmark *Benchmark::Args(const std::vector<int64_t> &args)
+{
+    m_args.push_back(args);
+    return this;
+}
+
+Benchmark *Benchmark::UseRealTime()
+{
+    m_bUseRealTime = true;
+    return this;
+}
+
+Benchmark *RegisterBenchmark(const char *name, Function fn)
+{
+    GetRegistry().emplace_back(new Benchmark(name, fn));
+    return GetRegistry().back().get();
+}
+
+} // namespace mfx_benchmark
+
+using namespace mfx_benchmark;
+
+int main(int argc, char **argv)
+{
+    Options opt;
+
+    for (int i = 1; i < argc; i += 1)
+    {
+        std::string value;
+
+        if (ParseFlag(argv[i], "--benchmark_filter", value))
+        {
+            opt.filter = ("all" == value) ? "." : value;
+        }
+        else if (ParseFlag(argv[i], "--benchmark_min_time", value))
+        {
+            opt.minTime = atof(value.c_str());
+        }
+        else if (ParseFlag(argv[i], "--benchmark_format", value))
+        {
+            opt.bJsonFormat = ("json" == value);
+        }
+        else if (ParseFlag(argv[i], "--benchmark_out_format", value))
+        {
+            opt.bJsonOut = ("json" == value);
+        }
+        else if (ParseFlag(argv[i], "--benchmark_out", value))
+        {
+            opt.out = value;
+        }
+        else if (ParseFlag(argv[i], "--benchmark_list_tests", value))
+        {
+            opt.bList = ("true" == value);
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+
+    std::regex filter;
+    try
+    {
+        filter = std::regex(opt.filter);
+    }
+    catch (const std::regex_error &)
+    {
+        fprintf(stderr, "Invalid --benchmark_filter: %s\n", opt.filter.c_str());
+        return 1;
+    }
+
+    // expand the cases with their arguments
+    std::vector<std::pair<const Benchmark *, std::vector<int64_t>>> cases;
+    std::vector<std::string> names;
+    size_t nameWidth = 10;
+
+    for (auto &bm : GetRegistry())
+    {
+        std::vector<std::vector<int64_t>> argSets = bm->ArgSets();
+        if (argSets.empty())
+            argSets.push_back({});
+
+        for (auto &args : argSets)
+        {
+            std::string name = bm->Name();
+            for (int64_t arg : args)
+                name += "/" + std::to_string(arg);
+            if (bm->IsRealTime())
+                name += "/real_time";
+
+            if (!std::regex_search(name, filter))
+                continue;
+
+            cases.emplace_back(bm.get(), args);
+            names.push_back(name);
+            nameWidth = std::max(nameWidth, name.size());
+        }
+    }
+
+    if (opt.bList)
+    {
+        for (auto &name : names)
+            printf("%s\n", name.c_str());
+        return 0;
+    }
+
+    std::vector<Result> results;
+
+    if (!opt.bJsonFormat)
+        WriteConsoleHeader(stdout, nameWidth);
+
+    for (size_t i = 0; i < cases.size(); i += 1)
+    {
+        results.push_back(Runner::Run(*cases[i].first, cases[i].second, names[i], opt.minTime));
+        if (!opt.bJsonFormat)
+        {
+            WriteConsoleResult(stdout, nameWidth, results.back());
+            fflush(stdout);
+        }
+    }
+
+    if (opt.bJsonFormat)
+        WriteJson(stdout, argv[0], results);
+
+    if (!opt.out.empty())
+    {
+        FILE *f = fopen(opt.out.c_str(), "w");
+        if (!f)
+        {
+            fprintf(stderr, "Can't open %s\n", opt.out.c_str());
+            return 1;
+        }
+
+        if (opt.bJsonOut)
+        {
+            WriteJson(f, argv[0], results);
+        }
+        else
+        {
+            WriteConsoleHeader(f, nameWidth);
+            for (auto &res : results)
+                WriteConsoleResult(f, nameWidth, res);
+        }
+        fclose(f);
+    }
+
+    bool bFailed = std::any_of(results.begin(), results.end(),
+        [](const Result &res) { return !res.error.empty(); });
+
+    return bFailed ? 1 : 0;
+}
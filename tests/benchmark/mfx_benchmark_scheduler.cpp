@@ -0,0 +1,150 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "mfx_benchmark.h"
+
+#include "mfx_common.h"
+#include "mfx_task.h"
+#include "mfx_scheduler_core.h"
+
+#include <atomic>
+
+using namespace mfx_benchmark;
+
+namespace
+{
+
+mfxStatus CountRoutine(void *pState, void *, mfxU32, mfxU32)
+{
+    ((std::atomic<mfxU32> *)pState)->fetch_add(1, std::memory_order_relaxed);
+    return MFX_TASK_DONE;
+}
+
+// the scheduler without a core as created by the session,
+// returns nullptr if it can't be initialized
+MFXIScheduler2 * CreateScheduler(mfxU32 numThreads)
+{
+    MFXIScheduler2 *pScheduler = CreateInterfaceInstance<MFXIScheduler2>(MFXIScheduler2_GUID);
+    if (!pScheduler)
+        return nullptr;
+
+    MFX_SCHEDULER_PARAM2 param;
+    memset(&param, 0, sizeof(param));
+    param.flags = MFX_SCHEDULER_DEFAULT;
+    param.numberOfThreads = numThreads;
+
+    if (MFX_ERR_NONE != pScheduler->Initialize2(&param))
+    {
+        pScheduler->Release();
+        return nullptr;
+    }
+    return pScheduler;
+}
+
+void InitTask(MFX_TASK &task, void *pOwner, std::atomic<mfxU32> &counter)
+{
+    memset(&task, 0, sizeof(task));
+    task.pOwner = pOwner;
+    task.entryPoint.pState = &counter;
+    task.entryPoint.pRoutine = CountRoutine;
+    task.entryPoint.requiredNumThreads = 1;
+    task.entryPoint.pRoutineName = "CountRoutine";
+    task.priority = MFX_PRIORITY_NORMAL;
+    task.threadingPolicy = MFX_TASK_THREADING_INTER;
+}
+
+} // namespace
+
+// latency of one AddTask/Synchronize round trip, the argument is the number of threads
+static void BM_Scheduler_RoundTrip(State &state)
+{
+    MFXIScheduler2 *pScheduler = CreateScheduler((mfxU32)state.range(0));
+    if (!pScheduler)
+    {
+        state.SkipWithError("can't initialize the scheduler");
+        return;
+    }
+
+    std::atomic<mfxU32> counter(0);
+    int owner = 0;
+    MFX_TASK task;
+    InitTask(task, &owner, counter);
+
+    while (state.KeepRunning())
+    {
+        mfxSyncPoint syncp = nullptr;
+        if (MFX_ERR_NONE != pScheduler->AddTask(task, &syncp) ||
+            MFX_ERR_NONE != pScheduler->Synchronize(syncp, 60000))
+        {
+            state.SkipWithError("the task failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    pScheduler->WaitForAllTasksCompletion(&owner);
+    pScheduler->Release();
+}
+MFX_BENCHMARK(BM_Scheduler_RoundTrip)->Arg(1)->Arg(4)->UseRealTime();
+
+// throughput of a chain of dependent tasks synchronized on the last one,
+// like a decode -> vpp -> encode pipeline, the arguments are the number of threads and the chain length
+static void BM_Scheduler_Chain(State &state)
+{
+    MFXIScheduler2 *pScheduler = CreateScheduler((mfxU32)state.range(0));
+    if (!pScheduler)
+    {
+        state.SkipWithError("can't initialize the scheduler");
+        return;
+    }
+
+    const mfxU32 length = (mfxU32)state.range(1);
+    std::atomic<mfxU32> counter(0);
+    int owner = 0;
+    std::vector<char> dependencies(length);
+
+    while (state.KeepRunning())
+    {
+        mfxSyncPoint syncp = nullptr;
+        bool bFailed = false;
+
+        for (mfxU32 i = 0; i < length && !bFailed; i += 1)
+        {
+            MFX_TASK task;
+            InitTask(task, &owner, counter);
+            task.pSrc[0] = i ? &dependencies[i - 1] : nullptr;
+            task.pDst[0] = &dependencies[i];
+
+            bFailed = MFX_ERR_NONE != pScheduler->AddTask(task, &syncp);
+        }
+
+        if (bFailed || MFX_ERR_NONE != pScheduler->Synchronize(syncp, 60000))
+        {
+            state.SkipWithError("the task failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+
+    pScheduler->WaitForAllTasksCompletion(&owner);
+    pScheduler->Release();
+}
+MFX_BENCHMARK(BM_Scheduler_Chain)->Args({ 1, 3 })->Args({ 4, 3 })->Args({ 4, 16 })->UseRealTime();
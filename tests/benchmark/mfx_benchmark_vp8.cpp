@@ -0,0 +1,175 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_benchmark.h"
+
+#include "mfx_common.h"
+
+#if defined(MFX_ENABLE_VP8_VIDEO_DECODE_HW)
+
+#include "mfx_vp8_dec_decode_hw.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace mfx_benchmark;
+
+namespace
+{
+
+const mfxU32 IvfFileHeaderSize  = 32;
+const mfxU32 IvfFrameHeaderSize = 12;
+const mfxU32 KeyFrameInterval   = 30;
+
+void PutLE16(std::vector<mfxU8> &buf, mfxU32 value)
+{
+    buf.push_back((mfxU8)value);
+    buf.push_back((mfxU8)(value >> 8));
+}
+
+void PutLE32(std::vector<mfxU8> &buf, mfxU32 value)
+{
+    PutLE16(buf, value);
+    PutLE16(buf, value >> 16);
+}
+
+// IVF file of a WebRTC like stream: a key frame every second and small inter frames.
+// The first partition is all zeros which the bool decoder reads as a valid header
+// without updates, the token partition is filler.
+std::vector<mfxU8> MakeIvfStream(mfxU32 width, mfxU32 height, mfxU32 numFrames)
+{
+    const mfxU32 firstPartitionSize = 256;
+    const mfxU32 keyFrameSize = width * height / 24;
+    const mfxU32 interFrameSize = width * height / 160;
+
+    std::vector<mfxU8> ivf;
+    ivf.reserve(IvfFileHeaderSize + numFrames * (IvfFrameHeaderSize + interFrameSize) + keyFrameSize * (numFrames / KeyFrameInterval + 1));
+
+    ivf.insert(ivf.end(), { 'D', 'K', 'I', 'F' });
+    PutLE16(ivf, 0);                    // version
+    PutLE16(ivf, IvfFileHeaderSize);
+    ivf.insert(ivf.end(), { 'V', 'P', '8', '0' });
+    PutLE16(ivf, width);
+    PutLE16(ivf, height);
+    PutLE32(ivf, 30);                   // frame rate
+    PutLE32(ivf, 1);                    // time scale
+    PutLE32(ivf, numFrames);
+    PutLE32(ivf, 0);
+
+    for (mfxU32 n = 0; n < numFrames; n += 1)
+    {
+        const bool isKey = (n % KeyFrameInterval) == 0;
+        const mfxU32 frameSize = (isKey ? keyFrameSize : interFrameSize) + (n * 131) % 512;
+
+        PutLE32(ivf, frameSize);
+        PutLE32(ivf, n);                // time stamp
+        PutLE32(ivf, 0);
+
+        size_t start = ivf.size();
+
+        // frame tag: frame type, version 0, show frame and the first partition size
+        mfxU32 tag = (isKey ? 0 : 1) | (1 << 4) | (firstPartitionSize << 5);
+        ivf.push_back((mfxU8)tag);
+        ivf.push_back((mfxU8)(tag >> 8));
+        ivf.push_back((mfxU8)(tag >> 16));
+
+        if (isKey)
+        {
+            ivf.insert(ivf.end(), { 0x9d, 0x01, 0x2a });
+            PutLE16(ivf, width);
+            PutLE16(ivf, height);
+        }
+
+        ivf.insert(ivf.end(), firstPartitionSize, 0);
+
+        while (ivf.size() < start + frameSize)
+            ivf.push_back((mfxU8)((ivf.size() * 37) ^ n));
+    }
+
+    return ivf;
+}
+
+// reaches the frame parsing of the decoder, it needs neither a core nor a device
+class VP8FrameParser : public VideoDECODEVP8_HW
+{
+public:
+    VP8FrameParser()
+        : VideoDECODEVP8_HW(nullptr, nullptr)
+    {}
+
+    mfxStatus ParseFrame(mfxBitstream &in, mfxBitstream &frame)
+    {
+        VP8DecodeCommon::IVF_FRAME ivfFrame = {};
+
+        mfxStatus sts = ConstructFrame(&in, &frame, ivfFrame);
+        if (MFX_ERR_NONE != sts)
+            return sts;
+
+        return DecodeFrameHeader(&frame);
+    }
+};
+
+} // namespace
+
+// per frame work of the decoder on the CPU: frames of an IVF file are parsed in place
+// and their partitions are copied once, to the buffer standing for the driver one
+static void BM_VP8_ParseFrames(State &state)
+{
+    const mfxU32 width = (mfxU32)state.range(0), height = (mfxU32)state.range(1);
+    const mfxU32 numFrames = 300;
+    std::vector<mfxU8> ivf = MakeIvfStream(width, height, numFrames);
+    std::vector<mfxU8> sliceData(width * height);
+
+    VP8FrameParser parser;
+
+    while (state.KeepRunning())
+    {
+        size_t pos = IvfFileHeaderSize;
+
+        while (pos + IvfFrameHeaderSize <= ivf.size())
+        {
+            mfxU32 frameSize = ivf[pos] | (ivf[pos + 1] << 8) | (ivf[pos + 2] << 16) | (ivf[pos + 3] << 24);
+            pos += IvfFrameHeaderSize;
+
+            mfxBitstream in = {}, frame = {};
+            in.Data = ivf.data() + pos;
+            in.DataLength = in.MaxLength = frameSize;
+
+            if (MFX_ERR_NONE != parser.ParseFrame(in, frame))
+            {
+                state.SkipWithError("can't parse the frame");
+                return;
+            }
+
+            // the decoder submits the data past the uncompressed chunk
+            mfxU32 offset = (frame.Data[0] & 1) ? 3 : 10;
+            std::copy(frame.Data + offset, frame.Data + frame.DataLength, sliceData.data());
+            ClobberMemory();
+
+            pos += frameSize;
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * (ivf.size() - IvfFileHeaderSize - numFrames * IvfFrameHeaderSize));
+    state.SetItemsProcessed(state.iterations() * numFrames);
+}
+MFX_BENCHMARK(BM_VP8_ParseFrames)->Args({ 640, 480 })->Args({ 1280, 720 })->Args({ 1920, 1080 });
+
+#endif // MFX_ENABLE_VP8_VIDEO_DECODE_HW
@@ -0,0 +1,85 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "fast_copy_c_impl.h"
+#include "fast_copy_sse4_impl.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+
+typedef void (*RowCopy)(const mfxU8* src, mfxU8* dst, int width);
+
+const int Guard = 64;
+
+// copies a row starting at every offset from a 16-byte boundary and checks
+// that exactly width bytes reach dst and nothing around them is touched
+void CheckRowCopy(RowCopy copy, int width)
+{
+    alignas(16) mfxU8 src[Guard + 16 + 256 + Guard];
+    for (size_t i = 0; i < sizeof(src); i++)
+        src[i] = mfxU8(i * 7 + 1);
+
+    for (int offset = 0; offset < 16; offset++)
+    {
+        std::vector<mfxU8> dst(Guard + width + Guard, 0xcd);
+
+        copy(src + Guard + offset, dst.data() + Guard, width);
+
+        for (int i = 0; i < Guard; i++)
+        {
+            ASSERT_EQ(0xcd, dst[i]) << "offset " << offset << ", byte before dst " << Guard - i;
+            ASSERT_EQ(0xcd, dst[Guard + width + i]) << "offset " << offset << ", byte past dst " << i;
+        }
+        for (int i = 0; i < width; i++)
+            ASSERT_EQ(src[Guard + offset + i], dst[Guard + i]) << "offset " << offset << ", byte " << i;
+    }
+}
+
+} // namespace
+
+TEST(FastCopy, VideoToSysCShortRows)
+{
+    for (int width = 0; width < 16; width++)
+        CheckRowCopy(copyVideoToSys_C, width);
+}
+
+// rows shorter than the distance to the next aligned address,
+// e.g. short NAL units copied out of the coded buffer
+TEST(FastCopy, VideoToSysSSE4ShortRows)
+{
+    if (!__builtin_cpu_supports("sse4.1"))
+        return;
+
+    for (int width = 0; width < 16; width++)
+        CheckRowCopy(copyVideoToSys_SSE4, width);
+}
+
+TEST(FastCopy, VideoToSysSSE4Rows)
+{
+    if (!__builtin_cpu_supports("sse4.1"))
+        return;
+
+    for (int width = 16; width <= 256; width++)
+        CheckRowCopy(copyVideoToSys_SSE4, width);
+}
@@ -0,0 +1,208 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_common.h"
+#include "mfx_mfe_adapter.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The adapter only needs the multi-frame context calls of VA, the frames are
+// submitted through the function set by SetSubmitFunction.
+VAStatus vaCreateMFContext(VADisplay, VAMFContextID *mf_context)
+{
+    *mf_context = 1;
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaMFAddContext(VADisplay, VAMFContextID, VAContextID)
+{
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaMFReleaseContext(VADisplay, VAMFContextID, VAContextID)
+{
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaDestroyContext(VADisplay, VAContextID)
+{
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaMFSubmit(VADisplay, VAMFContextID, VAContextID *, int)
+{
+    ADD_FAILURE() << "vaMFSubmit is called instead of the test function";
+    return VA_STATUS_ERROR_UNIMPLEMENTED;
+}
+
+namespace
+{
+
+const VADisplay DISPLAY = (VADisplay)1;
+
+// a frame interval no test is going to wait for, us
+const long long LONG_BUDGET = 10 * 1000 * 1000;
+
+// batches seen by the "driver"
+std::mutex                            g_guard;
+std::vector<std::vector<VAContextID>> g_batches;
+VAStatus                              g_submitStatus;
+
+VAStatus FakeSubmit(VADisplay, VAMFContextID, VAContextID *contexts, int num_contexts)
+{
+    std::lock_guard<std::mutex> lock(g_guard);
+    g_batches.push_back(std::vector<VAContextID>(contexts, contexts + num_contexts));
+    return g_submitStatus;
+}
+
+class MFEAdapter : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        g_batches.clear();
+        g_submitStatus = VA_STATUS_SUCCESS;
+
+        mfxExtMultiFrameParam par = {};
+        par.MaxNumFrames = 3;
+        ASSERT_EQ(MFX_ERR_NONE, m_mfe.Create(par, DISPLAY));
+        m_mfe.SetSubmitFunction(&FakeSubmit);
+    }
+
+    // Submit of every stream from a thread of its own, as encoders do
+    std::vector<mfxStatus> SubmitTogether(std::vector<VAContextID> const & contexts, long long timeToWait)
+    {
+        std::vector<mfxStatus> sts(contexts.size(), MFX_ERR_UNKNOWN);
+        std::vector<std::thread> threads;
+
+        for (size_t i = 0; i < contexts.size(); i++)
+            threads.emplace_back([&, i] { sts[i] = m_mfe.Submit(contexts[i], timeToWait, false); });
+
+        for (std::thread & t : threads)
+            t.join();
+
+        return sts;
+    }
+
+    MFEVAAPIEncoder m_mfe;
+};
+
+long long ElapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// All joined streams bring a frame: the batch is submitted as soon as it is
+// full, nobody waits for the deadline.
+TEST_F(MFEAdapter, FullBatchIsSubmittedAtOnce)
+{
+    for (VAContextID ctx : { 10, 11, 12 })
+        ASSERT_EQ(MFX_ERR_NONE, m_mfe.Join(ctx, LONG_BUDGET));
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<mfxStatus> sts = SubmitTogether({ 10, 11, 12 }, LONG_BUDGET);
+    EXPECT_LT(ElapsedUs(start), LONG_BUDGET / 2);
+
+    for (mfxStatus s : sts)
+        EXPECT_EQ(MFX_ERR_NONE, s);
+
+    ASSERT_EQ(1u, g_batches.size());
+    EXPECT_EQ(3u, g_batches[0].size());
+
+    MFEBatchPolicy::Statistics stats = m_mfe.GetStatistics();
+    EXPECT_EQ(1u, stats.numBatches);
+    EXPECT_EQ(3u, stats.numFrames);
+    EXPECT_EQ(1u, stats.numFullBatches);
+    EXPECT_EQ(0u, stats.numDeadlineBatches);
+    EXPECT_EQ(1u, stats.batchSizes[3]);
+}
+
+// A stream expected to join the batch doesn't come: the frames collected
+// are submitted when the budget of the first one runs out.
+TEST_F(MFEAdapter, PartialBatchIsSubmittedOnDeadline)
+{
+    const long long budget = 20 * 1000;
+
+    ASSERT_EQ(MFX_ERR_NONE, m_mfe.Join(10, budget));
+    ASSERT_EQ(MFX_ERR_NONE, m_mfe.Join(11, budget));
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(MFX_ERR_NONE, m_mfe.Submit(10, budget, false));
+    long long elapsed = ElapsedUs(start);
+
+    EXPECT_GE(elapsed, budget);
+    EXPECT_LT(elapsed, LONG_BUDGET / 2);
+
+    ASSERT_EQ(1u, g_batches.size());
+    ASSERT_EQ(1u, g_batches[0].size());
+    EXPECT_EQ(10u, g_batches[0][0]);
+
+    MFEBatchPolicy::Statistics stats = m_mfe.GetStatistics();
+    EXPECT_EQ(1u, stats.numBatches);
+    EXPECT_EQ(0u, stats.numFullBatches);
+    EXPECT_EQ(1u, stats.numDeadlineBatches);
+    EXPECT_GE(stats.maxWaitTime, (mfxU64)budget);
+}
+
+// A skipped frame doesn't hold the batch, the other streams fill it.
+TEST_F(MFEAdapter, SkippedFrameIsNotWaitedFor)
+{
+    ASSERT_EQ(MFX_ERR_NONE, m_mfe.Join(10, LONG_BUDGET));
+    ASSERT_EQ(MFX_ERR_NONE, m_mfe.Join(11, LONG_BUDGET));
+    ASSERT_EQ(MFX_ERR_NONE, m_mfe.Join(12, LONG_BUDGET));
+
+    EXPECT_EQ(MFX_ERR_NONE, m_mfe.Submit(12, LONG_BUDGET, true));
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<mfxStatus> sts = SubmitTogether({ 10, 11 }, LONG_BUDGET);
+    EXPECT_LT(ElapsedUs(start), LONG_BUDGET / 2);
+
+    for (mfxStatus s : sts)
+        EXPECT_EQ(MFX_ERR_NONE, s);
+
+    ASSERT_EQ(1u, g_batches.size());
+    EXPECT_EQ(2u, g_batches[0].size());
+}
+
+// The driver refuses the batch: every stream of it gets the error.
+TEST_F(MFEAdapter, FailedSubmissionIsReported)
+{
+    g_submitStatus = VA_STATUS_ERROR_OPERATION_FAILED;
+
+    ASSERT_EQ(MFX_ERR_NONE, m_mfe.Join(10, LONG_BUDGET));
+    ASSERT_EQ(MFX_ERR_NONE, m_mfe.Join(11, LONG_BUDGET));
+
+    std::vector<mfxStatus> sts = SubmitTogether({ 10, 11 }, LONG_BUDGET);
+
+    for (mfxStatus s : sts)
+        EXPECT_EQ(MFX_ERR_DEVICE_FAILED, s);
+
+    MFEBatchPolicy::Statistics stats = m_mfe.GetStatistics();
+    EXPECT_EQ(0u, stats.numBatches);
+    EXPECT_EQ(1u, stats.numFailedBatches);
+}
@@ -0,0 +1,209 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_scheduler_core.h"
+#include "mfx_ext_buffers.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+const mfxU32 NUM_TASKS = 64;
+const mfxU32 SYNC_TIMEOUT = 10000;
+
+// records the threads executing the tasks of all sessions
+struct TaskLog
+{
+    std::mutex guard;
+    std::set<std::thread::id> threads;
+    std::atomic<mfxU32> numDone{0};
+};
+
+mfxStatus RecordThread(void *pState, void *, mfxU32, mfxU32)
+{
+    TaskLog *pLog = (TaskLog *) pState;
+
+    {
+        std::lock_guard<std::mutex> guard(pLog->guard);
+        pLog->threads.insert(std::this_thread::get_id());
+    }
+    pLog->numDone += 1;
+
+    return MFX_TASK_DONE;
+}
+
+MFX_SCHEDULER_PARAM2 MakeParam(mfxU16 numThread)
+{
+    MFX_SCHEDULER_PARAM2 param = {};
+
+    param.flags = MFX_SCHEDULER_SHARED_POOL;
+    // the number of threads the session would create by itself
+    param.numberOfThreads = 4;
+    param.params.NumThread = numThread;
+
+    return param;
+}
+
+// scheduler of a session joining the shared pool
+class Session
+{
+public:
+    Session() : m_pScheduler(new mfxSchedulerCore) {}
+    ~Session() { Close(); }
+
+    mfxStatus Init(const MFX_SCHEDULER_PARAM2 &param) { return m_pScheduler->Initialize2(&param); }
+
+    // the session leaves the pool with the last reference to its scheduler
+    void Close()
+    {
+        if (m_pScheduler)
+            m_pScheduler->Release();
+        m_pScheduler = nullptr;
+    }
+
+    mfxU32 GetNumThreads()
+    {
+        MFX_SCHEDULER_PARAM param = {};
+        m_pScheduler->GetParam(&param);
+        return param.numberOfThreads;
+    }
+
+    // queues independent tasks and waits for all of them
+    void RunTasks(TaskLog &log, mfxTaskThreadingPolicy policy)
+    {
+        std::vector<mfxSyncPoint> syncPoints(NUM_TASKS);
+
+        for (mfxU32 i = 0; i < NUM_TASKS; i++)
+        {
+            MFX_TASK task = {};
+            task.pOwner = this;
+            task.entryPoint.pState = &log;
+            task.entryPoint.pRoutine = &RecordThread;
+            task.entryPoint.requiredNumThreads = 1;
+            task.priority = MFX_PRIORITY_NORMAL;
+            task.threadingPolicy = policy;
+
+            ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->AddTask(task, &syncPoints[i]));
+        }
+
+        for (mfxSyncPoint syncPoint : syncPoints)
+            ASSERT_EQ(MFX_ERR_NONE, m_pScheduler->Synchronize(syncPoint, SYNC_TIMEOUT));
+    }
+
+private:
+    mfxSchedulerCore *m_pScheduler;
+};
+
+}
+
+TEST(SchedulerPool, SessionsRunTasksOnSharedThreads)
+{
+    TaskLog log;
+    Session s1, s2;
+
+    ASSERT_EQ(MFX_ERR_NONE, s1.Init(MakeParam(3)));
+    ASSERT_EQ(MFX_ERR_NONE, s2.Init(MakeParam(0)));
+
+    // the second session takes the pool as it is
+    EXPECT_EQ(3u, s1.GetNumThreads());
+    EXPECT_EQ(3u, s2.GetNumThreads());
+
+    std::thread t1([&] { s1.RunTasks(log, MFX_TASK_THREADING_INTER); });
+    std::thread t2([&] { s2.RunTasks(log, MFX_TASK_THREADING_DEDICATED); });
+    t1.join();
+    t2.join();
+
+    EXPECT_EQ(2 * NUM_TASKS, log.numDone);
+    // sessions don't spawn threads of their own
+    EXPECT_LE(log.threads.size(), 3u);
+
+    s1.Close();
+    s2.Close();
+}
+
+TEST(SchedulerPool, SessionKeepsRunningAfterOtherLeaves)
+{
+    TaskLog log;
+    Session s1, s2;
+
+    ASSERT_EQ(MFX_ERR_NONE, s1.Init(MakeParam(2)));
+    ASSERT_EQ(MFX_ERR_NONE, s2.Init(MakeParam(2)));
+
+    s1.RunTasks(log, MFX_TASK_THREADING_INTER);
+    s1.Close();
+
+    s2.RunTasks(log, MFX_TASK_THREADING_INTER);
+    EXPECT_EQ(2 * NUM_TASKS, log.numDone);
+
+    s2.Close();
+}
+
+TEST(SchedulerPool, JoinWithOtherNumberOfThreadsIsRejected)
+{
+    Session s1, s2, s3;
+
+    ASSERT_EQ(MFX_ERR_NONE, s1.Init(MakeParam(2)));
+
+    EXPECT_EQ(MFX_ERR_INCOMPATIBLE_VIDEO_PARAM, s2.Init(MakeParam(3)));
+    EXPECT_EQ(MFX_ERR_NONE, s3.Init(MakeParam(2)));
+
+    s3.Close();
+    s2.Close();
+    s1.Close();
+}
+
+TEST(SchedulerPool, JoinWithOtherPlacementIsRejected)
+{
+    Session s1, s2;
+    MFX_SCHEDULER_PARAM2 param = MakeParam(0);
+
+    ASSERT_EQ(MFX_ERR_NONE, s1.Init(param));
+
+    param.affinityPolicy = MFX_THREADS_AFFINITY_COMPACT;
+    EXPECT_EQ(MFX_ERR_INCOMPATIBLE_VIDEO_PARAM, s2.Init(param));
+
+    s2.Close();
+    s1.Close();
+}
+
+TEST(SchedulerPool, LastSessionLeavingDestroysThePool)
+{
+    TaskLog log;
+    Session s1, s2;
+
+    ASSERT_EQ(MFX_ERR_NONE, s1.Init(MakeParam(2)));
+    s1.Close();
+
+    // no session holds the pool, a new one is created with other threads
+    ASSERT_EQ(MFX_ERR_NONE, s2.Init(MakeParam(3)));
+    EXPECT_EQ(3u, s2.GetNumThreads());
+
+    s2.RunTasks(log, MFX_TASK_THREADING_INTER);
+    EXPECT_EQ(NUM_TASKS, log.numDone);
+
+    s2.Close();
+}
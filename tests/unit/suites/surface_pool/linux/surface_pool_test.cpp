@@ -0,0 +1,175 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_surface_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// surfaces of the tests are never written by a component,
+// so the pool has nothing to wait for
+mfxStatus MFXVideoCORE_SyncOperation(mfxSession, mfxSyncPoint, mfxU32)
+{
+    return MFX_ERR_NONE;
+}
+
+namespace
+{
+
+const mfxSession SESSION = (mfxSession)1;
+const int NUM_ITERATIONS = 2000;
+
+mfxFrameInfo MakeInfo(mfxU16 width)
+{
+    mfxFrameInfo info = {};
+    info.FourCC       = MFX_FOURCC_NV12;
+    info.ChromaFormat = MFX_CHROMAFORMAT_YUV420;
+    info.Width        = width;
+    info.Height       = 64;
+    return info;
+}
+
+mfxStatus ReleaseSurface(mfxFrameSurface1 * surface)
+{
+    return (*surface->FrameInterface->Release)(surface);
+}
+
+// gives the tests the guard and the trimming of the pool
+class TestSurfacePool : public mfxSurfacePool
+{
+public:
+    TestSurfacePool()
+        : mfxSurfacePool(SESSION, MFX_MEMTYPE_FROM_DECODE, -1)
+    {}
+
+    std::mutex & Guard() { return m_guard; }
+
+    // frees all idle surfaces, the guard must be held
+    mfxU32 TrimIdle() { return Trim(0); }
+};
+
+}
+
+TEST(SurfacePool, ReleasedSurfaceIsReused)
+{
+    mfxSurfacePoolSet pools;
+    const mfxFrameInfo info = MakeInfo(64);
+    mfxFrameSurface1 *s1 = NULL, *s2 = NULL;
+
+    ASSERT_EQ(MFX_ERR_NONE, pools.GetSurface(SESSION, MFX_MEMTYPE_FROM_DECODE, -1, info, &s1));
+    EXPECT_EQ(MFX_ERR_NONE, ReleaseSurface(s1));
+    EXPECT_EQ(MFX_ERR_UNDEFINED_BEHAVIOR, ReleaseSurface(s1));
+
+    ASSERT_EQ(MFX_ERR_NONE, pools.GetSurface(SESSION, MFX_MEMTYPE_FROM_DECODE, -1, info, &s2));
+    EXPECT_EQ(s1, s2);
+    EXPECT_EQ(MFX_ERR_NONE, ReleaseSurface(s2));
+}
+
+// The last reference is dropped while the pool is trimmed: the surface
+// must not be freed under the releasing thread.
+TEST(SurfacePool, ReleaseRacesTrim)
+{
+    TestSurfacePool *pool = new TestSurfacePool;
+    const mfxFrameInfo info = MakeInfo(64);
+    mfxFrameSurface1 *surface = NULL;
+    mfxU32 numFreed = 0;
+
+    ASSERT_EQ(MFX_ERR_NONE, pool->GetSurface(info, &surface));
+
+    std::thread app;
+    {
+        std::lock_guard<std::mutex> guard(pool->Guard());
+
+        // the release is waiting for the guard when the pool is trimmed
+        app = std::thread([surface] { EXPECT_EQ(MFX_ERR_NONE, ReleaseSurface(surface)); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        numFreed = pool->TrimIdle();
+    }
+    app.join();
+
+    EXPECT_EQ(0u, numFreed);
+    while (numFreed--)
+        pool->Release();
+
+    mfxFrameSurface1 *reused = NULL;
+    ASSERT_EQ(MFX_ERR_NONE, pool->GetSurface(info, &reused));
+    EXPECT_EQ(surface, reused);
+    EXPECT_EQ(MFX_ERR_NONE, ReleaseSurface(reused));
+
+    pool->Detach();
+}
+
+// Getting a surface of another size trims the idle surfaces of the pool
+// while other threads drop the last references to their surfaces.
+TEST(SurfacePool, ReleaseRacesResize)
+{
+    mfxSurfacePoolSet pools;
+
+    auto loop = [&pools](mfxU16 width)
+    {
+        const mfxFrameInfo info = MakeInfo(width);
+
+        for (int i = 0; i < NUM_ITERATIONS; i++)
+        {
+            mfxFrameSurface1 *surface = NULL;
+            ASSERT_EQ(MFX_ERR_NONE, pools.GetSurface(SESSION, MFX_MEMTYPE_FROM_DECODE, -1, info, &surface));
+            ASSERT_EQ(MFX_ERR_NONE, (*surface->FrameInterface->AddRef)(surface));
+            ASSERT_EQ(MFX_ERR_NONE, ReleaseSurface(surface));
+            ASSERT_EQ(MFX_ERR_NONE, ReleaseSurface(surface));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (mfxU16 width : { 64, 128, 64, 128 })
+        threads.emplace_back(loop, width);
+
+    for (std::thread & t : threads)
+        t.join();
+}
+
+// Closing of the session frees the idle surfaces while the application
+// releases the ones it holds.
+TEST(SurfacePool, ReleaseRacesDetach)
+{
+    const mfxFrameInfo info = MakeInfo(64);
+
+    for (int i = 0; i < NUM_ITERATIONS / 10; i++)
+    {
+        mfxSurfacePoolSet *pools = new mfxSurfacePoolSet;
+        std::vector<mfxFrameSurface1 *> surfaces(16);
+
+        for (mfxFrameSurface1 *& surface : surfaces)
+            ASSERT_EQ(MFX_ERR_NONE, pools->GetSurface(SESSION, MFX_MEMTYPE_FROM_DECODE, -1, info, &surface));
+
+        std::thread app([&surfaces]
+        {
+            for (mfxFrameSurface1 *surface : surfaces)
+                EXPECT_EQ(MFX_ERR_NONE, ReleaseSurface(surface));
+        });
+
+        delete pools;
+        app.join();
+    }
+}
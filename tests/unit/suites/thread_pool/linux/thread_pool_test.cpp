@@ -0,0 +1,127 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "umc_thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+// every index is run exactly once, on the workers and the caller
+void CheckAllIndicesRun(UMC::ThreadPool & pool, uint32_t numTasks)
+{
+    std::vector<std::atomic<uint32_t>> runs(numTasks);
+    for (auto & r : runs)
+        r = 0;
+
+    pool.ParallelFor(numTasks, [&runs](uint32_t i) { runs[i]++; });
+
+    for (uint32_t i = 0; i < numTasks; i++)
+        EXPECT_EQ(1u, runs[i].load()) << "index " << i;
+}
+
+}
+
+TEST(ThreadPool, RunsEveryIndexOnce)
+{
+    UMC::ThreadPool pool(3);
+    EXPECT_EQ(4u, pool.GetNumThreads());
+
+    for (uint32_t n : { 0u, 1u, 2u, 4u, 7u, 64u })
+        CheckAllIndicesRun(pool, n);
+}
+
+TEST(ThreadPool, CallerTakesPart)
+{
+    UMC::ThreadPool pool(1);
+
+    std::thread::id caller = std::this_thread::get_id();
+    std::set<std::thread::id> threads;
+    std::mutex guard;
+
+    pool.ParallelFor(16, [&](uint32_t)
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        threads.insert(std::this_thread::get_id());
+    });
+
+    EXPECT_NE(threads.end(), threads.find(caller));
+    EXPECT_LE(threads.size(), 2u);
+}
+
+TEST(ThreadPool, UsesWorkers)
+{
+    UMC::ThreadPool pool(2);
+
+    std::atomic<uint32_t> inside(0);
+    std::atomic<uint32_t> peak(0);
+
+    // tasks wait for each other, so they can complete only when run concurrently
+    pool.ParallelFor(3, [&](uint32_t)
+    {
+        uint32_t n = ++inside;
+        uint32_t p = peak;
+        while (n > p && !peak.compare_exchange_weak(p, n))
+            ;
+        while (peak < 3)
+            std::this_thread::yield();
+    });
+
+    EXPECT_EQ(3u, peak.load());
+}
+
+TEST(ThreadPool, ConcurrentCallers)
+{
+    UMC::ThreadPool pool(4);
+
+    std::vector<std::thread> callers;
+    for (int c = 0; c < 4; c++)
+    {
+        callers.emplace_back([&pool]
+        {
+            for (int k = 0; k < 200; k++)
+                CheckAllIndicesRun(pool, 1 + k % 9);
+        });
+    }
+
+    for (auto & t : callers)
+        t.join();
+}
+
+TEST(ThreadPool, NestedJobs)
+{
+    UMC::ThreadPool pool(2);
+
+    std::atomic<uint32_t> runs(0);
+
+    pool.ParallelFor(3, [&](uint32_t)
+    {
+        pool.ParallelFor(3, [&](uint32_t) { runs++; });
+    });
+
+    EXPECT_EQ(9u, runs.load());
+}
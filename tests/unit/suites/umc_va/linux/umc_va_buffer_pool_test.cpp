@@ -0,0 +1,386 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "umc_va_linux_buffer_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace UMC;
+
+namespace
+{
+
+// keeps the buffers in memory and counts the calls,
+// surfaces are decoded unless a test says they're still rendering
+class FakeBackend : public VABufferBackend
+{
+public:
+    FakeBackend()
+        : created(0)
+        , mapped(0)
+        , destroyed(0)
+        , queried(0)
+        , failCreate(false)
+        , m_nextId(1)
+    {}
+
+    virtual VAStatus CreateBuffer(VABufferType, uint32_t size, uint32_t numElements, VABufferID* id)
+    {
+        if (failCreate)
+            return VA_STATUS_ERROR_ALLOCATION_FAILED;
+
+        *id = m_nextId++;
+        m_buffers[*id].resize(size * numElements);
+        ++created;
+        return VA_STATUS_SUCCESS;
+    }
+
+    virtual VAStatus MapBuffer(VABufferID id, void** ptr)
+    {
+        auto it = m_buffers.find(id);
+        if (it == m_buffers.end())
+            return VA_STATUS_ERROR_INVALID_BUFFER;
+
+        *ptr = it->second.data();
+        ++mapped;
+        return VA_STATUS_SUCCESS;
+    }
+
+    virtual VAStatus DestroyBuffer(VABufferID id)
+    {
+        if (!m_buffers.erase(id))
+            return VA_STATUS_ERROR_INVALID_BUFFER;
+
+        ++destroyed;
+        return VA_STATUS_SUCCESS;
+    }
+
+    virtual VAStatus QuerySurfaceStatus(VASurfaceID surface, VASurfaceStatus* status)
+    {
+        if (surface == VA_INVALID_SURFACE)
+            return VA_STATUS_ERROR_INVALID_SURFACE;
+
+        *status = m_rendering.count(surface) ? VASurfaceRendering : VASurfaceReady;
+        ++queried;
+        return VA_STATUS_SUCCESS;
+    }
+
+    void SetRendering(VASurfaceID surface, bool bRendering)
+    {
+        if (bRendering)
+            m_rendering.insert(surface);
+        else
+            m_rendering.erase(surface);
+    }
+
+    size_t Alive() const { return m_buffers.size(); }
+
+    int  created;
+    int  mapped;
+    int  destroyed;
+    int  queried;
+    bool failCreate;
+
+private:
+    VABufferID m_nextId;
+    std::map<VABufferID, std::vector<uint8_t>> m_buffers;
+    std::set<VASurfaceID> m_rendering;
+};
+
+const uint32_t PicParamSize = 256;
+const VASurfaceID Surface   = 1;
+
+} // namespace
+
+TEST(VABufferPool, CreatesBufferOnFirstAcquire)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend);
+
+    VABufferPool::Buffer buffer = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, buffer));
+
+    EXPECT_NE(nullptr, buffer.ptr);
+    EXPECT_EQ(PicParamSize, buffer.size);
+    EXPECT_EQ(1u, buffer.numElements);
+    EXPECT_EQ(1, backend.created);
+    EXPECT_EQ(1u, pool.GetNumBuffers());
+    EXPECT_EQ(0u, pool.GetNumFree());
+}
+
+TEST(VABufferPool, ReusesBufferWhenSurfaceIsDecoded)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend);
+
+    VABufferPool::Buffer first = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, first));
+    backend.SetRendering(Surface, true);
+    pool.Release(first.id, Surface);
+    pool.NextFrame();
+
+    // the device may still read the buffer of the previous frame
+    VABufferPool::Buffer second = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, second));
+    EXPECT_NE(first.id, second.id);
+    pool.Release(second.id, Surface + 1);
+    pool.NextFrame();
+
+    // however many frames later
+    for (int frame = 0; frame < 8; ++frame)
+    {
+        VABufferPool::Buffer next = {};
+        ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, next));
+        EXPECT_EQ(second.id, next.id);
+        pool.Release(next.id, Surface + 1);
+        pool.NextFrame();
+    }
+
+    backend.SetRendering(Surface, false);
+
+    VABufferPool::Buffer third = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, third));
+    EXPECT_EQ(first.id, third.id);
+    EXPECT_EQ(2, backend.created);
+    EXPECT_EQ(0, backend.destroyed);
+}
+
+TEST(VABufferPool, SteadyStreamStopsCreatingBuffers)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend);
+
+    // the device is two frames behind
+    const int depth = 2;
+
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        VASurfaceID surface = frame % 8;
+
+        VABufferPool::Buffer pic = {}, slice = {}, data = {};
+        ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, pic));
+        ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceParameterBufferType, 64, 4, slice));
+        ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 10000 + frame * 10, 1, data));
+
+        backend.SetRendering(surface, true);
+        pool.Release(pic.id, surface);
+        pool.Release(slice.id, surface);
+        pool.Release(data.id, surface);
+        pool.NextFrame();
+
+        if (frame >= depth)
+            backend.SetRendering((frame - depth) % 8, false);
+    }
+
+    // the buffers of the frames the device works on and of the one being built
+    EXPECT_EQ(3 * (depth + 1), backend.created);
+    EXPECT_EQ(0, backend.destroyed);
+    EXPECT_EQ(300, backend.mapped);
+}
+
+TEST(VABufferPool, DecodedSurfaceIsQueriedOnce)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend);
+
+    VABufferPool::Buffer pic = {}, slice = {}, data = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, pic));
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceParameterBufferType, 64, 4, slice));
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 10000, 1, data));
+    pool.Release(pic.id, Surface);
+    pool.Release(slice.id, Surface);
+    pool.Release(data.id, Surface);
+    pool.NextFrame();
+
+    VABufferPool::Buffer next = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, next));
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceParameterBufferType, 64, 4, next));
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 10000, 1, next));
+
+    EXPECT_EQ(1, backend.queried);
+    EXPECT_EQ(3, backend.created);
+}
+
+TEST(VABufferPool, BufferOfUnknownSurfaceIsNotReused)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend, false, 1);
+
+    VABufferPool::Buffer first = {}, second = {}, third = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, first));
+    pool.Release(first.id, VA_INVALID_SURFACE);
+    pool.NextFrame();
+
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, second));
+    EXPECT_NE(first.id, second.id);
+
+    // it goes when the pool is trimmed
+    pool.Release(second.id, Surface);
+    EXPECT_EQ(1, backend.destroyed);
+
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, third));
+    EXPECT_EQ(second.id, third.id);
+}
+
+TEST(VABufferPool, MatchesParameterBuffersExactly)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend);
+
+    VABufferPool::Buffer buffer = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceParameterBufferType, 64, 8, buffer));
+    pool.Release(buffer.id, Surface);
+
+    VABufferPool::Buffer fewer = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceParameterBufferType, 64, 4, fewer));
+    EXPECT_NE(buffer.id, fewer.id);
+    EXPECT_EQ(4u, fewer.numElements);
+    pool.Release(fewer.id, Surface);
+
+    VABufferPool::Buffer other = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAIQMatrixBufferType, 64, 8, other));
+    EXPECT_NE(buffer.id, other.id);
+    EXPECT_EQ(3, backend.created);
+}
+
+TEST(VABufferPool, DataBuffersUseSizeClasses)
+{
+    EXPECT_EQ(4096u, VABufferPool::GetSizeClass(1));
+    EXPECT_EQ(4096u, VABufferPool::GetSizeClass(4096));
+    EXPECT_EQ(8192u, VABufferPool::GetSizeClass(4097));
+    EXPECT_EQ(1024u * 1024, VABufferPool::GetSizeClass(600 * 1024));
+    EXPECT_EQ(3u * 1024 * 1024, VABufferPool::GetSizeClass(2 * 1024 * 1024 + 1));
+
+    FakeBackend backend;
+    VABufferPool pool(&backend);
+
+    VABufferPool::Buffer buffer = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 5000, 1, buffer));
+    EXPECT_EQ(8192u, buffer.size);
+    pool.Release(buffer.id, Surface);
+
+    VABufferPool::Buffer smaller = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 100, 1, smaller));
+    EXPECT_EQ(buffer.id, smaller.id);
+    EXPECT_EQ(1, backend.created);
+}
+
+TEST(VABufferPool, GrowingDataBufferReplacesSmallerOnes)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend);
+
+    VABufferPool::Buffer small1 = {}, small2 = {}, large = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 4096, 1, small1));
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 4096, 1, small2));
+    pool.Release(small1.id, Surface);
+
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 100000, 1, large));
+    EXPECT_EQ(131072u, large.size);
+
+    // the free one is gone, the one in use stays
+    EXPECT_EQ(1, backend.destroyed);
+    EXPECT_EQ(2u, pool.GetNumBuffers());
+    pool.Release(small2.id, Surface);
+    pool.Release(large.id, Surface);
+
+    VABufferPool::Buffer next = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 4096, 1, next));
+    EXPECT_EQ(small2.id, next.id);
+}
+
+TEST(VABufferPool, ExactSizeModeDoesNotRoundDataBuffers)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend, true);
+
+    VABufferPool::Buffer buffer = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 5000, 1, buffer));
+    EXPECT_EQ(5000u, buffer.size);
+    pool.Release(buffer.id, Surface);
+
+    VABufferPool::Buffer smaller = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 4000, 1, smaller));
+    EXPECT_NE(buffer.id, smaller.id);
+}
+
+TEST(VABufferPool, TrimsOldestFreeBuffers)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend, false, 2);
+
+    std::vector<VABufferPool::Buffer> buffers(4);
+    for (uint32_t i = 0; i < buffers.size(); ++i)
+        ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize + i, 1, buffers[i]));
+
+    for (auto& buffer : buffers)
+    {
+        pool.Release(buffer.id, Surface);
+        pool.NextFrame();
+    }
+
+    EXPECT_EQ(2u, pool.GetNumFree());
+    EXPECT_EQ(2, backend.destroyed);
+
+    VABufferPool::Buffer newest = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize + 3, 1, newest));
+    EXPECT_EQ(buffers[3].id, newest.id);
+}
+
+TEST(VABufferPool, ResetDestroysAllBuffers)
+{
+    FakeBackend backend;
+    {
+        VABufferPool pool(&backend);
+
+        VABufferPool::Buffer used = {}, released = {};
+        ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, used));
+        ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VASliceDataBufferType, 4096, 1, released));
+        pool.Release(released.id, Surface);
+
+        EXPECT_EQ(VA_STATUS_SUCCESS, pool.Reset());
+        EXPECT_EQ(0u, pool.GetNumBuffers());
+        EXPECT_EQ(0u, backend.Alive());
+
+        ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, used));
+    }
+    // the destructor releases what's left
+    EXPECT_EQ(0u, backend.Alive());
+}
+
+TEST(VABufferPool, DiscardAndFailuresDontLeak)
+{
+    FakeBackend backend;
+    VABufferPool pool(&backend);
+
+    VABufferPool::Buffer buffer = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, buffer));
+    EXPECT_EQ(VA_STATUS_SUCCESS, pool.Discard(buffer.id));
+    EXPECT_EQ(VA_STATUS_ERROR_INVALID_BUFFER, pool.Discard(buffer.id));
+    EXPECT_EQ(0u, backend.Alive());
+
+    backend.failCreate = true;
+    EXPECT_EQ(VA_STATUS_ERROR_ALLOCATION_FAILED, pool.Acquire(VAPictureParameterBufferType, PicParamSize, 1, buffer));
+    EXPECT_EQ(0u, pool.GetNumBuffers());
+}
@@ -0,0 +1,359 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_common.h"
+#include "libmfx_allocator_vaapi.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+const mfxU16 WIDTH  = 16;
+const mfxU16 HEIGHT = 16;
+
+// image buffers and images of the fake driver are numbered after their surfaces
+const VABufferID BUFFER_BASE = 100;
+const VAImageID  IMAGE_BASE  = 200;
+
+// calls seen by the "driver"
+struct Driver
+{
+    std::atomic<int> derive{0};
+    std::atomic<int> destroy{0};
+    std::atomic<int> map{0};
+    std::atomic<int> unmap{0};
+    std::atomic<int> sync{0};
+
+    // vaMapBuffer of this buffer waits until it's reset
+    std::mutex              guard;
+    std::condition_variable changed;
+    VABufferID              blocked = VA_INVALID_ID;
+    bool                    inBlockedMap = false;
+
+    std::vector<mfxU8> pixels = std::vector<mfxU8>(WIDTH * HEIGHT * 3 / 2);
+};
+
+Driver *g_driver;
+
+} // namespace
+
+// The allocator is built from its source, the test provides the VA calls it makes.
+VAStatus vaCreateSurfaces(VADisplay, unsigned int, unsigned int, unsigned int, VASurfaceID *surfaces,
+                          unsigned int num_surfaces, VASurfaceAttrib *, unsigned int)
+{
+    for (unsigned int i = 0; i < num_surfaces; i++)
+        surfaces[i] = i + 1;
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaDestroySurfaces(VADisplay, VASurfaceID *, int)
+{
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaCreateBuffer(VADisplay, VAContextID, VABufferType, unsigned int, unsigned int, void *, VABufferID *)
+{
+    ADD_FAILURE() << "video memory frames don't need buffers";
+    return VA_STATUS_ERROR_UNIMPLEMENTED;
+}
+
+VAStatus vaDestroyBuffer(VADisplay, VABufferID)
+{
+    ADD_FAILURE() << "video memory frames don't need buffers";
+    return VA_STATUS_ERROR_UNIMPLEMENTED;
+}
+
+VAStatus vaDeriveImage(VADisplay, VASurfaceID surface, VAImage *image)
+{
+    *image = {};
+    image->image_id     = IMAGE_BASE + surface;
+    image->buf          = BUFFER_BASE + surface;
+    image->format.fourcc = VA_FOURCC_NV12;
+    image->width        = WIDTH;
+    image->height       = HEIGHT;
+    image->num_planes   = 2;
+    image->pitches[0]   = WIDTH;
+    image->pitches[1]   = WIDTH;
+    image->offsets[1]   = WIDTH * HEIGHT;
+
+    g_driver->derive += 1;
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaDestroyImage(VADisplay, VAImageID)
+{
+    g_driver->destroy += 1;
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaMapBuffer(VADisplay, VABufferID buf, void **pbuf)
+{
+    {
+        std::unique_lock<std::mutex> lock(g_driver->guard);
+        if (buf == g_driver->blocked)
+        {
+            g_driver->inBlockedMap = true;
+            g_driver->changed.notify_all();
+            g_driver->changed.wait(lock, [buf] { return buf != g_driver->blocked; });
+        }
+    }
+
+    *pbuf = g_driver->pixels.data();
+    g_driver->map += 1;
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaUnmapBuffer(VADisplay, VABufferID)
+{
+    g_driver->unmap += 1;
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus vaSyncSurface(VADisplay, VASurfaceID)
+{
+    g_driver->sync += 1;
+    return VA_STATUS_SUCCESS;
+}
+
+namespace
+{
+
+const VADisplay DISPLAY = (VADisplay)1;
+
+class VAAPIAllocator : public ::testing::Test
+{
+protected:
+    VAAPIAllocator()
+        : m_allocator(MFX_MEMTYPE_VIDEO_MEMORY_DECODER_TARGET | MFX_MEMTYPE_INTERNAL_FRAME, DISPLAY)
+    {}
+
+    void SetUp() override
+    {
+        g_driver = &m_driver;
+
+        mfxFrameAllocRequest request = {};
+        request.Info.FourCC       = MFX_FOURCC_NV12;
+        request.Info.Width        = WIDTH;
+        request.Info.Height       = HEIGHT;
+        request.Type              = MFX_MEMTYPE_VIDEO_MEMORY_DECODER_TARGET | MFX_MEMTYPE_INTERNAL_FRAME;
+        request.NumFrameSuggested = 2;
+
+        ASSERT_EQ(MFX_ERR_NONE, Call(m_allocator.frameAllocator.Alloc, &request, &m_response));
+    }
+
+    void TearDown() override
+    {
+        EXPECT_EQ(MFX_ERR_NONE, Call(m_allocator.frameAllocator.Free, &m_response));
+        g_driver = nullptr;
+    }
+
+    // the core passes the allocator as pthis
+    template <class F, class... Args>
+    mfxStatus Call(F f, Args... args)
+    {
+        return f(&m_allocator, args...);
+    }
+
+    mfxStatus Lock(mfxU32 idx, mfxU16 lockFlag)
+    {
+        mfxFrameData data = {};
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+        data.LockFlag = lockFlag;
+#else
+        std::ignore = lockFlag;
+#endif
+        mfxStatus sts = Call(m_allocator.frameAllocator.Lock, m_response.mids[idx], &data);
+        if (sts == MFX_ERR_NONE)
+            EXPECT_EQ(m_driver.pixels.data(), data.Y);
+        return sts;
+    }
+
+    mfxStatus Unlock(mfxU32 idx)
+    {
+        mfxFrameData data = {};
+        return Call(m_allocator.frameAllocator.Unlock, m_response.mids[idx], &data);
+    }
+
+    // the way components submit the surface to the device
+    mfxStatus GetHDL(mfxU32 idx)
+    {
+        mfxHDL hdl = nullptr;
+        return Call(m_allocator.frameAllocator.GetHDL, m_response.mids[idx], &hdl);
+    }
+
+    Driver                                                  m_driver;
+    mfxDefaultAllocatorVAAPI::mfxWideHWFrameAllocator       m_allocator;
+    mfxFrameAllocResponse                                   m_response = {};
+};
+
+} // namespace
+
+TEST_F(VAAPIAllocator, LockMapsAndUnlockUnmaps)
+{
+    ASSERT_EQ(MFX_ERR_NONE, Lock(0, 0));
+    EXPECT_EQ(1, m_driver.derive);
+    EXPECT_EQ(1, m_driver.map);
+
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+    EXPECT_EQ(1, m_driver.unmap);
+    // the image is kept until the device gets the surface
+    EXPECT_EQ(0, m_driver.destroy);
+
+    ASSERT_EQ(MFX_ERR_NONE, Lock(0, 0));
+    EXPECT_EQ(1, m_driver.derive);
+    EXPECT_EQ(2, m_driver.map);
+    EXPECT_EQ(0, m_driver.sync);
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+
+    ASSERT_EQ(MFX_ERR_NONE, GetHDL(0));
+    EXPECT_EQ(1, m_driver.destroy);
+}
+
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+TEST_F(VAAPIAllocator, ReadOnlyLockKeepsMappingAndSyncs)
+{
+    ASSERT_EQ(MFX_ERR_NONE, Lock(0, MFX_FRAMELOCK_READ_ONLY));
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+    EXPECT_EQ(0, m_driver.unmap);
+
+    // the kept mapping is reused, the lock still waits for the device
+    ASSERT_EQ(MFX_ERR_NONE, Lock(0, MFX_FRAMELOCK_READ_ONLY));
+    EXPECT_EQ(1, m_driver.derive);
+    EXPECT_EQ(1, m_driver.map);
+    EXPECT_EQ(1, m_driver.sync);
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+
+    // a read-write lock reuses it too and drops it on unlock
+    ASSERT_EQ(MFX_ERR_NONE, Lock(0, 0));
+    EXPECT_EQ(1, m_driver.map);
+    EXPECT_EQ(2, m_driver.sync);
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+    EXPECT_EQ(1, m_driver.unmap);
+    EXPECT_EQ(0, m_driver.destroy);
+}
+
+TEST_F(VAAPIAllocator, DeviceAccessFlushesKeptMapping)
+{
+    ASSERT_EQ(MFX_ERR_NONE, Lock(0, MFX_FRAMELOCK_READ_ONLY));
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+    ASSERT_EQ(MFX_ERR_NONE, Lock(1, MFX_FRAMELOCK_READ_ONLY));
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(1));
+
+    ASSERT_EQ(MFX_ERR_NONE, GetHDL(0));
+    EXPECT_EQ(1, m_driver.unmap);
+    EXPECT_EQ(1, m_driver.destroy);
+
+    // the next lock maps what the device wrote
+    ASSERT_EQ(MFX_ERR_NONE, Lock(0, MFX_FRAMELOCK_READ_ONLY));
+    EXPECT_EQ(3, m_driver.derive);
+    EXPECT_EQ(3, m_driver.map);
+    EXPECT_EQ(0, m_driver.sync);
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+}
+
+TEST_F(VAAPIAllocator, FlushOfLockedFrameIsDeferredToLastUnlock)
+{
+    ASSERT_EQ(MFX_ERR_NONE, Lock(0, MFX_FRAMELOCK_READ_ONLY));
+    ASSERT_EQ(MFX_ERR_NONE, Lock(0, MFX_FRAMELOCK_READ_ONLY));
+
+    ASSERT_EQ(MFX_ERR_NONE, GetHDL(0));
+    EXPECT_EQ(0, m_driver.unmap);
+
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+    EXPECT_EQ(0, m_driver.unmap);
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+    EXPECT_EQ(1, m_driver.unmap);
+    EXPECT_EQ(1, m_driver.destroy);
+}
+
+TEST_F(VAAPIAllocator, ConcurrentReadOnlyLocksShareMapping)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([this]
+        {
+            for (int i = 0; i < 100; i++)
+            {
+                ASSERT_EQ(MFX_ERR_NONE, Lock(0, MFX_FRAMELOCK_READ_ONLY));
+                ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+            }
+        });
+    }
+    for (std::thread &t : threads)
+        t.join();
+
+    EXPECT_EQ(1, m_driver.derive);
+    EXPECT_EQ(1, m_driver.map);
+    EXPECT_EQ(0, m_driver.unmap);
+
+    ASSERT_EQ(MFX_ERR_NONE, GetHDL(0));
+    EXPECT_EQ(1, m_driver.unmap);
+    EXPECT_EQ(1, m_driver.destroy);
+}
+#endif // (MFX_VERSION >= MFX_VERSION_NEXT)
+
+// The allocator guard isn't held over VA calls: a slow map of one surface doesn't stall the
+// other surfaces nor the device submission of the surface being mapped.
+TEST_F(VAAPIAllocator, MappingDoesNotBlockOtherFrames)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_driver.guard);
+        m_driver.blocked = BUFFER_BASE + 1;
+    }
+
+    std::thread locker([this] { EXPECT_EQ(MFX_ERR_NONE, Lock(0, 0)); });
+    {
+        std::unique_lock<std::mutex> lock(m_driver.guard);
+        ASSERT_TRUE(m_driver.changed.wait_for(lock, std::chrono::seconds(10), [this] { return m_driver.inBlockedMap; }));
+    }
+
+    auto others = std::async(std::launch::async, [this]
+    {
+        EXPECT_EQ(MFX_ERR_NONE, GetHDL(1));
+        EXPECT_EQ(MFX_ERR_NONE, Lock(1, 0));
+        EXPECT_EQ(MFX_ERR_NONE, Unlock(1));
+        EXPECT_EQ(MFX_ERR_NONE, GetHDL(0));
+    });
+    bool bDone = others.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+
+    {
+        std::lock_guard<std::mutex> lock(m_driver.guard);
+        m_driver.blocked = VA_INVALID_ID;
+        m_driver.changed.notify_all();
+    }
+    locker.join();
+    others.wait();
+    EXPECT_TRUE(bDone);
+
+    // the surface went to the device while it was being locked, the unlock drops the image
+    ASSERT_EQ(MFX_ERR_NONE, Unlock(0));
+    EXPECT_EQ(2, m_driver.unmap);
+    EXPECT_EQ(1, m_driver.destroy);
+}
@@ -0,0 +1,294 @@
+/* ****************************************************************************** *\
+
+Copyright (C) 2020 Intel Corporation.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+- Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+- Neither the name of Intel Corporation nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY INTEL CORPORATION "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL INTEL CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+File Name: capture.cpp
+
+\* ****************************************************************************** */
+#include <algorithm>
+#include <string.h>
+
+#include "capture.h"
+#include "../dumps/dump.h"
+#include "../loggers/thread_info.h"
+
+namespace
+{
+    // the file is written by chunks of this size
+    const size_t CAPTURE_BUFFER_SIZE = 4 << 20;
+
+    inline size_t AlignSize(size_t size)
+    {
+        return (size + CAPTURE_ALIGNMENT - 1) & ~(size_t)(CAPTURE_ALIGNMENT - 1);
+    }
+}
+
+Capture* Capture::_sing_capture = NULL;
+
+Capture::Capture()
+    : _file(NULL)
+    , _start(std::chrono::steady_clock::now())
+{
+    _buffer.reserve(CAPTURE_BUFFER_SIZE);
+}
+
+Capture::~Capture()
+{
+    Flush();
+    if (_file)
+        fclose(_file);
+}
+
+bool Capture::Enable(std::string file_path)
+{
+    if (_sing_capture)
+        return true;
+
+    std::string strproc_id = std::string("_") + ToString(ThreadInfo::GetProcessId());
+    size_t pos = file_path.rfind(".");
+    if (pos == std::string::npos || file_path.find('/', pos) != std::string::npos)
+        file_path.insert(file_path.length(), strproc_id);
+    else
+        file_path.insert(pos, strproc_id);
+
+    Capture *capture = new Capture();
+    capture->_file = fopen(file_path.c_str(), "wb");
+    if (!capture->_file)
+    {
+        delete capture;
+        return false;
+    }
+
+    CaptureFileHeader header = {};
+    memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+    header.version = CAPTURE_VERSION;
+    header.headerSize = sizeof(header);
+    header.startTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    fwrite(&header, sizeof(header), 1, capture->_file);
+
+    _sing_capture = capture;
+    atexit(Capture::Close);
+
+    return true;
+}
+
+void Capture::Close()
+{
+    Flush();
+}
+
+void Capture::Write(const void *data, size_t size)
+{
+    Capture *capture = _sing_capture;
+    if (!capture)
+        return;
+
+    std::lock_guard<std::mutex> guard(capture->_write);
+
+    if (capture->_buffer.size() + size > CAPTURE_BUFFER_SIZE && !capture->_buffer.empty())
+    {
+        fwrite(capture->_buffer.data(), 1, capture->_buffer.size(), capture->_file);
+        capture->_buffer.clear();
+    }
+    capture->_buffer.insert(capture->_buffer.end(), (const char *)data, (const char *)data + size);
+}
+
+void Capture::Flush()
+{
+    Capture *capture = _sing_capture;
+    if (!capture)
+        return;
+
+    std::lock_guard<std::mutex> guard(capture->_write);
+
+    if (!capture->_buffer.empty())
+    {
+        fwrite(capture->_buffer.data(), 1, capture->_buffer.size(), capture->_file);
+        capture->_buffer.clear();
+    }
+    fflush(capture->_file);
+}
+
+mfxI64 Capture::GetTime()
+{
+    Capture *capture = _sing_capture;
+    if (!capture)
+        return 0;
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - capture->_start).count();
+}
+
+void Capture::PackBitstream(mfxU64 session, const mfxBitstream &before, mfxU32 remaining, std::vector<char> &field)
+{
+    CaptureBitstreamData header = {};
+    const char *data = before.Data ? (const char *)before.Data + before.DataOffset : NULL;
+    const mfxU32 length = before.Data ? before.DataLength : 0;
+
+    field.clear();
+
+    Capture *capture = _sing_capture;
+    if (capture)
+    {
+        std::lock_guard<std::mutex> guard(capture->_tails_guard);
+        std::vector<char> &tail = capture->_tails[session];
+
+        // the application keeps the tail at the head of the new input
+        size_t common = std::min<size_t>(tail.size(), length);
+        if (common && !memcmp(tail.data(), data, common))
+            header.reused = (mfxU32)common;
+
+        // the library only moves DataOffset, so the tail is the end of the input
+        header.remaining = std::min(remaining, length);
+        if (header.remaining)
+            tail.assign(data + length - header.remaining, data + length);
+        else
+            tail.clear();
+    }
+
+    header.stored = length - header.reused;
+    field.resize(sizeof(header) + header.stored);
+    if (header.stored)
+        memcpy(field.data() + sizeof(header), data + header.reused, header.stored);
+    memcpy(field.data(), &header, sizeof(header));
+}
+
+void Capture::ForgetSession(mfxU64 session)
+{
+    Capture *capture = _sing_capture;
+    if (!capture)
+        return;
+
+    std::lock_guard<std::mutex> guard(capture->_tails_guard);
+    capture->_tails.erase(session);
+}
+
+namespace
+{
+    std::vector<char> & GetThreadBuffer()
+    {
+        static thread_local std::vector<char> buffer;
+        return buffer;
+    }
+}
+
+CaptureRecord::CaptureRecord(eCaptureCall call, mfxSession session)
+    : _buffer(GetThreadBuffer())
+    , _session((mfxU64)(size_t)session)
+{
+    CaptureRecordHeader header = {};
+
+    header.call = (mfxU16)call;
+    header.threadId = (mfxU64)ThreadInfo::GetThreadId();
+    header.session = _session;
+
+    _buffer.assign((const char *)&header, (const char *)&header + sizeof(header));
+}
+
+void CaptureRecord::Begin()
+{
+    CaptureRecordHeader *header = (CaptureRecordHeader *)_buffer.data();
+    header->start = Capture::GetTime();
+}
+
+void CaptureRecord::End(mfxStatus status)
+{
+    CaptureRecordHeader *header = (CaptureRecordHeader *)_buffer.data();
+    header->duration = Capture::GetTime() - header->start;
+    header->status = status;
+}
+
+void CaptureRecord::Add(eCaptureTag tag, const void *data, mfxU32 size)
+{
+    CaptureFieldHeader field = {};
+    const size_t offset = _buffer.size();
+
+    field.tag = (mfxU16)tag;
+    field.size = size;
+
+    _buffer.resize(offset + sizeof(field) + AlignSize(size));
+    memcpy(_buffer.data() + offset, &field, sizeof(field));
+    if (size)
+        memcpy(_buffer.data() + offset + sizeof(field), data, size);
+
+    ((CaptureRecordHeader *)_buffer.data())->numFields += 1;
+}
+
+void CaptureRecord::AddPointer(eCaptureTag tag, const void *ptr)
+{
+    mfxU64 id = (mfxU64)(size_t)ptr;
+    Add(tag, id);
+}
+
+void CaptureRecord::AddVideoParam(const mfxVideoParam *par)
+{
+    if (!par)
+        return;
+
+    Add(CAPTURE_TAG_VIDEO_PARAM, *par);
+    for (mfxU16 i = 0; par->ExtParam && i < par->NumExtParam; ++i)
+    {
+        const mfxExtBuffer *buffer = par->ExtParam[i];
+        if (!buffer)
+            continue;
+
+        // the reader still sees the buffer was attached
+        if (CaptureExtBufferHasPointers(buffer->BufferId))
+            Add(CAPTURE_TAG_EXT_BUFFER, *buffer);
+        else
+            Add(CAPTURE_TAG_EXT_BUFFER, buffer, buffer->BufferSz);
+    }
+}
+
+void CaptureRecord::AddSurface(eCaptureTag tag, const mfxFrameSurface1 *surface)
+{
+    if (!surface)
+        return;
+
+    CaptureSurface desc = {};
+    desc.id = (mfxU64)(size_t)surface;
+    desc.Info = surface->Info;
+    desc.TimeStamp = surface->Data.TimeStamp;
+    desc.FrameOrder = surface->Data.FrameOrder;
+    desc.PicStruct = surface->Info.PicStruct;
+    Add(tag, desc);
+}
+
+void CaptureRecord::AddBitstream(const mfxBitstream &before, const mfxBitstream *after)
+{
+    Add(CAPTURE_TAG_BITSTREAM, before);
+    if (after)
+    {
+        Capture::PackBitstream(_session, before, after->DataLength, _field);
+        Add(CAPTURE_TAG_BITSTREAM_DATA, _field.data(), (mfxU32)_field.size());
+    }
+}
+
+void CaptureRecord::Commit()
+{
+    ((CaptureRecordHeader *)_buffer.data())->size = (mfxU32)_buffer.size();
+    Capture::Write(_buffer.data(), _buffer.size());
+}
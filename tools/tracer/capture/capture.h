@@ -0,0 +1,111 @@
+/* ****************************************************************************** *\
+
+Copyright (C) 2020 Intel Corporation.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+- Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+- Neither the name of Intel Corporation nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY INTEL CORPORATION "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL INTEL CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+File Name: capture.h
+
+\* ****************************************************************************** */
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdio.h>
+
+#include "mfxvideo.h"
+#include "capture_format.h"
+
+// Binary capture of the calls, an alternative to the text log when the
+// tracer must not slow the application down. Records are formed by the
+// calling thread and appended to a large buffer, the file is written
+// only when the buffer is full, on closing of a session and on exit.
+class Capture
+{
+public:
+    static bool IsEnabled() { return _sing_capture != NULL; }
+    // opens the file, the process id is appended to the name like for text logs
+    static bool Enable(std::string file_path);
+    static void Write(const void *data, size_t size);
+    static void Flush();
+    // nanoseconds since the capture start
+    static mfxI64 GetTime();
+
+    // Fills the bitstream data field: only the part of the input which
+    // was not in the bitstream tail left by the previous call is stored.
+    // remaining is DataLength after the call, it becomes the new tail.
+    static void PackBitstream(mfxU64 session, const mfxBitstream &before, mfxU32 remaining, std::vector<char> &field);
+    static void ForgetSession(mfxU64 session);
+
+private:
+    Capture();
+    ~Capture();
+    // flushes the buffer on exit, the object stays alive as other
+    // threads may still be running
+    static void Close();
+
+    static Capture *_sing_capture;
+
+    std::mutex _write;
+    FILE *_file;
+    std::vector<char> _buffer;
+    std::chrono::steady_clock::time_point _start;
+
+    std::mutex _tails_guard;
+    std::map<mfxU64, std::vector<char> > _tails;
+};
+
+// A record of one call, formed in a thread local buffer
+class CaptureRecord
+{
+public:
+    CaptureRecord(eCaptureCall call, mfxSession session);
+
+    // marks the library call boundaries
+    void Begin();
+    void End(mfxStatus status);
+
+    void Add(eCaptureTag tag, const void *data, mfxU32 size);
+    template <class T>
+    void Add(eCaptureTag tag, const T &value) { Add(tag, &value, (mfxU32)sizeof(T)); }
+    void AddPointer(eCaptureTag tag, const void *ptr);
+    void AddVideoParam(const mfxVideoParam *par);
+    void AddSurface(eCaptureTag tag, const mfxFrameSurface1 *surface);
+    // before is a copy of the bitstream taken before the library call,
+    // the data is stored for the input bitstreams only (after is not NULL)
+    void AddBitstream(const mfxBitstream &before, const mfxBitstream *after);
+
+    // writes the record to the capture
+    void Commit();
+
+private:
+    std::vector<char> &_buffer;
+    mfxU64 _session;
+    std::vector<char> _field;
+};
+
+#endif //CAPTURE_H_
@@ -0,0 +1,216 @@
+/* ****************************************************************************** *\
+
+Copyright (C) 2020 Intel Corporation.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+- Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+- Neither the name of Intel Corporation nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY INTEL CORPORATION "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL INTEL CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+File Name: capture_format.h
+
+\* ****************************************************************************** */
+#ifndef CAPTURE_FORMAT_H_
+#define CAPTURE_FORMAT_H_
+
+#include "mfxstructures.h"
+#include "mfxbrc.h"
+#include "mfxcamera.h"
+#include "mfxfei.h"
+#include "mfxla.h"
+#include "mfxmvc.h"
+
+// Binary capture of the API calls.
+//
+// File starts with CaptureFileHeader followed by records, one per call,
+// in order of call completion. A record is CaptureRecordHeader followed by
+// numFields fields, each field is CaptureFieldHeader followed by its data
+// padded to 8 bytes. Structures are stored as the application passed them,
+// pointers inside them are meaningless for the reader and are only used to
+// tell objects apart (surfaces, sync points, sessions). Extension buffers
+// carrying pointers are stored as mfxExtBuffer header only, the data they
+// point to is not captured.
+
+#define CAPTURE_MAGIC "MFXCAPT1"
+
+enum
+{
+    CAPTURE_VERSION     = 1,
+    CAPTURE_ALIGNMENT   = 8,
+};
+
+struct CaptureFileHeader
+{
+    char   magic[8];
+    mfxU32 version;
+    mfxU32 headerSize;
+    // wall clock of the capture start, microseconds since epoch
+    mfxU64 startTime;
+    mfxU64 reserved[4];
+};
+
+// Stable identifiers of the captured functions
+enum eCaptureCall
+{
+    CAPTURE_MFXInit                         = 0x0001,
+    CAPTURE_MFXInitEx                       = 0x0002,
+    CAPTURE_MFXClose                        = 0x0003,
+    CAPTURE_MFXVideoCORE_SyncOperation      = 0x0004,
+
+    CAPTURE_MFXVideoDECODE_DecodeHeader     = 0x0101,
+    CAPTURE_MFXVideoDECODE_QueryIOSurf      = 0x0102,
+    CAPTURE_MFXVideoDECODE_Init             = 0x0103,
+    CAPTURE_MFXVideoDECODE_Reset            = 0x0104,
+    CAPTURE_MFXVideoDECODE_Close            = 0x0105,
+    CAPTURE_MFXVideoDECODE_DecodeFrameAsync = 0x0106,
+
+    CAPTURE_MFXVideoENCODE_QueryIOSurf      = 0x0201,
+    CAPTURE_MFXVideoENCODE_Init             = 0x0202,
+    CAPTURE_MFXVideoENCODE_Reset            = 0x0203,
+    CAPTURE_MFXVideoENCODE_Close            = 0x0204,
+    CAPTURE_MFXVideoENCODE_EncodeFrameAsync = 0x0205,
+
+    CAPTURE_MFXVideoVPP_QueryIOSurf         = 0x0301,
+    CAPTURE_MFXVideoVPP_Init                = 0x0302,
+    CAPTURE_MFXVideoVPP_Reset               = 0x0303,
+    CAPTURE_MFXVideoVPP_Close               = 0x0304,
+    CAPTURE_MFXVideoVPP_RunFrameVPPAsync    = 0x0305,
+};
+
+struct CaptureRecordHeader
+{
+    // size of the record including this header
+    mfxU32 size;
+    mfxU16 call;
+    mfxU16 numFields;
+    mfxU64 threadId;
+    // session as the application sees it
+    mfxU64 session;
+    // call start relative to the capture start and call duration, nanoseconds
+    mfxI64 start;
+    mfxI64 duration;
+    mfxI32 status;
+    mfxU32 reserved;
+};
+
+enum eCaptureTag
+{
+    CAPTURE_TAG_IMPL            = 0x0001, // mfxIMPL
+    CAPTURE_TAG_VERSION         = 0x0002, // mfxVersion
+    CAPTURE_TAG_INIT_PARAM      = 0x0003, // mfxInitParam
+    CAPTURE_TAG_SESSION_OUT     = 0x0004, // mfxU64, session created by the call
+
+    CAPTURE_TAG_VIDEO_PARAM     = 0x0010, // mfxVideoParam
+    CAPTURE_TAG_EXT_BUFFER      = 0x0011, // extension buffer of the preceding mfxVideoParam
+    CAPTURE_TAG_ALLOC_REQUEST   = 0x0012, // mfxFrameAllocRequest[], output of QueryIOSurf
+
+    CAPTURE_TAG_BITSTREAM       = 0x0020, // mfxBitstream before the call
+    CAPTURE_TAG_BITSTREAM_DATA  = 0x0021, // CaptureBitstreamData + new bytes
+    CAPTURE_TAG_ENCODE_CTRL     = 0x0022, // mfxEncodeCtrl
+
+    CAPTURE_TAG_SURFACE_IN      = 0x0030, // CaptureSurface, input of the call
+    CAPTURE_TAG_SURFACE_WORK    = 0x0031, // CaptureSurface, working/output surface passed by the application
+    CAPTURE_TAG_SURFACE_OUT     = 0x0032, // mfxU64, surface returned by the library
+
+    CAPTURE_TAG_SYNCP           = 0x0040, // mfxU64, sync point passed to or returned by the call
+    CAPTURE_TAG_WAIT            = 0x0041, // mfxU32
+};
+
+// extension buffers whose contents can't be stored by value
+inline bool CaptureExtBufferHasPointers(mfxU32 id)
+{
+    switch (id)
+    {
+    case MFX_EXTBUFF_VPP_DONOTUSE:
+    case MFX_EXTBUFF_VPP_DOUSE:
+    case MFX_EXTBUFF_VPP_COMPOSITE:
+    case MFX_EXTBUFF_MVC_SEQ_DESC:
+    case MFX_EXTBUFF_OPAQUE_SURFACE_ALLOCATION:
+    case MFX_EXTBUFF_CODING_OPTION_SPSPPS:
+    case MFX_EXTBUFF_CODING_OPTION_VPS:
+    case MFX_EXTBUFF_MBQP:
+    case MFX_EXTBUFF_MB_FORCE_INTRA:
+    case MFX_EXTBUFF_MB_DISABLE_SKIP_MAP:
+    case MFX_EXTBUFF_ENCODED_SLICES_INFO:
+    case MFX_EXTBUFF_BRC:
+    case MFX_EXTBUFF_LOOKAHEAD_STAT:
+    case MFX_EXTBUF_CAM_VIGNETTE_CORRECTION:
+    case MFX_EXTBUF_CAM_FORWARD_GAMMA_CORRECTION:
+    case MFX_EXTBUF_CAM_3DLUT:
+    case MFX_EXTBUFF_FEI_PREENC_CTRL:
+    case MFX_EXTBUFF_FEI_PREENC_MV_PRED:
+    case MFX_EXTBUFF_FEI_PREENC_MV:
+    case MFX_EXTBUFF_FEI_PREENC_MB:
+    case MFX_EXTBUFF_FEI_ENC_MV_PRED:
+    case MFX_EXTBUFF_FEI_ENC_QP:
+    case MFX_EXTBUFF_FEI_ENC_MV:
+    case MFX_EXTBUFF_FEI_ENC_MB:
+    case MFX_EXTBUFF_FEI_ENC_MB_STAT:
+    case MFX_EXTBUFF_FEI_PAK_CTRL:
+    case MFX_EXTBUFF_FEI_SLICE:
+    case MFX_EXTBUFF_FEI_DEC_STREAM_OUT:
+#if (MFX_VERSION >= 1025)
+    case MFX_EXTBUFF_ENCODED_UNITS_INFO:
+#endif
+#if (MFX_VERSION >= 1026)
+    case MFX_EXTBUFF_VP9_SEGMENTATION:
+#endif
+#if (MFX_VERSION >= 1034)
+    case MFX_EXTBUFF_ENCODER_IPCM_AREA:
+#endif
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct CaptureFieldHeader
+{
+    mfxU16 tag;
+    mfxU16 reserved;
+    mfxU32 size;
+};
+
+struct CaptureSurface
+{
+    mfxU64        id;
+    mfxFrameInfo  Info;
+    mfxU64        TimeStamp;
+    mfxU32        FrameOrder;
+    mfxU16        PicStruct;
+    mfxU16        reserved;
+};
+
+// The decoder input is usually the unconsumed tail of the previous call
+// followed by newly read data. Only the new part is stored, reused bytes
+// are the leading part of the data left in the bitstream after the previous
+// call with a bitstream in the same session.
+struct CaptureBitstreamData
+{
+    // bytes taken from the tail of the previous call
+    mfxU32 reused;
+    // bytes stored after this structure
+    mfxU32 stored;
+    // DataLength after the call, i.e. the tail for the next call
+    mfxU32 remaining;
+    mfxU32 reserved;
+};
+
+#endif //CAPTURE_FORMAT_H_
@@ -0,0 +1,224 @@
+/* ****************************************************************************** *\
+
+Copyright (C) 2020 Intel Corporation.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+- Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+- Neither the name of Intel Corporation nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY INTEL CORPORATION "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL INTEL CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+File Name: capture_reader.cpp
+
+\* ****************************************************************************** */
+#include <fstream>
+#include <string.h>
+
+#include "capture_reader.h"
+
+const char *GetCaptureCallName(mfxU16 call)
+{
+    switch (call)
+    {
+#define CAPTURE_CALL_NAME(name) case CAPTURE_##name: return #name;
+    CAPTURE_CALL_NAME(MFXInit)
+    CAPTURE_CALL_NAME(MFXInitEx)
+    CAPTURE_CALL_NAME(MFXClose)
+    CAPTURE_CALL_NAME(MFXVideoCORE_SyncOperation)
+    CAPTURE_CALL_NAME(MFXVideoDECODE_DecodeHeader)
+    CAPTURE_CALL_NAME(MFXVideoDECODE_QueryIOSurf)
+    CAPTURE_CALL_NAME(MFXVideoDECODE_Init)
+    CAPTURE_CALL_NAME(MFXVideoDECODE_Reset)
+    CAPTURE_CALL_NAME(MFXVideoDECODE_Close)
+    CAPTURE_CALL_NAME(MFXVideoDECODE_DecodeFrameAsync)
+    CAPTURE_CALL_NAME(MFXVideoENCODE_QueryIOSurf)
+    CAPTURE_CALL_NAME(MFXVideoENCODE_Init)
+    CAPTURE_CALL_NAME(MFXVideoENCODE_Reset)
+    CAPTURE_CALL_NAME(MFXVideoENCODE_Close)
+    CAPTURE_CALL_NAME(MFXVideoENCODE_EncodeFrameAsync)
+    CAPTURE_CALL_NAME(MFXVideoVPP_QueryIOSurf)
+    CAPTURE_CALL_NAME(MFXVideoVPP_Init)
+    CAPTURE_CALL_NAME(MFXVideoVPP_Reset)
+    CAPTURE_CALL_NAME(MFXVideoVPP_Close)
+    CAPTURE_CALL_NAME(MFXVideoVPP_RunFrameVPPAsync)
+#undef CAPTURE_CALL_NAME
+    default:
+        return "unknown";
+    }
+}
+
+const CaptureField *CaptureCall::Find(mfxU16 tag, size_t from) const
+{
+    for (size_t i = from; i < fields.size(); ++i)
+    {
+        if (fields[i].tag == tag)
+            return &fields[i];
+    }
+    return NULL;
+}
+
+CaptureReader::CaptureReader()
+{
+    memset(&_header, 0, sizeof(_header));
+}
+
+bool CaptureReader::Open(const std::string &file_path, std::string &error)
+{
+    std::ifstream file(file_path.c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        error = "can't open " + file_path;
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    _data.resize((size_t)size);
+    if (size && !file.read(_data.data(), size))
+    {
+        error = "can't read " + file_path;
+        return false;
+    }
+
+    if (!Parse(error))
+        return false;
+
+    RestoreBitstreams();
+    return true;
+}
+
+bool CaptureReader::Parse(std::string &error)
+{
+    if (_data.size() < sizeof(_header))
+    {
+        error = "file is too short";
+        return false;
+    }
+
+    memcpy(&_header, _data.data(), sizeof(_header));
+    if (memcmp(_header.magic, CAPTURE_MAGIC, sizeof(_header.magic)))
+    {
+        error = "not a capture file";
+        return false;
+    }
+    if (_header.version != CAPTURE_VERSION || _header.headerSize < sizeof(_header) || _header.headerSize > _data.size())
+    {
+        error = "unsupported capture version";
+        return false;
+    }
+
+    size_t offset = _header.headerSize;
+    while (offset + sizeof(CaptureRecordHeader) <= _data.size())
+    {
+        CaptureCall call = {};
+        memcpy(&call.header, _data.data() + offset, sizeof(call.header));
+
+        const size_t end = offset + call.header.size;
+        if (call.header.size < sizeof(call.header) || end > _data.size())
+        {
+            // the application was killed while the buffer was being written
+            break;
+        }
+
+        size_t pos = offset + sizeof(call.header);
+        for (mfxU16 i = 0; i < call.header.numFields && pos + sizeof(CaptureFieldHeader) <= end; ++i)
+        {
+            CaptureFieldHeader fieldHeader;
+            memcpy(&fieldHeader, _data.data() + pos, sizeof(fieldHeader));
+            pos += sizeof(fieldHeader);
+
+            if (fieldHeader.size > end - pos)
+                break;
+
+            CaptureField field = { fieldHeader.tag, fieldHeader.size, _data.data() + pos };
+            call.fields.push_back(field);
+
+            pos += (fieldHeader.size + CAPTURE_ALIGNMENT - 1) & ~(size_t)(CAPTURE_ALIGNMENT - 1);
+        }
+
+        _calls.push_back(call);
+        offset = end;
+    }
+
+    return true;
+}
+
+void CaptureReader::RestoreBitstreams()
+{
+    struct Tail
+    {
+        size_t end;
+        mfxU32 length;
+    };
+    std::map<mfxU64, Tail> tails;
+    std::vector<size_t> offsets(_calls.size(), 0);
+
+    // the input of a call is usually the tail of the previous one followed by
+    // the stored bytes, so the stream grows only by the stored parts
+    for (size_t i = 0; i < _calls.size(); ++i)
+    {
+        CaptureCall &call = _calls[i];
+        if (CAPTURE_MFXClose == call.header.call)
+        {
+            // the handle may be reused by a new session
+            tails.erase(call.header.session);
+            continue;
+        }
+
+        const CaptureField *field = call.Find(CAPTURE_TAG_BITSTREAM_DATA);
+        if (!field || field->size < sizeof(CaptureBitstreamData))
+            continue;
+
+        CaptureBitstreamData data;
+        memcpy(&data, field->data, sizeof(data));
+        if (data.stored > field->size - sizeof(data))
+            continue;
+
+        std::vector<mfxU8> &stream = _streams[call.header.session];
+        Tail &tail = tails[call.header.session];
+        if (data.reused > tail.length)
+            data.reused = tail.length;
+
+        const size_t tailStart = tail.end - tail.length;
+        size_t start = tailStart;
+        if (data.reused < tail.length || tail.end != stream.size())
+        {
+            // the application dropped a part of the tail, start a new piece
+            std::vector<mfxU8> reused(stream.begin() + tailStart, stream.begin() + tailStart + data.reused);
+            start = stream.size();
+            stream.insert(stream.end(), reused.begin(), reused.end());
+        }
+        stream.insert(stream.end(), (const mfxU8 *)field->data + sizeof(data),
+            (const mfxU8 *)field->data + sizeof(data) + data.stored);
+
+        offsets[i] = start;
+        call.bitstreamLength = data.reused + data.stored;
+
+        tail.end = start + call.bitstreamLength;
+        tail.length = data.remaining < call.bitstreamLength ? data.remaining : call.bitstreamLength;
+    }
+
+    // streams don't grow anymore, pointers are stable
+    for (size_t i = 0; i < _calls.size(); ++i)
+    {
+        if (_calls[i].bitstreamLength)
+            _calls[i].bitstream = _streams[_calls[i].header.session].data() + offsets[i];
+    }
+}
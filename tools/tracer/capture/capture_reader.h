@@ -0,0 +1,96 @@
+/* ****************************************************************************** *\
+
+Copyright (C) 2020 Intel Corporation.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+- Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+- Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+- Neither the name of Intel Corporation nor the names of its contributors
+may be used to endorse or promote products derived from this software
+without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY INTEL CORPORATION "AS IS" AND ANY EXPRESS OR
+IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL INTEL CORPORATION BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+File Name: capture_reader.h
+
+\* ****************************************************************************** */
+#ifndef CAPTURE_READER_H_
+#define CAPTURE_READER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "capture_format.h"
+
+struct CaptureField
+{
+    mfxU16      tag;
+    mfxU32      size;
+    const char *data;
+};
+
+struct CaptureCall
+{
+    CaptureRecordHeader       header;
+    std::vector<CaptureField> fields;
+
+    // decoder input restored from the stored parts, empty if the call had none
+    const mfxU8 *bitstream;
+    mfxU32       bitstreamLength;
+
+    // returns the first field with the tag starting from the index, or NULL
+    const CaptureField *Find(mfxU16 tag, size_t from = 0) const;
+
+    template <class T>
+    bool Get(mfxU16 tag, T &value) const
+    {
+        const CaptureField *field = Find(tag);
+        if (!field || field->size < sizeof(T))
+            return false;
+        value = *(const T *)field->data;
+        return true;
+    }
+};
+
+// returns the function name of eCaptureCall value
+const char *GetCaptureCallName(mfxU16 call);
+
+// Loads the whole capture file, calls are kept in the order of the file
+class CaptureReader
+{
+public:
+    CaptureReader();
+
+    // returns false with the error message if the file is not a valid capture
+    bool Open(const std::string &file_path, std::string &error);
+
+    const CaptureFileHeader & GetHeader() const { return _header; }
+    const std::vector<CaptureCall> & GetCalls() const { return _calls; }
+
+private:
+    bool Parse(std::string &error);
+    void RestoreBitstreams();
+
+    CaptureFileHeader _header;
+    std::vector<char> _data;
+    std::vector<CaptureCall> _calls;
+
+    // decoder input of each session as one contiguous stream
+    std::map<mfxU64, std::vector<mfxU8> > _streams;
+};
+
+#endif //CAPTURE_READER_H_
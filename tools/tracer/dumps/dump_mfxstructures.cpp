@@ -305,6 +305,9 @@ std::string DumpContext::dump(const std::string structName, const mfxFrameData &
 {
     std::string str;
     str += structName + ".reserved[]=" + DUMP_RESERVED_ARRAY(frameData.reserved) + "\n";
+#if (MFX_VERSION >= MFX_VERSION_NEXT)
+    str += structName + ".LockFlag=" + ToString(frameData.LockFlag) + "\n";
+#endif
     str += structName + ".PitchHigh=" + ToString(frameData.PitchHigh) + "\n";
     str += structName + ".TimeStamp=" + ToString(frameData.TimeStamp) + "\n";
     str += structName + ".FrameOrder=" + ToString(frameData.FrameOrder) + "\n";
@@ -29,6 +29,7 @@ File Name: log.cpp
 \* ****************************************************************************** */
 
 #include "log.h"
+#include "../capture/capture.h"
 
 Log* Log::_sing_log = NULL;
 bool Log::useGUI = false;
@@ -104,6 +105,9 @@ void Log::clear()
 
 void Log::WriteLog(const std::string &log)
 {
+    // calls are captured in binary form instead
+    if (Capture::IsEnabled())
+        return;
 
 #if defined(_WIN32) || defined(_WIN64)
     DWORD start_flag = 0;
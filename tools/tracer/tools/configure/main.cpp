@@ -27,7 +27,7 @@
     #define LOG_TYPES "console, file, etw"
     #define HOME string(getenv("HOMEPATH"))
 #else
-    #define LOG_TYPES "console, file, syslog"
+    #define LOG_TYPES "console, file, syslog, capture"
     #define HOME string(getenv("HOME"))
 #endif
 
@@ -51,7 +51,7 @@ int main(int argc, char *argv[])
             "  [core]\n"
             "    edit      enable or disable edit of config file (1 - enable, 0 - disable)\n"
             "    type      log type (you can use: " LOG_TYPES ")\n"
-            "    log       log file to dump trace (if applicable)\n"
+            "    log       log file to dump trace (if applicable), binary capture file for the capture type\n"
             "    level     log level (you can use: " LOG_LEVELS ")\n"
             "\n"
             "Examples:\n"
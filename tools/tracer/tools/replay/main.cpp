@@ -0,0 +1,98 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <string>
+
+#include "capture_reader.h"
+#include "replay.h"
+
+using namespace std;
+
+static void print_help()
+{
+    cout << "Usage: mfx-replay [options] capture_file\n"
+         << "Re-issues the calls recorded by mfx-tracer in the capture mode.\n\n"
+         << "Options:\n"
+         << "  -fast           issue the calls as fast as possible instead of the captured timing\n"
+         << "  -sw             force the software implementation\n"
+         << "  -device path    DRM render node, /dev/dri/renderD128 by default\n"
+         << "  -h, --help      print this help\n";
+}
+
+int main(int argc, char *argv[])
+{
+    ReplayParams params;
+    string file_path;
+
+    params.timed = true;
+    params.software = false;
+    params.device = "/dev/dri/renderD128";
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg(argv[i]);
+        if (arg == "-h" || arg == "--help") {
+            print_help();
+            return 0;
+        }
+        else if (arg == "-fast") {
+            params.timed = false;
+        }
+        else if (arg == "-sw") {
+            params.software = true;
+        }
+        else if (arg == "-device") {
+            if (++i >= argc) {
+                cerr << "error: device path is not specified\n";
+                return 1;
+            }
+            params.device = argv[i];
+        }
+        else if (file_path.empty() && arg[0] != '-') {
+            file_path = arg;
+        }
+        else {
+            cerr << "error: unknown option: " << arg << "\n";
+            print_help();
+            return 1;
+        }
+    }
+
+    if (file_path.empty()) {
+        print_help();
+        return 1;
+    }
+
+    CaptureReader reader;
+    string error;
+    if (!reader.Open(file_path, error)) {
+        cerr << "error: " << file_path << ": " << error << "\n";
+        return 1;
+    }
+
+    cout << "replaying " << reader.GetCalls().size() << " calls from " << file_path << "\n\n";
+
+    Replayer replayer(reader, params);
+    replayer.Run();
+    replayer.PrintReport(cout);
+
+    return 0;
+}
@@ -0,0 +1,696 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <string.h>
+
+#if defined(LIBVA_SUPPORT)
+#include <fcntl.h>
+#include <unistd.h>
+#include <va/va.h>
+#include <va/va_drm.h>
+#endif
+
+#include "replay.h"
+
+namespace
+{
+    typedef std::chrono::steady_clock clock_type;
+
+    inline mfxI64 ElapsedNs(clock_type::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+    }
+
+    // replay owns the surfaces, so they are in the system memory
+    mfxU16 ToSystemMemory(mfxU16 pattern)
+    {
+        if (pattern & (MFX_IOPATTERN_IN_VIDEO_MEMORY | MFX_IOPATTERN_IN_OPAQUE_MEMORY))
+            pattern = (pattern & ~(MFX_IOPATTERN_IN_VIDEO_MEMORY | MFX_IOPATTERN_IN_OPAQUE_MEMORY)) | MFX_IOPATTERN_IN_SYSTEM_MEMORY;
+        if (pattern & (MFX_IOPATTERN_OUT_VIDEO_MEMORY | MFX_IOPATTERN_OUT_OPAQUE_MEMORY))
+            pattern = (pattern & ~(MFX_IOPATTERN_OUT_VIDEO_MEMORY | MFX_IOPATTERN_OUT_OPAQUE_MEMORY)) | MFX_IOPATTERN_OUT_SYSTEM_MEMORY;
+        return pattern;
+    }
+
+    bool AllocateSurface(const mfxFrameInfo &info, std::vector<mfxU8> &data, mfxFrameSurface1 &surface)
+    {
+        const mfxU32 width = (mfxU32)(info.Width + 31) & ~31u;
+        const mfxU32 height = (mfxU32)(info.Height + 31) & ~31u;
+        mfxU32 pitch = 0;
+        size_t size = 0;
+
+        switch (info.FourCC)
+        {
+        case MFX_FOURCC_NV12:
+            pitch = width;
+            size = (size_t)pitch * height * 3 / 2;
+            break;
+        case MFX_FOURCC_P010:
+        case MFX_FOURCC_P016:
+            pitch = width * 2;
+            size = (size_t)pitch * height * 3 / 2;
+            break;
+        case MFX_FOURCC_YUY2:
+        case MFX_FOURCC_UYVY:
+            pitch = width * 2;
+            size = (size_t)pitch * height;
+            break;
+        case MFX_FOURCC_RGB4:
+        case MFX_FOURCC_BGR4:
+        case MFX_FOURCC_A2RGB10:
+        case MFX_FOURCC_AYUV:
+        case MFX_FOURCC_Y210:
+        case MFX_FOURCC_Y216:
+        case MFX_FOURCC_Y410:
+            pitch = width * 4;
+            size = (size_t)pitch * height;
+            break;
+        default:
+            return false;
+        }
+
+        data.assign(size, 0);
+        memset(&surface, 0, sizeof(surface));
+        surface.Info = info;
+        surface.Data.PitchHigh = (mfxU16)(pitch >> 16);
+        surface.Data.PitchLow = (mfxU16)(pitch & 0xffff);
+
+        mfxU8 *base = data.data();
+        switch (info.FourCC)
+        {
+        case MFX_FOURCC_NV12:
+        case MFX_FOURCC_P010:
+        case MFX_FOURCC_P016:
+            surface.Data.Y = base;
+            surface.Data.UV = base + (size_t)pitch * height;
+            surface.Data.V = surface.Data.UV + (info.FourCC == MFX_FOURCC_NV12 ? 1 : 2);
+            break;
+        case MFX_FOURCC_YUY2:
+            surface.Data.Y = base;
+            surface.Data.U = base + 1;
+            surface.Data.V = base + 3;
+            break;
+        case MFX_FOURCC_UYVY:
+            surface.Data.U = base;
+            surface.Data.Y = base + 1;
+            surface.Data.V = base + 2;
+            break;
+        case MFX_FOURCC_RGB4:
+        case MFX_FOURCC_BGR4:
+        case MFX_FOURCC_A2RGB10:
+            surface.Data.B = base;
+            surface.Data.G = base + 1;
+            surface.Data.R = base + 2;
+            surface.Data.A = base + 3;
+            break;
+        case MFX_FOURCC_AYUV:
+            surface.Data.V = base;
+            surface.Data.U = base + 1;
+            surface.Data.Y = base + 2;
+            surface.Data.A = base + 3;
+            break;
+        case MFX_FOURCC_Y210:
+        case MFX_FOURCC_Y216:
+            surface.Data.Y16 = (mfxU16 *)base;
+            surface.Data.U16 = (mfxU16 *)base + 1;
+            surface.Data.V16 = (mfxU16 *)base + 3;
+            break;
+        case MFX_FOURCC_Y410:
+            surface.Data.Y410 = (mfxY410 *)base;
+            break;
+        }
+
+        return true;
+    }
+}
+
+Replayer::Replayer(const CaptureReader &reader, const ReplayParams &params)
+    : m_reader(reader)
+    , m_params(params)
+    , m_missedSyncPoints(0)
+    , m_unsupported(0)
+    , m_latenessTotal(0)
+    , m_latenessMax(0)
+    , m_capturedWallTime(0)
+    , m_replayedWallTime(0)
+    , m_captureStart(0)
+    , m_fd(-1)
+    , m_display(NULL)
+{
+}
+
+Replayer::~Replayer()
+{
+    // the application may have been captured without closing its sessions
+    for (std::map<mfxU64, mfxSession>::iterator it = m_sessions.begin(); it != m_sessions.end(); ++it)
+        MFXClose(it->second);
+    m_sessions.clear();
+
+#if defined(LIBVA_SUPPORT)
+    if (m_display)
+        vaTerminate((VADisplay)m_display);
+    if (m_fd >= 0)
+        close(m_fd);
+#endif
+}
+
+mfxStatus Replayer::Run()
+{
+    // calls of every thread are replayed in the order of their start
+    std::map<mfxU64, std::vector<const CaptureCall *> > threads;
+    const std::vector<CaptureCall> &calls = m_reader.GetCalls();
+
+    mfxI64 first = 0, last = 0;
+    for (size_t i = 0; i < calls.size(); ++i)
+    {
+        threads[calls[i].header.threadId].push_back(&calls[i]);
+
+        first = i ? std::min(first, calls[i].header.start) : calls[i].header.start;
+        last = std::max(last, calls[i].header.start + calls[i].header.duration);
+    }
+    m_capturedWallTime = last - first;
+    m_captureStart = first;
+
+    for (std::map<mfxU64, std::vector<const CaptureCall *> >::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        std::stable_sort(it->second.begin(), it->second.end(),
+            [](const CaptureCall *a, const CaptureCall *b) { return a->header.start < b->header.start; });
+    }
+
+    m_replayStart = clock_type::now();
+    std::vector<std::thread> workers;
+    for (std::map<mfxU64, std::vector<const CaptureCall *> >::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        workers.emplace_back(&Replayer::ThreadProc, this, &it->second);
+    }
+    for (size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+    m_replayedWallTime = ElapsedNs(m_replayStart);
+
+    return MFX_ERR_NONE;
+}
+
+void Replayer::ThreadProc(const std::vector<const CaptureCall *> *calls)
+{
+    for (size_t i = 0; i < calls->size(); ++i)
+    {
+        const CaptureCall &call = *(*calls)[i];
+        mfxI64 lateness = 0;
+
+        if (m_params.timed)
+        {
+            // calls start at the same offset from the replay start as in the capture
+            clock_type::time_point target = m_replayStart + std::chrono::nanoseconds(call.header.start - m_captureStart);
+            std::this_thread::sleep_until(target);
+            lateness = std::max<mfxI64>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - target).count(), 0);
+        }
+
+        clock_type::time_point callStart = clock_type::now();
+        mfxStatus sts = Execute(call);
+        mfxI64 duration = ElapsedNs(callStart);
+
+        std::lock_guard<std::mutex> guard(m_guard);
+        CallStat &stat = m_stats[call.header.call];
+        stat.count += 1;
+        stat.capturedTime += call.header.duration;
+        stat.capturedMax = std::max(stat.capturedMax, call.header.duration);
+        stat.replayedTime += duration;
+        stat.replayedMax = std::max(stat.replayedMax, duration);
+        if (sts != (mfxStatus)call.header.status)
+            stat.mismatches += 1;
+
+        m_latenessTotal += lateness;
+        m_latenessMax = std::max(m_latenessMax, lateness);
+    }
+}
+
+mfxStatus Replayer::Execute(const CaptureCall &call)
+{
+    switch (call.header.call)
+    {
+    case CAPTURE_MFXInit:
+    case CAPTURE_MFXInitEx:
+        return Init(call);
+    case CAPTURE_MFXClose:
+        return Close(call);
+    case CAPTURE_MFXVideoCORE_SyncOperation:
+        return SyncOperation(call);
+    case CAPTURE_MFXVideoDECODE_DecodeHeader:
+        return DecodeHeader(call);
+    case CAPTURE_MFXVideoDECODE_QueryIOSurf:
+    case CAPTURE_MFXVideoENCODE_QueryIOSurf:
+    case CAPTURE_MFXVideoVPP_QueryIOSurf:
+        return QueryIOSurf(call);
+    case CAPTURE_MFXVideoDECODE_Init:
+    case CAPTURE_MFXVideoDECODE_Reset:
+    case CAPTURE_MFXVideoENCODE_Init:
+    case CAPTURE_MFXVideoENCODE_Reset:
+    case CAPTURE_MFXVideoVPP_Init:
+    case CAPTURE_MFXVideoVPP_Reset:
+        return InitComponent(call);
+    case CAPTURE_MFXVideoDECODE_Close:
+    case CAPTURE_MFXVideoENCODE_Close:
+    case CAPTURE_MFXVideoVPP_Close:
+        return CloseComponent(call);
+    case CAPTURE_MFXVideoDECODE_DecodeFrameAsync:
+        return DecodeFrameAsync(call);
+    case CAPTURE_MFXVideoENCODE_EncodeFrameAsync:
+        return EncodeFrameAsync(call);
+    case CAPTURE_MFXVideoVPP_RunFrameVPPAsync:
+        return RunFrameVPPAsync(call);
+    default:
+        return MFX_ERR_UNSUPPORTED;
+    }
+}
+
+mfxStatus Replayer::Init(const CaptureCall &call)
+{
+    mfxInitParam par = {};
+    mfxU64 id = 0;
+
+    if (!call.Get(CAPTURE_TAG_SESSION_OUT, id))
+    {
+        // the application failed to create the session, try the same
+        id = 0;
+    }
+
+    if (CAPTURE_MFXInitEx == call.header.call)
+    {
+        call.Get(CAPTURE_TAG_INIT_PARAM, par);
+        par.ExtParam = NULL;
+        par.NumExtParam = 0;
+    }
+    else
+    {
+        call.Get(CAPTURE_TAG_IMPL, par.Implementation);
+        call.Get(CAPTURE_TAG_VERSION, par.Version);
+    }
+
+    if (m_params.software)
+        par.Implementation = MFX_IMPL_SOFTWARE;
+
+    mfxSession session = NULL;
+    mfxStatus sts = MFXInitEx(par, &session);
+    if (MFX_ERR_NONE != sts)
+        return sts;
+
+#if defined(LIBVA_SUPPORT)
+    if (MFX_IMPL_SOFTWARE != MFX_IMPL_BASETYPE(par.Implementation))
+    {
+        std::unique_lock<std::mutex> guard(m_guard);
+        if (!m_display)
+        {
+            m_fd = open(m_params.device.c_str(), O_RDWR);
+            if (m_fd >= 0)
+            {
+                VADisplay display = vaGetDisplayDRM(m_fd);
+                int major = 0, minor = 0;
+                if (display && VA_STATUS_SUCCESS == vaInitialize(display, &major, &minor))
+                    m_display = display;
+            }
+        }
+        guard.unlock();
+
+        if (m_display)
+            MFXVideoCORE_SetHandle(session, MFX_HANDLE_VA_DISPLAY, (mfxHDL)m_display);
+    }
+#endif
+
+    if (!id)
+    {
+        MFXClose(session);
+        return sts;
+    }
+
+    std::lock_guard<std::mutex> guard(m_guard);
+    m_sessions[id] = session;
+    return sts;
+}
+
+mfxStatus Replayer::Close(const CaptureCall &call)
+{
+    mfxSession session = NULL;
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+        std::map<mfxU64, mfxSession>::iterator it = m_sessions.find(call.header.session);
+        if (it == m_sessions.end())
+            return MFX_ERR_INVALID_HANDLE;
+        session = it->second;
+        m_sessions.erase(it);
+    }
+    return MFXClose(session);
+}
+
+mfxSession Replayer::GetSession(mfxU64 id)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+    std::map<mfxU64, mfxSession>::iterator it = m_sessions.find(id);
+    return (it == m_sessions.end()) ? NULL : it->second;
+}
+
+bool Replayer::RestoreVideoParam(const CaptureCall &call, VideoParam &param)
+{
+    size_t idx = 0;
+    for (; idx < call.fields.size(); ++idx)
+    {
+        if (CAPTURE_TAG_VIDEO_PARAM == call.fields[idx].tag)
+            break;
+    }
+    if (idx == call.fields.size() || call.fields[idx].size < sizeof(mfxVideoParam))
+        return false;
+
+    memcpy(&param.par, call.fields[idx].data, sizeof(param.par));
+    param.par.IOPattern = ToSystemMemory(param.par.IOPattern);
+
+    // extension buffers follow the parameters
+    for (++idx; idx < call.fields.size() && CAPTURE_TAG_EXT_BUFFER == call.fields[idx].tag; ++idx)
+    {
+        const CaptureField &field = call.fields[idx];
+        // buffers with pointers inside are captured by their header only
+        if (field.size < sizeof(mfxExtBuffer) || CaptureExtBufferHasPointers(((const mfxExtBuffer *)field.data)->BufferId))
+        {
+            std::lock_guard<std::mutex> guard(m_guard);
+            m_unsupported += 1;
+            continue;
+        }
+        param.buffers.push_back(std::vector<char>(field.data, field.data + field.size));
+    }
+    for (size_t i = 0; i < param.buffers.size(); ++i)
+        param.ext.push_back((mfxExtBuffer *)param.buffers[i].data());
+
+    param.par.ExtParam = param.ext.empty() ? NULL : param.ext.data();
+    param.par.NumExtParam = (mfxU16)param.ext.size();
+    return true;
+}
+
+void Replayer::RestoreBitstream(const CaptureCall &call, mfxBitstream &bs)
+{
+    call.Get(CAPTURE_TAG_BITSTREAM, bs);
+    memset(bs.reserved, 0, sizeof(bs.reserved));
+    bs.EncryptedData = NULL;
+    bs.ExtParam = NULL;
+    bs.NumExtParam = 0;
+
+    // the library only reads the input, so it's given straight from the capture
+    bs.Data = const_cast<mfxU8 *>(call.bitstream);
+    bs.DataOffset = 0;
+    bs.DataLength = call.bitstreamLength;
+    bs.MaxLength = call.bitstreamLength;
+}
+
+mfxStatus Replayer::DecodeHeader(const CaptureCall &call)
+{
+    mfxSession session = GetSession(call.header.session);
+    VideoParam param;
+    mfxBitstream bs = {};
+
+    if (!RestoreVideoParam(call, param))
+        return MFX_ERR_NULL_PTR;
+    RestoreBitstream(call, bs);
+
+    return MFXVideoDECODE_DecodeHeader(session, &bs, &param.par);
+}
+
+mfxStatus Replayer::QueryIOSurf(const CaptureCall &call)
+{
+    mfxSession session = GetSession(call.header.session);
+    mfxFrameAllocRequest request[2] = {};
+    VideoParam param;
+
+    if (!RestoreVideoParam(call, param))
+        return MFX_ERR_NULL_PTR;
+
+    switch (call.header.call)
+    {
+    case CAPTURE_MFXVideoDECODE_QueryIOSurf:
+        return MFXVideoDECODE_QueryIOSurf(session, &param.par, request);
+    case CAPTURE_MFXVideoENCODE_QueryIOSurf:
+        return MFXVideoENCODE_QueryIOSurf(session, &param.par, request);
+    default:
+        return MFXVideoVPP_QueryIOSurf(session, &param.par, request);
+    }
+}
+
+mfxStatus Replayer::InitComponent(const CaptureCall &call)
+{
+    mfxSession session = GetSession(call.header.session);
+    VideoParam param;
+
+    if (!RestoreVideoParam(call, param))
+        return MFX_ERR_NULL_PTR;
+
+    switch (call.header.call)
+    {
+    case CAPTURE_MFXVideoDECODE_Init:
+        return MFXVideoDECODE_Init(session, &param.par);
+    case CAPTURE_MFXVideoDECODE_Reset:
+        return MFXVideoDECODE_Reset(session, &param.par);
+    case CAPTURE_MFXVideoENCODE_Init:
+        return MFXVideoENCODE_Init(session, &param.par);
+    case CAPTURE_MFXVideoENCODE_Reset:
+        return MFXVideoENCODE_Reset(session, &param.par);
+    case CAPTURE_MFXVideoVPP_Init:
+        return MFXVideoVPP_Init(session, &param.par);
+    default:
+        return MFXVideoVPP_Reset(session, &param.par);
+    }
+}
+
+mfxStatus Replayer::CloseComponent(const CaptureCall &call)
+{
+    mfxSession session = GetSession(call.header.session);
+
+    switch (call.header.call)
+    {
+    case CAPTURE_MFXVideoDECODE_Close:
+        return MFXVideoDECODE_Close(session);
+    case CAPTURE_MFXVideoENCODE_Close:
+        return MFXVideoENCODE_Close(session);
+    default:
+        return MFXVideoVPP_Close(session);
+    }
+}
+
+mfxFrameSurface1 *Replayer::GetSurface(const CaptureCall &call, mfxU16 tag)
+{
+    CaptureSurface desc = {};
+    const CaptureField *field = call.Find(tag);
+    if (!field || field->size < sizeof(desc))
+        return NULL;
+    memcpy(&desc, field->data, sizeof(desc));
+
+    std::lock_guard<std::mutex> guard(m_guard);
+    std::unique_ptr<Surface> &surface = m_surfaces[desc.id];
+
+    if (surface &&
+        (surface->surface.Info.FourCC != desc.Info.FourCC ||
+         surface->surface.Info.Width < desc.Info.Width ||
+         surface->surface.Info.Height < desc.Info.Height))
+    {
+        // the application reallocated its surfaces
+        m_retired.push_back(std::move(surface));
+    }
+
+    if (!surface)
+    {
+        surface.reset(new Surface);
+        if (!AllocateSurface(desc.Info, surface->data, surface->surface))
+        {
+            m_unsupported += 1;
+            surface.reset();
+            return NULL;
+        }
+    }
+
+    // frame parameters change from call to call, the data stays
+    surface->surface.Info = desc.Info;
+    surface->surface.Data.TimeStamp = desc.TimeStamp;
+    surface->surface.Data.FrameOrder = desc.FrameOrder;
+    return &surface->surface;
+}
+
+Replayer::Bitstream *Replayer::GetBitstream(const mfxBitstream &captured)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+    std::unique_ptr<Bitstream> &bitstream = m_bitstreams[(mfxU64)(size_t)captured.Data];
+
+    if (!bitstream)
+        bitstream.reset(new Bitstream());
+    if (bitstream->data.size() < captured.MaxLength)
+        bitstream->data.resize(captured.MaxLength);
+
+    memset(&bitstream->bs, 0, sizeof(bitstream->bs));
+    bitstream->bs.Data = bitstream->data.data();
+    bitstream->bs.MaxLength = captured.MaxLength;
+    bitstream->bs.DataOffset = std::min(captured.DataOffset, captured.MaxLength);
+    bitstream->bs.DataLength = std::min(captured.DataLength, captured.MaxLength - bitstream->bs.DataOffset);
+    return bitstream.get();
+}
+
+void Replayer::SetSyncPoint(const CaptureCall &call, mfxSyncPoint syncp)
+{
+    mfxU64 id = 0;
+    if (!syncp || !call.Get(CAPTURE_TAG_SYNCP, id))
+        return;
+
+    std::lock_guard<std::mutex> guard(m_guard);
+    m_syncPoints[id] = syncp;
+    m_syncPointAdded.notify_all();
+}
+
+mfxSyncPoint Replayer::FindSyncPoint(mfxU64 id)
+{
+    std::unique_lock<std::mutex> guard(m_guard);
+
+    // the producing call may be still running in another thread
+    std::map<mfxU64, mfxSyncPoint>::iterator it;
+    m_syncPointAdded.wait_for(guard, std::chrono::seconds(1), [this, id, &it] {
+        it = m_syncPoints.find(id);
+        return it != m_syncPoints.end();
+    });
+    if (it == m_syncPoints.end())
+    {
+        m_missedSyncPoints += 1;
+        return NULL;
+    }
+
+    // the application may reuse the handle for another operation
+    mfxSyncPoint syncp = it->second;
+    m_syncPoints.erase(it);
+    return syncp;
+}
+
+mfxStatus Replayer::SyncOperation(const CaptureCall &call)
+{
+    mfxSession session = GetSession(call.header.session);
+    mfxU64 id = 0;
+    mfxU32 wait = 0;
+
+    call.Get(CAPTURE_TAG_SYNCP, id);
+    call.Get(CAPTURE_TAG_WAIT, wait);
+
+    mfxSyncPoint syncp = FindSyncPoint(id);
+    if (!syncp)
+        return MFX_ERR_NULL_PTR;
+
+    return MFXVideoCORE_SyncOperation(session, syncp, wait);
+}
+
+mfxStatus Replayer::DecodeFrameAsync(const CaptureCall &call)
+{
+    mfxSession session = GetSession(call.header.session);
+    mfxFrameSurface1 *work = GetSurface(call, CAPTURE_TAG_SURFACE_WORK);
+    mfxFrameSurface1 *out = NULL;
+    mfxSyncPoint syncp = NULL;
+    mfxBitstream bs = {};
+    mfxStatus sts;
+
+    if (call.Find(CAPTURE_TAG_BITSTREAM))
+    {
+        RestoreBitstream(call, bs);
+        sts = MFXVideoDECODE_DecodeFrameAsync(session, &bs, work, &out, &syncp);
+    }
+    else
+    {
+        // draining of the decoder
+        sts = MFXVideoDECODE_DecodeFrameAsync(session, NULL, work, &out, &syncp);
+    }
+
+    SetSyncPoint(call, syncp);
+    return sts;
+}
+
+mfxStatus Replayer::EncodeFrameAsync(const CaptureCall &call)
+{
+    mfxSession session = GetSession(call.header.session);
+    mfxFrameSurface1 *surface = GetSurface(call, CAPTURE_TAG_SURFACE_IN);
+    mfxEncodeCtrl ctrl = {};
+    mfxBitstream captured = {};
+    mfxSyncPoint syncp = NULL;
+
+    const bool withCtrl = call.Get(CAPTURE_TAG_ENCODE_CTRL, ctrl);
+    ctrl.ExtParam = NULL;
+    ctrl.NumExtParam = 0;
+    ctrl.Payload = NULL;
+    ctrl.NumPayload = 0;
+
+    call.Get(CAPTURE_TAG_BITSTREAM, captured);
+    Bitstream *bitstream = GetBitstream(captured);
+
+    mfxStatus sts = MFXVideoENCODE_EncodeFrameAsync(session, withCtrl ? &ctrl : NULL, surface, &bitstream->bs, &syncp);
+
+    SetSyncPoint(call, syncp);
+    return sts;
+}
+
+mfxStatus Replayer::RunFrameVPPAsync(const CaptureCall &call)
+{
+    mfxSession session = GetSession(call.header.session);
+    mfxFrameSurface1 *in = GetSurface(call, CAPTURE_TAG_SURFACE_IN);
+    mfxFrameSurface1 *out = GetSurface(call, CAPTURE_TAG_SURFACE_WORK);
+    mfxSyncPoint syncp = NULL;
+
+    mfxStatus sts = MFXVideoVPP_RunFrameVPPAsync(session, in, out, NULL, &syncp);
+
+    SetSyncPoint(call, syncp);
+    return sts;
+}
+
+void Replayer::PrintReport(std::ostream &out) const
+{
+    const double ms = 1e-6;
+
+    out << std::fixed << std::setprecision(3);
+    out << std::left << std::setw(36) << "function"
+        << std::right << std::setw(8) << "calls"
+        << std::setw(14) << "captured, ms"
+        << std::setw(14) << "replayed, ms"
+        << std::setw(12) << "max cap."
+        << std::setw(12) << "max rep."
+        << std::setw(12) << "mismatch" << "\n";
+
+    for (std::map<mfxU16, CallStat>::const_iterator it = m_stats.begin(); it != m_stats.end(); ++it)
+    {
+        const CallStat &stat = it->second;
+        out << std::left << std::setw(36) << GetCaptureCallName(it->first)
+            << std::right << std::setw(8) << stat.count
+            << std::setw(14) << stat.capturedTime * ms / stat.count
+            << std::setw(14) << stat.replayedTime * ms / stat.count
+            << std::setw(12) << stat.capturedMax * ms
+            << std::setw(12) << stat.replayedMax * ms
+            << std::setw(12) << stat.mismatches << "\n";
+    }
+
+    out << "\n";
+    out << "captured wall time, ms:  " << m_capturedWallTime * ms << "\n";
+    out << "replayed wall time, ms:  " << m_replayedWallTime * ms << "\n";
+    if (m_params.timed)
+    {
+        mfxU64 numCalls = m_reader.GetCalls().size();
+        out << "call lateness, ms:       avg " << (numCalls ? m_latenessTotal * ms / numCalls : 0.0)
+            << ", max " << m_latenessMax * ms << "\n";
+    }
+    if (m_missedSyncPoints)
+        out << "missed sync points:      " << m_missedSyncPoints << "\n";
+    if (m_unsupported)
+        out << "unsupported parameters:  " << m_unsupported << "\n";
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2020 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#ifndef REPLAY_H_
+#define REPLAY_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "mfxvideo.h"
+#include "capture_reader.h"
+
+struct ReplayParams
+{
+    // issue the calls at the captured moments, otherwise as fast as possible
+    bool        timed;
+    // force the software implementation
+    bool        software;
+    // DRM render node for the hardware implementation
+    std::string device;
+};
+
+// Re-issues the captured calls against the library. Calls of each captured
+// thread are replayed by a thread of its own, so the concurrency of the
+// application is preserved. Surfaces, sync points and sessions of the
+// capture are mapped to the replay objects by their captured handles.
+// Surfaces are always allocated in the system memory.
+class Replayer
+{
+public:
+    Replayer(const CaptureReader &reader, const ReplayParams &params);
+    ~Replayer();
+
+    mfxStatus Run();
+    void PrintReport(std::ostream &out) const;
+
+private:
+    struct CallStat
+    {
+        mfxU32 count;
+        mfxU32 mismatches;
+        mfxI64 capturedTime;
+        mfxI64 capturedMax;
+        mfxI64 replayedTime;
+        mfxI64 replayedMax;
+    };
+
+    // mfxVideoParam restored from the capture with its extension buffers
+    struct VideoParam
+    {
+        mfxVideoParam                   par;
+        std::vector<std::vector<char> > buffers;
+        std::vector<mfxExtBuffer *>     ext;
+    };
+
+    struct Surface
+    {
+        mfxFrameSurface1   surface;
+        std::vector<mfxU8> data;
+    };
+
+    struct Bitstream
+    {
+        mfxBitstream       bs;
+        std::vector<mfxU8> data;
+    };
+
+    void ThreadProc(const std::vector<const CaptureCall *> *calls);
+    mfxStatus Execute(const CaptureCall &call);
+
+    mfxStatus Init(const CaptureCall &call);
+    mfxStatus Close(const CaptureCall &call);
+    mfxStatus SyncOperation(const CaptureCall &call);
+    mfxStatus DecodeHeader(const CaptureCall &call);
+    mfxStatus QueryIOSurf(const CaptureCall &call);
+    mfxStatus InitComponent(const CaptureCall &call);
+    mfxStatus CloseComponent(const CaptureCall &call);
+    mfxStatus DecodeFrameAsync(const CaptureCall &call);
+    mfxStatus EncodeFrameAsync(const CaptureCall &call);
+    mfxStatus RunFrameVPPAsync(const CaptureCall &call);
+
+    mfxSession GetSession(mfxU64 id);
+    bool RestoreVideoParam(const CaptureCall &call, VideoParam &param);
+    void RestoreBitstream(const CaptureCall &call, mfxBitstream &bs);
+    mfxFrameSurface1 *GetSurface(const CaptureCall &call, mfxU16 tag);
+    Bitstream *GetBitstream(const mfxBitstream &captured);
+    void SetSyncPoint(const CaptureCall &call, mfxSyncPoint syncp);
+    mfxSyncPoint FindSyncPoint(mfxU64 id);
+
+    const CaptureReader &m_reader;
+    const ReplayParams   m_params;
+
+    // protects all the maps below, the library is called without it
+    std::mutex              m_guard;
+    std::condition_variable m_syncPointAdded;
+
+    std::map<mfxU64, mfxSession>                  m_sessions;
+    std::map<mfxU64, mfxSyncPoint>                m_syncPoints;
+    std::map<mfxU64, std::unique_ptr<Surface> >   m_surfaces;
+    std::map<mfxU64, std::unique_ptr<Bitstream> > m_bitstreams;
+    // surfaces replaced by the reallocation, may still be used by the library
+    std::vector<std::unique_ptr<Surface> >        m_retired;
+
+    std::map<mfxU16, CallStat> m_stats;
+    mfxU32 m_missedSyncPoints;
+    mfxU32 m_unsupported;
+    // how late the calls were issued against the captured timing
+    mfxI64 m_latenessTotal;
+    mfxI64 m_latenessMax;
+    mfxI64 m_capturedWallTime;
+    mfxI64 m_replayedWallTime;
+
+    // start of the capture and of the replay, timed calls keep their offset
+    mfxI64 m_captureStart;
+    std::chrono::steady_clock::time_point m_replayStart;
+
+    int   m_fd;
+    void *m_display;
+};
+
+#endif // REPLAY_H_
@@ -27,6 +27,13 @@ void tracer_init()
         Log::SetLogType(LOG_CONSOLE);
     } else if (type == std::string("file")) {
         Log::SetLogType(LOG_FILE);
+    } else if (type == std::string("capture")) {
+        // binary capture of the calls for mfx-replay, the text log is off
+        std::string file_path = Config::GetParam("core", "log");
+        if (file_path.empty())
+            file_path = "mfxtracer.cap";
+        if (!Capture::Enable(file_path))
+            Log::SetLogType(LOG_CONSOLE);
     } else {
         // TODO: what to do with incorrect setting?
         Log::SetLogType(LOG_CONSOLE);
@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <exception>
 #include "mfxvideo.h"
+#include "../capture/capture.h"
 #include "../config/config.h"
 #include "../dumps/dump.h"
 #include "../loggers/log.h"
@@ -110,11 +110,17 @@ mfxStatus MFXInit(mfxIMPL impl, mfxVersion *ver, mfxSession *session)
         Log::WriteLog(context.dump("ver", ver));
         Log::WriteLog(context.dump("session", loader->session));
         /* Initializing loaded library */
+        CaptureRecord record(CAPTURE_MFXInit, NULL);
+        record.Add(CAPTURE_TAG_IMPL, impl);
+        if (ver) record.Add(CAPTURE_TAG_VERSION, *ver);
+        record.Begin();
         Timer t;
         mfxStatus mfx_res = (*(MFXInitPointer)loader->table[eMFXInit_tracer])(impl, ver, &(loader->session));
         std::string elapsed = TimeToString(t.GetTime());
+        record.End(mfx_res);
         Log::WriteLog(">> MFXInit called");
         if (MFX_ERR_NONE != mfx_res) {
+            record.Commit();
             dlclose(loader->dlhandle);
             free(loader);
             Log::WriteLog(context.dump("ver", ver));
@@ -123,6 +129,8 @@ mfxStatus MFXInit(mfxIMPL impl, mfxVersion *ver, mfxSession *session)
             return mfx_res;
         }
         *session = (mfxSession)loader;
+        record.AddPointer(CAPTURE_TAG_SESSION_OUT, loader);
+        record.Commit();
         Log::WriteLog(context.dump("impl", impl));
         Log::WriteLog(context.dump("ver", ver));
         Log::WriteLog(context.dump("session", loader->session));
@@ -149,9 +157,16 @@ mfxStatus MFXClose(mfxSession session)
             return MFX_ERR_INVALID_HANDLE;
         }
         Log::WriteLog(context.dump("session", session));
+        CaptureRecord record(CAPTURE_MFXClose, session);
+        record.Begin();
         Timer t;
         mfxStatus mfx_res = (*(MFXClosePointer)loader->table[eMFXClose_tracer])(loader->session);
         std::string elapsed = TimeToString(t.GetTime());
+        record.End(mfx_res);
+        record.Commit();
+        // the session handle may be reused, so it starts with no bitstream tail
+        Capture::ForgetSession((mfxU64)(size_t)session);
+        Capture::Flush();
         Log::WriteLog(">> MFXClose called");
         dlclose(loader->dlhandle);
         free(loader);
@@ -215,11 +230,16 @@ mfxStatus MFXInitEx(mfxInitParam par, mfxSession *session)
         Log::WriteLog(context.dump("par", par));
         Log::WriteLog(context.dump("session", loader->session));
         /* Initializing loaded library */
+        CaptureRecord record(CAPTURE_MFXInitEx, NULL);
+        record.Add(CAPTURE_TAG_INIT_PARAM, par);
+        record.Begin();
         Timer t;
         mfxStatus mfx_res = (*(MFXInitExPointer)loader->table[eMFXInitEx_tracer])(par, &(loader->session));
         std::string elapsed = TimeToString(t.GetTime());
+        record.End(mfx_res);
         Log::WriteLog(">> MFXInitEx called");
         if (MFX_ERR_NONE != mfx_res) {
+            record.Commit();
             dlclose(loader->dlhandle);
             free(loader);
             Log::WriteLog(context.dump("par", par));
@@ -228,6 +248,8 @@ mfxStatus MFXInitEx(mfxInitParam par, mfxSession *session)
             return mfx_res;
         }
         *session = (mfxSession)loader;
+        record.AddPointer(CAPTURE_TAG_SESSION_OUT, loader);
+        record.Commit();
         Log::WriteLog(context.dump("par", par));
         Log::WriteLog(context.dump("session", loader->session));
         Log::WriteLog(std::string("function: MFXInitEx(" + elapsed + ", " + context.dump_mfxStatus("status", mfx_res) + ") - \n\n"));
@@ -32,6 +32,7 @@ File Name: mfx_video_core.cpp
 #include <iostream>
 
 #include "../loggers/timer.h"
+#include "../capture/capture.h"
 #include "../tracer/functions_table.h"
 #include "mfx_structures.h"
 
@@ -413,6 +414,28 @@ mfxStatus MFXVideoCORE_QueryPlatform(mfxSession session, mfxPlatform* platform)
 mfxStatus MFXVideoCORE_SyncOperation(mfxSession session, mfxSyncPoint syncp, mfxU32 wait)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            // already synced
+            if (!syncp) return MFX_ERR_NONE;
+
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoCORE_SyncOperation_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoCORE_SyncOperation, session);
+            record.AddPointer(CAPTURE_TAG_SYNCP, syncp);
+            record.Add(CAPTURE_TAG_WAIT, wait);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoCORE_SyncOperation) proc) (loader->session, syncp, wait);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         if (Log::GetLogLevel() >= LOG_LEVEL_FULL) //call function with logging
         {
             DumpContext context;
@@ -32,6 +32,7 @@ File Name: mfx_video_decode.cpp
 #include <iostream>
 
 #include "../loggers/timer.h"
+#include "../capture/capture.h"
 #include "../tracer/functions_table.h"
 #include "mfx_structures.h"
 
@@ -73,6 +74,27 @@ mfxStatus MFXVideoDECODE_Query(mfxSession session, mfxVideoParam *in, mfxVideoPa
 mfxStatus MFXVideoDECODE_DecodeHeader(mfxSession session, mfxBitstream *bs, mfxVideoParam *par)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoDECODE_DecodeHeader_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoDECODE_DecodeHeader, session);
+            mfxBitstream before = {};
+            if (bs) before = *bs;
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoDECODE_DecodeHeader) proc) (loader->session, bs, par);
+            record.End(status);
+            if (bs) record.AddBitstream(before, bs);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_MFX;
         Log::WriteLog("function: MFXVideoDECODE_DecodeHeader(mfxSession session=" + ToString(session) + ", mfxBitstream *bs=" + ToString(bs) + ", mfxVideoParam *par=" + ToString(par) + ") +");
@@ -107,6 +129,25 @@ mfxStatus MFXVideoDECODE_DecodeHeader(mfxSession session, mfxBitstream *bs, mfxV
 mfxStatus MFXVideoDECODE_QueryIOSurf(mfxSession session, mfxVideoParam *par, mfxFrameAllocRequest *request)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoDECODE_QueryIOSurf_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoDECODE_QueryIOSurf, session);
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoDECODE_QueryIOSurf) proc) (loader->session, par, request);
+            record.End(status);
+            if (request) record.Add(CAPTURE_TAG_ALLOC_REQUEST, *request);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_MFX;
         Log::WriteLog("function: MFXVideoDECODE_QueryIOSurf(mfxSession session=" + ToString(session) + ", mfxVideoParam *par=" + ToString(par) + ", mfxFrameAllocRequest *request=" + ToString(request) + ") +");
@@ -141,6 +182,24 @@ mfxStatus MFXVideoDECODE_QueryIOSurf(mfxSession session, mfxVideoParam *par, mfx
 mfxStatus MFXVideoDECODE_Init(mfxSession session, mfxVideoParam *par)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoDECODE_Init_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoDECODE_Init, session);
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoDECODE_Init) proc) (loader->session, par);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_MFX;
         Log::WriteLog("function: MFXVideoDECODE_Init(mfxSession session=" + ToString(session) + ", mfxVideoParam *par=" + ToString(par) + ") +");
@@ -173,6 +232,24 @@ mfxStatus MFXVideoDECODE_Init(mfxSession session, mfxVideoParam *par)
 mfxStatus MFXVideoDECODE_Reset(mfxSession session, mfxVideoParam *par)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoDECODE_Reset_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoDECODE_Reset, session);
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoDECODE_Reset) proc) (loader->session, par);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_MFX;
         Log::WriteLog("function: MFXVideoDECODE_Reset(mfxSession session=" + ToString(session) + ", mfxVideoParam *par=" + ToString(par) + ") +");
@@ -205,6 +282,23 @@ mfxStatus MFXVideoDECODE_Reset(mfxSession session, mfxVideoParam *par)
 mfxStatus MFXVideoDECODE_Close(mfxSession session)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoDECODE_Close_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoDECODE_Close, session);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoDECODE_Close) proc) (loader->session);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_MFX;
         Log::WriteLog("function: MFXVideoDECODE_Close(mfxSession session=" + ToString(session) + ") +");
@@ -365,6 +459,29 @@ mfxStatus MFXVideoDECODE_GetPayload(mfxSession session, mfxU64 *ts, mfxPayload *
 mfxStatus MFXVideoDECODE_DecodeFrameAsync(mfxSession session, mfxBitstream *bs, mfxFrameSurface1 *surface_work, mfxFrameSurface1 **surface_out, mfxSyncPoint *syncp)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoDECODE_DecodeFrameAsync_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoDECODE_DecodeFrameAsync, session);
+            mfxBitstream before = {};
+            if (bs) before = *bs;
+            record.AddSurface(CAPTURE_TAG_SURFACE_WORK, surface_work);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoDECODE_DecodeFrameAsync) proc) (loader->session, bs, surface_work, surface_out, syncp);
+            record.End(status);
+            if (bs) record.AddBitstream(before, bs);
+            if (surface_out && *surface_out) record.AddPointer(CAPTURE_TAG_SURFACE_OUT, *surface_out);
+            if (syncp && *syncp) record.AddPointer(CAPTURE_TAG_SYNCP, *syncp);
+            record.Commit();
+
+            return status;
+        }
         if (Log::GetLogLevel() >= LOG_LEVEL_FULL) // call with logging
         {
             DumpContext context;
@@ -32,6 +32,7 @@ File Name: mfx_video_encode.cpp
 #include <iostream>
 
 #include "../loggers/timer.h"
+#include "../capture/capture.h"
 #include "../tracer/functions_table.h"
 #include "mfx_structures.h"
 #include <vector>
@@ -264,6 +265,25 @@ mfxStatus MFXVideoENCODE_Query(mfxSession session, mfxVideoParam *in, mfxVideoPa
 mfxStatus MFXVideoENCODE_QueryIOSurf(mfxSession session, mfxVideoParam *par, mfxFrameAllocRequest *request)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoENCODE_QueryIOSurf_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoENCODE_QueryIOSurf, session);
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoENCODE_QueryIOSurf) proc) (loader->session, par, request);
+            record.End(status);
+            if (request) record.Add(CAPTURE_TAG_ALLOC_REQUEST, *request);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_MFX;
         Log::WriteLog("function: MFXVideoENCODE_QueryIOSurf(mfxSession session=" + ToString(session) + ", mfxVideoParam *par=" + ToString(par) + ", mfxFrameAllocRequest *request=" + ToString(request) + ") +");
@@ -298,6 +318,24 @@ mfxStatus MFXVideoENCODE_QueryIOSurf(mfxSession session, mfxVideoParam *par, mfx
 mfxStatus MFXVideoENCODE_Init(mfxSession session, mfxVideoParam *par)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoENCODE_Init_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoENCODE_Init, session);
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoENCODE_Init) proc) (loader->session, par);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_MFX;
         Log::WriteLog("function: MFXVideoENCODE_Init(mfxSession session=" + ToString(session) + ", mfxVideoParam *par=" + ToString(par) + ") +");
@@ -378,6 +416,24 @@ mfxStatus MFXVideoENCODE_Init(mfxSession session, mfxVideoParam *par)
 mfxStatus MFXVideoENCODE_Reset(mfxSession session, mfxVideoParam *par)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoENCODE_Reset_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoENCODE_Reset, session);
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoENCODE_Reset) proc) (loader->session, par);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_MFX;
         Log::WriteLog("function: MFXVideoENCODE_Reset(mfxSession session=" + ToString(session) + ", mfxVideoParam *par=" + ToString(par) + ") +");
@@ -411,6 +467,23 @@ mfxStatus MFXVideoENCODE_Reset(mfxSession session, mfxVideoParam *par)
 mfxStatus MFXVideoENCODE_Close(mfxSession session)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoENCODE_Close_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoENCODE_Close, session);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoENCODE_Close) proc) (loader->session);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_MFX;
         Log::WriteLog("function: MFXVideoENCODE_Close(mfxSession session=" + ToString(session) + ") +");
@@ -505,6 +578,27 @@ mfxStatus MFXVideoENCODE_GetEncodeStat(mfxSession session, mfxEncodeStat *stat)
 mfxStatus MFXVideoENCODE_EncodeFrameAsync(mfxSession session, mfxEncodeCtrl *ctrl, mfxFrameSurface1 *surface, mfxBitstream *bs, mfxSyncPoint *syncp)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoENCODE_EncodeFrameAsync_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoENCODE_EncodeFrameAsync, session);
+            if (ctrl) record.Add(CAPTURE_TAG_ENCODE_CTRL, *ctrl);
+            record.AddSurface(CAPTURE_TAG_SURFACE_IN, surface);
+            if (bs) record.AddBitstream(*bs, NULL);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoENCODE_EncodeFrameAsync) proc) (loader->session, ctrl, surface, bs, syncp);
+            record.End(status);
+            if (syncp && *syncp) record.AddPointer(CAPTURE_TAG_SYNCP, *syncp);
+            record.Commit();
+
+            return status;
+        }
         if (Log::GetLogLevel() >= LOG_LEVEL_FULL) // call with logging
         {
             DumpContext context;
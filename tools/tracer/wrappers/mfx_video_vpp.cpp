@@ -32,6 +32,7 @@ File Name: mfx_video_vpp.cpp
 #include <iostream>
 
 #include "../loggers/timer.h"
+#include "../capture/capture.h"
 #include "../tracer/functions_table.h"
 #include "mfx_structures.h"
 
@@ -73,6 +74,25 @@ mfxStatus MFXVideoVPP_Query(mfxSession session, mfxVideoParam *in, mfxVideoParam
 mfxStatus MFXVideoVPP_QueryIOSurf(mfxSession session, mfxVideoParam *par, mfxFrameAllocRequest *request)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoVPP_QueryIOSurf_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoVPP_QueryIOSurf, session);
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoVPP_QueryIOSurf) proc) (loader->session, par, request);
+            record.End(status);
+            if (request) record.Add(CAPTURE_TAG_ALLOC_REQUEST, request, 2 * sizeof(mfxFrameAllocRequest));
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_VPP;
         Log::WriteLog("function: MFXVideoVPP_QueryIOSurf(mfxSession session=" + ToString(session) + ", mfxVideoParam *par=" + ToString(par) + ", mfxFrameAllocRequest *request=" + ToString(request) + ") +");
@@ -107,6 +127,24 @@ mfxStatus MFXVideoVPP_QueryIOSurf(mfxSession session, mfxVideoParam *par, mfxFra
 mfxStatus MFXVideoVPP_Init(mfxSession session, mfxVideoParam *par)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoVPP_Init_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoVPP_Init, session);
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoVPP_Init) proc) (loader->session, par);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_VPP;
         Log::WriteLog("function: MFXVideoVPP_Init(mfxSession session=" + ToString(session) + ", mfxVideoParam *par=" + ToString(par) + ") +");
@@ -139,6 +177,24 @@ mfxStatus MFXVideoVPP_Init(mfxSession session, mfxVideoParam *par)
 mfxStatus MFXVideoVPP_Reset(mfxSession session, mfxVideoParam *par)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoVPP_Reset_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoVPP_Reset, session);
+            record.AddVideoParam(par);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoVPP_Reset) proc) (loader->session, par);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_VPP;
         Log::WriteLog("function: MFXVideoVPP_Reset(mfxSession session=" + ToString(session) + ", mfxVideoParam *par=" + ToString(par) + ") +");
@@ -171,6 +227,23 @@ mfxStatus MFXVideoVPP_Reset(mfxSession session, mfxVideoParam *par)
 mfxStatus MFXVideoVPP_Close(mfxSession session)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoVPP_Close_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoVPP_Close, session);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoVPP_Close) proc) (loader->session);
+            record.End(status);
+            record.Commit();
+
+            return status;
+        }
         DumpContext context;
         context.context = DUMPCONTEXT_VPP;
         Log::WriteLog("function: MFXVideoVPP_Close(mfxSession session=" + ToString(session) + ") +");
@@ -265,6 +338,26 @@ mfxStatus MFXVideoVPP_GetVPPStat(mfxSession session, mfxVPPStat *stat)
 mfxStatus MFXVideoVPP_RunFrameVPPAsync(mfxSession session, mfxFrameSurface1 *in, mfxFrameSurface1 *out, mfxExtVppAuxData *aux, mfxSyncPoint *syncp)
 {
     try{
+        if (Capture::IsEnabled()) // binary capture instead of the text log
+        {
+            mfxLoader *loader = (mfxLoader*) session;
+
+            if (!loader) return MFX_ERR_INVALID_HANDLE;
+
+            mfxFunctionPointer proc = loader->table[eMFXVideoVPP_RunFrameVPPAsync_tracer];
+            if (!proc) return MFX_ERR_INVALID_HANDLE;
+
+            CaptureRecord record(CAPTURE_MFXVideoVPP_RunFrameVPPAsync, session);
+            record.AddSurface(CAPTURE_TAG_SURFACE_IN, in);
+            record.AddSurface(CAPTURE_TAG_SURFACE_WORK, out);
+            record.Begin();
+            mfxStatus status = (*(fMFXVideoVPP_RunFrameVPPAsync) proc) (loader->session, in, out, aux, syncp);
+            record.End(status);
+            if (syncp && *syncp) record.AddPointer(CAPTURE_TAG_SYNCP, *syncp);
+            record.Commit();
+
+            return status;
+        }
         if (Log::GetLogLevel() >= LOG_LEVEL_FULL) // call with logging
         {
             DumpContext context;